@@ -30,21 +30,23 @@
 #ifndef LD_CAPABILITIES_H
 #define LD_CAPABILITIES_H
 
-#include <util_bit_set.h>
+#include <QString>
+
+#include <cstdint>
 
 #include "ld_common.h"
 
 namespace Ld {
     /**
-     * Specialization of the Util::BitSet class that is used to track parent requirements or child capabilities
-     * for elements throughout the application.
+     * Fixed width bit set that is used to track parent requirements or child capabilities for elements throughout
+     * the application.
+     *
+     * Built-in capabilities occupy a single 64-bit mask so the pre-defined instances are constant initialized and
+     * set operations never allocate.  Capabilities added by plug-ins by name are placed in a second 64-bit mask.
      *
      * This class also defines several specific and common parent requirements.
      */
-    class LD_PUBLIC_API Capabilities:public Util::BitSet {
-        private:
-            static Util::BitSet::BitNameHash bitNameHash;
-
+    class LD_PUBLIC_API Capabilities {
         public:
             /**
              * Pre-defined instance of \ref Capabilities, indicates selection are OK.
@@ -871,34 +873,41 @@ namespace Ld {
              */
             static const Capabilities allSymbols;
 
-            Capabilities();
+            /**
+             * The maximum number of built-in bits.
+             */
+            static constexpr unsigned maximumNumberBuiltInBits = 64;
 
-            ~Capabilities();
+            /**
+             * The maximum number of bits that can be assigned by plug-ins.
+             */
+            static constexpr unsigned maximumNumberPlugInBits = 64;
 
             /**
-             * Copy constructor.
-             *
-             * \param[in] other The instance to be copied.
+             * Constructor.  Creates an empty set.
              */
-            Capabilities(const Util::BitSet& other);
+            constexpr Capabilities():currentBuiltIns(0),currentPlugIns(0) {}
 
             /**
              * Copy constructor.
              *
              * \param[in] other The instance to be copied.
              */
-            Capabilities(const Capabilities& other);
+            constexpr Capabilities(const Capabilities& other) = default;
 
             /**
              * Constructor
              *
              * \param[in] bitName A literal string values or QString indicating the name of a bit to be set on
-             *                    instance creation. The bit will be created if it does not already exist.
+             *                    instance creation. The bit will be created if it does not already exist.  Names of
+             *                    built-in capabilities, such as "SELECTION", reference the built-in bits.
              */
             template<typename T> LD_PUBLIC_TEMPLATE_METHOD Capabilities(
                     const T& bitName
-                ):Util::BitSet(
-                    &bitNameHash
+                ):currentBuiltIns(
+                    0
+                ),currentPlugIns(
+                    0
                 ) {
                 assignAndSetBits(bitName);
             }
@@ -917,22 +926,76 @@ namespace Ld {
             template<typename T1, typename... T2> LD_PUBLIC_TEMPLATE_METHOD Capabilities(
                     const T1&    firstBitName,
                     const T2&... additionalBitNames
-                ):Util::BitSet(
-                    &bitNameHash
+                ):currentBuiltIns(
+                    0
+                ),currentPlugIns(
+                    0
                 ) {
                 assignAndSetBits(firstBitName);
                 assignAndSetBits(additionalBitNames...);
             }
 
             /**
-             * Method you can use to add a bit to this bit set.
+             * Method you can use to add a bit to this bit set.  New bits are placed in the plug-in extension.
              *
              * \param[in] bitName The name of the bit.
              *
-             * \return Returns true on success, returns false if the bit was already assigned.
+             * \return Returns true on success, returns false if the bit was already assigned or if all the bits in
+             *         the plug-in extension have already been assigned.
              */
             static bool assignBit(const QString& bitName);
 
+            /**
+             * Method you can use to determine how many times a bit could not be set because every bit in the plug-in
+             * extension had already been assigned.  Bits that can not be assigned are left clear so callers, such as
+             * the plug-in loader, should compare this value before and after creating capabilities to detect the
+             * failure.
+             *
+             * \return Returns the number of bit names that could not be assigned.
+             */
+            static unsigned numberUnassignedBits();
+
+            /**
+             * Method you can use to determine if this set is empty.
+             *
+             * \return Returns true if no bits are set.  Returns false if one or more bits are set.
+             */
+            constexpr bool isEmpty() const {
+                return currentBuiltIns == 0 && currentPlugIns == 0;
+            }
+
+            /**
+             * Method you can use to determine if this set is not empty.
+             *
+             * \return Returns true if one or more bits are set.  Returns false if no bits are set.
+             */
+            constexpr bool isNotEmpty() const {
+                return !isEmpty();
+            }
+
+            /**
+             * Method you can use to determine if this set shares any bits with another set.
+             *
+             * \param[in] other The set to compare against.
+             *
+             * \return Returns true if the two sets share at least one bit.
+             */
+            constexpr bool intersects(const Capabilities& other) const {
+                return (currentBuiltIns & other.currentBuiltIns) != 0 || (currentPlugIns & other.currentPlugIns) != 0;
+            }
+
+            /**
+             * Method you can use to determine if this set contains every bit in another set.
+             *
+             * \param[in] other The set to compare against.
+             *
+             * \return Returns true if every bit in the other set is also in this set.
+             */
+            constexpr bool contains(const Capabilities& other) const {
+                return    (currentBuiltIns & other.currentBuiltIns) == other.currentBuiltIns
+                       && (currentPlugIns & other.currentPlugIns) == other.currentPlugIns;
+            }
+
             /**
              * Assignment operator.
              *
@@ -940,12 +1003,117 @@ namespace Ld {
              *
              * \return Returns a reference to this instance.
              */
-            inline Capabilities operator=(const Capabilities& other) {
-                Util::BitSet::operator=(other);
+            Capabilities& operator=(const Capabilities& other) = default;
+
+            /**
+             * Union operator.
+             *
+             * \param[in] other The set to merge with this set.
+             *
+             * \return Returns the union of the two sets.
+             */
+            constexpr Capabilities operator|(const Capabilities& other) const {
+                return Capabilities(currentBuiltIns | other.currentBuiltIns, currentPlugIns | other.currentPlugIns);
+            }
+
+            /**
+             * Intersection operator.
+             *
+             * \param[in] other The set to intersect with this set.
+             *
+             * \return Returns the intersection of the two sets.
+             */
+            constexpr Capabilities operator&(const Capabilities& other) const {
+                return Capabilities(currentBuiltIns & other.currentBuiltIns, currentPlugIns & other.currentPlugIns);
+            }
+
+            /**
+             * Symmetric difference operator.
+             *
+             * \param[in] other The set to compare against this set.
+             *
+             * \return Returns the bits set in exactly one of the two sets.
+             */
+            constexpr Capabilities operator^(const Capabilities& other) const {
+                return Capabilities(currentBuiltIns ^ other.currentBuiltIns, currentPlugIns ^ other.currentPlugIns);
+            }
+
+            /**
+             * Union assignment operator.
+             *
+             * \param[in] other The set to merge into this set.
+             *
+             * \return Returns a reference to this instance.
+             */
+            inline Capabilities& operator|=(const Capabilities& other) {
+                currentBuiltIns |= other.currentBuiltIns;
+                currentPlugIns  |= other.currentPlugIns;
+
                 return *this;
             }
 
+            /**
+             * Intersection assignment operator.
+             *
+             * \param[in] other The set to intersect with this set.
+             *
+             * \return Returns a reference to this instance.
+             */
+            inline Capabilities& operator&=(const Capabilities& other) {
+                currentBuiltIns &= other.currentBuiltIns;
+                currentPlugIns  &= other.currentPlugIns;
+
+                return *this;
+            }
+
+            /**
+             * Comparison operator.
+             *
+             * \param[in] other The instance to compare against.
+             *
+             * \return Returns true if the sets are equal.
+             */
+            constexpr bool operator==(const Capabilities& other) const {
+                return currentBuiltIns == other.currentBuiltIns && currentPlugIns == other.currentPlugIns;
+            }
+
+            /**
+             * Comparison operator.
+             *
+             * \param[in] other The instance to compare against.
+             *
+             * \return Returns true if the sets are not equal.
+             */
+            constexpr bool operator!=(const Capabilities& other) const {
+                return !operator==(other);
+            }
+
         private:
+            /**
+             * Type used to hold the bit masks.
+             */
+            typedef std::uint64_t Mask;
+
+            /**
+             * Constructor used to create the pre-defined instances at compile time.
+             *
+             * \param[in] builtIns The mask of built-in bits.
+             *
+             * \param[in] plugIns  The mask of bits assigned by plug-ins.
+             */
+            constexpr Capabilities(Mask builtIns, Mask plugIns = 0):currentBuiltIns(builtIns),currentPlugIns(plugIns) {}
+
+            /**
+             * Method that sets a bit by name.  If the bit is not already assigned, a new assignment will be created
+             * for it.
+             *
+             * \param[in] bitName The name of the bit.
+             *
+             * \return Returns true on success, returns false if the bit was not assigned and no plug-in bits remain.
+             *         The failure is counted by \ref Ld::Capabilities::numberUnassignedBits.
+             */
+            bool setBit(const QString& bitName);
+
             /**
              * Method that can be used to set a bit.  If the bit is not already assigned, a new assignment will be
              * created for it.
@@ -953,8 +1121,7 @@ namespace Ld {
              * \param[in] bitName The name of the bit.
              */
             template<typename T> LD_PUBLIC_TEMPLATE_METHOD void assignAndSetBits(const T& bitName) {
-                assignBit(bitName);
-                setBit(bitName, true);
+                setBit(QString(bitName));
             }
 
             /**
@@ -974,6 +1141,26 @@ namespace Ld {
                 assignAndSetBits(firstBitName);
                 assignAndSetBits(additionalBitNames...);
             }
+
+            /**
+             * The number of bits assigned by plug-ins.
+             */
+            static unsigned numberAssignedPlugInBits;
+
+            /**
+             * The number of bit names that could not be assigned.
+             */
+            static unsigned currentNumberUnassignedBits;
+
+            /**
+             * The built-in bits.
+             */
+            Mask currentBuiltIns;
+
+            /**
+             * The bits assigned by plug-ins.
+             */
+            Mask currentPlugIns;
     };
 };
 
@@ -200,6 +200,17 @@ namespace Ld {
              */
             QSharedPointer<Translator> translator(const QString& elementName) const;
 
+            /**
+             * Method you can use to obtain the translator for an element.  The lookup uses the element's type
+             * identifier, falling back to a lookup by name for element types with no registered creator.
+             *
+             * \param[in] element The element we want a translator for.
+             *
+             * \return Returns a pointer to the desired translator.  A null pointer is returned if no translator is
+             *         available.
+             */
+            Translator* translator(ElementPointer element) const;
+
             /**
              * Method that can be called by a translator to insert the translation of a child element.  This method will
              * be called when the element heirarchy needs to be honored.  The default implementation will simply invoke
@@ -215,7 +226,8 @@ namespace Ld {
             /**
              * Method that is called each time the code generator detects an error condition.  This method may be
              * triggered multiple times during a translation and may be triggered from a different thread from that used
-             * to invoke the code generator.  Reports the error to the code generator.
+             * to invoke the code generator.  Reports the error to the code generator.  The method is thread safe during
+             * parallel translation; diagnostics are held and reported in element order once all workers complete.
              *
              * \param[in] diagnostic The diagnostic tied to the error, warning, etc.
              */
@@ -235,7 +247,7 @@ namespace Ld {
              * Method you can call to update the number of successfully completed translation steps.  You should call
              * this method from translators if they intentionally avoid calling
              * \ref Ld::CodeGenerationEngine::translateChild or \ref Ld::CodeGenerationEngine::translateElement for
-             * any children.
+             * any children.  The method is thread safe during parallel translation.
              */
             void translationStepCompleted();
 
@@ -253,6 +265,15 @@ namespace Ld {
              */
             void setTranslationAvailable(bool nowTranslationAvailable = true);
 
+            /**
+             * Method you can call to obtain a modifiable reference to the current translation phase.  Derived classes
+             * can use this method to adjust the translation phase once information gathered by earlier phases is
+             * available.
+             *
+             * \return Returns a reference to the current translation phase.
+             */
+            TranslationPhase& modifiableTranslationPhase();
+
             /**
              * Method you can call to advance to the next translation phase.
              */
@@ -346,7 +367,45 @@ namespace Ld {
              */
             virtual bool missingTranslator(ElementPointer element) = 0;
 
+            /**
+             * Method you can use to determine which parallel translation shard the calling thread is processing.
+             *
+             * \return Returns the zero based index of the shard being translated by the calling thread.  Returns -1 if
+             *         the calling thread is not translating a shard.
+             */
+            static int parallelShardIndex();
+
+            /**
+             * Method that is called on the engine thread just before the shards of a parallel translation are started.
+             * You can overload this method to allocate per-shard state so that thread safe translators can avoid
+             * contending for shared state.  The default implementation does nothing.
+             *
+             * \param[in] numberShards The number of shards that will be translated.
+             */
+            virtual void parallelTranslationStarting(unsigned numberShards);
+
+            /**
+             * Method that is called on the engine thread after every shard of a parallel translation has completed.
+             * You can overload this method to merge per-shard state, in shard order.  The default implementation does
+             * nothing.
+             *
+             * \param[in] numberShards The number of shards that were translated.
+             */
+            virtual void parallelTranslationFinished(unsigned numberShards);
+
+            /**
+             * Method that is called to build up a list of root elements to be processed.
+             *
+             * \return Returns a list of root elements to be processed.
+             */
+            RootElement::RootElementList rootElementsToProcess();
+
         private:
+            /**
+             * Class used to translate a contiguous range of elements on a worker thread during parallel translation.
+             */
+            class TranslationShard;
+
             /**
              * Method that clears all pending errors on all children of a root element.
              *
@@ -364,11 +423,15 @@ namespace Ld {
             bool translateRootElement(QSharedPointer<RootElement> rootElement);
 
             /**
-             * Method that is called to build up a list of root elements to be processed.
+             * Method that translates every element under a root element, distributing elements with thread safe
+             * translators across a pool of worker threads.  Diagnostics and completed step counts are merged in
+             * element order so the results match a serial translation.
              *
-             * \return Returns a list of root elements to be processed.
+             * \param[in] rootElement The root element to be translated.
+             *
+             * \return Returns true on success, returns false on error.
              */
-            RootElement::RootElementList rootElementsToProcess();
+            bool translateElementsInParallel(QSharedPointer<RootElement> rootElement);
 
             /**
              * Method that determines the total number of element translator calls to be performed.
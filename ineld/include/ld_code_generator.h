@@ -35,10 +35,12 @@
 #include <QByteArray>
 #include <QList>
 #include <QHash>
+#include <QVector>
 #include <QThread>
 
 #include "ld_common.h"
 #include "ld_element_structures.h"
+#include "ld_element.h"
 #include "ld_diagnostic_structures.h"
 #include "ld_diagnostic.h"
 #include "ld_code_generator_output_type.h"
@@ -261,6 +263,17 @@ namespace Ld {
              */
             QSharedPointer<Translator> translator(const QString& elementName) const;
 
+            /**
+             * Method you can use to obtain a translator, by element type identifier.  Lookups are performed through
+             * a flat table that is rebuilt, as needed, when a translation is started.
+             *
+             * \param[in] typeId The type identifier of the element we want a translator for.
+             *
+             * \return Returns a pointer to the desired translator.  The translator remains owned by this code
+             *         generator.  A null pointer is returned if no translator is available.
+             */
+            Translator* translator(Element::TypeId typeId) const;
+
             /**
              * Method you can use to start translation.  Note that the translation process will run in a separate
              * thread.  You can overload the following methods to obtain results:
@@ -349,6 +362,40 @@ namespace Ld {
              */
             const QSet<Diagnostic::Type>& enabledDiagnosticTypes() const;
 
+            /**
+             * Method you can use to enable or disable parallel translation.  When enabled, phases that ignore the
+             * element heirarchy will translate elements with thread safe translators across a pool of worker threads.
+             * Parallel translation is disabled by default.
+             *
+             * \param[in] nowEnabled If true, parallel translation will be enabled.  If false, parallel translation
+             *                       will be disabled.
+             */
+            void setParallelTranslationEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable parallel translation.
+             *
+             * \param[in] nowDisabled If true, parallel translation will be disabled.  If false, parallel translation
+             *                        will be enabled.
+             */
+            void setParallelTranslationDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if parallel translation is enabled.
+             *
+             * \return Returns true if parallel translation is enabled.  Returns false if parallel translation is
+             *         disabled.
+             */
+            bool parallelTranslationEnabled() const;
+
+            /**
+             * Method you can use to determine if parallel translation is disabled.
+             *
+             * \return Returns true if parallel translation is disabled.  Returns false if parallel translation is
+             *         enabled.
+             */
+            bool parallelTranslationDisabled() const;
+
             /**
              * Method you can use to obtain a list of reported diagnostics.
              *
@@ -510,6 +557,12 @@ namespace Ld {
             const CodeGenerationEngine& codeGenerationEngine() const;
 
         private:
+            /**
+             * Method that rebuilds the translator table if translators or element types were registered since the
+             * table was last built.
+             */
+            void updateTranslatorTable();
+
             /**
              * The visual used to report code generation status.
              */
@@ -530,6 +583,16 @@ namespace Ld {
              */
             QHash<QString, QSharedPointer<Translator>> currentTranslators;
 
+            /**
+             * Table of translators, indexed by element type identifier.
+             */
+            QVector<Translator*> currentTranslatorsByTypeId;
+
+            /**
+             * Flag indicating that the translator table must be rebuilt.
+             */
+            bool currentTranslatorTableStale;
+
             /**
              * A hash of all the code generators known in the system.
              */
@@ -550,6 +613,11 @@ namespace Ld {
              */
             QSet<Diagnostic::Type> currentEnabledDiagnosticTypes;
 
+            /**
+             * Flag indicating if parallel translation is enabled.
+             */
+            bool currentParallelTranslationEnabled;
+
             /**
              * An empty/default list of returned diagnostics.
              */
@@ -39,6 +39,7 @@
 #include "ld_common.h"
 #include "ld_data_type.h"
 #include "ld_function_variant.h"
+#include "ld_plug_in_information.h"
 
 namespace Ud {
     class UsageData;
@@ -107,6 +108,66 @@ namespace Ld {
              */
             static bool debugOutputDisabled();
 
+            /**
+             * Method you can use to set the maximum number of threads generated models should use.
+             *
+             * \param[in] newMaximumNumberThreads The new maximum number of threads.
+             */
+            static void setMaximumNumberThreads(unsigned newMaximumNumberThreads);
+
+            /**
+             * Method you can use to determine the maximum number of threads generated models should use.
+             *
+             * \return Returns the maximum number of threads.
+             */
+            static unsigned maximumNumberThreads();
+
+            /**
+             * Method you can use to set the directory used to cache compiled objects and linked libraries.
+             *
+             * \param[in] newDirectory The new cache directory.  An empty string disables the object cache.
+             *
+             * \return Returns true on success.  Returns false if the directory could not be created.
+             */
+            static bool setObjectCacheDirectory(const QString& newDirectory);
+
+            /**
+             * Method you can use to set the maximum size of the object cache.
+             *
+             * \param[in] newMaximumSize The new maximum size, in bytes.
+             */
+            static void setObjectCacheMaximumSize(unsigned long long newMaximumSize);
+
+            /**
+             * Method you can use to pre-warm the object cache from a directory of programs.  You would typically call
+             * this method once, at start-up, after calling \ref Configure::configure.
+             *
+             * \param[in] documentDirectory The directory containing the programs to be translated.
+             *
+             * \param[in] plugInsByName     The plug-ins available to the loaded programs.
+             *
+             * \return Returns the number of programs successfully translated.
+             */
+            static unsigned prewarmObjectCache(const QString& documentDirectory, const PlugInsByName& plugInsByName);
+
+            /**
+             * Method you can use to set the directory used to cache precompiled declaration headers for plug-in
+             * libraries.  A single header holding every registered declaration payload is built, or reused.  You
+             * would typically call this method once, at start-up, after calling \ref Configure::configure.
+             *
+             * \param[in] newDirectory       The new cache directory.  An empty string disables precompiled
+             *                               declaration headers.
+             *
+             * \param[in] compilerExecutable The compiler used to build the precompiled headers.  An empty string will
+             *                               cause clang++ in the compiler executable directory to be used.
+             *
+             * \return Returns true on success.  Returns false if the directory could not be created.
+             */
+            static bool setDeclarationPchDirectory(
+                const QString& newDirectory,
+                const QString& compilerExecutable = QString()
+            );
+
             /**
              * Static configuration method that can be used to update linker settings.
              *
@@ -30,8 +30,11 @@
 #ifndef LD_CPP_ASSIGNMENT_OPERATOR_TRANSLATOR_H
 #define LD_CPP_ASSIGNMENT_OPERATOR_TRANSLATOR_H
 
+#include <QList>
+
 #include "ld_common.h"
 #include "ld_data_type.h"
+#include "ld_identifier_container.h"
 #include "ld_cpp_binary_operator_translator_base.h"
 
 namespace Ld {
@@ -257,6 +260,9 @@ namespace Ld {
              * \param[in] includePerThread           Include a reference to the per-thread instance as the second
              *                                       parameter.
              *
+             * \param[in] functionNameSuffix         Suffix to be appended to the function name.  This is used to
+             *                                       name function specializations.
+             *
              * \return Returns true on success, returns false on error.
              */
             static bool insertFunctionPrototype(
@@ -266,7 +272,8 @@ namespace Ld {
                 bool                            includeReturnType,
                 bool                            includeParameterTypes,
                 bool                            includeModelImplementation,
-                bool                            includePerThread
+                bool                            includePerThread,
+                const QString&                  functionNameSuffix = QString()
             );
 
             /**
@@ -295,6 +302,55 @@ namespace Ld {
                 bool                            includeModelImplementation,
                 bool                            includePerThread
             );
+
+            /**
+             * Method that locates the identifiers of a function's parameters.
+             *
+             * \param[in] functionElement The function to locate the parameters of.
+             *
+             * \param[in] engine          The code generation engine driving the translation.
+             *
+             * \return Returns the parameter identifiers in parameter order.
+             */
+            static QList<IdentifierContainer> parameterIdentifiers(
+                QSharedPointer<FunctionElement> functionElement,
+                CppCodeGenerationEngine&        engine
+            );
+
+            /**
+             * Method that temporarily assigns the parameter types of a function specialization.  The function's
+             * return type is updated to match the parameter types.  Call
+             * \ref CppAssignmentOperatorTranslator::restoreGenericTypes to undo the change.
+             *
+             * \param[in] functionElement The function being specialized.
+             *
+             * \param[in] engine          The code generation engine driving the translation.
+             *
+             * \param[in] parameterTypes  The parameter types of the specialization.
+             *
+             * \return Returns the original parameter types followed by the original function return type.
+             */
+            static QList<DataType> applySpecialization(
+                QSharedPointer<FunctionElement>   functionElement,
+                CppCodeGenerationEngine&          engine,
+                const QList<DataType::ValueType>& parameterTypes
+            );
+
+            /**
+             * Method that restores the types changed by \ref CppAssignmentOperatorTranslator::applySpecialization.
+             *
+             * \param[in] functionElement The function that was specialized.
+             *
+             * \param[in] engine          The code generation engine driving the translation.
+             *
+             * \param[in] genericTypes    The types returned by
+             *                            \ref CppAssignmentOperatorTranslator::applySpecialization.
+             */
+            static void restoreGenericTypes(
+                QSharedPointer<FunctionElement> functionElement,
+                CppCodeGenerationEngine&        engine,
+                const QList<DataType>&          genericTypes
+            );
     };
 };
 
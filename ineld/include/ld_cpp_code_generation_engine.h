@@ -32,6 +32,11 @@
 
 #include <QSharedPointer>
 #include <QByteArray>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QWeakPointer>
+#include <QString>
 #include <QSet>
 #include <QTemporaryFile>
 #include <QSemaphore>
@@ -44,6 +49,7 @@
 #include "ld_identifier.h"
 #include "ld_identifier_container.h"
 #include "ld_code_generation_engine.h"
+#include "ld_cpp_expression_optimizer.h"
 
 namespace Model {
     class Status;
@@ -115,13 +121,18 @@ namespace Ld {
              * the \ref Ld::CppContext instance.  Use this method rather than the
              * Cbe::LinkerContext::setStaticLibraries or Cbe::LinkerContext::setDynamicLibraries methods.
              *
+             * The library's declarations are inserted into the translation unit unless they are supplied by a
+             * precompiled header, see \ref Ld::CppCodeGenerator::updateDeclarationPchFiles.
+             *
              * \param[in] libraryName The name of the library.
              */
             void dependsOnLibrary(const QString& libraryName);
 
             /**
              * Method you can call to add an operation checkpoint to the code.  Calling this method will cause a small
-             * snippet of C++ code to be inserted that checks for abort and pause conditions.
+             * snippet of C++ code to be inserted that checks for abort and pause conditions.  Under the release
+             * optimization profile, the checkpoint is only inserted if the element has an instruction breakpoint set
+             * or the release checkpoint interval has been reached.
              *
              * Do not call this method in the middle of an operation, only between operations.  Note that, on success,
              * this method will also start a new statement for the caller.
@@ -134,7 +145,9 @@ namespace Ld {
 
             /**
              * Method you can call to add an operation checkpoint to the code.  Calling this method will cause a small
-             * snippet of C++ code to be inserted that checks for abort and pause conditions.
+             * snippet of C++ code to be inserted that checks for abort and pause conditions.  Under the release
+             * optimization profile, the checkpoint is only inserted if the element has an instruction breakpoint set
+             * or the release checkpoint interval has been reached.
              *
              * Do not call this method in the middle of an operation, only between operations.  Note that, on success,
              * this method will also start a new statement for the caller.
@@ -352,6 +365,149 @@ namespace Ld {
              */
             bool asRValue() const;
 
+            /**
+             * Method you can use to determine if elementwise matrix operator trees should be fused into single loops.
+             *
+             * \return Returns true if elementwise fusion is enabled.  Returns false if elementwise fusion is disabled.
+             */
+            bool elementwiseFusionEnabled() const;
+
+            /**
+             * Method you can use to determine if independent for-all loops may be split across worker threads.
+             * Parallel loops require the release profile with no operation checkpoints and no profiling since
+             * checkpoints and profiling records are tied to the model thread.
+             *
+             * \return Returns true if parallel loops may be generated.  Returns false if all loops must be
+             *         sequential.
+             */
+            bool parallelLoopsEnabled() const;
+
+            /**
+             * Method you can use to obtain the thread partitioning chosen for this translation.  The partitioning is
+             * determined just before the model class declaration is generated.
+             *
+             * \return Returns a list holding, for each thread, the top level elements assigned to that thread in
+             *         program order.
+             */
+            const QList<ElementPointerList>& threadPartitions() const;
+
+            /**
+             * Method you can use to determine if an element should be translated into the thread currently being
+             * generated.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element's top level ancestor was assigned to the current thread.  Root
+             *         elements are always reported as belonging to the first thread.
+             */
+            bool inCurrentThread(ElementPointer element) const;
+
+            /**
+             * Method you can use during type inference to obtain the value type of an element.  On early inference
+             * passes, elements that depend on a variable whose type has not yet been inferred report no type so that
+             * unresolved variables do not force their default type into the result.  Later passes resolve those
+             * elements once the variables they depend on have types.
+             *
+             * \param[in] element The element to obtain the value type of.
+             *
+             * \return Returns the value type of the element.  Returns \ref DataType::ValueType::NONE if the element
+             *         depends on a variable whose type is still unresolved.
+             */
+            DataType::ValueType inferredValueType(ElementPointer element) const;
+
+            /**
+             * Method you should call when type inference changes the type of an identifier.  The engine repeats the
+             * inference phase until no identifier changes.
+             *
+             * \param[in] identifier    The identifier whose type was changed.
+             *
+             * \param[in] sourceElement The element that caused the change.  The element is used to explain why a
+             *                          variable degrades to a variant.
+             */
+            void inferredTypeChanged(const IdentifierContainer& identifier, ElementPointer sourceElement);
+
+            /**
+             * The maximum number of passes used to infer types.
+             */
+            static constexpr unsigned maximumInferencePasses = 16;
+
+            /**
+             * Type used to represent the parameter types of a user defined function.
+             */
+            typedef QList<DataType::ValueType> FunctionSignature;
+
+            /**
+             * Method you can use to record the generic signature of a user defined function.  The generic signature
+             * holds the types the function's parameters have when no specialization applies.
+             *
+             * \param[in] function       The identifier of the function.
+             *
+             * \param[in] parameterTypes The generic parameter types, in parameter order.
+             */
+            void setGenericFunctionSignature(
+                const IdentifierContainer& function,
+                const FunctionSignature&   parameterTypes
+            );
+
+            /**
+             * Method you can use to obtain the generic signature of a user defined function.
+             *
+             * \param[in] function The identifier of the function.
+             *
+             * \return Returns the generic parameter types.  An empty list is returned if the function has no
+             *         parameters or has not been seen.
+             */
+            FunctionSignature genericFunctionSignature(const IdentifierContainer& function) const;
+
+            /**
+             * Method you can use to request a specialization of a user defined function.  Requests beyond the
+             * specialization budget set by \ref CppCodeGenerator::setMaximumFunctionSpecializations are ignored.
+             *
+             * \param[in] function       The identifier of the function.
+             *
+             * \param[in] parameterTypes The parameter types of the specialization.
+             *
+             * \return Returns true if the specialization exists.  Returns false if the budget is exhausted.
+             */
+            bool addFunctionSpecialization(
+                const IdentifierContainer& function,
+                const FunctionSignature&   parameterTypes
+            );
+
+            /**
+             * Method you can use to obtain the specializations of a user defined function.
+             *
+             * \param[in] function The identifier of the function.
+             *
+             * \return Returns the parameter types of each specialization in the order the specializations were added.
+             */
+            QList<FunctionSignature> functionSpecializations(const IdentifierContainer& function) const;
+
+            /**
+             * Method you can use to locate the specialization of a user defined function matching a signature.
+             *
+             * \param[in] function       The identifier of the function.
+             *
+             * \param[in] parameterTypes The parameter types to locate.
+             *
+             * \return Returns the zero based index of the specialization.  A negative value is returned if there is
+             *         no matching specialization.
+             */
+            int functionSpecializationIndex(
+                const IdentifierContainer& function,
+                const FunctionSignature&   parameterTypes
+            ) const;
+
+            /**
+             * Method you can use to obtain the suffix appended to a function's internal name to name a
+             * specialization.
+             *
+             * \param[in] specializationIndex The zero based index of the specialization.
+             *
+             * \return Returns the suffix used for the specialization.
+             */
+            static QString functionSpecializationSuffix(unsigned specializationIndex);
+
         protected:
             /**
              * Pure virtual method that returns the translation phase instance to be used.
@@ -387,6 +543,16 @@ namespace Ld {
              */
             bool postTranslate() final;
 
+            /**
+             * Method that is called to translate an element.  During the thread phases, elements that were assigned
+             * to a different thread are skipped.
+             *
+             * \param[in] element The element to be translated.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool translateElement(ElementPointer element) override;
+
         private:
             /**
              * Method that is called just before querying the element tree to identify any and all required headers and
@@ -398,6 +564,30 @@ namespace Ld {
              */
             bool preIdentifyDependenciesAndExplicitTypes();
 
+            /**
+             * Method that determines if an operation checkpoint should be inserted for an element.  Under the
+             * release profile, this method also tracks the number of operations since the last checkpoint.
+             *
+             * \param[in] element The element the checkpoint would be tied to.
+             *
+             * \return Returns true if a checkpoint should be inserted.  Returns false if the checkpoint should be
+             *         omitted.
+             */
+            bool operationCheckpointRequired(ElementPointer element);
+
+            /**
+             * Method that inserts the code for an operation checkpoint, including any profiling code.
+             *
+             * \param[in] element        The element to be tied to this operation.
+             *
+             * \param[in] checkpointCall The checkpoint call to insert.  The string should contain a single "%1"
+             *                           placeholder for the operation handle.  An empty string indicates that only
+             *                           profiling code should be inserted.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool insertOperationCheckpointCode(ElementPointer element, const QString& checkpointCall);
+
             /**
              * Method that is called just before querying the element tree to identify any and all types for elements
              * whose types have not been explicitly declared.
@@ -406,6 +596,43 @@ namespace Ld {
              */
             bool preIdentifyInferredTypes();
 
+            /**
+             * Method that is called after each type inference pass.  The method requests another pass while types
+             * are still changing, switches unresolved variables to their default type once the types settle, and
+             * issues the type inference report after the last pass.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool postIdentifyInferredTypes();
+
+            /**
+             * Method that emits run-time library symbols required by the target platform.
+             */
+            void emitRuntimeLibrarySymbols();
+
+            /**
+             * Method that determines if an element depends on a variable whose type has not been inferred.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element or one of its descendants references an unresolved variable.
+             */
+            static bool dependsOnUnresolvedType(ElementPointer element);
+
+            /**
+             * Method that determines if an identifier is a variable whose type is still unresolved.
+             *
+             * \param[in] identifier The identifier to be checked.
+             *
+             * \return Returns true if the identifier is a variable with no type.
+             */
+            static bool unresolvedVariable(const IdentifierContainer& identifier);
+
+            /**
+             * Method that issues a warning for every variable whose type degrades to a variant.
+             */
+            void reportVariantVariables();
+
             /**
              * Method that is called when the translator starts inserting declarations.
              *
@@ -518,6 +745,38 @@ namespace Ld {
              */
             bool preLink();
 
+            /**
+             * Method that partitions the top level elements of every root element into independent groups and assigns
+             * the groups to threads.  Top level elements that reference a common identifier are always placed into
+             * the same thread so that program order is preserved for every variable and function.  Plots are placed
+             * with the variables they name, and statements that read or write files or call plug-in functions are
+             * kept in program order with each other.
+             */
+            void partitionThreads();
+
+            /**
+             * Method that checks the code generator's model cache for a model matching the current root element
+             * revisions and build settings.  On a match, the cached model is copied to the output file.
+             *
+             * \return Returns true if the cached model was restored.  Returns false if the model must be
+             *         translated.
+             */
+            bool restoreCachedModel();
+
+            /**
+             * Method that records the model built by a successful translation in the code generator's model cache.
+             */
+            void storeCachedModel();
+
+            /**
+             * Method that calculates the object cache key for the current intermediate representation.
+             *
+             * \param[in] stage A value describing the backend stage and any stage specific settings.
+             *
+             * \return Returns the object cache key.
+             */
+            QByteArray objectCacheKey(const QString& stage) const;
+
             /**
              * Virtual method you can overload to receive notification of diagnostic messages from the compiler.  Note
              * that the method may be called from a different thread than the one used to invoke the compiler.
@@ -671,6 +930,112 @@ namespace Ld {
              * Semaphore used to block execution until the background thread completes.
              */
             QSemaphore backendSemaphore;
+
+            /**
+             * The maximum number of threads we can generate code for.
+             */
+            unsigned currentMaximumNumberThreads;
+
+            /**
+             * Flag indicating if the release optimization profile is in use.
+             */
+            bool currentReleaseProfile;
+
+            /**
+             * The number of operations between checkpoints under the release profile.  A value of 0 indicates that
+             * checkpoints are only inserted at instruction breakpoints.
+             */
+            unsigned currentReleaseCheckpointInterval;
+
+            /**
+             * The number of operations since the last checkpoint was inserted under the release profile.
+             */
+            unsigned currentOperationsSinceCheckpoint;
+
+            /**
+             * Flag indicating if profiling code should be generated.
+             */
+            bool currentProfilingEnabled;
+
+            /**
+             * Flag indicating if the type inference report should be issued.
+             */
+            bool currentTypeInferenceReportEnabled;
+
+            /**
+             * The number of completed type inference passes.
+             */
+            unsigned currentInferencePass;
+
+            /**
+             * Flag indicating that elements depending on unresolved variables are reported as having no type.
+             */
+            bool currentDeferringUnresolvedTypes;
+
+            /**
+             * Flag indicating that an identifier type changed during the current inference pass.
+             */
+            bool currentInferredTypesChanged;
+
+            /**
+             * The element that first caused each variable to be inferred as a variant.
+             */
+            QHash<IdentifierContainer, ElementPointer> currentVariantSources;
+
+            /**
+             * The maximum number of specializations generated for each user defined function.
+             */
+            unsigned currentMaximumFunctionSpecializations;
+
+            /**
+             * Flag indicating if elementwise fusion is enabled.
+             */
+            bool currentElementwiseFusionEnabled;
+
+            /**
+             * Flag indicating if parallel for-all loops are enabled.
+             */
+            bool currentParallelLoopsEnabled;
+
+            /**
+             * The optimizer used to fold constants and reuse common subexpressions.
+             */
+            CppExpressionOptimizer currentExpressionOptimizer;
+
+            /**
+             * The generic signature of each user defined function.
+             */
+            QHash<IdentifierContainer, FunctionSignature> currentGenericFunctionSignatures;
+
+            /**
+             * The specializations generated for each user defined function.
+             */
+            QHash<IdentifierContainer, QList<FunctionSignature>> currentFunctionSpecializations;
+
+            /**
+             * The top level elements assigned to each thread.
+             */
+            QList<ElementPointerList> currentThreadPartitions;
+
+            /**
+             * Hash of thread IDs by top level element.
+             */
+            QHash<ElementPointer, unsigned> currentThreadsByTopLevelElement;
+
+            /**
+             * Flag indicating that this translation is being satisfied from the model cache.
+             */
+            bool currentUsingCachedModel;
+
+            /**
+             * The root element revisions captured when this translation started.
+             */
+            QList<QPair<QWeakPointer<RootElement>, unsigned long long>> currentRootRevisions;
+
+            /**
+             * The build settings captured when this translation started.
+             */
+            QString currentBuildSettings;
     };
 };
 
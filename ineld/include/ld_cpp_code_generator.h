@@ -31,13 +31,27 @@
 #define LD_CPP_CODE_GENERATOR_H
 
 #include <QString>
+#include <QStringList>
 #include <QSharedPointer>
 #include <QScopedPointer>
 #include <QByteArray>
 #include <QMap>
 #include <QList>
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QWeakPointer>
+#include <QTemporaryDir>
+
+#include <cstdint>
 
 #include "ld_common.h"
+#include "ld_element_structures.h"
+#include "ld_handle.h"
+#include "ld_diagnostic_structures.h"
+#include "ld_plug_in_information.h"
+#include "ld_cpp_object_cache.h"
+#include "ld_cpp_declaration_pch_cache.h"
 #include "ld_code_generator_output_type_container.h"
 #include "ld_code_generator.h"
 
@@ -67,6 +81,47 @@ namespace Ld {
              */
             static const char codeGeneratorName[];
 
+            /**
+             * The name of the function exported by models built with profiling enabled.  The function has the
+             * signature described by \ref Ld::CppCodeGenerator::ModelProfileFunction.
+             */
+            static const char modelProfileFunctionName[];
+
+            /**
+             * The library name used for the combined payload held by the precompiled declaration header.
+             */
+            static const char declarationPchLibraryName[];
+
+            /**
+             * Type of the function exported by models built with profiling enabled.  The function copies the hit
+             * count and exclusive time, in nanoseconds, of each operation into the supplied arrays, optionally
+             * clearing the model's counters, and returns the number of operations in the model.
+             */
+            typedef unsigned long long (*ModelProfileFunction)(
+                unsigned long long* hitCounts,
+                unsigned long long* exclusiveNanoseconds,
+                unsigned long long  capacity,
+                bool                reset
+            );
+
+            /**
+             * Enumeration of supported optimization profiles.
+             */
+            enum class OptimizationProfile : std::uint8_t {
+                /**
+                 * Indicates the generated model should support interactive debugging.  An operation checkpoint is
+                 * inserted before every operation and the model reports thread entry and exit to the console.
+                 */
+                DEBUGGABLE,
+
+                /**
+                 * Indicates the generated model is intended for batch runs.  Operation checkpoints are only inserted
+                 * at operations with an instruction breakpoint set and, optionally, at a coarse interval.  Console
+                 * debug output is omitted.
+                 */
+                RELEASE
+            };
+
             /**
              * Constructor
              *
@@ -120,6 +175,394 @@ namespace Ld {
              */
             bool debugOutputDisabled() const;
 
+            /**
+             * Method you can use to select the optimization profile used for generated models.  The debuggable
+             * profile is used by default.
+             *
+             * \param[in] newOptimizationProfile The new optimization profile.
+             */
+            void setOptimizationProfile(OptimizationProfile newOptimizationProfile);
+
+            /**
+             * Method you can use to determine the optimization profile used for generated models.
+             *
+             * \return Returns the current optimization profile.
+             */
+            OptimizationProfile optimizationProfile() const;
+
+            /**
+             * Method you can use to set the interval between operation checkpoints under the release profile.  Pause
+             * and abort requests are only honored at checkpoints so smaller intervals make a running model more
+             * responsive at some cost in performance.  This setting is ignored by the debuggable profile.
+             *
+             * \param[in] newCheckpointInterval The number of operations between checkpoints.  A value of 0 will
+             *                                  cause checkpoints to be inserted only at operations with an
+             *                                  instruction breakpoint set.
+             */
+            void setReleaseCheckpointInterval(unsigned newCheckpointInterval);
+
+            /**
+             * Method you can use to determine the interval between operation checkpoints under the release profile.
+             *
+             * \return Returns the number of operations between checkpoints.  A value of 0 indicates checkpoints are
+             *         only inserted at operations with an instruction breakpoint set.
+             */
+            unsigned releaseCheckpointInterval() const;
+
+            /**
+             * Method you can use to enable or disable profiling.  When enabled, each operation checkpoint records a
+             * timestamp into a per-thread ring buffer that the model folds into per-operation hit counts and times.
+             * The model exports \ref Ld::CppCodeGenerator::modelProfileFunctionName so the data can be retrieved
+             * after a run using \ref Ld::CppCodeGenerator::collectOperationProfile.  Profiling is disabled by default.
+             *
+             * \param[in] nowEnabled If true, profiling will be enabled.  If false, profiling will be disabled.
+             */
+            void setProfilingEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable profiling.
+             *
+             * \param[in] nowDisabled If true, profiling will be disabled.  If false, profiling will be enabled.
+             */
+            void setProfilingDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if profiling is enabled.
+             *
+             * \return Returns true if profiling is enabled.  Returns false if profiling is disabled.
+             */
+            bool profilingEnabled() const;
+
+            /**
+             * Method you can use to determine if profiling is disabled.
+             *
+             * \return Returns true if profiling is disabled.  Returns false if profiling is enabled.
+             */
+            bool profilingDisabled() const;
+
+            /**
+             * Method you can use to enable or disable the type inference report.  When enabled, translation issues a
+             * warning for every variable whose type degrades to a variant, naming the variable and the reason.  The
+             * report is disabled by default.
+             *
+             * \param[in] nowEnabled If true, the report will be enabled.  If false, the report will be disabled.
+             */
+            void setTypeInferenceReportEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable the type inference report.
+             *
+             * \param[in] nowDisabled If true, the report will be disabled.  If false, the report will be enabled.
+             */
+            void setTypeInferenceReportDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if the type inference report is enabled.
+             *
+             * \return Returns true if the report is enabled.  Returns false if the report is disabled.
+             */
+            bool typeInferenceReportEnabled() const;
+
+            /**
+             * Method you can use to determine if the type inference report is disabled.
+             *
+             * \return Returns true if the report is disabled.  Returns false if the report is enabled.
+             */
+            bool typeInferenceReportDisabled() const;
+
+            /**
+             * Method you can use to set the maximum number of specializations generated for each user defined
+             * function.  A specialization is generated for each distinct set of argument types seen at call sites so
+             * that calls bind to a version of the function with concrete parameter types rather than variants.
+             * Call sites beyond the budget use the generic version of the function.
+             *
+             * \param[in] newMaximumSpecializations The maximum number of specializations per function.  A value of 0
+             *                                      disables specialization.
+             */
+            void setMaximumFunctionSpecializations(unsigned newMaximumSpecializations);
+
+            /**
+             * Method you can use to determine the maximum number of specializations generated for each user defined
+             * function.
+             *
+             * \return Returns the maximum number of specializations per function.  A value of 0 indicates that
+             *         specialization is disabled.
+             */
+            unsigned maximumFunctionSpecializations() const;
+
+            /**
+             * The default maximum number of specializations generated for each user defined function.
+             */
+            static constexpr unsigned defaultMaximumFunctionSpecializations = 8;
+
+            /**
+             * Method you can use to enable or disable elementwise fusion.  When enabled, trees of elementwise matrix
+             * operators, such as sums, differences, Hadamard products and scaling by scalars, are emitted as a single
+             * loop over the result coefficients rather than as a chain of operators that each allocate a temporary
+             * matrix.  Fusion is enabled by default.
+             *
+             * \param[in] nowEnabled If true, elementwise fusion will be enabled.  If false, elementwise fusion will be
+             *                       disabled.
+             */
+            void setElementwiseFusionEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable elementwise fusion.
+             *
+             * \param[in] nowDisabled If true, elementwise fusion will be disabled.  If false, elementwise fusion will
+             *                        be enabled.
+             */
+            void setElementwiseFusionDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if elementwise fusion is enabled.
+             *
+             * \return Returns true if elementwise fusion is enabled.  Returns false if elementwise fusion is disabled.
+             */
+            bool elementwiseFusionEnabled() const;
+
+            /**
+             * Method you can use to determine if elementwise fusion is disabled.
+             *
+             * \return Returns true if elementwise fusion is disabled.  Returns false if elementwise fusion is enabled.
+             */
+            bool elementwiseFusionDisabled() const;
+
+            /**
+             * Method you can use to enable or disable expression optimization.  When enabled, constant arithmetic is
+             * evaluated during translation and pure subexpressions repeated across a thread's assignments are
+             * computed once into temporaries.  Expression optimization is enabled by default.
+             *
+             * \param[in] nowEnabled If true, expression optimization will be enabled.  If false, expressions will be
+             *                       translated as written.
+             */
+            void setExpressionOptimizationEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable expression optimization.
+             *
+             * \param[in] nowDisabled If true, expression optimization will be disabled.  If false, expression
+             *                        optimization will be enabled.
+             */
+            void setExpressionOptimizationDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if expression optimization is enabled.
+             *
+             * \return Returns true if expression optimization is enabled.  Returns false if expression optimization
+             *         is disabled.
+             */
+            bool expressionOptimizationEnabled() const;
+
+            /**
+             * Method you can use to determine if expression optimization is disabled.
+             *
+             * \return Returns true if expression optimization is disabled.  Returns false if expression optimization
+             *         is enabled.
+             */
+            bool expressionOptimizationDisabled() const;
+
+            /**
+             * Method you can use to enable or disable parallel for-all loops.  When enabled, integer range loops
+             * whose iterations are independent are split across worker threads under the release profile, provided
+             * that operation checkpoints and profiling are not in use.  Parallel loops are enabled by default.
+             *
+             * \param[in] nowEnabled If true, parallel loops will be enabled.  If false, all loops will be sequential.
+             */
+            void setParallelLoopsEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable parallel for-all loops.
+             *
+             * \param[in] nowDisabled If true, parallel loops will be disabled.  If false, parallel loops will be
+             *                        enabled.
+             */
+            void setParallelLoopsDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if parallel for-all loops are enabled.
+             *
+             * \return Returns true if parallel loops are enabled.  Returns false if parallel loops are disabled.
+             */
+            bool parallelLoopsEnabled() const;
+
+            /**
+             * Method you can use to determine if parallel for-all loops are disabled.
+             *
+             * \return Returns true if parallel loops are disabled.  Returns false if parallel loops are enabled.
+             */
+            bool parallelLoopsDisabled() const;
+
+            /**
+             * Method you can use to retrieve profiling data from a model and record it in the root element the model
+             * was generated from.
+             *
+             * \param[in] profileFunction The profile function resolved from the loaded model.
+             *
+             * \param[in] rootElement     The root element used to generate the model.
+             *
+             * \param[in] reset           If true, the model's counters will be cleared after they are read.
+             *
+             * \return Returns true on success.  Returns false if the profile function is null or the model does not
+             *         match the root element's operation database.
+             */
+            static bool collectOperationProfile(
+                ModelProfileFunction        profileFunction,
+                QSharedPointer<RootElement> rootElement,
+                bool                        reset = true
+            );
+
+            /**
+             * Method you can use to set the maximum number of threads the generated model should use.  The code
+             * generator will partition independent top level operations across up to this many threads.
+             *
+             * \param[in] newMaximumNumberThreads The new maximum number of threads.  A value of 0 is treated as 1.
+             */
+            void setMaximumNumberThreads(unsigned newMaximumNumberThreads);
+
+            /**
+             * Method you can use to determine the maximum number of threads the generated model should use.
+             *
+             * \return Returns the maximum number of threads.
+             */
+            unsigned maximumNumberThreads() const;
+
+            /**
+             * Method you can use to obtain the partitioning chosen during the last translation.  Each entry holds the
+             * top level elements, in program order, that were assigned to a single thread.
+             *
+             * \return Returns a list of top level elements per thread.
+             */
+            QList<ElementWeakPointerList> threadPartitions() const;
+
+            /**
+             * Method you can use to enable or disable the model cache.  When enabled, the code generator will keep a
+             * copy of the most recent successful model built from each root element.  Translating a root element
+             * again, without any intervening changes to the root element, its imports, or the build settings, will
+             * then reuse the cached model rather than translating, compiling and linking the model.  The model cache
+             * is enabled by default.
+             *
+             * The cache holds whole models only.  Any change to the program discards the entire cached model and the
+             * next translation regenerates every element.  A model restored from the cache is not translated again;
+             * the diagnostics, including warnings, reported when the model was built are reported again instead.
+             *
+             * \param[in] nowEnabled If true, the model cache will be enabled.  If false, the model cache
+             *                       will be disabled and cleared.
+             */
+            void setModelCacheEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to disable or enable the model cache.
+             *
+             * \param[in] nowDisabled If true, the model cache will be disabled and cleared.  If false, the
+             *                        model cache will be enabled.
+             */
+            void setModelCacheDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if the model cache is enabled.
+             *
+             * \return Returns true if the model cache is enabled.  Returns false if the model cache is
+             *         disabled.
+             */
+            bool modelCacheEnabled() const;
+
+            /**
+             * Method you can use to determine if the model cache is disabled.
+             *
+             * \return Returns true if the model cache is disabled.  Returns false if the model cache is
+             *         enabled.
+             */
+            bool modelCacheDisabled() const;
+
+            /**
+             * Method you can use to discard all cached models.
+             */
+            void clearModelCache();
+
+            /**
+             * Method you can use to determine if the last translation reused a cached model.
+             *
+             * \return Returns true if the last translation was satisfied from the model cache.  Returns false
+             *         if the last translation was performed in full.
+             */
+            bool lastModelWasCached() const;
+
+            /**
+             * Method you can use to access the on-disk cache of compiled objects and linked libraries.  The object
+             * cache is disabled until you set a cache directory.
+             *
+             * \return Returns a reference to the object cache.
+             */
+            CppObjectCache& objectCache();
+
+            /**
+             * Method you can use to access the on-disk cache of compiled objects and linked libraries.
+             *
+             * \return Returns a constant reference to the object cache.
+             */
+            const CppObjectCache& objectCache() const;
+
+            /**
+             * Method you can use to pre-warm the object cache by translating every program in a directory.  This
+             * method blocks until every program has been translated and should not be called while a translation is
+             * in progress.
+             *
+             * \param[in] documentDirectory The directory containing the programs to be translated.  Files that can
+             *                              not be loaded are skipped.
+             *
+             * \param[in] plugInsByName     The plug-ins available to the loaded programs.
+             *
+             * \return Returns the number of programs successfully translated.
+             */
+            unsigned prewarmObjectCache(const QString& documentDirectory, const PlugInsByName& plugInsByName);
+
+            /**
+             * Method you can use to access the on-disk cache of precompiled declaration headers.  The cache is
+             * disabled until you set a cache directory.
+             *
+             * \return Returns a reference to the declaration PCH cache.
+             */
+            CppDeclarationPchCache& declarationPchCache();
+
+            /**
+             * Method you can use to access the on-disk cache of precompiled declaration headers.
+             *
+             * \return Returns a constant reference to the declaration PCH cache.
+             */
+            const CppDeclarationPchCache& declarationPchCache() const;
+
+            /**
+             * Method you can use to build, or locate, a single precompiled header holding the declarations of every
+             * registered C++ declaration payload.  The compiler accepts only one chain of precompiled headers so the
+             * declaration header is chained on the last standard PCH file and takes its place in the standard PCH
+             * files.  The compiler arguments used to build the header are derived from the current compiler
+             * settings.
+             *
+             * If the header can not be built, or is later removed from the standard PCH files, the declarations of
+             * each library are inserted into each translation unit instead.  Call this method after the compiler
+             * settings and standard PCH files have been configured.  This method blocks while the header is built and
+             * should not be called while a translation is in progress.
+             *
+             * The header is built by an external compiler, so it is only used once the embedded compiler has been
+             * shown to load it.  If no compiler executable has been set on the declaration PCH cache, this method will
+             * look for clang++ in the executable directory.  If no embedded compiler files have been set, the
+             * application executable is used.
+             *
+             * \return Returns the number of libraries whose declarations are supplied by the precompiled header.
+             */
+            unsigned updateDeclarationPchFiles();
+
+            /**
+             * Method you can use to determine if a library's declarations are supplied by a precompiled header.
+             *
+             * \param[in] libraryName The name of the library.
+             *
+             * \return Returns true if the library's declarations are supplied by a precompiled header.  Returns false
+             *         if the declarations must be included in the translation unit.
+             */
+            bool declarationPchAvailable(const QString& libraryName) const;
+
             /**
              * Method you can use to set the executable directory.  Call to this function will be ignored if the linker
              * is an internal function.  If the linker is external, you must call this function prior to invoking the
@@ -401,6 +844,71 @@ namespace Ld {
             ) final;
 
         private:
+            /**
+             * Class used to track the model built by the most recent successful translation of a root element.
+             */
+            class ModelCacheEntry {
+                public:
+                    /**
+                     * The revision of each root element used by the translation, including imports.
+                     */
+                    QList<QPair<QWeakPointer<RootElement>, unsigned long long>> rootRevisions;
+
+                    /**
+                     * A description of the build settings used by the translation.
+                     */
+                    QString buildSettings;
+
+                    /**
+                     * The cached copy of the model.
+                     */
+                    QString artifactFile;
+
+                    /**
+                     * The diagnostics, such as warnings, reported while the model was built.  The diagnostics are
+                     * reported again each time the model is restored.
+                     */
+                    DiagnosticPointerList diagnostics;
+            };
+
+            /**
+             * Method that returns a description of every setting that impacts the generated output.
+             *
+             * \return Returns a string describing the current build settings.
+             */
+            QString buildSettings() const;
+
+            /**
+             * Method that returns the directory used to hold cached models, creating it if needed.
+             *
+             * \return Returns the path to the cache directory.  An empty string is returned if the directory could
+             *         not be created.
+             */
+            QString modelCacheDirectory();
+
+            /**
+             * Method that confirms the embedded compiler can load a chain of precompiled headers by compiling a
+             * trivial translation unit against them.  This method blocks while the compiler runs.  The standard PCH
+             * files are left unchanged.
+             *
+             * \param[in] pchFiles The precompiled headers to be checked.
+             *
+             * \return Returns true if the embedded compiler accepted the precompiled headers.
+             */
+            bool embeddedCompilerAccepts(const QList<QString>& pchFiles);
+
+            /**
+             * Method that builds the compiler arguments used to create the precompiled declaration header.  The
+             * arguments mirror the target, system root, resource directory, toolchain, and header search paths
+             * configured on the compiler.
+             *
+             * \param[in] basePchFile The PCH file the declaration header is chained on.  An empty string indicates
+             *                        that the header is not chained.
+             *
+             * \return Returns the compiler arguments.
+             */
+            QStringList declarationPchCompilerArguments(const QString& basePchFile) const;
+
             /**
              * List of supported output types.
              */
@@ -415,6 +923,102 @@ namespace Ld {
              * The linker used to link shared objects.
              */
             QScopedPointer<Cbe::DynamicLibraryLinker> currentLinker;
+
+            /**
+             * The optimization profile used for generated models.
+             */
+            OptimizationProfile currentOptimizationProfile;
+
+            /**
+             * The number of operations between checkpoints under the release profile.
+             */
+            unsigned currentReleaseCheckpointInterval;
+
+            /**
+             * Flag indicating if profiling is enabled.
+             */
+            bool currentProfilingEnabled;
+
+            /**
+             * Flag indicating if the type inference report is enabled.
+             */
+            bool currentTypeInferenceReportEnabled;
+
+            /**
+             * The maximum number of specializations generated for each user defined function.
+             */
+            unsigned currentMaximumFunctionSpecializations;
+
+            /**
+             * Flag indicating if elementwise fusion is enabled.
+             */
+            bool currentElementwiseFusionEnabled;
+
+            /**
+             * Flag indicating if expression optimization is enabled.
+             */
+            bool currentExpressionOptimizationEnabled;
+
+            /**
+             * Flag indicating if parallel for-all loops are enabled.
+             */
+            bool currentParallelLoopsEnabled;
+
+            /**
+             * The maximum number of threads to generate code for.
+             */
+            unsigned currentMaximumNumberThreads;
+
+            /**
+             * The thread partitioning chosen during the last translation.
+             */
+            QList<ElementWeakPointerList> currentThreadPartitions;
+
+            /**
+             * Flag indicating if the model cache is enabled.
+             */
+            bool currentModelCacheEnabled;
+
+            /**
+             * Flag indicating if the last translation was satisfied from the model cache.
+             */
+            bool currentLastModelWasCached;
+
+            /**
+             * The cached models, by root element handle.
+             */
+            QHash<Handle, ModelCacheEntry> currentModelCache;
+
+            /**
+             * Temporary directory used to hold cached models.
+             */
+            QScopedPointer<QTemporaryDir> currentModelCacheDirectory;
+
+            /**
+             * The on-disk cache of compiled objects and linked libraries.
+             */
+            CppObjectCache currentObjectCache;
+
+            /**
+             * The on-disk cache of precompiled declaration headers.
+             */
+            CppDeclarationPchCache currentDeclarationPchCache;
+
+            /**
+             * The precompiled declaration header currently included in the standard PCH files.
+             */
+            QString currentDeclarationPchFile;
+
+            /**
+             * The standard PCH file the precompiled declaration header was chained on and replaced.  An empty string
+             * indicates that the header was appended to the standard PCH files.
+             */
+            QString currentDeclarationPchBaseFile;
+
+            /**
+             * The libraries whose declarations are held by the precompiled declaration header.
+             */
+            QSet<QString> currentDeclarationPchLibraries;
     };
 };
 
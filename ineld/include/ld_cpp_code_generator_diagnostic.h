@@ -171,7 +171,21 @@ namespace Ld {
                 /**
                  * An iterable is empty where at least one value is required.
                  */
-                EMPTY_ITERABLE
+                EMPTY_ITERABLE,
+
+                /**
+                 * No assignment to a variable has a type that could be inferred so the variable falls back to the
+                 * default variant type.  Reported as a warning when the type inference report is enabled.  The backend
+                 * message holds the variable name.
+                 */
+                VARIABLE_TYPE_NOT_INFERRED,
+
+                /**
+                 * A variable was inferred as a variant because it is assigned a variant value or values with types
+                 * that only a variant can hold.  Reported as a warning when the type inference report is enabled.  The
+                 * backend message holds the variable name.
+                 */
+                VARIABLE_INFERRED_AS_VARIANT
             };
 
             /**
@@ -32,6 +32,7 @@
 
 #include <QSharedPointer>
 #include <QString>
+#include <QList>
 #include <QByteArray>
 
 #include <cstdint>
@@ -62,6 +63,13 @@ namespace Ld {
              */
             static CppDeclarationPayload payload(const QString& libraryName);
 
+            /**
+             * Method you can use to obtain the names of every library with a registered payload.
+             *
+             * \return Returns a list of library names.
+             */
+            static QList<QString> libraries();
+
             CppDeclarationPayload();
 
             /**
@@ -133,12 +141,20 @@ namespace Ld {
             bool isCompressed() const;
 
             /**
-             * Method you can use to obtain the uncompressed payload.
+             * Method you can use to obtain the uncompressed payload.  Compressed payloads are decompressed once and
+             * the result is shared by every copy of this payload.
              *
              * \return Returns a byte array holding the uncompressed payload.
              */
             QByteArray payload() const;
 
+            /**
+             * Method you can use to obtain a SHA-256 hash of the uncompressed payload.
+             *
+             * \return Returns the payload hash.  An empty array is returned for invalid payloads.
+             */
+            QByteArray hash() const;
+
             /**
              * Assignment operator.
              *
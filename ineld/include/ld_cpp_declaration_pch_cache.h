@@ -0,0 +1,217 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::CppDeclarationPchCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_CPP_DECLARATION_PCH_CACHE_H
+#define LD_CPP_DECLARATION_PCH_CACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QMutex>
+
+#include "ld_common.h"
+
+namespace Ld {
+    class CppDeclarationPayload;
+
+    /**
+     * Class that maintains an on-disk cache of precompiled headers built from C++ declaration payloads.  Each
+     * precompiled header is keyed by the payload hash, the compiler and the compiler arguments used to build it, and
+     * the embedded compiler that loads it, so a stale precompiled header is never reused.
+     *
+     * The cache is disabled until a cache directory is set.  All methods are thread safe.
+     */
+    class LD_PUBLIC_API CppDeclarationPchCache {
+        public:
+            /**
+             * Version of the cache layout.  Changing this value invalidates every existing cache entry.
+             */
+            static constexpr unsigned formatVersion = 1;
+
+            /**
+             * The maximum time allowed to build a single precompiled header, in milliseconds.
+             */
+            static constexpr int buildTimeoutMilliseconds = 300000;
+
+            /**
+             * The extension used for generated header files.
+             */
+            static const QString headerExtension;
+
+            /**
+             * The extension used for precompiled header files.
+             */
+            static const QString pchExtension;
+
+            CppDeclarationPchCache();
+
+            ~CppDeclarationPchCache();
+
+            /**
+             * Method you can use to set the directory holding the cache.  The directory will be created if needed.
+             *
+             * \param[in] newDirectory The new cache directory.  An empty string disables the cache.
+             *
+             * \return Returns true on success.  Returns false if the directory could not be created.  The cache is
+             *         disabled on failure.
+             */
+            bool setDirectory(const QString& newDirectory);
+
+            /**
+             * Method you can use to obtain the directory holding the cache.
+             *
+             * \return Returns the cache directory.  An empty string is returned if the cache is disabled.
+             */
+            QString directory() const;
+
+            /**
+             * Method you can use to determine if the cache is enabled.
+             *
+             * \return Returns true if the cache is enabled.  Returns false if the cache is disabled.
+             */
+            bool enabled() const;
+
+            /**
+             * Method you can use to set the compiler executable used to build precompiled headers.
+             *
+             * \param[in] newCompilerExecutable The full path to the compiler executable.  The compiler must accept
+             *                                  clang style command line arguments.
+             */
+            void setCompilerExecutable(const QString& newCompilerExecutable);
+
+            /**
+             * Method you can use to obtain the compiler executable used to build precompiled headers.
+             *
+             * \return Returns the full path to the compiler executable.
+             */
+            QString compilerExecutable() const;
+
+            /**
+             * Method you can use to set the files that identify the embedded compiler that loads the precompiled
+             * headers.  The compiler rejects a precompiled header written by a different compiler version so
+             * replacing any of these files invalidates the cache entries.
+             *
+             * \param[in] newEmbeddedCompilerFiles The files, such as the executable or library holding the embedded
+             *                                     compiler.
+             */
+            void setEmbeddedCompilerFiles(const QStringList& newEmbeddedCompilerFiles);
+
+            /**
+             * Method you can use to obtain the files that identify the embedded compiler.
+             *
+             * \return Returns the files that identify the embedded compiler.
+             */
+            QStringList embeddedCompilerFiles() const;
+
+            /**
+             * Method you can use to calculate the key used to identify a precompiled header.  Arguments that name
+             * existing files, such as precompiled headers this header is built against, and the embedded compiler
+             * files contribute their size and modification time to the key.
+             *
+             * \param[in] payload           The declaration payload.
+             *
+             * \param[in] compilerArguments The compiler arguments used to build the precompiled header.
+             *
+             * \return Returns the key.  An empty array is returned if the payload is invalid.
+             */
+            QByteArray key(const CppDeclarationPayload& payload, const QStringList& compilerArguments) const;
+
+            /**
+             * Method you can use to locate an existing precompiled header for a payload.
+             *
+             * \param[in] payload           The declaration payload.
+             *
+             * \param[in] compilerArguments The compiler arguments used to build the precompiled header.
+             *
+             * \return Returns the full path to the precompiled header.  An empty string is returned if no up to date
+             *         precompiled header exists or the cache is disabled.
+             */
+            QString pchFile(const CppDeclarationPayload& payload, const QStringList& compilerArguments) const;
+
+            /**
+             * Method you can use to obtain a precompiled header for a payload, building it if needed.  This method
+             * blocks while the compiler runs.
+             *
+             * \param[in] payload           The declaration payload.
+             *
+             * \param[in] compilerArguments The compiler arguments used to build the precompiled header.
+             *
+             * \return Returns the full path to the precompiled header.  An empty string is returned if the cache is
+             *         disabled, no compiler is set, or the build failed.
+             */
+            QString build(const CppDeclarationPayload& payload, const QStringList& compilerArguments);
+
+            /**
+             * Method you can use to obtain the number of precompiled headers built by this cache.
+             *
+             * \return Returns the number of successful builds.
+             */
+            unsigned long numberBuilds() const;
+
+        private:
+            /**
+             * Method that determines the base path, without extension, used for a cache entry.  The cache mutex must
+             * be locked.
+             *
+             * \param[in] payload The declaration payload.
+             *
+             * \param[in] key     The key of the entry.
+             *
+             * \return Returns the base path of the entry.
+             */
+            QString entryBasePath(const CppDeclarationPayload& payload, const QByteArray& key) const;
+
+            /**
+             * Mutex used to serialize access to the cache.
+             */
+            mutable QMutex cacheMutex;
+
+            /**
+             * The cache directory.
+             */
+            QString currentDirectory;
+
+            /**
+             * The compiler executable.
+             */
+            QString currentCompilerExecutable;
+
+            /**
+             * The files that identify the embedded compiler.
+             */
+            QStringList currentEmbeddedCompilerFiles;
+
+            /**
+             * The number of precompiled headers built.
+             */
+            unsigned long currentNumberBuilds;
+    };
+}
+
+#endif
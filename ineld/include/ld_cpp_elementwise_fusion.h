@@ -0,0 +1,230 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::CppElementwiseFusion class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_CPP_ELEMENTWISE_FUSION_H
+#define LD_CPP_ELEMENTWISE_FUSION_H
+
+#include <QString>
+#include <QList>
+
+#include "ld_common.h"
+#include "ld_element_structures.h"
+#include "ld_data_type.h"
+
+namespace Ld {
+    class CppCodeGenerationEngine;
+
+    /**
+     * Class that emits trees of elementwise matrix operators as a single loop.  Without fusion, an expression such as
+     * \f$ A + B \circ C - 2 D \f$ creates a temporary matrix for every operator.  The fused form evaluates each
+     * operand once, checks that the operands conform, and computes every coefficient of the result in one pass over
+     * the operands.
+     *
+     * Fusion covers addition, subtraction, the Hadamard product, multiplication and division by a scalar, and unary
+     * minus when the result is a real or complex matrix.  Grouping operators are looked through.  Operands that do
+     * not conform fall back to the unfused operators so the run-time library reports the error as before.
+     *
+     * The fused loop reads and writes coefficients through the matrix accessors so transposed and padded operands
+     * are handled by the run-time library.
+     */
+    class LD_PUBLIC_API CppElementwiseFusion {
+        public:
+            /**
+             * The minimum number of operators a tree must hold before it is fused.  A lone operator gains nothing
+             * from fusion.
+             */
+            static constexpr unsigned minimumFusedOperators = 2;
+
+            /**
+             * Method that determines if an element is the root of an elementwise operator tree that should be fused.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \param[in] engine  The code generation engine driving the translation.
+             *
+             * \return Returns true if the element should be translated using \ref CppElementwiseFusion::translate.
+             */
+            static bool isFusionRoot(ElementPointer element, const CppCodeGenerationEngine& engine);
+
+            /**
+             * Method that emits a fused elementwise operator tree.
+             *
+             * \param[in]     element The root of the operator tree.
+             *
+             * \param[in,out] engine  The code generation engine driving the translation.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            static bool translate(ElementPointer element, CppCodeGenerationEngine& engine);
+
+        private:
+            /**
+             * Enumeration of fused operations.
+             */
+            enum class Operation {
+                /**
+                 * Indicates the element is not a fused operator.
+                 */
+                NONE,
+
+                /**
+                 * Indicates elementwise addition.
+                 */
+                ADD,
+
+                /**
+                 * Indicates elementwise subtraction.
+                 */
+                SUBTRACT,
+
+                /**
+                 * Indicates multiplication by a scalar.
+                 */
+                MULTIPLY,
+
+                /**
+                 * Indicates division by a scalar.
+                 */
+                DIVIDE,
+
+                /**
+                 * Indicates the Hadamard product.
+                 */
+                HADAMARD,
+
+                /**
+                 * Indicates unary minus.
+                 */
+                NEGATE
+            };
+
+            /**
+             * Method that determines the fused operation performed by an element.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns the fused operation.  \ref CppElementwiseFusion::Operation::NONE is returned if the
+             *         element is not a fused operator.
+             */
+            static Operation operation(ElementPointer element);
+
+            /**
+             * Method that determines if an element is a grouping operator.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is a grouping operator.
+             */
+            static bool isGrouping(ElementPointer element);
+
+            /**
+             * Method that skips over grouping operators.
+             *
+             * \param[in] element The element to start from.
+             *
+             * \return Returns the first element below any grouping operators.
+             */
+            static ElementPointer skipGrouping(ElementPointer element);
+
+            /**
+             * Method that determines if an element can be used as a matrix operand of a fused operator.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is an integer, real, or complex matrix.
+             */
+            static bool isMatrixOperand(ElementPointer element);
+
+            /**
+             * Method that determines if an element can be used as a scalar operand of a fused operator.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is an integer, real, or complex value.
+             */
+            static bool isScalarOperand(ElementPointer element);
+
+            /**
+             * Method that counts the fused operators in a tree.
+             *
+             * \param[in] element The root of the tree.
+             *
+             * \return Returns the number of fused operators.
+             */
+            static unsigned countOperators(ElementPointer element);
+
+            /**
+             * Method that collects the operands of a fused tree, in left to right order.
+             *
+             * \param[in]     element  The root of the tree.
+             *
+             * \param[in,out] operands List the operands are appended to.
+             */
+            static void collectOperands(ElementPointer element, QList<ElementPointer>& operands);
+
+            /**
+             * Method that builds the C++ expression for a fused tree.
+             *
+             * \param[in]     element      The root of the tree.
+             *
+             * \param[in]     operands     The operands returned by \ref CppElementwiseFusion::collectOperands.
+             *
+             * \param[in,out] operandIndex The index of the next operand.  Set to 0 before calling this method.
+             *
+             * \param[in]     resultType   The value type of the fused result.
+             *
+             * \param[in]     perElement   If true, the expression computes a single coefficient inside the fused
+             *                             loop.  If false, the expression applies the unfused operators to whole
+             *                             operands.
+             *
+             * \return Returns the C++ expression.
+             */
+            static QString expression(
+                ElementPointer               element,
+                const QList<ElementPointer>& operands,
+                unsigned&                    operandIndex,
+                DataType::ValueType          resultType,
+                bool                         perElement
+            );
+
+            /**
+             * Method that returns a format string used to convert a scalar to the result's coefficient type.
+             *
+             * \param[in] fromType   The value type being converted.  Matrix types are treated as their coefficient
+             *                       type.
+             *
+             * \param[in] resultType The value type of the fused result.
+             *
+             * \return Returns a format string with "%1" standing for the value to be converted.
+             */
+            static QString conversion(DataType::ValueType fromType, DataType::ValueType resultType);
+    };
+};
+
+#endif
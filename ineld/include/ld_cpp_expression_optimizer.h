@@ -0,0 +1,345 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::CppExpressionOptimizer class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_CPP_EXPRESSION_OPTIMIZER_H
+#define LD_CPP_EXPRESSION_OPTIMIZER_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+#include <model_intrinsic_types.h>
+
+#include "ld_common.h"
+#include "ld_element_structures.h"
+
+namespace Ld {
+    class CppCodeGenerationEngine;
+
+    /**
+     * Class that optimizes expressions as they are translated to C++.  The optimizer performs two transformations:
+     *
+     *     * Constant folding.  Integer and real subtrees built only from literals, \f$ \pi \f$, \f$ e \f$ and basic
+     *       arithmetic operators are evaluated during translation and emitted as a single literal.
+     *
+     *     * Common subexpression elimination.  Structurally identical pure subtrees that are evaluated unconditionally
+     *       by the assignments of a thread are computed once into a temporary and reused until one of the variables
+     *       they depend on is reassigned.
+     *
+     * A subtree is pure if it holds only literals, special values, variables, arithmetic and matrix operators, and
+     * calls to built-in functions that do not require a per-thread instance, as reported by \ref FunctionData.
+     *
+     * Temporaries are computed immediately after the operation checkpoint of the statement holding their first
+     * occurrence so run-time errors are still reported against the statement that originally held the expression.
+     */
+    class LD_PUBLIC_API CppExpressionOptimizer {
+        public:
+            /**
+             * The minimum weight of a subtree before it is placed in a temporary.  Each operator adds one to the
+             * weight.  Each function call adds this value.
+             */
+            static constexpr unsigned minimumSubexpressionWeight = 2;
+
+            CppExpressionOptimizer();
+
+            ~CppExpressionOptimizer();
+
+            /**
+             * Method you can use to enable or disable the optimizer.
+             *
+             * \param[in] nowEnabled If true, the optimizer will be enabled.  If false, expressions will be translated
+             *                       as written.
+             */
+            void setEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to determine if the optimizer is enabled.
+             *
+             * \return Returns true if the optimizer is enabled.  Returns false if the optimizer is disabled.
+             */
+            bool enabled() const;
+
+            /**
+             * Method you can use to discard all analysis.  You should call this method at the start of each
+             * translation.
+             */
+            void clear();
+
+            /**
+             * Method you can use to analyze the statements executed by a thread and declare the temporaries used to
+             * hold common subexpressions.  The method should be called while the thread's local variables are being
+             * declared.
+             *
+             * \param[in]     statements The top level elements executed by the thread, in program order.
+             *
+             * \param[in,out] engine     The code generation engine driving the translation.
+             */
+            void declareTemporaries(const ElementPointerList& statements, CppCodeGenerationEngine& engine);
+
+            /**
+             * Method you can use to compute the temporaries first needed by a statement.  The method should be
+             * called immediately after the statement's operation checkpoint.
+             *
+             * \param[in]     statement The statement being translated.
+             *
+             * \param[in,out] engine    The code generation engine driving the translation.
+             *
+             * \return Returns true on success.  Returns false on error.
+             */
+            bool computeTemporaries(ElementPointer statement, CppCodeGenerationEngine& engine);
+
+            /**
+             * Method you can use to determine if an element should be translated by the optimizer rather than by
+             * the element's translator.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is a foldable constant or is held in a temporary.
+             */
+            bool replaces(ElementPointer element);
+
+            /**
+             * Method you can use to translate an element that the optimizer replaces.
+             *
+             * \param[in]     element The element to be translated.
+             *
+             * \param[in,out] engine  The code generation engine driving the translation.
+             *
+             * \return Returns true on success.  Returns false on error.
+             */
+            bool translate(ElementPointer element, CppCodeGenerationEngine& engine);
+
+            /**
+             * Method that determines if an element is a pure operation whose operands are always evaluated.  Built-in
+             * functions are pure unless they need a per-thread instance or perform file I/O.  The element's children
+             * are not checked.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is a pure operation.
+             */
+            static bool isPureOperation(ElementPointer element);
+
+        private:
+            /**
+             * Class that tracks an occurrence of a pure subtree.
+             */
+            class Occurrence {
+                public:
+                    /**
+                     * The root of the subtree.
+                     */
+                    ElementPointer element;
+
+                    /**
+                     * The index of the statement holding the subtree.
+                     */
+                    unsigned statementIndex;
+            };
+
+            /**
+             * Method that records the pure subtrees of an expression that are always evaluated.
+             *
+             * \param[in]     element        The root of the expression.
+             *
+             * \param[in]     statementIndex The index of the statement holding the expression.
+             *
+             * \param[in,out] occurrences    Occurrences of each subtree, keyed by the subtree's structure.
+             */
+            void collectOccurrences(
+                ElementPointer                     element,
+                unsigned                           statementIndex,
+                QHash<QString, QList<Occurrence>>& occurrences
+            );
+
+            /**
+             * Method that splits the occurrences of a subtree into runs over which the subtree's value can not
+             * change, and assigns a temporary to each run holding more than one occurrence.
+             *
+             * \param[in]     occurrences   The uncovered occurrences of the subtree, in program order.
+             *
+             * \param[in]     assignedKeys  The keys of the variables assigned by each statement.
+             *
+             * \param[in]     statements    The statements executed by the thread.
+             *
+             * \param[in,out] coveredRoots  Occurrences whose descendants will not be evaluated.
+             *
+             * \param[in,out] engine        The code generation engine driving the translation.
+             */
+            void assignTemporaries(
+                const QList<Occurrence>&    occurrences,
+                const QList<QSet<QString>>& assignedKeys,
+                const ElementPointerList&   statements,
+                QSet<ElementPointer>&       coveredRoots,
+                CppCodeGenerationEngine&    engine
+            );
+
+            /**
+             * Method that determines if an element is a grouping operator.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is a grouping operator.
+             */
+            static bool isGrouping(ElementPointer element);
+
+            /**
+             * Method that determines if a top level element is an assignment whose right hand side can be optimized.
+             *
+             * \param[in] statement The top level element to be checked.
+             *
+             * \return Returns true if the statement is an assignment to a variable or to a matrix coefficient.
+             */
+            static bool isOptimizedAssignment(ElementPointer statement);
+
+            /**
+             * Method that obtains the structural key of a pure subtree.
+             *
+             * \param[in] element The root of the subtree.
+             *
+             * \return Returns the key.  An empty string is returned if the subtree is not pure.
+             */
+            QString key(ElementPointer element);
+
+            /**
+             * Method that obtains the weight of a pure subtree.
+             *
+             * \param[in] element The root of the subtree.
+             *
+             * \return Returns the number of operators in the subtree with each function call counted as
+             *         \ref CppExpressionOptimizer::minimumSubexpressionWeight operators.
+             */
+            static unsigned weight(ElementPointer element);
+
+            /**
+             * Method that obtains the name of a temporary.
+             *
+             * \param[in] temporary The index of the temporary.
+             *
+             * \return Returns the C++ name of the temporary.
+             */
+            static QString temporaryName(unsigned temporary);
+
+            /**
+             * Method that collects the keys of the variables referenced by a subtree.
+             *
+             * \param[in]     element      The root of the subtree.
+             *
+             * \param[in,out] variableKeys The collected keys.
+             */
+            void referencedVariables(ElementPointer element, QSet<QString>& variableKeys);
+
+            /**
+             * Method that collects the keys of the variables a statement may assign.
+             *
+             * \param[in]     element      The statement or one of its descendants.
+             *
+             * \param[in,out] variableKeys The collected keys.
+             */
+            void assignedVariables(ElementPointer element, QSet<QString>& variableKeys);
+
+            /**
+             * Method that determines if an element is the root of a foldable constant subtree.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if the element is an operator whose subtree can be folded.
+             */
+            bool isFoldRoot(ElementPointer element);
+
+            /**
+             * Method that determines if a subtree is a constant that can be evaluated during translation.
+             *
+             * \param[in] element The root of the subtree.
+             *
+             * \return Returns true if the subtree can be folded.
+             */
+            static bool isFoldable(ElementPointer element);
+
+            /**
+             * Method that evaluates a constant integer subtree.
+             *
+             * \param[in]  element The root of the subtree.
+             *
+             * \param[out] value   The value of the subtree.
+             *
+             * \return Returns true if the subtree could be evaluated exactly.
+             */
+            static bool foldInteger(ElementPointer element, Model::Integer& value);
+
+            /**
+             * Method that evaluates a constant real subtree.
+             *
+             * \param[in]  element The root of the subtree.
+             *
+             * \param[out] value   The value of the subtree.
+             *
+             * \return Returns true if the subtree could be evaluated to a finite value.
+             */
+            static bool foldReal(ElementPointer element, Model::Real& value);
+
+            /**
+             * Flag indicating if the optimizer is enabled.
+             */
+            bool currentEnabled;
+
+            /**
+             * Structural keys of the subtrees seen so far.  An empty key marks an impure subtree.
+             */
+            QHash<ElementPointer, QString> currentKeys;
+
+            /**
+             * Cached results of \ref CppExpressionOptimizer::isFoldRoot.
+             */
+            QHash<ElementPointer, bool> currentFoldRoots;
+
+            /**
+             * The temporary holding each replaced subtree.
+             */
+            QHash<ElementPointer, unsigned> currentTemporariesByElement;
+
+            /**
+             * The subtree each temporary is computed from, indexed by temporary.
+             */
+            ElementPointerList currentTemporarySources;
+
+            /**
+             * The temporaries computed by each statement, in the order they must be computed.
+             */
+            QHash<ElementPointer, QList<unsigned>> currentTemporariesByStatement;
+
+            /**
+             * The subtree currently being computed into a temporary.
+             */
+            ElementPointer currentComputedElement;
+    };
+}
+
+#endif
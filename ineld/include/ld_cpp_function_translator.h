@@ -30,7 +30,11 @@
 #ifndef LD_CPP_FUNCTION_TRANSLATOR_H
 #define LD_CPP_FUNCTION_TRANSLATOR_H
 
+#include <QList>
+
 #include "ld_common.h"
+#include "ld_data_type.h"
+#include "ld_identifier_container.h"
 #include "ld_cpp_translator.h"
 
 namespace Ld {
@@ -64,6 +68,18 @@ namespace Ld {
                 CppCodeGenerationEngine& generationEngine
             ) final;
 
+            /**
+             * Method that is called during translation to identify the types of variables that must be inferred.
+             * Calls to user defined functions request a specialization of the function matching the argument types.
+             *
+             * \param[in,out] element          A pointer to the element to be translated.
+             *
+             * \param[in,out] generationEngine The generation engine driving the conversion.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool identifyInferredTypes(ElementPointer element, CppCodeGenerationEngine& generationEngine) override;
+
             /**
              * Method that is called during translation to insert the actual implementation.
              *
@@ -85,6 +101,30 @@ namespace Ld {
              * \return Returns true on success, returns false on error.  The default implementation always returns true.
              */
             bool methodDefinitions(ElementPointer element, CppCodeGenerationEngine& generationEngine) override;
+
+        private:
+            /**
+             * Method that determines the specialization a call to a user defined function should bind to.  Only
+             * parameters that are variants in the generic signature are specialized.
+             *
+             * \param[in] element          The element calling the function.
+             *
+             * \param[in] function         The identifier of the called function.
+             *
+             * \param[in] generationEngine The generation engine driving the conversion.
+             *
+             * \param[in] inferring        If true, argument types are obtained using
+             *                             \ref CppCodeGenerationEngine::inferredValueType.
+             *
+             * \return Returns the parameter types of the specialization.  An empty list is returned if the call
+             *         should use the generic version of the function.
+             */
+            static QList<DataType::ValueType> specializedSignature(
+                ElementPointer             element,
+                const IdentifierContainer& function,
+                CppCodeGenerationEngine&   generationEngine,
+                bool                       inferring
+            );
     };
 };
 
@@ -34,6 +34,8 @@
 #include <QString>
 
 #include "ld_common.h"
+#include "ld_element_structures.h"
+#include "ld_data_type.h"
 #include "ld_cpp_translator.h"
 
 namespace Ld {
@@ -46,6 +48,13 @@ namespace Ld {
         Q_DECLARE_TR_FUNCTIONS(Ld::CppMatrixOperatorTranslator)
 
         public:
+            /**
+             * The minimum number of literal entries a matrix must contain before the literal entries are emitted as
+             * packed static data rather than as individual arguments to the matrix build method.  Smaller matrices
+             * compile quickly either way.
+             */
+            static constexpr unsigned long minimumPackedLiteralEntries = 64;
+
             ~CppMatrixOperatorTranslator() override;
 
             /**
@@ -76,6 +85,21 @@ namespace Ld {
              * \return Returns true on success, returns false on error.  The default implementation always returns true.
              */
             bool methodDefinitions(ElementPointer element, CppCodeGenerationEngine& generationEngine) override;
+
+        private:
+            /**
+             * Method that generates the packed static data text for a single matrix entry.
+             *
+             * \param[in]  child     The child element holding the entry.
+             *
+             * \param[in]  valueType The value type of the matrix.
+             *
+             * \param[out] entryText The generated C++ text for the entry.
+             *
+             * \return Returns true if the entry is a literal that can be packed.  Returns false if the entry must be
+             *         calculated at run-time.
+             */
+            static bool packedEntry(ElementPointer child, DataType::ValueType valueType, QString& entryText);
     };
 };
 
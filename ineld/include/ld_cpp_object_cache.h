@@ -0,0 +1,271 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::CppObjectCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_CPP_OBJECT_CACHE_H
+#define LD_CPP_OBJECT_CACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+
+#include "ld_common.h"
+
+namespace Ld {
+    /**
+     * Class that maintains an on-disk, content addressed cache of compiled objects and linked libraries.  Entries are
+     * keyed by a hash of everything that influences the backend's output, such as the generated intermediate
+     * representation and the compiler and linker settings.  The cache is bounded in size and evicts the least
+     * recently used entries first.
+     *
+     * The cache is disabled until a cache directory is set.  All methods are thread safe.
+     */
+    class LD_PUBLIC_API CppObjectCache {
+        public:
+            /**
+             * The default maximum cache size, in bytes.
+             */
+            static constexpr unsigned long long defaultMaximumSize = 1024ULL * 1024ULL * 1024ULL;
+
+            /**
+             * The extension used for cache entries.
+             */
+            static const QString entryExtension;
+
+            CppObjectCache();
+
+            ~CppObjectCache();
+
+            /**
+             * Method you can use to set the directory holding the cache.  The directory will be created if needed and
+             * any entries already in the directory will be adopted, ordered by their last access time.
+             *
+             * \param[in] newDirectory The new cache directory.  An empty string disables the cache.
+             *
+             * \return Returns true on success.  Returns false if the directory could not be created.  The cache is
+             *         disabled on failure.
+             */
+            bool setDirectory(const QString& newDirectory);
+
+            /**
+             * Method you can use to obtain the directory holding the cache.
+             *
+             * \return Returns the cache directory.  An empty string is returned if the cache is disabled.
+             */
+            QString directory() const;
+
+            /**
+             * Method you can use to determine if the cache is enabled.
+             *
+             * \return Returns true if the cache is enabled.  Returns false if the cache is disabled.
+             */
+            bool enabled() const;
+
+            /**
+             * Method you can use to set the maximum size of the cache.  Least recently used entries will be evicted
+             * immediately if the cache exceeds the new size.
+             *
+             * \param[in] newMaximumSize The new maximum size, in bytes.
+             */
+            void setMaximumSize(unsigned long long newMaximumSize);
+
+            /**
+             * Method you can use to obtain the maximum size of the cache.
+             *
+             * \return Returns the maximum cache size, in bytes.
+             */
+            unsigned long long maximumSize() const;
+
+            /**
+             * Method you can use to obtain the current size of the cache.
+             *
+             * \return Returns the total size of all cache entries, in bytes.
+             */
+            unsigned long long size() const;
+
+            /**
+             * Method you can use to obtain the number of entries in the cache.
+             *
+             * \return Returns the number of cache entries.
+             */
+            unsigned long numberEntries() const;
+
+            /**
+             * Method you can use to determine if an entry exists in the cache.  This method does not impact the hit
+             * and miss counters or the eviction order.
+             *
+             * \param[in] key The key to check for.
+             *
+             * \return Returns true if the entry exists.  Returns false if the entry does not exist.
+             */
+            bool contains(const QByteArray& key) const;
+
+            /**
+             * Method you can use to copy a cached entry to a file.
+             *
+             * \param[in] key             The key of the desired entry.
+             *
+             * \param[in] destinationFile The file to receive the cached entry.  Any existing file will be replaced.
+             *
+             * \return Returns true on a cache hit.  Returns false on a cache miss or if the cache is disabled.
+             */
+            bool retrieve(const QByteArray& key, const QString& destinationFile);
+
+            /**
+             * Method you can use to add a file to the cache.  An existing entry with the same key will be replaced.
+             *
+             * \param[in] key        The key to store the entry under.
+             *
+             * \param[in] sourceFile The file to be cached.
+             *
+             * \return Returns true on success.  Returns false if the cache is disabled, the file could not be copied,
+             *         or the file is larger than the maximum cache size.
+             */
+            bool insert(const QByteArray& key, const QString& sourceFile);
+
+            /**
+             * Method you can use to remove every entry from the cache.
+             */
+            void clear();
+
+            /**
+             * Method you can use to obtain the number of cache hits.
+             *
+             * \return Returns the number of successful calls to \ref CppObjectCache::retrieve.
+             */
+            unsigned long long numberHits() const;
+
+            /**
+             * Method you can use to obtain the number of cache misses.
+             *
+             * \return Returns the number of unsuccessful calls to \ref CppObjectCache::retrieve while the cache was
+             *         enabled.
+             */
+            unsigned long long numberMisses() const;
+
+            /**
+             * Method you can use to reset the hit and miss counters.
+             */
+            void resetStatistics();
+
+        private:
+            /**
+             * Class that tracks a single cache entry.
+             */
+            class Entry {
+                public:
+                    /**
+                     * The size of the entry, in bytes.
+                     */
+                    unsigned long long size;
+
+                    /**
+                     * The access sequence number of the most recent use of this entry.
+                     */
+                    unsigned long long lastUsed;
+            };
+
+            /**
+             * Method that determines the filename used to hold an entry.
+             *
+             * \param[in] key The key of the entry.
+             *
+             * \return Returns the full path to the entry.
+             */
+            QString entryFilename(const QByteArray& key) const;
+
+            /**
+             * Method that marks an entry as most recently used.  The cache mutex must be locked.
+             *
+             * \param[in] key The key of the entry.
+             */
+            void touch(const QByteArray& key);
+
+            /**
+             * Method that removes an entry.  The cache mutex must be locked.
+             *
+             * \param[in] key The key of the entry.
+             */
+            void removeEntry(const QByteArray& key);
+
+            /**
+             * Method that evicts least recently used entries until the cache fits within its maximum size.  The
+             * cache mutex must be locked.
+             */
+            void evict();
+
+            /**
+             * Mutex used to serialize access to the cache.
+             */
+            mutable QMutex cacheMutex;
+
+            /**
+             * The cache directory.
+             */
+            QString currentDirectory;
+
+            /**
+             * The maximum cache size, in bytes.
+             */
+            unsigned long long currentMaximumSize;
+
+            /**
+             * The current cache size, in bytes.
+             */
+            unsigned long long currentSize;
+
+            /**
+             * The most recently issued access sequence number.
+             */
+            unsigned long long currentAccessSequence;
+
+            /**
+             * The number of cache hits.
+             */
+            unsigned long long currentNumberHits;
+
+            /**
+             * The number of cache misses.
+             */
+            unsigned long long currentNumberMisses;
+
+            /**
+             * The cache entries, by key.
+             */
+            QHash<QByteArray, Entry> currentEntries;
+
+            /**
+             * The cache keys, by access sequence number.  The first entry is the least recently used.
+             */
+            QMap<unsigned long long, QByteArray> currentKeysByLastUse;
+    };
+};
+
+#endif
@@ -0,0 +1,267 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::CppParallelLoop class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_CPP_PARALLEL_LOOP_H
+#define LD_CPP_PARALLEL_LOOP_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSharedPointer>
+
+#include "ld_common.h"
+#include "ld_element_structures.h"
+#include "ld_identifier_container.h"
+
+namespace Ld {
+    class CppCodeGenerationEngine;
+    class Range2Element;
+
+    /**
+     * Class that determines if the iterations of a for-all loop over an integer range are independent and, if so,
+     * emits the loop as contiguous blocks of the range run on worker threads.
+     *
+     * A loop is parallelized when its body is a single assignment, or a compound statement of assignments, to plain
+     * variables and every assigned expression is pure.  Each assigned variable must either be a reduction or be
+     * private to an iteration:
+     *
+     * * A reduction is a variable only referenced by a single statement of the form \f$ s \leftarrow s + x \f$,
+     *   \f$ s \leftarrow s - x \f$, \f$ s \leftarrow s \times x \f$, \f$ s \leftarrow min(s, x) \f$, or
+     *   \f$ s \leftarrow max(s, x) \f$.  Each worker accumulates a partial result that is combined, in worker order,
+     *   once the workers finish.
+     *
+     * * A private variable is assigned before it is read in every iteration.  Each worker uses its own copy and the
+     *   value from the final iteration is kept once the workers finish.
+     *
+     * Calls to random number generators, file I/O functions, and user defined functions block parallelization, as
+     * do instruction breakpoints within the loop.
+     *
+     * Each worker performs the run-time's per-thread setup.  A run-time error raised by any worker is captured and,
+     * once every worker has been joined, rethrown on the model thread so the model aborts as it would for a
+     * sequential loop.
+     */
+    class LD_PUBLIC_API CppParallelLoop {
+        public:
+            /**
+             * The minimum number of iterations given to each worker thread.  Shorter ranges use fewer workers so
+             * that thread launches do not dominate the run time.
+             */
+            static constexpr unsigned minimumIterationsPerWorker = 64;
+
+            /**
+             * Constructor.  Analyzes the loop.
+             *
+             * \param[in] element The for-all element to be analyzed.
+             *
+             * \param[in] range   The range the loop iterates over.
+             *
+             * \param[in] engine  The code generation engine driving the translation.
+             */
+            CppParallelLoop(
+                ElementPointer                 element,
+                QSharedPointer<Range2Element>  range,
+                const CppCodeGenerationEngine& engine
+            );
+
+            ~CppParallelLoop();
+
+            /**
+             * Method you can use to determine if the loop can be run in parallel.
+             *
+             * \return Returns true if the loop can be run in parallel.  Returns false if the loop must be sequential.
+             */
+            bool isParallel() const;
+
+            /**
+             * Method that emits the parallel loop.  The range end-points must already be held in validated
+             * variables.
+             *
+             * \param[in]     rangeStartVariable The variable holding the first value of the range.
+             *
+             * \param[in]     rangeEndVariable   The variable holding the last value of the range.
+             *
+             * \param[in]     suffix             Suffix used to keep the names of the loop's variables unique.
+             *
+             * \param[in,out] engine             The code generation engine driving the translation.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool translate(
+                const QString&           rangeStartVariable,
+                const QString&           rangeEndVariable,
+                const QString&           suffix,
+                CppCodeGenerationEngine& engine
+            );
+
+        private:
+            /**
+             * Enumeration of recognized reductions.
+             */
+            enum class Reduction {
+                /**
+                 * Indicates the statement is not a reduction.
+                 */
+                NONE,
+
+                /**
+                 * Indicates a sum.  Subtraction is treated as a sum of negated terms.
+                 */
+                SUM,
+
+                /**
+                 * Indicates a product.
+                 */
+                PRODUCT,
+
+                /**
+                 * Indicates a minimum.
+                 */
+                MINIMUM,
+
+                /**
+                 * Indicates a maximum.
+                 */
+                MAXIMUM
+            };
+
+            /**
+             * Method that performs the analysis.
+             *
+             * \param[in] range The range the loop iterates over.
+             *
+             * \return Returns true if the loop can be run in parallel.
+             */
+            bool analyze(QSharedPointer<Range2Element> range);
+
+            /**
+             * Method that determines if an element or any of its descendants has an instruction breakpoint.
+             *
+             * \param[in] element The element to be checked.
+             *
+             * \return Returns true if a breakpoint is set.
+             */
+            static bool hasBreakpoint(ElementPointer element);
+
+            /**
+             * Method that determines if an expression is built only from pure operations.
+             *
+             * \param[in] element The root of the expression.
+             *
+             * \return Returns true if the expression is pure.
+             */
+            static bool isPureExpression(ElementPointer element);
+
+            /**
+             * Method that skips over grouping operators.
+             *
+             * \param[in] element The element to start from.
+             *
+             * \return Returns the first element below any grouping operators.
+             */
+            static ElementPointer skipGrouping(ElementPointer element);
+
+            /**
+             * Method that determines if an element is a reference to a variable.
+             *
+             * \param[in] element    The element to be checked.
+             *
+             * \param[in] identifier The identifier of the variable.
+             *
+             * \return Returns true if the element, looking through grouping operators, references the variable.
+             */
+            static bool isVariable(ElementPointer element, const IdentifierContainer& identifier);
+
+            /**
+             * Method that counts the references to variables in an expression.
+             *
+             * \param[in]     element The root of the expression.
+             *
+             * \param[in,out] counts  Hash the number of references to each variable is added to.
+             */
+            static void countReferences(ElementPointer element, QHash<IdentifierContainer, unsigned>& counts);
+
+            /**
+             * Method that determines the reduction performed by an assignment.
+             *
+             * \param[in] target     The identifier of the assigned variable.
+             *
+             * \param[in] expression The assigned expression.
+             *
+             * \return Returns the reduction.  \ref CppParallelLoop::Reduction::NONE is returned if the assignment is
+             *         not a reduction.
+             */
+            static Reduction reduction(const IdentifierContainer& target, ElementPointer expression);
+
+            /**
+             * Method that obtains the C++ type name used for a variable.
+             *
+             * \param[in] identifier The identifier of the variable.
+             *
+             * \return Returns the type name.  An empty string is returned if the type can not be translated.
+             */
+            static QString variableTypeName(const IdentifierContainer& identifier);
+
+            /**
+             * Flag indicating if the loop can be run in parallel.
+             */
+            bool currentParallel;
+
+            /**
+             * The for-all element.
+             */
+            ElementPointer currentElement;
+
+            /**
+             * The loop body.
+             */
+            ElementPointer currentOperation;
+
+            /**
+             * The identifier of the loop index.
+             */
+            IdentifierContainer currentIndex;
+
+            /**
+             * The reduction variables, in the order they are first assigned.
+             */
+            QList<IdentifierContainer> currentReductionVariables;
+
+            /**
+             * The reduction performed on each reduction variable.
+             */
+            QHash<IdentifierContainer, Reduction> currentReductions;
+
+            /**
+             * The private variables, in the order they are first assigned.
+             */
+            QList<IdentifierContainer> currentPrivateVariables;
+    };
+};
+
+#endif
@@ -142,8 +142,12 @@ namespace Ld {
              *
              * \param[in] generateDynamicLibrary If true, the CPP code generator will run all available phases.  If
              *                                   false, the last translation phase will be skipped.
+             *
+             * \param[in] numberThreads          The number of threads to generate code for.  The phases from
+             *                                   \ref Phase::THREAD_DEFINITION through \ref Phase::THREAD_END will be
+             *                                   repeated once per thread.
              */
-            CppTranslationPhase(bool generateDynamicLibrary = true);
+            CppTranslationPhase(bool generateDynamicLibrary = true, unsigned numberThreads = 1);
 
             ~CppTranslationPhase() override;
 
@@ -178,25 +182,74 @@ namespace Ld {
              */
             Phase phase() const;
 
+            /**
+             * Method you can use to change the number of threads to be built.  You should only change the number of
+             * threads before the first thread phase is started.
+             *
+             * \param[in] newNumberThreads The new number of threads.  A value of 0 is treated as 1.
+             */
+            void setNumberThreads(unsigned newNumberThreads);
+
             /**
              * Method that indicates the number of threads to be built.
              *
-             * \return Returns the number of threads required for this model.  This method currently always returns 1.
+             * \return Returns the number of threads required for this model.
              */
             unsigned numberThreads() const;
 
             /**
              * Method that returns the current thread ID.
              *
-             * \return Returns the zero based thread ID.  This method currently always returnes 0.
+             * \return Returns the zero based thread ID.  The value is only meaningful during the thread phases.
              */
             unsigned threadId() const;
 
+            /**
+             * Method that resets the translation phase to the first phase and the first thread.
+             */
+            void reset() override;
+
+            /**
+             * Method that advances the translation phase to the next phase.  After \ref Phase::THREAD_END, the method
+             * will return to \ref Phase::THREAD_DEFINITION until code for every thread has been generated.  If
+             * \ref CppTranslationPhase::repeatPhase was called, the current phase is repeated instead.
+             */
+            void nextPhase() override;
+
+            /**
+             * Method you can call to request that the next call to \ref CppTranslationPhase::nextPhase repeat the
+             * current phase rather than advance.  The engine uses this to iterate type inference to a fixed point.
+             */
+            void repeatPhase();
+
+            /**
+             * Method you can use to determine if the current phase will be repeated.
+             *
+             * \return Returns true if the current phase will be repeated.  Returns false if the next call to
+             *         \ref CppTranslationPhase::nextPhase will advance.
+             */
+            bool phaseWillRepeat() const;
+
         private:
             /**
              * The number of translation phases.
              */
             unsigned currentNumberPhases;
+
+            /**
+             * The number of threads to be generated.
+             */
+            unsigned currentNumberThreads;
+
+            /**
+             * The zero based ID of the thread currently being generated.
+             */
+            unsigned currentThreadId;
+
+            /**
+             * Flag indicating that the current phase should be repeated.
+             */
+            bool currentRepeatPhase;
     };
 };
 
@@ -36,6 +36,8 @@
 #include <QMap>
 #include <QList>
 #include <QSet>
+#include <QHash>
+#include <QVector>
 
 #include <cstdint>
 
@@ -54,6 +56,7 @@
 #include "ld_capabilities.h"
 #include "ld_diagnostic_structures.h"
 #include "ld_element_cursor.h"
+#include "ld_element_iterator.h"
 
 namespace Ld {
     class Visual;
@@ -257,6 +260,17 @@ namespace Ld {
              */
             typedef unsigned short Precedence;
 
+            /**
+             * Type used to represent a compact element type identifier.  Type identifiers are assigned, in order,
+             * as element creators are registered.
+             */
+            typedef unsigned TypeId;
+
+            /**
+             * Value used to indicate an invalid or unregistered element type.
+             */
+            static constexpr TypeId invalidTypeId = 0;
+
             /**
              * Value used to indicate an invalid child index.
              */
@@ -436,6 +450,16 @@ namespace Ld {
              */
             static ElementPointer create(const QString& typeName);
 
+            /**
+             * Static method you can use to create an element given a type identifier.  This method behaves
+             * identically to \ref Element::create(const QString&) but avoids the name lookup.
+             *
+             * \param[in] typeId The type identifier of the desired element type.
+             *
+             * \return Returns a pointer to a class derived from \ref Element.
+             */
+            static ElementPointer create(TypeId typeId);
+
             /**
              * Static template method you can use to create a properly cast element.
              *
@@ -459,6 +483,33 @@ namespace Ld {
              */
             static bool registerCreator(const QString& typeName, CreatorFunction creatorFunction);
 
+            /**
+             * Static method you can use to obtain the type identifier assigned to an element type.
+             *
+             * \param[in] typeName The name used to reference the element type.
+             *
+             * \return Returns the type identifier.  The value \ref Element::invalidTypeId is returned if no creator
+             *         has been registered for the element type.
+             */
+            static TypeId typeIdByName(const QString& typeName);
+
+            /**
+             * Static method you can use to obtain the type name tied to a type identifier.
+             *
+             * \param[in] typeId The type identifier of the desired element type.
+             *
+             * \return Returns the type name.  An empty string is returned if the type identifier is invalid.
+             */
+            static QString typeNameById(TypeId typeId);
+
+            /**
+             * Static method you can use to obtain the largest type identifier assigned so far.
+             *
+             * \return Returns the largest assigned type identifier.  The value \ref Element::invalidTypeId is
+             *         returned if no element creators have been registered.
+             */
+            static TypeId maximumTypeId();
+
             /**
              * Method you can call to indicate whether elements should automatically delete any visual tied to them
              * when they are destroyed.
@@ -569,6 +620,15 @@ namespace Ld {
              */
             ElementWeakPointer weakThis() const;
 
+            /**
+             * Method you can use to obtain this element's type identifier.  The value is determined when
+             * \ref Element::setWeakThis is called.
+             *
+             * \return Returns the type identifier for this element.  The value \ref Element::invalidTypeId is returned
+             *         if no creator has been registered for this element's type.
+             */
+            TypeId typeId() const;
+
             /**
              * Method you can use to determine the precedence for this element when comparing against the parent.
              *
@@ -886,6 +946,58 @@ namespace Ld {
              */
             ElementPointerSet descendants() const;
 
+            /**
+             * Method you can use to determine the number of non-null descendants of this element.  The value is
+             * maintained as children are added and removed so this method operates in constant time.
+             *
+             * \return Returns the number of descendants under this element, excluding this element.
+             */
+            unsigned long numberDescendants() const;
+
+            /**
+             * Method you can use to obtain an iterator to the first descendant of this element.  Unlike
+             * \ref Ld::Element::descendants, the iterator walks the tree in place and does not allocate.
+             *
+             * \param[in] order The desired traversal order.
+             *
+             * \return Returns an iterator to the first descendant of this element.
+             */
+            ElementIterator descendantsBegin(ElementIterator::Order order = ElementIterator::Order::PRE_ORDER) const;
+
+            /**
+             * Method you can use to obtain an iterator marking the end of a traversal of this element's descendants.
+             *
+             * \return Returns an iterator marking the end of the traversal.
+             */
+            ElementIterator descendantsEnd() const;
+
+            /**
+             * Method you can use to visit every non-null descendant of this element without allocating.
+             *
+             * \param[in] visitor A callable accepting an \ref Ld::ElementPointer and returning a boolean value.  The
+             *                    visitor should return true to continue the traversal or false to stop.
+             *
+             * \param[in] order   The desired traversal order.
+             *
+             * \return Returns true if every descendant was visited.  Returns false if the visitor stopped the
+             *         traversal.
+             */
+            template<typename Visitor> bool visitDescendants(
+                    Visitor                visitor,
+                    ElementIterator::Order order = ElementIterator::Order::PRE_ORDER
+                ) const {
+                bool            keepGoing = true;
+                ElementIterator it        = descendantsBegin(order);
+                ElementIterator end       = descendantsEnd();
+
+                while (keepGoing && it != end) {
+                    keepGoing = visitor(*it);
+                    ++it;
+                }
+
+                return keepGoing;
+            }
+
             /**
              * Method you can use to obtain an ordered list of all the ancestors.
              *
@@ -1187,6 +1299,15 @@ namespace Ld {
              */
             virtual CalculatedValue calculatedValue(unsigned valueIndex = 0) const;
 
+            /**
+             * Method you can use to obtain a counter that advances each time this element's calculated values are
+             * updated or cleared.  You can use this value to determine if data derived from the calculated values,
+             * such as a rendered image, is stale.
+             *
+             * \return Returns the current calculated value generation.
+             */
+            unsigned long long calculatedValueGeneration() const;
+
             /**
              * Method you can use to determine if this element supports payloads.
              *
@@ -1386,6 +1507,20 @@ namespace Ld {
              */
             virtual void descendantFormatUpdated(ElementPointer changedElement, FormatPointer newFormat);
 
+            /**
+             * Method that is triggered whenever an instruction breakpoint is set or cleared on a descendant.  The
+             * default implementation propagates the message upwards in the element tree.
+             *
+             * If you overload this method, please be sure to call the base class implementation in order to allow for
+             * event propagation to occur.
+             *
+             * \param[in] changedElement   The element who's breakpoint status has changed.
+             *
+             * \param[in] breakpointNowSet If true, a breakpoint is now set on the element.  If false, the breakpoint
+             *                             has been cleared.
+             */
+            virtual void descendantInstructionBreakpointUpdated(ElementPointer changedElement, bool breakpointNowSet);
+
             /**
              * Method you can call to inform the associated \ref Ld::Visual that the element's internal data
              * has changed.  You should call this method when data tracked directly by the element is updated. This
@@ -1469,9 +1604,35 @@ namespace Ld {
             bool precedenceSuggestsParenthesis() const;
 
             /**
-             * Dictionary used to identify empty element creators based on an element type name.
+             * Method used by the parent classes to update the descendant count of this element and every ancestor
+             * after a subtree is added under this element.
+             *
+             * \param[in] numberAdded The number of elements added, including the root of the added subtree.
              */
-            static QMap<QString, CreatorFunction> creators;
+            void increaseNumberDescendants(unsigned long numberAdded);
+
+            /**
+             * Method used by the parent classes to update the descendant count of this element and every ancestor
+             * after a subtree is removed from under this element.
+             *
+             * \param[in] numberRemoved The number of elements removed, including the root of the removed subtree.
+             */
+            void decreaseNumberDescendants(unsigned long numberRemoved);
+
+            /**
+             * Hash used to map element type names to type identifiers.
+             */
+            static QHash<QString, TypeId> typeIdsByName;
+
+            /**
+             * Element type names, by type identifier less one.
+             */
+            static QVector<QString> typeNamesById;
+
+            /**
+             * Empty element creators, by type identifier less one.
+             */
+            static QVector<CreatorFunction> creatorsById;
 
             /**
              * Value indicating if element's should automatically delete the visual they are tied to.
@@ -1483,11 +1644,33 @@ namespace Ld {
              */
             ElementWeakPointer currentWeakThis;
 
+            /**
+             * The type identifier for this element.
+             */
+            TypeId currentTypeId;
+
             /**
              * Pointer to the element's parent.
              */
             ElementWeakPointer currentParent;
 
+            /**
+             * The index of this element within its parent, maintained by parents with positional or fixed children so
+             * that \ref Element::indexOfChild and the sibling methods can operate in constant time.
+             */
+            unsigned long currentIndexInParent;
+
+            /**
+             * The number of non-null descendants under this element, maintained by the parent classes as children are
+             * added and removed.
+             */
+            unsigned long currentNumberDescendants;
+
+            /**
+             * Counter advanced each time the calculated values for this element are updated or cleared.
+             */
+            unsigned long long currentCalculatedValueGeneration;
+
             /**
              * Pointer to the visual representation for this element.
              */
@@ -0,0 +1,136 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::ElementImage class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_ELEMENT_IMAGE_H
+#define LD_ELEMENT_IMAGE_H
+
+#include <QByteArray>
+#include <QSize>
+
+#include "ld_common.h"
+
+namespace Ld {
+    /**
+     * Class that holds a rendered image of an element along with the image's format and size.  Carrying the metadata
+     * alongside the image allows code generators to place the image without decoding it again.
+     */
+    class LD_PUBLIC_API ElementImage {
+        public:
+            ElementImage();
+
+            /**
+             * Constructor.  The image format and size are determined from the image header.
+             *
+             * \param[in] data The encoded image data.
+             */
+            explicit ElementImage(const QByteArray& data);
+
+            /**
+             * Constructor.
+             *
+             * \param[in] data   The encoded image data.
+             *
+             * \param[in] format The image format, in lower case, as reported by QImageReader::format.
+             *
+             * \param[in] size   The image size, in pixels.
+             */
+            ElementImage(const QByteArray& data, const QByteArray& format, const QSize& size);
+
+            /**
+             * Copy constructor.
+             *
+             * \param[in] other The instance to be copied.
+             */
+            ElementImage(const ElementImage& other);
+
+            ~ElementImage();
+
+            /**
+             * Method you can use to determine if this image is valid.
+             *
+             * \return Returns true if the image holds data of a known format.  Returns false otherwise.
+             */
+            bool isValid() const;
+
+            /**
+             * Method you can use to determine if this image is invalid.
+             *
+             * \return Returns true if the image is empty or of an unknown format.  Returns false otherwise.
+             */
+            bool isInvalid() const;
+
+            /**
+             * Method you can use to obtain the encoded image data.
+             *
+             * \return Returns the encoded image data.
+             */
+            const QByteArray& data() const;
+
+            /**
+             * Method you can use to obtain the image format.
+             *
+             * \return Returns the image format, in lower case.  An empty array is returned if the format is unknown.
+             */
+            const QByteArray& format() const;
+
+            /**
+             * Method you can use to obtain the image size.
+             *
+             * \return Returns the image size, in pixels.
+             */
+            const QSize& size() const;
+
+            /**
+             * Assignment operator.
+             *
+             * \param[in] other The instance to be copied.
+             *
+             * \return Returns a reference to this instance.
+             */
+            ElementImage& operator=(const ElementImage& other);
+
+        private:
+            /**
+             * The encoded image data.
+             */
+            QByteArray currentData;
+
+            /**
+             * The image format.
+             */
+            QByteArray currentFormat;
+
+            /**
+             * The image size.
+             */
+            QSize currentSize;
+    };
+}
+
+#endif
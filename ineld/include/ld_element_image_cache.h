@@ -0,0 +1,171 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::ElementImageCache class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_ELEMENT_IMAGE_CACHE_H
+#define LD_ELEMENT_IMAGE_CACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+#include "ld_common.h"
+#include "ld_handle.h"
+#include "ld_element_structures.h"
+#include "ld_element_image.h"
+
+namespace Ld {
+    /**
+     * Class that caches rendered element images so they can be shared between code generators and reused across
+     * exports.  Entries are keyed by the element handle, a hash of the element's format, the image resolution, and
+     * the element's calculated value generation.  The owner is expected to remove entries when an element's content
+     * changes.
+     *
+     * All methods are thread safe.
+     */
+    class LD_PUBLIC_API ElementImageCache {
+        public:
+            ElementImageCache();
+
+            ~ElementImageCache();
+
+            /**
+             * Method you can use to obtain a cached image.
+             *
+             * \param[in] element The element to obtain the image for.
+             *
+             * \param[in] dpi     The image resolution in DPI.
+             *
+             * \return Returns the cached image.  An invalid image is returned on a cache miss.
+             */
+            ElementImage image(ElementPointer element, float dpi);
+
+            /**
+             * Method you can use to add an image to the cache.  Any existing entry with the same key is replaced.
+             *
+             * \param[in] element The element the image was rendered from.
+             *
+             * \param[in] dpi     The image resolution in DPI.
+             *
+             * \param[in] image   The rendered image.
+             */
+            void insert(ElementPointer element, float dpi, const ElementImage& image);
+
+            /**
+             * Method you can use to remove every cached image for an element.
+             *
+             * \param[in] handle The handle of the element.
+             */
+            void remove(const Handle& handle);
+
+            /**
+             * Method you can use to remove every entry from the cache.
+             */
+            void clear();
+
+            /**
+             * Method you can use to obtain the number of cached images.
+             *
+             * \return Returns the number of cached images.
+             */
+            unsigned long numberEntries() const;
+
+            /**
+             * Method you can use to obtain the number of cache hits.
+             *
+             * \return Returns the number of successful calls to \ref ElementImageCache::image.
+             */
+            unsigned long long numberHits() const;
+
+            /**
+             * Method you can use to obtain the number of cache misses.
+             *
+             * \return Returns the number of unsuccessful calls to \ref ElementImageCache::image.
+             */
+            unsigned long long numberMisses() const;
+
+        private:
+            /**
+             * Class that tracks a single cached image.
+             */
+            class Entry {
+                public:
+                    /**
+                     * Hash of the element format at the time the image was rendered.
+                     */
+                    QByteArray formatHash;
+
+                    /**
+                     * The image resolution in DPI.
+                     */
+                    float dpi;
+
+                    /**
+                     * The element's calculated value generation at the time the image was rendered.
+                     */
+                    unsigned long long calculatedValueGeneration;
+
+                    /**
+                     * The rendered image.
+                     */
+                    ElementImage image;
+            };
+
+            /**
+             * Method that calculates a hash of an element's format.
+             *
+             * \param[in] element The element of interest.
+             *
+             * \return Returns a hash of the element format.
+             */
+            static QByteArray formatHash(ElementPointer element);
+
+            /**
+             * Mutex used to serialize access to the cache.
+             */
+            mutable QMutex cacheMutex;
+
+            /**
+             * The cached images, by element handle.
+             */
+            QHash<Handle, QList<Entry>> currentEntries;
+
+            /**
+             * The number of cache hits.
+             */
+            unsigned long long currentNumberHits;
+
+            /**
+             * The number of cache misses.
+             */
+            unsigned long long currentNumberMisses;
+    };
+}
+
+#endif
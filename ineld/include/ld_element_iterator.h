@@ -0,0 +1,214 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::ElementIterator class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_ELEMENT_ITERATOR_H
+#define LD_ELEMENT_ITERATOR_H
+
+#include <cstdint>
+
+#include "ld_common.h"
+#include "ld_element_structures.h"
+
+namespace Ld {
+    class Element;
+
+    /**
+     * Forward iterator that walks the descendants of an element in depth first order.  The iterator moves through the
+     * tree using each element's parent pointer and child index so no intermediate containers are allocated, making it
+     * suitable for use on very large trees.  Null children are skipped.
+     *
+     * The tree must not be modified while an iterator is in use.
+     */
+    class LD_PUBLIC_API ElementIterator {
+        public:
+            /**
+             * Enumeration of supported traversal orders.
+             */
+            enum class Order : std::uint8_t {
+                /**
+                 * Indicates each element is visited before any of its children.
+                 */
+                PRE_ORDER,
+
+                /**
+                 * Indicates each element is visited after all of its children.
+                 */
+                POST_ORDER
+            };
+
+            /**
+             * Constructor.  Creates an iterator that matches the end of any traversal.
+             */
+            ElementIterator();
+
+            /**
+             * Constructor.
+             *
+             * \param[in] subtreeRoot The element whose descendants should be traversed.
+             *
+             * \param[in] order       The traversal order.
+             *
+             * \param[in] includeRoot If true, the subtree root will also be visited.  If false, only the descendants
+             *                        of the subtree root will be visited.
+             */
+            ElementIterator(ElementPointer subtreeRoot, Order order = Order::PRE_ORDER, bool includeRoot = false);
+
+            /**
+             * Copy constructor.
+             *
+             * \param[in] other The instance to be copied.
+             */
+            ElementIterator(const ElementIterator& other);
+
+            ~ElementIterator();
+
+            /**
+             * Method you can use to determine the traversal order used by this iterator.
+             *
+             * \return Returns the traversal order.
+             */
+            Order order() const;
+
+            /**
+             * Method you can use to obtain the element the iterator is currently pointing to.
+             *
+             * \return Returns the current element.  A null pointer is returned at the end of the traversal.
+             */
+            ElementPointer element() const;
+
+            /**
+             * Assignment operator.
+             *
+             * \param[in] other The instance to be copied.
+             *
+             * \return Returns a reference to this instance.
+             */
+            ElementIterator& operator=(const ElementIterator& other);
+
+            /**
+             * Dereferencing operator.
+             *
+             * \return Returns a reference to the current element.
+             */
+            const ElementPointer& operator*() const;
+
+            /**
+             * Indirection operator.
+             *
+             * \return Returns a pointer to the current element.
+             */
+            Element* operator->() const;
+
+            /**
+             * Pre-increment operator.  Advances to the next element in the traversal.
+             *
+             * \return Returns a reference to this instance.
+             */
+            ElementIterator& operator++();
+
+            /**
+             * Post-increment operator.  Advances to the next element in the traversal.
+             *
+             * \return Returns a copy of this iterator prior to being advanced.
+             */
+            ElementIterator operator++(int);
+
+            /**
+             * Comparison operator.
+             *
+             * \param[in] other The instance to compare against.
+             *
+             * \return Returns true if both iterators point to the same element.  Returns false if the iterators point
+             *         to different elements.
+             */
+            bool operator==(const ElementIterator& other) const;
+
+            /**
+             * Comparison operator.
+             *
+             * \param[in] other The instance to compare against.
+             *
+             * \return Returns true if the iterators point to different elements.  Returns false if both iterators
+             *         point to the same element.
+             */
+            bool operator!=(const ElementIterator& other) const;
+
+        private:
+            /**
+             * Method that locates the first non-null child of an element.
+             *
+             * \param[in] element The element to be searched.
+             *
+             * \return Returns the first non-null child.  A null pointer is returned if there are no non-null children.
+             */
+            static ElementPointer firstChild(ElementPointer element);
+
+            /**
+             * Method that locates the next non-null sibling of an element.
+             *
+             * \param[in] element The element to locate the sibling of.
+             *
+             * \return Returns the next non-null sibling.  A null pointer is returned if there are no further non-null
+             *         siblings.
+             */
+            static ElementPointer nextSibling(ElementPointer element);
+
+            /**
+             * Method that locates the deepest first descendant of an element.  The returned element is the first
+             * element visited by a post-order traversal of the element.
+             *
+             * \param[in] element The element to be searched.
+             *
+             * \return Returns the deepest first descendant.  The element itself is returned if it has no children.
+             */
+            static ElementPointer deepestFirstDescendant(ElementPointer element);
+
+            /**
+             * The root of the subtree being traversed.
+             */
+            ElementPointer currentSubtreeRoot;
+
+            /**
+             * The element the iterator is currently pointing to.
+             */
+            ElementPointer currentElement;
+
+            /**
+             * The traversal order.
+             */
+            Order currentOrder;
+
+            /**
+             * Flag indicating if the subtree root is to be visited.
+             */
+            bool currentIncludeRoot;
+    };
+};
+
+#endif
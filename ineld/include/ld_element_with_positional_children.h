@@ -366,6 +366,13 @@ namespace Ld {
             virtual bool cloneChildren(QSharedPointer<ElementWithPositionalChildren> element) const;
 
         private:
+            /**
+             * Method that updates the index each child holds for itself, starting at a given index.
+             *
+             * \param[in] startingIndex The index of the first child to be updated.
+             */
+            void updateChildIndices(unsigned long startingIndex);
+
             /**
              * The current list of children.
              */
@@ -31,6 +31,11 @@
 #define LD_FORMAT_CONTAINER_H
 
 #include <QSharedPointer>
+#include <QString>
+#include <QMap>
+#include <QHash>
+
+#include <util_hash_functions.h>
 
 #include "ld_common.h"
 #include "ld_format_structures.h"
@@ -42,6 +47,10 @@ namespace Ld {
      * Class that provides a container for pointers to classes derived from \ref Ld::Format.  The class will clone the
      * provided format when the class instance is created or when a new \ref Ld::Format instance is provided and will
      * delete the created, cloned, instance when the \ref Ld::FormatContainer is destroyed.
+     *
+     * The container captures the string description of the format, and a hash of that description, when the format
+     * is assigned.  Comparisons and hashing use the captured values so that the format does not need to be serialized
+     * each time the container is compared.  For this reason, the format held by the container must not be modified.
      */
     class LD_PUBLIC_API FormatContainer {
         public:
@@ -96,6 +105,22 @@ namespace Ld {
              */
             FormatPointer format() const;
 
+            /**
+             * Method you can use to obtain the key used to compare this container against other containers.  The key
+             * is the value reported by \ref Ld::Format::toString at the time the format was assigned.
+             *
+             * \return Returns the comparison key for this container.  An empty string is returned if no format has
+             *         been assigned.
+             */
+            const QString& key() const;
+
+            /**
+             * Method you can use to obtain the cached hash of the comparison key.
+             *
+             * \return Returns the hash of the comparison key.
+             */
+            Util::HashResult hash() const;
+
             /**
              * Assignment operator.
              *
@@ -147,12 +172,37 @@ namespace Ld {
             bool operator<(const FormatContainer& other) const;
 
         private:
+            /**
+             * Method that updates the cached comparison key and hash from the current format instance.
+             */
+            void updateKey();
+
             /**
              * A pointer to the underlying format.
              */
             FormatPointer currentFormatInstance;
+
+            /**
+             * The cached comparison key.
+             */
+            QString currentKey;
+
+            /**
+             * The cached hash of the comparison key.
+             */
+            Util::HashResult currentHash;
     };
 
+    /**
+     * Function that calculates a hash for a \ref Ld::FormatContainer instance.  The hash is based on the cached
+     * comparison key and is consistent with \ref Ld::FormatContainer::operator==.
+     *
+     * \param[in] key  The key to calculate a hash for.
+     *
+     * \param[in] seed An optional seed used to add entropy to the hash.
+     */
+    LD_PUBLIC_API Util::HashResult qHash(const FormatContainer& key, Util::HashSeed seed = 0);
+
     /**
      * Type you can use to uniquely identify a format by a numeric value.
      */
@@ -161,7 +211,7 @@ namespace Ld {
     /**
      * Type you can use to tie a unique format to an identifier.
      */
-    typedef QMap<FormatContainer, FormatIdentifier> FormatIdentifiersByFormat;
+    typedef QHash<FormatContainer, FormatIdentifier> FormatIdentifiersByFormat;
 
     /**
      * Type you can use to tie an identifier to a format.
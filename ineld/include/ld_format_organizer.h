@@ -32,6 +32,7 @@
 
 #include <QSharedPointer>
 #include <QMap>
+#include <QHash>
 #include <QList>
 
 #include "ld_common.h"
@@ -48,11 +49,22 @@ namespace Ld {
      *
      * Note that this class defines the concept of a format identifier which is a unique number for each unique format.
      * The identifiers are only unique so-long as new formats are not added to the list.
+     *
+     * Formats are tracked in a hash keyed by \ref Ld::FormatContainer.  Each container caches the string description
+     * and hash of its format so each unique format is serialized only once, when it is first presented to the
+     * organizer.
      */
     class LD_PUBLIC_API FormatOrganizer {
         public:
             FormatOrganizer();
 
+            /**
+             * Copy constructor.
+             *
+             * \param[in] other The instance to be copied.
+             */
+            FormatOrganizer(const FormatOrganizer& other);
+
             ~FormatOrganizer();
 
             /**
@@ -83,6 +95,25 @@ namespace Ld {
              */
             void addFormat(const Format& newFormat);
 
+            /**
+             * Method you can use to add every format tracked by another organizer to this organizer.  Reference
+             * counts are accumulated so the result matches adding each format individually.
+             *
+             * \param[in] other The organizer holding the formats to be added.
+             */
+            void addFormats(const FormatOrganizer& other);
+
+            /**
+             * Method you can use to remove a single reference to a format.  The format will be removed from the
+             * organizer once every reference to the format has been removed.
+             *
+             * \param[in] formatContainer The container holding the format to be removed.
+             *
+             * \return Returns true if the format was known to the organizer.  Returns false if the format was not
+             *         known to the organizer.
+             */
+            bool removeFormat(const FormatContainer& formatContainer);
+
             /**
              * Method you can use to obtain an identifier for a specified format.
              *
@@ -148,10 +179,19 @@ namespace Ld {
             bool updateNeeded;
 
             /**
-             * A map of all known, unique, formats.  Map is used rather than set/hash to avoid the need for a hash
-             * function.
+             * Method that builds a container for a format without cloning the format.  The container is only used
+             * to perform lookups.
+             *
+             * \param[in] format The format to be placed in the container.
+             *
+             * \return Returns a container referencing the supplied format.
+             */
+            static FormatContainer lookupContainer(FormatPointer format);
+
+            /**
+             * A hash of all known, unique, formats along with the number of references to each format.
              */
-            QMap<FormatContainer, unsigned long> uniqueFormats;
+            QHash<FormatContainer, unsigned long> uniqueFormats;
 
             /**
              * The current map of identifiers by format.
@@ -166,7 +166,8 @@ namespace Ld {
             QSharedPointer<XmlExportContext> contextPointer() const;
 
             /**
-             * Method you can use to register a new format.
+             * Method you can use to register a new format.  This method is thread safe when called from a parallel
+             * translation shard; each shard registers formats into its own organizer.
              *
              * \param[in] format A shared pointer to the format to be registered.
              */
@@ -279,6 +280,22 @@ namespace Ld {
              */
             bool missingTranslator(ElementPointer element) final;
 
+            /**
+             * Method that is called before the shards of a parallel translation are started.  Creates one format
+             * organizer per shard.
+             *
+             * \param[in] numberShards The number of shards that will be translated.
+             */
+            void parallelTranslationStarting(unsigned numberShards) final;
+
+            /**
+             * Method that is called after every shard of a parallel translation has completed.  Merges the per-shard
+             * format organizers into the engine's format organizer.
+             *
+             * \param[in] numberShards The number of shards that were translated.
+             */
+            void parallelTranslationFinished(unsigned numberShards) final;
+
         private:
             /**
              * Method that is called at the start of the DTD translation phase.
@@ -308,6 +325,20 @@ namespace Ld {
              */
             bool postRegisterFormats();
 
+            /**
+             * Method that is called at the start of the render images translation phase.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool preRenderImages();
+
+            /**
+             * Method that is called at the end of the render images translation phase.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool postRenderImages();
+
             /**
              * Method that is called at the start of the header translation phase.
              *
@@ -381,6 +412,12 @@ namespace Ld {
              */
             FormatOrganizer formatOrganizer;
 
+            /**
+             * Format organizers used by each shard during parallel translation.  The list is only modified on the
+             * engine thread while no shards are running.
+             */
+            QList<QSharedPointer<FormatOrganizer>> shardFormatOrganizers;
+
             /**
              * The current math mode nesting level.
              */
@@ -46,6 +46,17 @@ namespace Ld {
         public:
             ~HtmlImageTranslatorBase() override;
 
+            /**
+             * Method that is called to render the element image ahead of the body phase.
+             *
+             * \param[in,out] element          A pointer to the element to be translated.
+             *
+             * \param[in,out] generationEngine The generation engine driving the conversion.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool renderImages(ElementPointer element, HtmlCodeGenerationEngine& generationEngine) override;
+
             /**
              * Method that is called to insert body content.
              *
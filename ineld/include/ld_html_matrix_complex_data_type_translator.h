@@ -31,6 +31,7 @@
 #define LD_HTML_MATRIX_COMPLEX_DATA_TYPE_TRANSLATOR_H
 
 #include <QString>
+#include <QStringList>
 
 #include "ld_common.h"
 #include "ld_element_structures.h"
@@ -66,6 +67,19 @@ namespace Ld {
 
                     ~Context() override;
 
+                    /**
+                     * Method that produces the real, imaginary and imaginary unit strings for a single coefficient.
+                     * The strings are memoized so that each visible coefficient is formatted only once.
+                     *
+                     * \param[in] row    The row containing the coefficient to be formatted.
+                     *
+                     * \param[in] column The column containing the coefficient to be formatted.
+                     *
+                     * \return Returns the strings reported by
+                     *         \ref Ld::MatrixComplexDataTypeDecoder::Context::componentStrings.
+                     */
+                    QStringList formatCell(unsigned long row, unsigned long column) const override;
+
                     /**
                      * Method that generates MathML for a single coefficient.
                      *
@@ -55,15 +55,20 @@ namespace Ld {
                  */
                 REGISTER_FORMATS = 1,
 
+                /**
+                 * Phase used to render element images ahead of the body.
+                 */
+                RENDER_IMAGES = 2,
+
                 /**
                  * Phase used to insert the header.
                  */
-                HEADER = 2,
+                HEADER = 3,
 
                 /**
                  * Phase that inserts the HTML body.
                  */
-                BODY = 3
+                BODY = 4
             };
 
             ~HtmlTranslationPhase() override;
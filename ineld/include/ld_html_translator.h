@@ -68,8 +68,22 @@ namespace Ld {
             bool translate(ElementPointer element, CodeGenerationEngine& codeGenerationEngine) final;
 
             /**
-             * Method that is called to register formats with the code generation engine.  The default implementation
-             * will register any format tied to the supplied element with the generation engine.
+             * Method that indicates if this translator can translate distinct elements concurrently.  The default
+             * implementation reports that the format registration phase is thread safe.  Image rendering reads
+             * payloads and drives element visuals so it is always performed on the engine thread.  You should overload
+             * this method if you overload \ref Ld::HtmlTranslator::registerFormats with a version that is not thread
+             * safe.
+             *
+             * \param[in] translationPhase The translation phase being performed.
+             *
+             * \return Returns true if the translator is thread safe during the supplied phase.
+             */
+            bool threadSafe(const TranslationPhase& translationPhase) const override;
+
+            /**
+             * Method that is called to register formats with the code generation engine.  Formats tied to elements
+             * are obtained from the root element's tracked format organizer so the default implementation does
+             * nothing.  You can overload this method to register additional formats used by an element.
              *
              * \param[in,out] element          A pointer to the element to be translated.
              *
@@ -79,6 +93,19 @@ namespace Ld {
              */
             virtual bool registerFormats(ElementPointer element, HtmlCodeGenerationEngine& generationEngine);
 
+            /**
+             * Method that is called to render element images ahead of the body phase.  Rendered images are held in
+             * the root element's image cache and are picked up by \ref Ld::HtmlTranslatorHelper::writeAsImage.  The
+             * default implementation renders elements placed directly in a paragraph when math is exported as images.
+             *
+             * \param[in,out] element          A pointer to the element to be translated.
+             *
+             * \param[in,out] generationEngine The generation engine driving the conversion.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            virtual bool renderImages(ElementPointer element, HtmlCodeGenerationEngine& generationEngine);
+
             /**
              * Method that is called to insert header content.
              *
@@ -37,6 +37,7 @@
 
 #include "ld_common.h"
 #include "ld_element_structures.h"
+#include "ld_element_image.h"
 #include "ld_format_structures.h"
 #include "ld_format.h"
 #include "ld_translator.h"
@@ -109,15 +110,29 @@ namespace Ld {
             bool writeAsImage(ElementPointer element, HtmlCodeGenerationEngine& generationEngine) const;
 
             /**
-             * Method you should overload to provide the requested image.
+             * Method you can use to render the element's image ahead of the body phase.  The rendered image is held
+             * by the root element's image cache so that \ref Ld::HtmlTranslatorHelper::writeAsImage does not need
+             * to render it again.  This method is safe to call from multiple threads.
+             *
+             * \param[in,out] element          A pointer to the element to be rendered.
+             *
+             * \param[in,out] generationEngine The generation engine driving the conversion.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool prerenderImage(ElementPointer element, HtmlCodeGenerationEngine& generationEngine) const;
+
+            /**
+             * Method you should overload to provide the requested image.  The default implementation obtains the
+             * image through \ref Ld::RootElement::elementImage so repeated exports reuse the cached rendering.
              *
              * \param[in,out] element          A pointer to the element to be translated.
              *
              * \param[in,out] generationEngine The generation engine driving the conversion.
              *
-             * \return Returns the image as a raw payload.  An empty payload is returned on error.
+             * \return Returns the image.  An invalid image is returned on error.
              */
-            virtual QByteArray getRawImage(ElementPointer element, HtmlCodeGenerationEngine& generationEngine) const;
+            virtual ElementImage getImage(ElementPointer element, HtmlCodeGenerationEngine& generationEngine) const;
 
             /**
              * Method you should overload to specify the desired image DPI used when generating the image.
@@ -155,28 +170,36 @@ namespace Ld {
             /**
              * Method that exports an image as a distinct payload.
              *
-             * \param[in]     imageData The buffer containing the image to be exported.
+             * \param[in]     image   The image to be exported.
              *
-             * \param[in,out] element   A pointer to the element to be translated.
+             * \param[in,out] element A pointer to the element to be translated.
              *
-             * \param[in,out] engine    The generation engine driving the conversion.
+             * \param[in,out] engine  The generation engine driving the conversion.
              *
              * \return Returns true on success, returns false on error.
              */
-            bool exportPayload(QByteArray& imageData, ElementPointer element, HtmlCodeGenerationEngine& engine) const;
+            bool exportPayload(
+                const ElementImage&       image,
+                ElementPointer            element,
+                HtmlCodeGenerationEngine& engine
+            ) const;
 
             /**
              * Method that embeds an image into the HTML stream.
              *
-             * \param[in]     imageData The buffer containing the image to be exported.
+             * \param[in]     image   The image to be exported.
              *
-             * \param[in,out] element   A pointer to the element to be translated.
+             * \param[in,out] element A pointer to the element to be translated.
              *
-             * \param[in,out] engine    The generation engine driving the conversion.
+             * \param[in,out] engine  The generation engine driving the conversion.
              *
              * \return Returns true on success, returns false on error.
              */
-            bool embedPayload(QByteArray& imageData, ElementPointer element, HtmlCodeGenerationEngine& engine) const;
+            bool embedPayload(
+                const ElementImage&       image,
+                ElementPointer            element,
+                HtmlCodeGenerationEngine& engine
+            ) const;
 
             /**
              * Method that embeds an image into the HTML stream.
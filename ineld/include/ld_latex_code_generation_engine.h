@@ -428,6 +428,20 @@ namespace Ld {
              */
             bool postIdentifyDependencies();
 
+            /**
+             * Method that is called at the start of the render images translation phase.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool preRenderImages();
+
+            /**
+             * Method that is called at the end of the render images translation phase.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool postRenderImages();
+
             /**
              * Method that is called at the start of the preamble translation phase.
              *
@@ -38,6 +38,7 @@
 
 #include "ld_common.h"
 #include "ld_element_structures.h"
+#include "ld_element_image.h"
 #include "ld_format_structures.h"
 #include "ld_format.h"
 #include "ld_latex_code_generation_engine.h"
@@ -68,6 +69,18 @@ namespace Ld {
              */
             bool identifyDependencies(ElementPointer element, LaTeXCodeGenerationEngine& generationEngine) override;
 
+            /**
+             * Method that is called during the \ref Ld::LaTeXTranslationPhase::Phase::RENDER_IMAGES phase to render
+             * the element image ahead of the body phase.
+             *
+             * \param[in,out] element          A pointer to the element to be translated.
+             *
+             * \param[in,out] generationEngine The generation engine driving the conversion.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool renderImages(ElementPointer element, LaTeXCodeGenerationEngine& generationEngine) override;
+
             /**
              * Method that is called to insert the LaTeX body content.
              *
@@ -86,15 +99,16 @@ namespace Ld {
             static constexpr float defaultDpi = 300.0F;
 
             /**
-             * Method you should overload to provide the requested image.
+             * Method you should overload to provide the requested image.  The default implementation obtains the
+             * image through \ref Ld::RootElement::elementImage so repeated exports reuse the cached rendering.
              *
              * \param[in,out] element          A pointer to the element to be translated.
              *
              * \param[in,out] generationEngine The generation engine driving the conversion.
              *
-             * \return Returns the image as a raw payload.  An empty payload is returned on error.
+             * \return Returns the image.  An invalid image is returned on error.
              */
-            virtual QByteArray getRawImage(ElementPointer element, LaTeXCodeGenerationEngine& generationEngine);
+            virtual ElementImage getImage(ElementPointer element, LaTeXCodeGenerationEngine& generationEngine);
 
             /**
              * Method you should overload to provide the required image rotation setting.
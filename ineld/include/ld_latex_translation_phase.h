@@ -50,15 +50,20 @@ namespace Ld {
                  */
                 IDENTIFY_DEPENDENCIES = 0,
 
+                /**
+                 * Phase used to render element images ahead of the body.
+                 */
+                RENDER_IMAGES = 1,
+
                 /**
                  * Phase used to add content to the preamble (excluding dependencies with external LaTeX packages).
                  */
-                PREAMBLE = 1,
+                PREAMBLE = 2,
 
                 /**
                  * Phase that inserts the document content.
                  */
-                BODY = 2
+                BODY = 3
             };
 
             ~LaTeXTranslationPhase() override;
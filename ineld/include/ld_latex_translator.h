@@ -76,6 +76,18 @@ namespace Ld {
              */
             virtual bool identifyDependencies(ElementPointer element, LaTeXCodeGenerationEngine& generationEngine);
 
+            /**
+             * Method that is called during the \ref Ld::LaTeXTranslationPhase::Phase::RENDER_IMAGES phase to render
+             * element images ahead of the body phase.  The default implementation does nothing.
+             *
+             * \param[in,out] element          A pointer to the element to be translated.
+             *
+             * \param[in,out] generationEngine The generation engine driving the conversion.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            virtual bool renderImages(ElementPointer element, LaTeXCodeGenerationEngine& generationEngine);
+
             /**
              * Method that is called to insert the LaTeX body content.
              *
@@ -104,12 +116,6 @@ namespace Ld {
                 LaTeXCodeGenerationEngine::UnicodeMode unicodeTranslationMode,
                 bool                                   textMode
             );
-
-        private:
-            /**
-             * Static map of LaTeX commands by unicode value.
-             */
-            static QMap<SpecialCharacters::UnicodeValue, QString> commandsByUnicodeValue;
     };
 };
 
@@ -117,7 +117,7 @@ namespace Ld {
                      *
                      * \return Returns a string representation of the coefficient.
                      */
-                    QString toString(unsigned long row, unsigned long column) override;
+                    QString toString(unsigned long row, unsigned long column) const override;
 
                 private:
                     /**
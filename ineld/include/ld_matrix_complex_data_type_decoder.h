@@ -33,6 +33,7 @@
 #include <QCoreApplication>
 #include <QList>
 #include <QString>
+#include <QStringList>
 
 #include <util_string.h>
 
@@ -147,7 +148,21 @@ namespace Ld {
                      *
                      * \return Returns a string representation of the coefficient.
                      */
-                    QString toString(unsigned long row, unsigned long column) override;
+                    QString toString(unsigned long row, unsigned long column) const override;
+
+                    /**
+                     * Method you can use to render a single matrix element as separate real, imaginary and imaginary
+                     * unit strings.  Code generators can return this value from
+                     * \ref Ld::MatrixDataTypeDecoder::Context::formatCell.
+                     *
+                     * \param[in] row    The matrix row of the coefficient to be rendered.
+                     *
+                     * \param[in] column The matrix column of the coefficient to be rendered.
+                     *
+                     * \return Returns a list holding the real baseline, real superscript, imaginary baseline,
+                     *         imaginary superscript and imaginary unit strings, in that order.
+                     */
+                    QStringList componentStrings(unsigned long row, unsigned long column) const;
 
                 private:
                     /**
@@ -31,6 +31,9 @@
 #define LD_MATRIX_DATA_TYPE_DECODER_H
 
 #include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+#include <QVector>
 
 #include "ld_common.h"
 #include "ld_format_structures.h"
@@ -150,7 +153,9 @@ namespace Ld {
                     virtual bool canSubscript() const = 0;
 
                     /**
-                     * Method you can overload to render a single matrix element.
+                     * Method you can overload to render a single matrix element.  This method is called from worker
+                     * threads when a large window is formatted so overloads must be reentrant: they may only read the
+                     * context and must not rely on state shared between calls.
                      *
                      * \param[in] row    The matrix row of the coefficient to be rendered.
                      *
@@ -158,7 +163,36 @@ namespace Ld {
                      *
                      * \return Returns a string representation of the coefficient.
                      */
-                    virtual QString toString(unsigned long row, unsigned long column) = 0;
+                    virtual QString toString(unsigned long row, unsigned long column) const = 0;
+
+                    /**
+                     * Method you can overload to produce the strings used to render a single matrix element.  The
+                     * strings are memoized by \ref Ld::MatrixDataTypeDecoder::Context::formattedCell so each visible
+                     * element is formatted only once.  Code generators overload this method to produce the pieces
+                     * they emit, such as a mantissa and exponent.  This method may be called concurrently for
+                     * distinct elements so, like \ref Ld::MatrixDataTypeDecoder::Context::toString, it must be
+                     * reentrant.  The default implementation returns the value reported by
+                     * \ref Ld::MatrixDataTypeDecoder::Context::toString.
+                     *
+                     * \param[in] row    The matrix row of the coefficient to be rendered.
+                     *
+                     * \param[in] column The matrix column of the coefficient to be rendered.
+                     *
+                     * \return Returns the strings used to render the coefficient.
+                     */
+                    virtual QStringList formatCell(unsigned long row, unsigned long column) const;
+
+                    /**
+                     * Method you can use to obtain the memoized strings for a visible matrix element.  The first call
+                     * formats every visible element, spreading large windows across worker threads by row.
+                     *
+                     * \param[in] row    The matrix row of the coefficient.  The row must be visible.
+                     *
+                     * \param[in] column The matrix column of the coefficient.  The column must be visible.
+                     *
+                     * \return Returns the strings reported by \ref Ld::MatrixDataTypeDecoder::Context::formatCell.
+                     */
+                    const QStringList& formattedCell(unsigned long row, unsigned long column);
 
                 protected:
                     /**
@@ -171,6 +205,53 @@ namespace Ld {
                     void configure(unsigned long numberRows, unsigned long numberColumns);
 
                 private:
+                    /**
+                     * Runnable used to format a contiguous range of visible rows.
+                     */
+                    class FormattingShard;
+
+                    /**
+                     * Method that formats every visible element.
+                     */
+                    void formatVisibleCells();
+
+                    /**
+                     * Method that formats a contiguous range of visible rows.
+                     *
+                     * \param[in] startingRowIndex The zero based index of the first visible row to format.
+                     *
+                     * \param[in] endingRowIndex   The zero based index just past the last visible row to format.
+                     */
+                    void formatVisibleRows(unsigned long startingRowIndex, unsigned long endingRowIndex);
+
+                    /**
+                     * Method that converts a matrix row to a zero based visible row index.
+                     *
+                     * \param[in] row The matrix row.
+                     *
+                     * \return Returns the visible row index.
+                     */
+                    unsigned long visibleRowIndex(unsigned long row) const;
+
+                    /**
+                     * Method that converts a matrix column to a zero based visible column index.
+                     *
+                     * \param[in] column The matrix column.
+                     *
+                     * \return Returns the visible column index.
+                     */
+                    unsigned long visibleColumnIndex(unsigned long column) const;
+
+                    /**
+                     * The formatted strings for each visible element, in row major order.
+                     */
+                    QVector<QStringList> currentFormattedCells;
+
+                    /**
+                     * Flag indicating if the visible elements have been formatted.
+                     */
+                    bool currentCellsFormatted;
+
                     /**
                      * Pointer to the format instance.
                      */
@@ -33,6 +33,7 @@
 #include <QCoreApplication>
 #include <QList>
 #include <QString>
+#include <QStringList>
 
 #include <util_string.h>
 
@@ -140,7 +141,20 @@ namespace Ld {
                      *
                      * \return Returns a string representation of the coefficient.
                      */
-                    QString toString(unsigned long row, unsigned long column) override;
+                    QString toString(unsigned long row, unsigned long column) const override;
+
+                    /**
+                     * Method you can use to render a single matrix element as separate mantissa and exponent strings.
+                     * Code generators can return this value from \ref Ld::MatrixDataTypeDecoder::Context::formatCell.
+                     *
+                     * \param[in] row    The matrix row of the coefficient to be rendered.
+                     *
+                     * \param[in] column The matrix column of the coefficient to be rendered.
+                     *
+                     * \return Returns a list holding the mantissa string followed by the exponent string.  The
+                     *         exponent string will be empty if no exponent is required.
+                     */
+                    QStringList mantissaAndExponentStrings(unsigned long row, unsigned long column) const;
 
                 private:
                     /**
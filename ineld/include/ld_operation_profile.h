@@ -0,0 +1,159 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::OperationProfile class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_OPERATION_PROFILE_H
+#define LD_OPERATION_PROFILE_H
+
+#include "ld_common.h"
+#include "ld_element_structures.h"
+#include "ld_operation.h"
+
+namespace Ld {
+    /**
+     * Class used to hold run-time profiling data for a single program operation.
+     *
+     * Exclusive time is the time spent between the checkpoint for this operation and the next checkpoint executed by
+     * the same thread.  Inclusive time also includes the exclusive time of every operation defined by a descendant of
+     * this operation's element.
+     */
+    class LD_PUBLIC_API OperationProfile {
+        public:
+            OperationProfile();
+
+            /**
+             * Constructor
+             *
+             * \param[in] operation            The operation this profile applies to.
+             *
+             * \param[in] hitCount             The number of times the operation was executed.
+             *
+             * \param[in] exclusiveNanoseconds The exclusive time spent in this operation, in nanoseconds.
+             *
+             * \param[in] inclusiveNanoseconds The inclusive time spent in this operation, in nanoseconds.
+             */
+            OperationProfile(
+                const Operation&   operation,
+                unsigned long long hitCount,
+                unsigned long long exclusiveNanoseconds,
+                unsigned long long inclusiveNanoseconds
+            );
+
+            /**
+             * Copy constructor
+             *
+             * \param[in] other The instance to be copied.
+             */
+            OperationProfile(const OperationProfile& other);
+
+            ~OperationProfile();
+
+            /**
+             * Method that indicates if the profile is valid.
+             *
+             * \return Returns true if the profile is tied to a valid operation.  Returns false if the profile is
+             *         invalid.
+             */
+            bool isValid() const;
+
+            /**
+             * Method that indicates if the profile is invalid.
+             *
+             * \return Returns true if the profile is invalid.  Returns false if the profile is valid.
+             */
+            bool isInvalid() const;
+
+            /**
+             * Method you can use to obtain the operation this profile applies to.
+             *
+             * \return Returns the operation tied to this profile.
+             */
+            const Operation& operation() const;
+
+            /**
+             * Method you can use to obtain the element this profile applies to.
+             *
+             * \return Returns a pointer to the element.  A null pointer may be returned if the element no longer
+             *         exists.
+             */
+            ElementPointer element() const;
+
+            /**
+             * Method you can use to obtain the number of times the operation was executed.
+             *
+             * \return Returns the operation's hit count.
+             */
+            unsigned long long hitCount() const;
+
+            /**
+             * Method you can use to obtain the exclusive time spent in the operation.
+             *
+             * \return Returns the exclusive time, in nanoseconds.
+             */
+            unsigned long long exclusiveNanoseconds() const;
+
+            /**
+             * Method you can use to obtain the inclusive time spent in the operation.
+             *
+             * \return Returns the inclusive time, in nanoseconds.
+             */
+            unsigned long long inclusiveNanoseconds() const;
+
+            /**
+             * Assignment operator
+             *
+             * \param[in] other The instance to be copied
+             *
+             * \return Returns a reference to this object.
+             */
+            OperationProfile& operator=(const OperationProfile& other);
+
+        private:
+            /**
+             * The operation this profile applies to.
+             */
+            Operation currentOperation;
+
+            /**
+             * The number of times the operation was executed.
+             */
+            unsigned long long currentHitCount;
+
+            /**
+             * The exclusive time spent in the operation, in nanoseconds.
+             */
+            unsigned long long currentExclusiveNanoseconds;
+
+            /**
+             * The inclusive time spent in the operation, in nanoseconds.
+             */
+            unsigned long long currentInclusiveNanoseconds;
+    };
+};
+
+#endif
@@ -37,7 +37,12 @@
 #include <QFileInfo>
 #include <QSet>
 #include <QHash>
+#include <QList>
+#include <QByteArray>
 #include <QBitArray>
+#include <QScopedPointer>
+
+#include <functional>
 
 #include <util_bit_array.h>
 
@@ -58,6 +63,11 @@ namespace Ld {
      *
      * The class also maintains a single static instance that is intended to be used as a temporary parking spot for
      * program files.
+     *
+     * Saves can optionally be performed on a background thread.  While a background save is in progress, every method
+     * that accesses the container, including payload reads and writes, blocks until the save completes.  The
+     * \ref ProgramFile::filename, \ref ProgramFile::openMode and \ref ProgramFile::errorString methods do not block;
+     * they report the values captured when the save was started.
      */
     class LD_PUBLIC_API ProgramFile {
         friend class PayloadData;
@@ -122,6 +132,47 @@ namespace Ld {
              */
             bool saveAs(const QString& newFilename);
 
+            /**
+             * Method you can use to write a program description held in memory and then close the working container
+             * and overwrite the customer's version on a background thread.  The method returns immediately after the
+             * background thread is started.  This method will fail if the container was opened read-only or if the
+             * container has never been saved.
+             *
+             * \param[in] description         The serialized program description to be stored in the default stream.
+             *
+             * \param[in] binary              If true, the description uses the compact binary encoding.  If false,
+             *                                the description is XML text.
+             *
+             * \param[in] purgedPayloads      A list of payloads to be removed before saving.
+             *
+             * \param[in] completionFunction  Optional function called from the background thread once the save has
+             *                                finished.
+             *
+             * \return Returns true if the background save was started, returns false on error.
+             */
+            bool saveInBackground(
+                const QByteArray&                    description,
+                bool                                 binary,
+                const QList<PayloadData::PayloadId>& purgedPayloads,
+                const std::function<void()>&         completionFunction = std::function<void()>()
+            );
+
+            /**
+             * Method you can use to determine if a background save is in progress.
+             *
+             * \return Returns true if a background save is in progress.
+             */
+            bool backgroundSaveActive() const;
+
+            /**
+             * Method you can use to wait for any pending background save to complete.
+             *
+             * \return Returns true if the last background save succeeded or if no background save was performed.
+             *         Returns false if the last background save failed.  The \ref ProgramFile::errorString method will
+             *         report the reason for the failure.
+             */
+            bool waitBackgroundSaveComplete() const;
+
             /**
              * Method you can use to close the working container and remove it without modifying the customer's copy.
              *
@@ -171,6 +222,13 @@ namespace Ld {
              */
             PayloadData clonePayload(PayloadData& payloadData);
 
+            /**
+             * Method you can use to obtain a list of payloads with a reference count of 0.
+             *
+             * \return Returns a list of payload IDs that are no longer referenced.
+             */
+            QList<PayloadData::PayloadId> unreferencedPayloads() const;
+
             /**
              * Method you can use to purge all payloads with a reference count of 0.
              *
@@ -186,10 +244,11 @@ namespace Ld {
             QString errorString() const;
 
             /**
-             * Method you can call to initialize the XML stream reader.
+             * Method you can call to initialize the XML stream reader.  If the container holds a binary encoded
+             * version of the stream, the binary version will be read in preference to XML text.
              *
              * \param[in] streamName The name of the XML stream.  The method will automatically append the correct
-             *                       extension to the stream name (currently ".xml")
+             *                       extension to the stream name (currently ".bin" or ".xml")
              *
              * \return Returns true on success, returns false on error.
              */
@@ -213,11 +272,15 @@ namespace Ld {
              * Method you can call to initialize the XML stream writer.
              *
              * \param[in] streamName The name of the XML stream.  The method will automatically append the correct
-             *                       extension to the stream name (currently ".xml")
+             *                       extension to the stream name (currently ".bin" or ".xml").  Any existing
+             *                       version of the stream, in either encoding, is erased.
+             *
+             * \param[in] binary     If true, the stream will be written using the compact binary encoding.  If
+             *                       false, the stream will be written as XML text.
              *
              * \return Returns true on success, returns false on error.
              */
-            bool initializeXmlWriter(const QString& streamName = QString());
+            bool initializeXmlWriter(const QString& streamName = QString(), bool binary = false);
 
             /**
              * Method you can use to access the current XML writer.
@@ -234,11 +297,56 @@ namespace Ld {
             bool releaseXmlWriter();
 
         private:
+            /**
+             * Thread used to perform background saves.
+             */
+            class SaveThread;
+
+            /**
+             * Method that determines if a background save is running on a thread other than the calling thread.
+             *
+             * \return Returns true if the caller should use the state captured when the background save started.
+             */
+            bool backgroundSaveActiveOnOtherThread() const;
+
             /**
              * Method used internally to reset the program file state.
              */
             void resetState();
 
+            /**
+             * Method that erases any existing version of a stream and opens a new, empty, stream for writing.
+             *
+             * \param[in] streamName The name of the stream.
+             *
+             * \param[in] binary     If true, the stream will hold the compact binary encoding.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool createStream(const QString& streamName, bool binary);
+
+            /**
+             * Method that writes a stream from data held in memory.
+             *
+             * \param[in] streamName The name of the stream.
+             *
+             * \param[in] data       The stream contents.
+             *
+             * \param[in] binary     If true, the stream holds the compact binary encoding.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool writeStream(const QString& streamName, const QByteArray& data, bool binary);
+
+            /**
+             * Method that removes a list of payloads from the container.
+             *
+             * \param[in] payloadIds The payloads to be removed.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool purgePayloads(const QList<PayloadData::PayloadId>& payloadIds);
+
             /**
              * Method that renames the container file.
              *
@@ -329,6 +437,31 @@ namespace Ld {
              * Map used to track payload data instances.
              */
             QHash<PayloadData::PayloadId, unsigned long> payloadReferenceCounts;
+
+            /**
+             * The thread performing the current or most recent background save.
+             */
+            QScopedPointer<SaveThread> currentSaveThread;
+
+            /**
+             * Flag indicating if the most recent background save succeeded.
+             */
+            bool currentBackgroundSaveSucceeded;
+
+            /**
+             * The container filename captured when the current background save was started.
+             */
+            QString currentBackgroundSaveFilename;
+
+            /**
+             * The container open mode captured when the current background save was started.
+             */
+            OpenMode currentBackgroundSaveOpenMode;
+
+            /**
+             * The last error captured when the current background save was started.
+             */
+            QString currentBackgroundSaveError;
     };
 };
 
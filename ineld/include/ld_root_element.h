@@ -36,11 +36,13 @@
 #include <QWeakPointer>
 #include <QString>
 #include <QMap>
+#include <QHash>
 #include <QList>
 #include <QSet>
 #include <QSharedPointer>
 #include <QBitArray>
 #include <QByteArray>
+#include <QVector>
 
 #include <model_rng.h>
 
@@ -53,11 +55,15 @@
 #include "ld_plug_in_information.h"
 #include "ld_payload_data.h"
 #include "ld_program_file.h"
+#include "ld_format_container.h"
 #include "ld_format_organizer.h"
 #include "ld_xml_writer.h"
 #include "ld_root_import.h"
 #include "ld_identifier_database.h"
 #include "ld_operation_database.h"
+#include "ld_operation_profile.h"
+#include "ld_element_image.h"
+#include "ld_element_image_cache.h"
 #include "ld_capabilities.h"
 #include "ld_document_settings.h"
 #include "ld_element_with_positional_children.h"
@@ -277,14 +283,67 @@ namespace Ld {
              */
             const OperationDatabase& operationDatabase() const;
 
+            /**
+             * Method you can use to record run-time profiling data collected from a model built with profiling
+             * enabled.  The supplied values are indexed by operation handle.  Inclusive times are calculated by adding
+             * the exclusive time of each operation to every operation defined by an ancestor element.
+             *
+             * \param[in] hitCounts            The number of times each operation was executed.
+             *
+             * \param[in] exclusiveNanoseconds The exclusive time spent in each operation, in nanoseconds.
+             */
+            void setOperationProfile(
+                const QVector<unsigned long long>& hitCounts,
+                const QVector<unsigned long long>& exclusiveNanoseconds
+            );
+
+            /**
+             * Method you can use to discard any recorded profiling data.
+             */
+            void clearOperationProfile();
+
+            /**
+             * Method you can use to determine if profiling data has been recorded.
+             *
+             * \return Returns true if profiling data is available.  Returns false if no profiling data is available.
+             */
+            bool hasOperationProfile() const;
+
+            /**
+             * Method you can use to obtain the profiling data for an element.
+             *
+             * \param[in] element The element of interest.
+             *
+             * \return Returns the profiling data for the element.  An invalid profile is returned if the element does
+             *         not define an operation or no profiling data is available.
+             */
+            OperationProfile operationProfile(ElementPointer element) const;
+
+            /**
+             * Method you can use to obtain the profiling data for every operation.
+             *
+             * \return Returns the profiling data, indexed by operation handle.
+             */
+            const QVector<OperationProfile>& operationProfiles() const;
+
             /**
              * Method you can call to generate a \ref Ld::FormatOrganizer instance initialized to provide data on all
-             * the formats in this program.
+             * the formats in this program.  Formats used by elements are tracked incrementally as elements are added,
+             * removed, or have their formats changed so this method only needs to add the document level formats to
+             * a copy of the tracked formats.
              *
              * \return Returns a shared pointer to a configured instance of a \ref Ld::FormatOrganizer for this program.
              */
             QSharedPointer<FormatOrganizer> formatOrganizer() const;
 
+            /**
+             * Method you can use to obtain the incrementally tracked formats used by elements under this root.  Unlike
+             * \ref RootElement::formatOrganizer, the document level formats are not included.
+             *
+             * \return Returns a reference to the organizer tracking every element format under this root.
+             */
+            const FormatOrganizer& elementFormatOrganizer() const;
+
             /**
              * Method you can use to change the application default page format.  The this value is used as the default
              * page format for all newly created root elements.
@@ -486,6 +545,36 @@ namespace Ld {
              */
             unsigned long numberPages() const;
 
+            /**
+             * Method you can use to select the compact binary encoding for the program description.  The binary
+             * encoding is smaller and faster to load than XML text but is not human readable.  The setting applies
+             * to subsequent saves.  Loads automatically detect the encoding.
+             *
+             * \param[in] nowEnabled If true, the binary encoding will be used.  If false, XML text will be used.
+             */
+            void setBinaryDescriptionEnabled(bool nowEnabled = true);
+
+            /**
+             * Method you can use to select XML text for the program description.
+             *
+             * \param[in] nowDisabled If true, XML text will be used.  If false, the binary encoding will be used.
+             */
+            void setBinaryDescriptionDisabled(bool nowDisabled = true);
+
+            /**
+             * Method you can use to determine if the program description will be saved using the binary encoding.
+             *
+             * \return Returns true if the binary encoding will be used.  Returns false if XML text will be used.
+             */
+            bool binaryDescriptionEnabled() const;
+
+            /**
+             * Method you can use to determine if the program description will be saved as XML text.
+             *
+             * \return Returns true if XML text will be used.  Returns false if the binary encoding will be used.
+             */
+            bool binaryDescriptionDisabled() const;
+
             /**
              * Method you can use to set the document default RNG type.
              *
@@ -599,6 +688,16 @@ namespace Ld {
              */
             bool isPristine() const;
 
+            /**
+             * Method that returns a revision number for the content under this root node.  The revision number is
+             * incremented each time a change is made, including setting or clearing an instruction breakpoint, and
+             * is never reset, even when the program is saved.  You can use this value to determine if derived data,
+             * such as a translation, is still current.
+             *
+             * \return Returns the current revision number.
+             */
+            unsigned long long revision() const;
+
             /**
              * Method that can be called to determine if this root import can be deleted.  The method will return
              * true if:
@@ -663,6 +762,43 @@ namespace Ld {
              */
             bool saveAs(const QString& newFilename, bool purgeOnSave = true);
 
+            /**
+             * Method you can use to save the program state without blocking.  The program description is captured
+             * immediately, so later edits are not included in this save.  The container is then written on a
+             * background thread.
+             *
+             * Completion is reported via \ref RootVisual::programSaved or \ref RootVisual::programSaveFailed.  When an
+             * application instance exists, the report is queued to the application's thread.  Otherwise it is made
+             * from \ref RootElement::waitBackgroundSaveComplete.  The program is marked pristine on completion only if
+             * it was not modified while the save was in progress.
+             *
+             * Methods that access the program file, including payload access, block until the background save
+             * completes.  Edits to the element tree do not block, and the program filename and open mode remain
+             * available without blocking.
+             *
+             * \param[in] purgeOnSave If true, payloads that are no longer referened by the program will be purged from
+             *                        the file.
+             *
+             * \return Returns true if the background save was started.  Returns false on error.
+             */
+            bool saveInBackground(bool purgeOnSave = true);
+
+            /**
+             * Method you can use to determine if a background save is pending.
+             *
+             * \return Returns true if a background save has been started and its completion has not yet been
+             *         reported.
+             */
+            bool backgroundSavePending() const;
+
+            /**
+             * Method you can use to wait for any pending background save to complete.  Completion is reported before
+             * this method returns.
+             *
+             * \return Returns true if the most recent background save succeeded.  Returns false if it failed.
+             */
+            bool waitBackgroundSaveComplete();
+
             /**
              * Method you can use to close the working program file behind this root node.  The contents of the root
              * element will not be saved.
@@ -855,6 +991,27 @@ namespace Ld {
              */
             virtual QByteArray exportElementImage(ElementPointer element, float dpi) const;
 
+            /**
+             * Method you can use to obtain a rendered image for an element, along with the image's format and size.
+             * Images are obtained through \ref Ld::RootElement::exportElementImage and cached so that code generators
+             * can share them and repeated exports can reuse images of unchanged elements.  This method can safely be
+             * called from multiple threads.
+             *
+             * \param[in] element The element to obtain the image for.
+             *
+             * \param[in] dpi     The desired image resolution in DPI.
+             *
+             * \return Returns the requested image.  An invalid image is returned if the element could not be rendered.
+             */
+            ElementImage elementImage(ElementPointer element, float dpi);
+
+            /**
+             * Method you can use to access the cache of rendered element images.
+             *
+             * \return Returns a reference to the element image cache.
+             */
+            ElementImageCache& elementImageCache();
+
             /**
              * Calculates a unique identifier for the document that would be associated with a specified file.
              *
@@ -952,6 +1109,17 @@ namespace Ld {
              */
             void descendantFormatUpdated(ElementPointer changedElement, FormatPointer newFormat) final;
 
+            /**
+             * Method that is triggered whenever an instruction breakpoint is set or cleared on a descendant.  The
+             * revision is advanced so that translations built for the previous breakpoints are discarded.
+             *
+             * \param[in] changedElement   The element who's breakpoint status has changed.
+             *
+             * \param[in] breakpointNowSet If true, a breakpoint is now set on the element.  If false, the breakpoint
+             *                             has been cleared.
+             */
+            void descendantInstructionBreakpointUpdated(ElementPointer changedElement, bool breakpointNowSet) final;
+
             /**
              * Method that is called by any child element when a change occurs.
              *
@@ -1050,6 +1218,15 @@ namespace Ld {
              */
             bool writeXmlDescription(const QString& filePath);
 
+            /**
+             * Method that is called to write the program's XML description to a provided writer.
+             *
+             * \param[in] writer   The writer to receive the description.
+             *
+             * \param[in] filePath The path to the file used as a reference location for relative imports.
+             */
+            void writeXmlDescription(QSharedPointer<XmlWriter> writer, const QString& filePath);
+
             /**
              * Method that is called to read the program's XML description and build the element tree from the root
              * element downward.
@@ -1282,6 +1459,29 @@ namespace Ld {
              */
             static void freeDocumentNumber(unsigned documentNumber);
 
+            /**
+             * Method that removes cached images of an element and of every ancestor of the element, since ancestor
+             * images include the element.
+             *
+             * \param[in] element The changed element.
+             */
+            void invalidateElementImages(ElementPointer element);
+
+            /**
+             * Method that updates the tracked format for an element.  Any previously tracked format for the element is
+             * released before the element's current format is added.
+             *
+             * \param[in] element The element to be tracked.
+             */
+            void trackElementFormat(ElementPointer element);
+
+            /**
+             * Method that releases the tracked format for an element.
+             *
+             * \param[in] element The element to stop tracking.
+             */
+            void untrackElementFormat(ElementPointer element);
+
             /**
              * The program file instance backing this root element/program.
              */
@@ -1302,6 +1502,26 @@ namespace Ld {
              */
             bool currentIsModified;
 
+            /**
+             * The current revision number.
+             */
+            unsigned long long currentRevision;
+
+            /**
+             * Flag indicating that a background save was started and its completion has not yet been reported.
+             */
+            bool currentBackgroundSavePending;
+
+            /**
+             * Flag indicating if the most recent background save succeeded.
+             */
+            bool currentBackgroundSaveSucceeded;
+
+            /**
+             * The revision captured when the most recent background save was started.
+             */
+            unsigned long long currentBackgroundSaveRevision;
+
             /**
              * A document number used to provide this document a unique name.  Names will be generated from
              * Document::currentFileInformation if this value is set to Document::invalidDocumentNumber.
@@ -1368,6 +1588,17 @@ namespace Ld {
              */
             ElementMap currentElementsByHandle;
 
+            /**
+             * Organizer holding reference counts for every format used by an element under this root.
+             */
+            FormatOrganizer currentElementFormats;
+
+            /**
+             * Hash of the format tracked for each element, by element handle.  The containers hold copies of the
+             * formats so that the tracked entry can be released after the element's format is modified in place.
+             */
+            QHash<Handle, FormatContainer> currentElementFormatsByHandle;
+
             /**
              * Ordered list of other root elements imported by this root element.
              */
@@ -1383,11 +1614,26 @@ namespace Ld {
              */
             OperationDatabase currentOperationDatabase;
 
+            /**
+             * The most recently recorded profiling data, indexed by operation handle.
+             */
+            QVector<OperationProfile> currentOperationProfiles;
+
+            /**
+             * Cache of rendered element images.
+             */
+            ElementImageCache currentElementImageCache;
+
             /**
              * Flag indicating the default brace condition else clause.
              */
             bool currentDefaultBraceConditionalElseClauseShown;
 
+            /**
+             * Flag indicating if the program description is saved using the binary encoding.
+             */
+            bool currentBinaryDescriptionEnabled;
+
             /**
              * The document RNG type.
              */
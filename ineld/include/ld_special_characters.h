@@ -138,6 +138,30 @@ namespace Ld {
              */
             static UnicodeValue unicodeForCommand(const QString& commandString);
 
+            /**
+             * Static method you can use to obtain the command associated with a unicode value.  The lookup uses a
+             * page table and is safe to call from multiple threads.
+             *
+             * \param[in] unicodeValue The unicode value to obtain the command for.
+             *
+             * \return Returns the command, without the prefix.  An empty string is returned if the unicode value is
+             *         not a special character.
+             */
+            static QString commandForUnicodeValue(UnicodeValue unicodeValue);
+
+            /**
+             * Static method you can use to locate the next non-ASCII character in a string.  Runs of ASCII text are
+             * scanned several characters at a time.
+             *
+             * \param[in] text          The text to be scanned.
+             *
+             * \param[in] startingIndex The index of the first character to check.
+             *
+             * \return Returns the index of the first character at or after the starting index with a unicode value
+             *         above 0x7F.  The length of the text is returned if there are no such characters.
+             */
+            static unsigned long nextNonAsciiIndex(const QString& text, unsigned long startingIndex = 0);
+
             /**
              * Static method you can use to obtain a recommended ordering for characters.
              *
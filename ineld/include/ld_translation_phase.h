@@ -136,13 +136,13 @@ namespace Ld {
             /**
              * Method that resets the translation phase to the first phase.
              */
-            void reset();
+            virtual void reset();
 
             /**
              * Method that advances the translation phase to the next phase.  The method will now allow you to advance
-             * past the last translation phase.
+             * past the last translation phase.  Derived classes can overload this method to repeat a range of phases.
              */
-            void nextPhase();
+            virtual void nextPhase();
 
             /**
              * Assignment operator.
@@ -180,6 +180,14 @@ namespace Ld {
              */
             operator unsigned() const;
 
+        protected:
+            /**
+             * Method that derived classes can use to jump to an arbitrary phase.
+             *
+             * \param[in] newPhaseNumber The new phase number.  Values beyond the last phase are ignored.
+             */
+            void setPhaseNumber(unsigned newPhaseNumber);
+
         private:
             unsigned currentPhaseNumber;
     };
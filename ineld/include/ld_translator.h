@@ -69,6 +69,18 @@ namespace Ld {
              */
             virtual bool translate(ElementPointer element, CodeGenerationEngine& codeGenerationEngine) = 0;
 
+            /**
+             * Method you can overload to indicate that this translator can translate distinct elements concurrently
+             * during a phase that ignores the element heirarchy.  Translators that report true must only use engine
+             * methods that are documented as thread safe.
+             *
+             * \param[in] translationPhase The translation phase being performed.
+             *
+             * \return Returns true if the translator is thread safe during the supplied phase.  The default
+             *         implementation returns false.
+             */
+            virtual bool threadSafe(const TranslationPhase& translationPhase) const;
+
             /**
              * Cast operator
              *
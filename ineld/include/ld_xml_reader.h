@@ -31,6 +31,11 @@
 #define LD_XML_READER_H
 
 #include <QXmlStreamReader>
+#include <QString>
+#include <QStringRef>
+#include <QByteArray>
+#include <QVector>
+#include <QMultiHash>
 
 #include "ld_common.h"
 #include "ld_xml_attributes.h"
@@ -39,7 +44,12 @@ class QVirtualFile;
 
 namespace Ld {
     /**
-     * Class you can use to read XML.  The class is a very thin wrapper on the Qt QXmlStreamReader class.
+     * Class you can use to read XML.  The class is a very thin wrapper on the Qt QXmlStreamReader class.  Namespace
+     * processing is disabled as program descriptions do not use XML namespaces.
+     *
+     * The reader can optionally process the compact binary encoding emitted by \ref Ld::XmlWriter in binary mode.
+     * The binary encoding presents the same token stream as the equivalent XML text so callers need not distinguish
+     * between the two.
      */
     class LD_PUBLIC_API XmlReader:public QXmlStreamReader {
 
@@ -49,9 +59,12 @@ namespace Ld {
             /**
              * Constructor.
              *
-             * \param[in] virtualFile The virtual file to write the XML data to.
+             * \param[in] virtualFile The virtual file to read the XML data from.
+             *
+             * \param[in] binary      If true, the reader will expect the compact binary encoding rather than XML
+             *                        text.  The entire encoded stream is read from the virtual file on construction.
              */
-            XmlReader(QVirtualFile* virtualFile);
+            XmlReader(QVirtualFile* virtualFile, bool binary = false);
 
             ~XmlReader();
 
@@ -75,6 +88,213 @@ namespace Ld {
              * \return Returns the list of attributes up-cast to the \ref XmlAttributes type.
              */
             XmlAttributes attributes() const;
+
+            /**
+             * Method you can use to obtain the qualified name of the current element.  Names are interned so that
+             * repeated tags share a single string instance and no allocation is performed once a tag name has been
+             * seen.
+             *
+             * \return Returns the qualified name of the current element.
+             */
+            QString internedQualifiedName();
+
+            /**
+             * Method you can use to determine if this reader processes the compact binary encoding.
+             *
+             * \return Returns true if this reader processes the compact binary encoding.  Returns false if this
+             *         reader processes XML text.
+             */
+            bool isBinary() const;
+
+            /**
+             * Method you can use to read the next token.
+             *
+             * \return Returns the type of the token that was read.
+             */
+            TokenType readNext();
+
+            /**
+             * Method you can use to obtain the type of the current token.
+             *
+             * \return Returns the type of the current token.
+             */
+            TokenType tokenType() const;
+
+            /**
+             * Method you can use to determine if the end of the document or an error has been reached.
+             *
+             * \return Returns true if there are no further tokens to be read.
+             */
+            bool atEnd() const;
+
+            /**
+             * Method you can use to determine if the current token is the end of the document.
+             *
+             * \return Returns true if the current token is the end of the document.
+             */
+            bool isEndDocument() const;
+
+            /**
+             * Method you can use to determine if the current token is the start of an element.
+             *
+             * \return Returns true if the current token is the start of an element.
+             */
+            bool isStartElement() const;
+
+            /**
+             * Method you can use to determine if the current token is the end of an element.
+             *
+             * \return Returns true if the current token is the end of an element.
+             */
+            bool isEndElement() const;
+
+            /**
+             * Method you can use to determine if the current token is character data.
+             *
+             * \return Returns true if the current token is character data.
+             */
+            bool isCharacters() const;
+
+            /**
+             * Method you can use to determine if the current token is character data containing only whitespace.
+             *
+             * \return Returns true if the current token is whitespace.
+             */
+            bool isWhitespace() const;
+
+            /**
+             * Method you can use to obtain the qualified name of the current element.
+             *
+             * \return Returns the qualified name of the current element.
+             */
+            QStringRef qualifiedName() const;
+
+            /**
+             * Method you can use to obtain the text of the current token.
+             *
+             * \return Returns the text of the current character or document type declaration token.
+             */
+            QStringRef text() const;
+
+            /**
+             * Method you can use to obtain the name of the document type declaration.
+             *
+             * \return Returns the document type declaration name.
+             */
+            QStringRef dtdName() const;
+
+            /**
+             * Method you can use to obtain the current line number.  The binary encoding has no line structure so
+             * the method returns 0 in binary mode.
+             *
+             * \return Returns the current line number.
+             */
+            qint64 lineNumber() const;
+
+            /**
+             * Method you can use to obtain the current column number.  The binary encoding has no line structure so
+             * the method returns 0 in binary mode.
+             *
+             * \return Returns the current column number.
+             */
+            qint64 columnNumber() const;
+
+            /**
+             * Method you can use to obtain the current character offset.  In binary mode, the method returns the
+             * current byte offset into the encoded stream.
+             *
+             * \return Returns the current character offset.
+             */
+            qint64 characterOffset() const;
+
+        private:
+            /**
+             * Method that reads a string table reference from the binary stream, adding a new string to the table if
+             * needed.
+             *
+             * \param[out] value The string that was read.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool readInterned(QString& value);
+
+            /**
+             * Method that reads an encoded attribute value from the binary stream.
+             *
+             * \param[out] value The value that was read.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool readValue(QString& value);
+
+            /**
+             * Method that reads the binary payload for an element's attributes.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool readBinaryAttributes();
+
+            /**
+             * Method that reads the next token from the binary stream.
+             *
+             * \return Returns the type of the token that was read.
+             */
+            TokenType readNextBinary();
+
+            /**
+             * Flag indicating if this reader processes the binary encoding.
+             */
+            bool currentBinary;
+
+            /**
+             * The binary encoded stream.
+             */
+            QByteArray binaryData;
+
+            /**
+             * The current read position in the binary encoded stream.
+             */
+            int binaryPosition;
+
+            /**
+             * The binary string table.
+             */
+            QVector<QString> stringTable;
+
+            /**
+             * The names of the currently open elements in binary mode.
+             */
+            QVector<QString> elementStack;
+
+            /**
+             * The current binary token type.
+             */
+            TokenType currentTokenType;
+
+            /**
+             * The current binary element name.
+             */
+            QString currentName;
+
+            /**
+             * The current binary text.
+             */
+            QString currentText;
+
+            /**
+             * The current binary document type declaration name.
+             */
+            QString currentDtdName;
+
+            /**
+             * The current binary attributes.
+             */
+            QXmlStreamAttributes currentAttributes;
+
+            /**
+             * Interned tag names, keyed by hash.
+             */
+            QMultiHash<unsigned, QString> internedNames;
     };
 };
 
@@ -31,6 +31,10 @@
 #define LD_XML_WRITER_H
 
 #include <QXmlStreamWriter>
+#include <QString>
+#include <QStringRef>
+#include <QByteArray>
+#include <QHash>
 
 #include <qvirtual_file.h>
 
@@ -41,6 +45,11 @@ class QVirtualFile;
 namespace Ld {
     /**
      * Class you can use to write XML.  The class is a very thin wrapper on the Qt QXmlStreamWriter class.
+     *
+     * The writer can optionally emit a compact binary encoding of the same event stream in place of XML text.  In
+     * binary mode, element and attribute names are written once and referenced by index afterwards and numeric and
+     * handle attribute values are stored in binary form.  Content written in binary mode must be read using an
+     * \ref Ld::XmlReader instance in binary mode.
      */
     class LD_PUBLIC_API XmlWriter:public QXmlStreamWriter {
 
@@ -51,8 +60,19 @@ namespace Ld {
              * Constructor.
              *
              * \param[in] virtualFile The virtual file to write the XML data to.
+             *
+             * \param[in] binary      If true, the writer will emit the compact binary encoding rather than XML text.
+             */
+            XmlWriter(QVirtualFile* virtualFile, bool binary = false);
+
+            /**
+             * Constructor.
+             *
+             * \param[in] array  The byte array to write the XML data to.
+             *
+             * \param[in] binary If true, the writer will emit the compact binary encoding rather than XML text.
              */
-            XmlWriter(QVirtualFile* virtualFile);
+            XmlWriter(QByteArray* array, bool binary = false);
 
             ~XmlWriter();
 
@@ -69,6 +89,130 @@ namespace Ld {
              * \return Returns a pointer to the virtual file tied to this XML writer.
              */
             QVirtualFile* virtualFile() const;
+
+            /**
+             * Method you can use to determine if this writer emits the compact binary encoding.
+             *
+             * \return Returns true if this writer emits the compact binary encoding.  Returns false if this writer
+             *         emits XML text.
+             */
+            bool isBinary() const;
+
+            /**
+             * Method you can use to enable or disable automatic formatting.  The setting is ignored in binary mode.
+             *
+             * \param[in] nowEnabled If true, automatic formatting will be enabled.
+             */
+            void setAutoFormatting(bool nowEnabled);
+
+            /**
+             * Method you can use to start the document.
+             */
+            void writeStartDocument();
+
+            /**
+             * Method you can use to end the document.  Any open elements are closed.
+             */
+            void writeEndDocument();
+
+            /**
+             * Method you can use to write a document type declaration.
+             *
+             * \param[in] dtd The document type declaration.
+             */
+            void writeDTD(const QString& dtd);
+
+            /**
+             * Method you can use to start a new element.
+             *
+             * \param[in] qualifiedName The name of the element.
+             */
+            void writeStartElement(const QString& qualifiedName);
+
+            /**
+             * Method you can use to write attributes to the current element.
+             *
+             * \param[in] attributes The attributes to be written.
+             */
+            void writeAttributes(const QXmlStreamAttributes& attributes);
+
+            /**
+             * Method you can use to write a single attribute to the current element.
+             *
+             * \param[in] qualifiedName The attribute name.
+             *
+             * \param[in] value         The attribute value.
+             */
+            void writeAttribute(const QString& qualifiedName, const QString& value);
+
+            /**
+             * Method you can use to write character data.
+             *
+             * \param[in] text The text to be written.
+             */
+            void writeCharacters(const QString& text);
+
+            /**
+             * Method you can use to end the current element.
+             */
+            void writeEndElement();
+
+            /**
+             * Method you can use to write an element holding only text.
+             *
+             * \param[in] qualifiedName The name of the element.
+             *
+             * \param[in] text          The text to be placed in the element.
+             */
+            void writeTextElement(const QString& qualifiedName, const QString& text);
+
+        private:
+            /**
+             * The buffer size that will trigger a write to the virtual file in binary mode.
+             */
+            static constexpr int flushThreshold = 65536;
+
+            /**
+             * Method that appends a string table reference to the binary buffer, adding the string to the table if
+             * needed.
+             *
+             * \param[in] value The string to be referenced.
+             */
+            void appendInterned(const QString& value);
+
+            /**
+             * Method that appends an encoded attribute value to the binary buffer.
+             *
+             * \param[in] value The value to be appended.
+             */
+            void appendValue(const QString& value);
+
+            /**
+             * Method that writes the binary buffer to the virtual file if it exceeds the flush threshold.
+             *
+             * \param[in] force If true, the buffer is written regardless of size.
+             */
+            void flushBinary(bool force = false);
+
+            /**
+             * Flag indicating if this writer emits the binary encoding.
+             */
+            bool currentBinary;
+
+            /**
+             * Binary data not yet written to the virtual file.
+             */
+            QByteArray binaryBuffer;
+
+            /**
+             * The binary string table, mapping each string to its index.
+             */
+            QHash<QString, unsigned long long> stringTable;
+
+            /**
+             * The number of open elements in binary mode.
+             */
+            unsigned long long openElements;
     };
 };
 
@@ -75,6 +75,7 @@ API_HEADERS = include/ld_common.h \
               include/ld_identifier_database.h \
               include/ld_operation.h \
               include/ld_operation_database.h \
+              include/ld_operation_profile.h \
               include/ld_function_variant.h \
               include/ld_function_data.h \
               include/ld_function_database.h \
@@ -136,6 +137,9 @@ API_HEADERS = include/ld_common.h \
 \
               include/ld_element_position.h \
               include/ld_element_cursor.h \
+              include/ld_element_iterator.h \
+              include/ld_element_image.h \
+              include/ld_element_image_cache.h \
               include/ld_cursor.h \
               include/ld_cursor_state_data.h \
               include/ld_cursor_weak_collection.h \
@@ -423,6 +427,7 @@ API_HEADERS = include/ld_common.h \
               include/ld_cpp_translation_phase.h \
               include/ld_cpp_translator.h \
               include/ld_cpp_declaration_payload.h \
+              include/ld_cpp_declaration_pch_cache.h \
               include/ld_cpp_library_information.h \
               include/ld_cpp_library_dependencies.h \
               include/ld_cpp_unary_operator_translator_base.h \
@@ -435,6 +440,10 @@ API_HEADERS = include/ld_common.h \
               include/ld_cpp_code_generator.h \
               include/ld_cpp_code_generator_diagnostic.h \
               include/ld_cpp_context.h \
+              include/ld_cpp_object_cache.h \
+              include/ld_cpp_elementwise_fusion.h \
+              include/ld_cpp_expression_optimizer.h \
+              include/ld_cpp_parallel_loop.h \
               include/ld_cpp_data_type_translator.h \
               include/ld_cpp_variant_data_type_translator.h \
               include/ld_cpp_boolean_data_type_translator.h \
@@ -855,6 +864,7 @@ SOURCES = source/ld_configure.cpp \
           source/ld_identifier_database.cpp \
           source/ld_operation.cpp \
           source/ld_operation_database.cpp \
+          source/ld_operation_profile.cpp \
           source/ld_function_variant_private.cpp \
           source/ld_function_variant.cpp \
           source/ld_function_data_private.cpp \
@@ -868,6 +878,7 @@ SOURCES = source/ld_configure.cpp \
           source/ld_xml_attributes.cpp \
           source/ld_xml_writer.cpp \
           source/ld_xml_reader.cpp \
+          source/ld_xml_binary_format.cpp \
           source/ld_xml_element.cpp \
           source/ld_xml_export_context.cpp \
           source/ld_xml_memory_export_context.cpp \
@@ -919,6 +930,9 @@ SOURCES = source/ld_configure.cpp \
 \
           source/ld_element_position.cpp \
           source/ld_element_cursor.cpp \
+          source/ld_element_iterator.cpp \
+          source/ld_element_image.cpp \
+          source/ld_element_image_cache.cpp \
           source/ld_cursor.cpp \
           source/ld_cursor_state_data.cpp \
           source/ld_cursor_weak_collection.cpp \
@@ -1225,11 +1239,17 @@ SOURCES = source/ld_configure.cpp \
           source/ld_cpp_code_generator.cpp \
           source/ld_cpp_declaration_payload.cpp \
           source/ld_cpp_declaration_payload_private.cpp \
+          source/ld_cpp_declaration_pch_cache.cpp \
           source/ld_cpp_library_information.cpp \
           source/ld_cpp_library_dependencies.cpp \
           source/ld_cpp_code_generator_diagnostic.cpp \
           source/ld_cpp_code_generator_diagnostic_private.cpp \
           source/ld_cpp_context.cpp \
+          source/ld_cpp_pch_probe_context.cpp \
+          source/ld_cpp_object_cache.cpp \
+          source/ld_cpp_elementwise_fusion.cpp \
+          source/ld_cpp_expression_optimizer.cpp \
+          source/ld_cpp_parallel_loop.cpp \
           source/ld_cpp_data_type_translator.cpp \
           source/ld_cpp_variant_data_type_translator.cpp \
           source/ld_cpp_boolean_data_type_translator.cpp \
@@ -1641,10 +1661,12 @@ PRIVATE_HEADERS = source/ld_configure_basic_functions.h \
                   source/ld_payload_data_private.h \
                   source/ld_cpp_declaration_payload_private.h \
                   source/ld_cpp_code_generator_diagnostic_private.h \
+                  source/ld_cpp_pch_probe_context.h \
                   source/ld_html_code_generator_diagnostic_private.h \
                   source/ld_latex_code_generator_diagnostic_private.h \
                   source/ld_environment_private.h \
                   source/ld_cursor_state_collection_entry_private.h \
+                  source/ld_xml_binary_format.h \
                   source/development_environment_private.h \
                   source/development_main_application_environment_private.h \
                   source/development_test_environment_private.h \
@@ -26,121 +26,301 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QHash>
 
-#include <util_bit_set.h>
+#include <cstdint>
 
 #include "ld_common.h"
 #include "ld_capabilities.h"
 
+/***********************************************************************************************************************
+ * Built-in capability bits
+ */
+
+/**
+ * Enumeration of the bits used by the built-in capabilities.  The order must match the order of the names in
+ * \ref builtInBitNames.
+ */
+enum BuiltInBit : unsigned {
+    SELECTION_BIT = 0,
+    FRAME_BIT,
+    TEXT_ANNOTATIONS_BIT,
+    NON_TEXT_ANNOTATIONS_BIT,
+    TYPE_DECLARATIONS_BIT,
+    ASSIGNMENT_BIT,
+    ITERATION_OPERATOR_BIT,
+    CONDITIONAL_OPERATOR_BIT,
+    COMPOUND_STATEMENT_OPERATOR_BIT,
+    COMPOUND_EXIT_OPERATOR_BIT,
+    DATA_TYPES_BIT,
+    VARIABLES_BIT,
+    SUBSCRIPTS_BIT,
+    SPECIAL_BOOLEAN_VALUES_BIT,
+    SPECIAL_INTEGER_VALUES_BIT,
+    SPECIAL_REAL_VALUES_BIT,
+    SPECIAL_COMPLEX_VALUES_BIT,
+    SPECIAL_SET_VALUES_BIT,
+    FUNCTION_DECLARATIONS_BIT,
+    BOOLEAN_FUNCTIONS_BIT,
+    INTEGER_FUNCTIONS_BIT,
+    REAL_FUNCTIONS_BIT,
+    COMPLEX_FUNCTIONS_BIT,
+    SET_FUNCTIONS_BIT,
+    TUPLE_FUNCTIONS_BIT,
+    MATRIX_BOOLEAN_FUNCTIONS_BIT,
+    MATRIX_INTEGER_FUNCTIONS_BIT,
+    MATRIX_REAL_FUNCTIONS_BIT,
+    MATRIX_COMPLEX_FUNCTIONS_BIT,
+    NUMERIC_LITERALS_BIT,
+    SET_LITERALS_BIT,
+    TUPLE_LITERALS_BIT,
+    MATRIX_LITERALS_BIT,
+    RANGES_BIT,
+    BOOLEAN_OPERATORS_BIT,
+    INTEGER_OPERATORS_BIT,
+    REAL_OPERATORS_BIT,
+    COMPLEX_OPERATORS_BIT,
+    SET_OPERATORS_BIT,
+    TUPLE_OPERATORS_BIT,
+    MATRIX_BOOLEAN_OPERATORS_BIT,
+    MATRIX_INTEGER_OPERATORS_BIT,
+    MATRIX_REAL_OPERATORS_BIT,
+    MATRIX_COMPLEX_OPERATORS_BIT,
+    ALPHABETIC_SYMBOLS_BIT,
+    STRING_IDENTIFIER_SYMBOLS_BIT,
+    NUMERIC_BINARY_SYMBOLS_BIT,
+    NUMERIC_DECIMAL_SYMBOLS_BIT,
+    NUMERIC_HEXIDECIMAL_SYMBOLS_BIT,
+    NUMERIC_HEXIDECIMAL_BASE_IDENTIFIER_SYMBOLS_BIT,
+    NUMERIC_BINARY_BASE_IDENTIFIER_SYMBOLS_BIT,
+    NUMERIC_IMAGINARY_UNIT_SYMBOLS_BIT,
+    NUMERIC_SIGN_SYMBOLS_BIT,
+    NUMERIC_DECIMAL_POINT_SYMBOLS_BIT,
+    NUMERIC_EXPONENTIAL_SYMBOLS_BIT,
+    NON_ASCII_ALPHABETIC_SYMBOLS_BIT,
+    SPECIAL_SYMBOLS_BIT,
+    NEW_LINE_BIT,
+    NUMBER_BUILT_IN_BITS
+};
+
+/**
+ * Table of the names associated with each built-in bit.  Plug-ins can use these names to reference a built-in
+ * capability.
+ */
+static const char* const builtInBitNames[] = {
+    "SELECTION",
+    "FRAME",
+    "TEXT_ANNOTATIONS",
+    "NON_TEXT_ANNOTATIONS",
+    "TYPE_DECLARATIONS",
+    "ASSIGNMENT",
+    "ITERATION_OPERATOR",
+    "CONDITIONAL_OPERATOR",
+    "COMPOUND_STATEMENT_OPERATOR",
+    "COMPOUND_EXIT_OPERATOR",
+    "DATA_TYPES",
+    "VARIABLES",
+    "SUBSCRIPTS",
+    "SPECIAL_BOOLEAN_VALUES",
+    "SPECIAL_INTEGER_VALUES",
+    "SPECIAL_REAL_VALUES",
+    "SPECIAL_COMPLEX_VALUES",
+    "SPECIAL_SET_VALUES",
+    "FUNCTION_DECLARATIONS",
+    "BOOLEAN_FUNCTIONS",
+    "INTEGER_FUNCTIONS",
+    "REAL_FUNCTIONS",
+    "COMPLEX_FUNCTIONS",
+    "SET_FUNCTIONS",
+    "TUPLE_FUNCTIONS",
+    "MATRIX_BOOLEAN_FUNCTIONS",
+    "MATRIX_INTEGER_FUNCTIONS",
+    "MATRIX_REAL_FUNCTIONS",
+    "MATRIX_COMPLEX_FUNCTIONS",
+    "NUMERIC_LITERALS",
+    "SET_LITERALS",
+    "TUPLE_LITERALS",
+    "MATRIX_LITERALS",
+    "RANGES",
+    "BOOLEAN_OPERATORS",
+    "INTEGER_OPERATORS",
+    "REAL_OPERATORS",
+    "COMPLEX_OPERATORS",
+    "SET_OPERATORS",
+    "TUPLE_OPERATORS",
+    "MATRIX_BOOLEAN_OPERATORS",
+    "MATRIX_INTEGER_OPERATORS",
+    "MATRIX_REAL_OPERATORS",
+    "MATRIX_COMPLEX_OPERATORS",
+    "ALPHABETIC_SYMBOLS",
+    "STRING_IDENTIFIER_SYMBOLS",
+    "NUMERIC_BINARY_SYMBOLS",
+    "NUMERIC_DECIMAL_SYMBOLS",
+    "NUMERIC_HEXIDECIMAL_SYMBOLS",
+    "NUMERIC_HEXIDECIMAL_BASE_IDENTIFIER_SYMBOLS",
+    "NUMERIC_BINARY_BASE_IDENTIFIER_SYMBOLS",
+    "NUMERIC_IMAGINARY_UNIT_SYMBOLS",
+    "NUMERIC_SIGN_SYMBOLS",
+    "NUMERIC_DECIMAL_POINT_SYMBOLS",
+    "NUMERIC_EXPONENTIAL_SYMBOLS",
+    "NON_ASCII_ALPHABETIC_SYMBOLS",
+    "SPECIAL_SYMBOLS",
+    "NEW_LINE",
+};
+
+static_assert(
+    sizeof(builtInBitNames) / sizeof(builtInBitNames[0]) == NUMBER_BUILT_IN_BITS,
+    "Built-in capability names do not match the built-in capability bits."
+);
+
+static_assert(
+    NUMBER_BUILT_IN_BITS <= Ld::Capabilities::maximumNumberBuiltInBits,
+    "Too many built-in capabilities for the built-in capability mask."
+);
+
+/**
+ * Function that calculates the mask for a built-in bit.
+ *
+ * \param[in] bit The bit of interest.
+ *
+ * \return Returns the mask for the bit.
+ */
+static constexpr std::uint64_t builtInMask(BuiltInBit bit) {
+    return std::uint64_t(1) << static_cast<unsigned>(bit);
+}
+
+/**
+ * Function that returns the table of bit indexes by bit name.  Indexes below
+ * \ref Ld::Capabilities::maximumNumberBuiltInBits reference built-in bits.  Higher indexes reference bits in the
+ * plug-in extension.  The table is seeded with the built-in names on first use.
+ *
+ * \return Returns a reference to the table of bit indexes.
+ */
+static QHash<QString, unsigned>& bitIndexesByName() {
+    static QHash<QString, unsigned> bitIndexes = []() {
+        QHash<QString, unsigned> result;
+        for (unsigned bitIndex=0 ; bitIndex<NUMBER_BUILT_IN_BITS ; ++bitIndex) {
+            result.insert(QString::fromLatin1(builtInBitNames[bitIndex]), bitIndex);
+        }
+
+        return result;
+    }();
+
+    return bitIndexes;
+}
+
 /***********************************************************************************************************************
  * Capabilities
  */
 
 namespace Ld {
-    Util::BitSet::BitNameHash Capabilities::bitNameHash;
-
-    const Capabilities Capabilities::selection("SELECTION");
-    const Capabilities Capabilities::frame("FRAME");
-    const Capabilities Capabilities::textAnnotations("TEXT_ANNOTATIONS");
-    const Capabilities Capabilities::nonTextAnnotations("NON_TEXT_ANNOTATIONS");
-    const Capabilities Capabilities::typeDeclaration("TYPE_DECLARATIONS");
-    const Capabilities Capabilities::assignment("ASSIGNMENT");
-    const Capabilities Capabilities::iterationOperator("ITERATION_OPERATOR");
-    const Capabilities Capabilities::conditionalOperator("CONDITIONAL_OPERATOR");
-    const Capabilities Capabilities::compoundStatementOperator("COMPOUND_STATEMENT_OPERATOR");
-    const Capabilities Capabilities::compoundExitOperator("COMPOUND_EXIT_OPERATOR");
-    const Capabilities Capabilities::dataTypes("DATA_TYPES");
-    const Capabilities Capabilities::variables("VARIABLES");
-    const Capabilities Capabilities::subscripts("SUBSCRIPTS");
-    const Capabilities Capabilities::specialBooleanValues("SPECIAL_BOOLEAN_VALUES");
-    const Capabilities Capabilities::specialIntegerValues("SPECIAL_INTEGER_VALUES");
-    const Capabilities Capabilities::specialRealValues("SPECIAL_REAL_VALUES");
-    const Capabilities Capabilities::specialComplexValues("SPECIAL_COMPLEX_VALUES");
-    const Capabilities Capabilities::specialSetValues("SPECIAL_SET_VALUES");
-    const Capabilities Capabilities::functionDeclarations("FUNCTION_DECLARATIONS");
-    const Capabilities Capabilities::booleanFunctions("BOOLEAN_FUNCTIONS");
-    const Capabilities Capabilities::integerFunctions("INTEGER_FUNCTIONS");
-    const Capabilities Capabilities::realFunctions("REAL_FUNCTIONS");
-    const Capabilities Capabilities::complexFunctions("COMPLEX_FUNCTIONS");
-    const Capabilities Capabilities::setFunctions("SET_FUNCTIONS");
-    const Capabilities Capabilities::tupleFunctions("TUPLE_FUNCTIONS");
-    const Capabilities Capabilities::matrixBooleanFunctions("MATRIX_BOOLEAN_FUNCTIONS");
-    const Capabilities Capabilities::matrixIntegerFunctions("MATRIX_INTEGER_FUNCTIONS");
-    const Capabilities Capabilities::matrixRealFunctions("MATRIX_REAL_FUNCTIONS");
-    const Capabilities Capabilities::matrixComplexFunctions("MATRIX_COMPLEX_FUNCTIONS");
-    const Capabilities Capabilities::numericLiterals("NUMERIC_LITERALS");
-    const Capabilities Capabilities::setLiterals("SET_LITERALS");
-    const Capabilities Capabilities::tupleLiterals("TUPLE_LITERALS");
-    const Capabilities Capabilities::matrixLiterals("MATRIX_LITERALS");
-    const Capabilities Capabilities::ranges("RANGES");
-    const Capabilities Capabilities::booleanOperators("BOOLEAN_OPERATORS");
-    const Capabilities Capabilities::integerOperators("INTEGER_OPERATORS");
-    const Capabilities Capabilities::realOperators("REAL_OPERATORS");
-    const Capabilities Capabilities::complexOperators("COMPLEX_OPERATORS");
-    const Capabilities Capabilities::setOperators("SET_OPERATORS");
-    const Capabilities Capabilities::tupleOperators("TUPLE_OPERATORS");
-    const Capabilities Capabilities::matrixBooleanOperators("MATRIX_BOOLEAN_OPERATORS");
-    const Capabilities Capabilities::matrixIntegerOperators("MATRIX_INTEGER_OPERATORS");
-    const Capabilities Capabilities::matrixRealOperators("MATRIX_REAL_OPERATORS");
-    const Capabilities Capabilities::matrixComplexOperators("MATRIX_COMPLEX_OPERATORS");
-    const Capabilities Capabilities::alphabeticSymbols("ALPHABETIC_SYMBOLS");
-    const Capabilities Capabilities::stringIdentifierSymbols("STRING_IDENTIFIER_SYMBOLS");
-    const Capabilities Capabilities::numericBinarySymbols("NUMERIC_BINARY_SYMBOLS");
-    const Capabilities Capabilities::numericDecimalSymbols("NUMERIC_DECIMAL_SYMBOLS");
-    const Capabilities Capabilities::numericHexidecimalSymbols("NUMERIC_HEXIDECIMAL_SYMBOLS");
-    const Capabilities Capabilities::numericHexidecimalBaseIdentifierSymbols(
-        "NUMERIC_HEXIDECIMAL_BASE_IDENTIFIER_SYMBOLS"
-    );
-    const Capabilities Capabilities::numericBinaryBaseIdentifierSymbols("NUMERIC_BINARY_BASE_IDENTIFIER_SYMBOLS");
-    const Capabilities Capabilities::numericImaginaryUnitSymbols("NUMERIC_IMAGINARY_UNIT_SYMBOLS");
-    const Capabilities Capabilities::numericSignSymbols("NUMERIC_SIGN_SYMBOLS");
-    const Capabilities Capabilities::numericDecimalPointSymbols("NUMERIC_DECIMAL_POINT_SYMBOLS");
-    const Capabilities Capabilities::numericExponentialSymbols("NUMERIC_EXPONENTIAL_SYMBOLS");
-    const Capabilities Capabilities::nonAsciiAlphabeticSymbols("NON_ASCII_ALPHABETIC_SYMBOLS");
-    const Capabilities Capabilities::specialSymbols("SPECIAL_SYMBOLS");
-    const Capabilities Capabilities::newLine("NEW_LINE");
-
-    const Capabilities Capabilities::expressions = (
+    unsigned Capabilities::numberAssignedPlugInBits    = 0;
+    unsigned Capabilities::currentNumberUnassignedBits = 0;
+
+    constexpr Capabilities Capabilities::selection(builtInMask(SELECTION_BIT));
+    constexpr Capabilities Capabilities::frame(builtInMask(FRAME_BIT));
+    constexpr Capabilities Capabilities::textAnnotations(builtInMask(TEXT_ANNOTATIONS_BIT));
+    constexpr Capabilities Capabilities::nonTextAnnotations(builtInMask(NON_TEXT_ANNOTATIONS_BIT));
+    constexpr Capabilities Capabilities::typeDeclaration(builtInMask(TYPE_DECLARATIONS_BIT));
+    constexpr Capabilities Capabilities::assignment(builtInMask(ASSIGNMENT_BIT));
+    constexpr Capabilities Capabilities::iterationOperator(builtInMask(ITERATION_OPERATOR_BIT));
+    constexpr Capabilities Capabilities::conditionalOperator(builtInMask(CONDITIONAL_OPERATOR_BIT));
+    constexpr Capabilities Capabilities::compoundStatementOperator(builtInMask(COMPOUND_STATEMENT_OPERATOR_BIT));
+    constexpr Capabilities Capabilities::compoundExitOperator(builtInMask(COMPOUND_EXIT_OPERATOR_BIT));
+    constexpr Capabilities Capabilities::dataTypes(builtInMask(DATA_TYPES_BIT));
+    constexpr Capabilities Capabilities::variables(builtInMask(VARIABLES_BIT));
+    constexpr Capabilities Capabilities::subscripts(builtInMask(SUBSCRIPTS_BIT));
+    constexpr Capabilities Capabilities::specialBooleanValues(builtInMask(SPECIAL_BOOLEAN_VALUES_BIT));
+    constexpr Capabilities Capabilities::specialIntegerValues(builtInMask(SPECIAL_INTEGER_VALUES_BIT));
+    constexpr Capabilities Capabilities::specialRealValues(builtInMask(SPECIAL_REAL_VALUES_BIT));
+    constexpr Capabilities Capabilities::specialComplexValues(builtInMask(SPECIAL_COMPLEX_VALUES_BIT));
+    constexpr Capabilities Capabilities::specialSetValues(builtInMask(SPECIAL_SET_VALUES_BIT));
+    constexpr Capabilities Capabilities::functionDeclarations(builtInMask(FUNCTION_DECLARATIONS_BIT));
+    constexpr Capabilities Capabilities::booleanFunctions(builtInMask(BOOLEAN_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::integerFunctions(builtInMask(INTEGER_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::realFunctions(builtInMask(REAL_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::complexFunctions(builtInMask(COMPLEX_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::setFunctions(builtInMask(SET_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::tupleFunctions(builtInMask(TUPLE_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::matrixBooleanFunctions(builtInMask(MATRIX_BOOLEAN_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::matrixIntegerFunctions(builtInMask(MATRIX_INTEGER_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::matrixRealFunctions(builtInMask(MATRIX_REAL_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::matrixComplexFunctions(builtInMask(MATRIX_COMPLEX_FUNCTIONS_BIT));
+    constexpr Capabilities Capabilities::numericLiterals(builtInMask(NUMERIC_LITERALS_BIT));
+    constexpr Capabilities Capabilities::setLiterals(builtInMask(SET_LITERALS_BIT));
+    constexpr Capabilities Capabilities::tupleLiterals(builtInMask(TUPLE_LITERALS_BIT));
+    constexpr Capabilities Capabilities::matrixLiterals(builtInMask(MATRIX_LITERALS_BIT));
+    constexpr Capabilities Capabilities::ranges(builtInMask(RANGES_BIT));
+    constexpr Capabilities Capabilities::booleanOperators(builtInMask(BOOLEAN_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::integerOperators(builtInMask(INTEGER_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::realOperators(builtInMask(REAL_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::complexOperators(builtInMask(COMPLEX_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::setOperators(builtInMask(SET_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::tupleOperators(builtInMask(TUPLE_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::matrixBooleanOperators(builtInMask(MATRIX_BOOLEAN_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::matrixIntegerOperators(builtInMask(MATRIX_INTEGER_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::matrixRealOperators(builtInMask(MATRIX_REAL_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::matrixComplexOperators(builtInMask(MATRIX_COMPLEX_OPERATORS_BIT));
+    constexpr Capabilities Capabilities::alphabeticSymbols(builtInMask(ALPHABETIC_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::stringIdentifierSymbols(builtInMask(STRING_IDENTIFIER_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericBinarySymbols(builtInMask(NUMERIC_BINARY_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericDecimalSymbols(builtInMask(NUMERIC_DECIMAL_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericHexidecimalSymbols(builtInMask(NUMERIC_HEXIDECIMAL_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericHexidecimalBaseIdentifierSymbols(
+        builtInMask(NUMERIC_HEXIDECIMAL_BASE_IDENTIFIER_SYMBOLS_BIT)
+    );
+    constexpr Capabilities Capabilities::numericBinaryBaseIdentifierSymbols(
+        builtInMask(NUMERIC_BINARY_BASE_IDENTIFIER_SYMBOLS_BIT)
+    );
+    constexpr Capabilities Capabilities::numericImaginaryUnitSymbols(builtInMask(NUMERIC_IMAGINARY_UNIT_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericSignSymbols(builtInMask(NUMERIC_SIGN_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericDecimalPointSymbols(builtInMask(NUMERIC_DECIMAL_POINT_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::numericExponentialSymbols(builtInMask(NUMERIC_EXPONENTIAL_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::nonAsciiAlphabeticSymbols(builtInMask(NON_ASCII_ALPHABETIC_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::specialSymbols(builtInMask(SPECIAL_SYMBOLS_BIT));
+    constexpr Capabilities Capabilities::newLine(builtInMask(NEW_LINE_BIT));
+
+    constexpr Capabilities Capabilities::expressions = (
           Capabilities::assignment
         | Capabilities::typeDeclaration
         | Capabilities::iterationOperator
         | Capabilities::conditionalOperator
     );
 
-    const Capabilities Capabilities::iterableLiterals = (
+    constexpr Capabilities Capabilities::iterableLiterals = (
           Capabilities::setLiterals
         | Capabilities::tupleLiterals
         | Capabilities::matrixLiterals
     );
 
-    const Capabilities Capabilities::allLiterals = (
+    constexpr Capabilities Capabilities::allLiterals = (
           Capabilities::numericLiterals
         | Capabilities::setLiterals
         | Capabilities::tupleLiterals
         | Capabilities::matrixLiterals
     );
 
-    const Capabilities Capabilities::numericOperators = (
+    constexpr Capabilities Capabilities::numericOperators = (
           Capabilities::integerOperators
         | Capabilities::realOperators
         | Capabilities::complexOperators
     );
 
-    const Capabilities Capabilities::scalarOperators = (
+    constexpr Capabilities Capabilities::scalarOperators = (
           Capabilities::booleanOperators
         | Capabilities::integerOperators
         | Capabilities::realOperators
         | Capabilities::complexOperators
     );
 
-    const Capabilities Capabilities::matrixOperators = (
+    constexpr Capabilities Capabilities::matrixOperators = (
           Capabilities::matrixBooleanOperators
         | Capabilities::matrixIntegerOperators
         | Capabilities::matrixRealOperators
         | Capabilities::matrixComplexOperators
     );
 
-    const Capabilities Capabilities::iterableOperators = (
+    constexpr Capabilities Capabilities::iterableOperators = (
           Capabilities::setOperators
         | Capabilities::tupleOperators
         | Capabilities::matrixBooleanOperators
@@ -149,12 +329,12 @@ namespace Ld {
         | Capabilities::matrixComplexOperators
     );
 
-    const Capabilities Capabilities::numericAndMatrixOperators = (
+    constexpr Capabilities Capabilities::numericAndMatrixOperators = (
           Capabilities::numericOperators
         | Capabilities::matrixOperators
     );
 
-    const Capabilities Capabilities::allOperators = (
+    constexpr Capabilities Capabilities::allOperators = (
           Capabilities::booleanOperators
         | Capabilities::integerOperators
         | Capabilities::realOperators
@@ -167,7 +347,7 @@ namespace Ld {
         | Capabilities::matrixComplexOperators
     );
 
-    const Capabilities Capabilities::allFunctions = (
+    constexpr Capabilities Capabilities::allFunctions = (
           Capabilities::booleanFunctions
         | Capabilities::integerFunctions
         | Capabilities::realFunctions
@@ -180,21 +360,21 @@ namespace Ld {
         | Capabilities::matrixComplexFunctions
     );
 
-    const Capabilities Capabilities::allScalarFunctions = (
+    constexpr Capabilities Capabilities::allScalarFunctions = (
           Capabilities::booleanFunctions
         | Capabilities::integerFunctions
         | Capabilities::realFunctions
         | Capabilities::complexFunctions
     );
 
-    const Capabilities Capabilities::allNumericFunctions = (
+    constexpr Capabilities Capabilities::allNumericFunctions = (
           Capabilities::booleanFunctions
         | Capabilities::integerFunctions
         | Capabilities::realFunctions
         | Capabilities::complexFunctions
     );
 
-    const Capabilities Capabilities::allIterableFunctions = (
+    constexpr Capabilities Capabilities::allIterableFunctions = (
           Capabilities::setFunctions
         | Capabilities::tupleFunctions
         | Capabilities::matrixBooleanFunctions
@@ -203,19 +383,19 @@ namespace Ld {
         | Capabilities::matrixComplexFunctions
     );
 
-    const Capabilities Capabilities::allMatrixFunctions = (
+    constexpr Capabilities Capabilities::allMatrixFunctions = (
           Capabilities::matrixBooleanFunctions
         | Capabilities::matrixIntegerFunctions
         | Capabilities::matrixRealFunctions
         | Capabilities::matrixComplexFunctions
     );
 
-    const Capabilities Capabilities::allLValues = (
+    constexpr Capabilities Capabilities::allLValues = (
           Capabilities::variables
         | Capabilities::subscripts
     );
 
-    const Capabilities Capabilities::allBooleanRValues = (
+    constexpr Capabilities Capabilities::allBooleanRValues = (
           Capabilities::allLValues
         | Capabilities::booleanOperators
         | Capabilities::specialBooleanValues
@@ -223,7 +403,7 @@ namespace Ld {
         | Capabilities::booleanFunctions
     );
 
-    const Capabilities Capabilities::allIntegerRValues = (
+    constexpr Capabilities Capabilities::allIntegerRValues = (
           Capabilities::allLValues
         | Capabilities::specialBooleanValues
         | Capabilities::specialIntegerValues
@@ -233,7 +413,7 @@ namespace Ld {
         | Capabilities::integerFunctions
     );
 
-    const Capabilities Capabilities::allRealRValues = (
+    constexpr Capabilities Capabilities::allRealRValues = (
           Capabilities::allLValues
         | Capabilities::specialBooleanValues
         | Capabilities::specialIntegerValues
@@ -245,7 +425,7 @@ namespace Ld {
         | Capabilities::realFunctions
     );
 
-    const Capabilities Capabilities::allComplexRValues = (
+    constexpr Capabilities Capabilities::allComplexRValues = (
           Capabilities::allLValues
         | Capabilities::specialBooleanValues
         | Capabilities::specialIntegerValues
@@ -259,7 +439,7 @@ namespace Ld {
         | Capabilities::complexFunctions
     );
 
-    const Capabilities Capabilities::allNumericRValues = (
+    constexpr Capabilities Capabilities::allNumericRValues = (
           Capabilities::allLValues
         | Capabilities::specialIntegerValues
         | Capabilities::specialRealValues
@@ -271,21 +451,21 @@ namespace Ld {
         | Capabilities::allNumericFunctions
     );
 
-    const Capabilities Capabilities::allScalarRValues = Capabilities::allComplexRValues;
+    constexpr Capabilities Capabilities::allScalarRValues = Capabilities::allComplexRValues;
 
-    const Capabilities Capabilities::allScalarAndMatrixRValues = (
+    constexpr Capabilities Capabilities::allScalarAndMatrixRValues = (
           Capabilities::allScalarRValues
         | Capabilities::matrixLiterals
         | Capabilities::matrixOperators
     );
 
-    const Capabilities Capabilities::allNumericAndMatrixRValues = (
+    constexpr Capabilities Capabilities::allNumericAndMatrixRValues = (
           Capabilities::allNumericRValues
         | Capabilities::matrixLiterals
         | Capabilities::matrixOperators
     );
 
-    const Capabilities Capabilities::allFiniteSetRValues = (
+    constexpr Capabilities Capabilities::allFiniteSetRValues = (
           Capabilities::allLValues
         | Capabilities::specialSetValues
         | Capabilities::setLiterals
@@ -293,65 +473,65 @@ namespace Ld {
         | Capabilities::setFunctions
     );
 
-    const Capabilities Capabilities::allSetRValues = (
+    constexpr Capabilities Capabilities::allSetRValues = (
           Capabilities::allLValues
         | Capabilities::allFiniteSetRValues
         | Capabilities::dataTypes
         | Capabilities::setFunctions
     );
 
-    const Capabilities Capabilities::allTupleRValues = (
+    constexpr Capabilities Capabilities::allTupleRValues = (
           Capabilities::tupleLiterals
         | Capabilities::tupleOperators
         | Capabilities::tupleFunctions
     );
 
-    const Capabilities Capabilities::allMatrixBooleanRValues = (
+    constexpr Capabilities Capabilities::allMatrixBooleanRValues = (
           Capabilities::allLValues
         | Capabilities::matrixBooleanOperators
         | Capabilities::matrixLiterals
         | Capabilities::matrixBooleanFunctions
     );
 
-    const Capabilities Capabilities::allMatrixIntegerRValues = (
+    constexpr Capabilities Capabilities::allMatrixIntegerRValues = (
           Capabilities::allLValues
         | Capabilities::matrixIntegerOperators
         | Capabilities::matrixLiterals
         | Capabilities::matrixIntegerFunctions
     );
 
-    const Capabilities Capabilities::allMatrixRealRValues = (
+    constexpr Capabilities Capabilities::allMatrixRealRValues = (
           Capabilities::allLValues
         | Capabilities::matrixRealOperators
         | Capabilities::matrixLiterals
         | Capabilities::matrixRealFunctions
     );
 
-    const Capabilities Capabilities::allMatrixComplexRValues = (
+    constexpr Capabilities Capabilities::allMatrixComplexRValues = (
           Capabilities::allLValues
         | Capabilities::matrixComplexOperators
         | Capabilities::matrixLiterals
         | Capabilities::matrixComplexFunctions
     );
 
-    const Capabilities Capabilities::allMatrixRValues = (
+    constexpr Capabilities Capabilities::allMatrixRValues = (
           Capabilities::allLValues
         | Capabilities::matrixOperators
         | Capabilities::matrixLiterals
         | Capabilities::allFunctions
     );
 
-    const Capabilities Capabilities::allFiniteSetAndTupleRValues = (
+    constexpr Capabilities Capabilities::allFiniteSetAndTupleRValues = (
           Capabilities::allFiniteSetRValues
         | Capabilities::allTupleRValues
     );
 
-    const Capabilities Capabilities::allScalarFiniteSetAndMatrixRValues = (
+    constexpr Capabilities Capabilities::allScalarFiniteSetAndMatrixRValues = (
           Capabilities::allScalarAndMatrixRValues
         | Capabilities::allFiniteSetRValues
     );
 
-    const Capabilities Capabilities::allIterableRValues = (
+    constexpr Capabilities Capabilities::allIterableRValues = (
           Capabilities::allLValues
         | Capabilities::setLiterals
         | Capabilities::tupleLiterals
@@ -362,62 +542,62 @@ namespace Ld {
         | Capabilities::allIterableFunctions
     );
 
-    const Capabilities Capabilities::allIterableAndRangeRValues = (
+    constexpr Capabilities Capabilities::allIterableAndRangeRValues = (
           Capabilities::allIterableRValues
         | Capabilities::ranges
     );
 
-    const Capabilities Capabilities::allRValues = (
+    constexpr Capabilities Capabilities::allRValues = (
           Capabilities::allLValues
         | Capabilities::allScalarAndMatrixRValues
         | Capabilities::allSetRValues
         | Capabilities::allTupleRValues
     );
 
-    const Capabilities Capabilities::allRValuesAndRanges = (
+    constexpr Capabilities Capabilities::allRValuesAndRanges = (
           Capabilities::allRValues
         | Capabilities::ranges
     );
 
-    const Capabilities Capabilities::functionDeclarationParameters = (
+    constexpr Capabilities Capabilities::functionDeclarationParameters = (
           Capabilities::variables
         | Capabilities::typeDeclaration
     );
 
-    const Capabilities Capabilities::allAssignables = (
+    constexpr Capabilities Capabilities::allAssignables = (
           Capabilities::variables
         | Capabilities::subscripts
         | Capabilities::typeDeclaration
         | Capabilities::functionDeclarations
     );
 
-    const Capabilities Capabilities::allValueAssignables = (
+    constexpr Capabilities Capabilities::allValueAssignables = (
           Capabilities::variables
         | Capabilities::subscripts
     );
 
-    const Capabilities Capabilities::allAnnotations = (
+    constexpr Capabilities Capabilities::allAnnotations = (
           Capabilities::textAnnotations
         | Capabilities::nonTextAnnotations
     );
 
-    const Capabilities Capabilities::asciiAlphanumericSymbols = (
+    constexpr Capabilities Capabilities::asciiAlphanumericSymbols = (
           Capabilities::alphabeticSymbols
         | Capabilities::numericDecimalPointSymbols
     );
 
-    const Capabilities Capabilities::allAlphabeticSymbols(
+    constexpr Capabilities Capabilities::allAlphabeticSymbols(
           Capabilities::alphabeticSymbols
         | Capabilities::nonAsciiAlphabeticSymbols
     );
 
-    const Capabilities Capabilities::allAlphanumericSymbols(
+    constexpr Capabilities Capabilities::allAlphanumericSymbols(
           Capabilities::alphabeticSymbols
         | Capabilities::numericDecimalSymbols
         | Capabilities::nonAsciiAlphabeticSymbols
     );
 
-    const Capabilities Capabilities::allSymbols(
+    constexpr Capabilities Capabilities::allSymbols(
           Capabilities::alphabeticSymbols
         | Capabilities::stringIdentifierSymbols
         | Capabilities::numericDecimalSymbols
@@ -425,29 +605,47 @@ namespace Ld {
         | Capabilities::specialSymbols
     );
 
-    Capabilities::Capabilities():Util::BitSet(&bitNameHash) {}
-
+    bool Capabilities::assignBit(const QString& bitName) {
+        bool success;
 
-    Capabilities::~Capabilities() {}
+        QHash<QString, unsigned>& bitIndexes = bitIndexesByName();
+        if (!bitIndexes.contains(bitName) && numberAssignedPlugInBits < maximumNumberPlugInBits) {
+            bitIndexes.insert(bitName, maximumNumberBuiltInBits + numberAssignedPlugInBits);
+            ++numberAssignedPlugInBits;
 
+            success = true;
+        } else {
+            success = false;
+        }
 
-    Capabilities::Capabilities(const Util::BitSet& other):BitSet(other) {
-        Q_ASSERT(tracksSameBitsAs(other));
+        return success;
     }
 
 
-    Capabilities::Capabilities(const Capabilities& other):Util::BitSet(other) {}
+    unsigned Capabilities::numberUnassignedBits() {
+        return currentNumberUnassignedBits;
+    }
 
 
-    bool Capabilities::assignBit(const QString& bitName) {
+    bool Capabilities::setBit(const QString& bitName) {
         bool success;
 
-        if (!bitNameHash.contains(bitName)) {
-            unsigned bitIndex = static_cast<unsigned>(bitNameHash.size());
-            bitNameHash.insert(bitName, bitIndex);
+        assignBit(bitName);
+
+        const QHash<QString, unsigned>& bitIndexes = bitIndexesByName();
+        QHash<QString, unsigned>::const_iterator it = bitIndexes.constFind(bitName);
+
+        if (it != bitIndexes.constEnd()) {
+            unsigned bitIndex = it.value();
+            if (bitIndex < maximumNumberBuiltInBits) {
+                currentBuiltIns |= Mask(1) << bitIndex;
+            } else {
+                currentPlugIns |= Mask(1) << (bitIndex - maximumNumberBuiltInBits);
+            }
 
             success = true;
         } else {
+            ++currentNumberUnassignedBits;
             success = false;
         }
 
@@ -28,6 +28,9 @@
 #include <QString>
 #include <QList>
 #include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
 
 #include <cassert>
 
@@ -47,7 +50,120 @@
 #include "ld_code_generator.h"
 #include "ld_code_generation_engine.h"
 
+/**
+ * The minimum number of elements we'll assign to a worker thread during parallel translation.  Smaller shards are not
+ * worth the thread hand-off.
+ */
+static constexpr unsigned minimumElementsPerShard = 64;
+
+/**
+ * Structure holding the results gathered by a worker thread during a parallel translation.
+ */
+struct ParallelTranslationResults {
+    /**
+     * The zero based index of the shard gathering these results.
+     */
+    unsigned shardIndex;
+
+    /**
+     * The diagnostics reported by the worker, in the order they were reported.
+     */
+    Ld::DiagnosticPointerList diagnostics;
+
+    /**
+     * The number of translation steps completed by the worker.
+     */
+    unsigned long numberCompletedSteps;
+};
+
+/**
+ * The results for the parallel translation being performed by the current thread.  The value is null when the thread
+ * is not performing a parallel translation.
+ */
+static thread_local ParallelTranslationResults* currentParallelResults = nullptr;
+
 namespace Ld {
+    class CodeGenerationEngine::TranslationShard:public QRunnable {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] engine     The engine performing the translation.
+             *
+             * \param[in] shardIndex The zero based index of this shard.
+             *
+             * \param[in] elements   The elements to be translated by this shard, in order.
+             */
+            TranslationShard(CodeGenerationEngine* engine, unsigned shardIndex, const ElementPointerList& elements) {
+                currentEngine                       = engine;
+                currentElements                     = elements;
+                currentSuccess                      = true;
+                currentResults.shardIndex           = shardIndex;
+                currentResults.numberCompletedSteps = 0;
+
+                setAutoDelete(false);
+            }
+
+            ~TranslationShard() override {}
+
+            /**
+             * Method that translates each element in this shard.
+             */
+            void run() override {
+                currentParallelResults = &currentResults;
+
+                for (  ElementPointerList::const_iterator it  = currentElements.constBegin(),
+                                                          end = currentElements.constEnd()
+                     ; !currentEngine->abortRequested && it != end
+                     ; ++it
+                    ) {
+                    currentSuccess = currentEngine->translateElement(*it) && currentSuccess;
+                }
+
+                currentParallelResults = nullptr;
+            }
+
+            /**
+             * Method you can use to determine if every element in this shard was translated successfully.
+             *
+             * \return Returns true on success, returns false on error.
+             */
+            bool success() const {
+                return currentSuccess;
+            }
+
+            /**
+             * Method you can use to obtain the results gathered by this shard.
+             *
+             * \return Returns a reference to the results gathered by this shard.
+             */
+            const ParallelTranslationResults& results() const {
+                return currentResults;
+            }
+
+        private:
+            /**
+             * The engine performing the translation.
+             */
+            CodeGenerationEngine* currentEngine;
+
+            /**
+             * The elements to be translated.
+             */
+            ElementPointerList currentElements;
+
+            /**
+             * Flag holding the accumulated translation status.
+             */
+            bool currentSuccess;
+
+            /**
+             * The diagnostics and step counts gathered by this shard.
+             */
+            ParallelTranslationResults currentResults;
+    };
+
+
     CodeGenerationEngine::CodeGenerationEngine(
             CodeGenerator*                          codeGenerator,
             QSharedPointer<RootElement>             rootElement,
@@ -155,14 +271,26 @@ namespace Ld {
     }
 
 
+    Translator* CodeGenerationEngine::translator(ElementPointer element) const {
+        Element::TypeId typeId = element->typeId();
+        return   typeId != Element::invalidTypeId
+               ? currentGenerator->translator(typeId)
+               : currentGenerator->translator(element->typeName()).data();
+    }
+
+
     bool CodeGenerationEngine::translateChild(ElementPointer element) {
         return translateElement(element);
     }
 
 
     void CodeGenerationEngine::translationErrorDetected(DiagnosticPointer diagnostic) {
-        currentReportedDiagnostics.append(diagnostic);
-        currentGenerator->translationErrorDetected(diagnostic);
+        if (currentParallelResults != nullptr) {
+            currentParallelResults->diagnostics.append(diagnostic);
+        } else {
+            currentReportedDiagnostics.append(diagnostic);
+            currentGenerator->translationErrorDetected(diagnostic);
+        }
     }
 
 
@@ -171,9 +299,24 @@ namespace Ld {
     }
 
 
+    int CodeGenerationEngine::parallelShardIndex() {
+        return currentParallelResults != nullptr ? static_cast<int>(currentParallelResults->shardIndex) : -1;
+    }
+
+
+    void CodeGenerationEngine::parallelTranslationStarting(unsigned) {}
+
+
+    void CodeGenerationEngine::parallelTranslationFinished(unsigned) {}
+
+
     void CodeGenerationEngine::translationStepCompleted() {
-        ++numberTranslationStepsCompleted;
-        translationStepCompleted(numberTranslationStepsCompleted);
+        if (currentParallelResults != nullptr) {
+            ++currentParallelResults->numberCompletedSteps;
+        } else {
+            ++numberTranslationStepsCompleted;
+            translationStepCompleted(numberTranslationStepsCompleted);
+        }
     }
 
 
@@ -193,7 +336,7 @@ namespace Ld {
              ; ++it
             ) {
             QSharedPointer<RootElement> root = *it;
-            numberElements += static_cast<unsigned long>(root->descendants().size()) + 1;
+            numberElements += root->numberDescendants() + 1;
         }
 
         unsigned long numberTranslationSteps = numberPerElementTranslationStepsToPerform(numberElements);
@@ -251,6 +394,12 @@ namespace Ld {
     }
 
 
+    TranslationPhase& CodeGenerationEngine::modifiableTranslationPhase() {
+        assert(currentTranslationPhase != nullptr);
+        return *currentTranslationPhase;
+    }
+
+
     void CodeGenerationEngine::advanceToNextPhase() {
         assert(currentTranslationPhase != nullptr);
         currentTranslationPhase->nextPhase();
@@ -261,10 +410,9 @@ namespace Ld {
         bool success;
 
         if (!abortRequested && !element.isNull()) {
-            QString                    elementName       = element->typeName();
-            QSharedPointer<Translator> elementTranslator = translator(elementName);
+            Translator* elementTranslator = translator(element);
 
-            if (elementTranslator.isNull()) {
+            if (elementTranslator == nullptr) {
                 if (missingTranslator(element)) {
                     success = false;
                 } else {
@@ -335,14 +483,18 @@ namespace Ld {
         if (translationMode == TranslationPhase::TranslationMode::HONOR_HEIRARCHY) {
             success = translateChild(rootElement);
         } else if (translationMode == TranslationPhase::TranslationMode::IGNORE_HEIRARCHY) {
-            success = true;
+            if (currentGenerator->parallelTranslationEnabled()) {
+                success = translateElementsInParallel(rootElement);
+            } else {
+                success = true;
 
-            RootElement::ElementIterator elementIterator    = rootElement->elementBegin();
-            RootElement::ElementIterator elementEndIterator = rootElement->elementEnd();
+                RootElement::ElementIterator elementIterator    = rootElement->elementBegin();
+                RootElement::ElementIterator elementEndIterator = rootElement->elementEnd();
 
-            while (!abortRequested && elementIterator != elementEndIterator) {
-                success = translateElement(*elementIterator) && success;
-                ++elementIterator;
+                while (!abortRequested && elementIterator != elementEndIterator) {
+                    success = translateElement(*elementIterator) && success;
+                    ++elementIterator;
+                }
             }
 
             if (success) {
@@ -357,6 +509,106 @@ namespace Ld {
     }
 
 
+    bool CodeGenerationEngine::translateElementsInParallel(QSharedPointer<RootElement> rootElement) {
+        bool               success = true;
+        ElementPointerList allElements;
+        ElementPointerList parallelElements;
+        ElementPointerList serialElements;
+
+        RootElement::ElementIterator elementIterator    = rootElement->elementBegin();
+        RootElement::ElementIterator elementEndIterator = rootElement->elementEnd();
+        while (elementIterator != elementEndIterator) {
+            ElementPointer element = *elementIterator;
+            if (!element.isNull()) {
+                Translator* elementTranslator = translator(element);
+                if (elementTranslator != nullptr && elementTranslator->threadSafe(*currentTranslationPhase)) {
+                    parallelElements.append(element);
+                } else {
+                    serialElements.append(element);
+                }
+
+                allElements.append(element);
+            }
+
+            ++elementIterator;
+        }
+
+        unsigned numberParallelElements = static_cast<unsigned>(parallelElements.size());
+        unsigned numberShards           = qMin(
+            static_cast<unsigned>(qMax(QThread::idealThreadCount(), 1)),
+            numberParallelElements / minimumElementsPerShard
+        );
+
+        if (numberShards > 1) {
+            // Translate the thread safe elements first, splitting them into contiguous shards.  The first shard runs
+            // on this thread.  Phases that ignore the heirarchy don't depend on visit order so the remaining elements
+            // can be translated afterwards.
+
+            QList<TranslationShard*> shards;
+            unsigned                 startIndex = 0;
+            for (unsigned shardIndex=0 ; shardIndex<numberShards ; ++shardIndex) {
+                unsigned endIndex = static_cast<unsigned>(
+                    (static_cast<unsigned long long>(numberParallelElements) * (shardIndex + 1)) / numberShards
+                );
+
+                shards.append(
+                    new TranslationShard(this, shardIndex, parallelElements.mid(startIndex, endIndex - startIndex))
+                );
+
+                startIndex = endIndex;
+            }
+
+            parallelTranslationStarting(numberShards);
+
+            QThreadPool threadPool;
+            threadPool.setMaxThreadCount(static_cast<int>(numberShards - 1));
+
+            for (unsigned shardIndex=1 ; shardIndex<numberShards ; ++shardIndex) {
+                threadPool.start(shards.at(shardIndex));
+            }
+
+            shards.first()->run();
+            threadPool.waitForDone();
+
+            parallelTranslationFinished(numberShards);
+
+            for (  QList<TranslationShard*>::const_iterator it = shards.constBegin(), end = shards.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                const TranslationShard*           shard   = *it;
+                const ParallelTranslationResults& results = shard->results();
+
+                for (  DiagnosticPointerList::const_iterator diagnosticIterator    = results.diagnostics.constBegin(),
+                                                             diagnosticEndIterator = results.diagnostics.constEnd()
+                     ; diagnosticIterator != diagnosticEndIterator
+                     ; ++diagnosticIterator
+                    ) {
+                    translationErrorDetected(*diagnosticIterator);
+                }
+
+                numberTranslationStepsCompleted += results.numberCompletedSteps;
+                success = shard->success() && success;
+
+                delete shard;
+            }
+
+            translationStepCompleted(numberTranslationStepsCompleted);
+        } else {
+            serialElements = allElements;
+        }
+
+        ElementPointerList::const_iterator serialIterator    = serialElements.constBegin();
+        ElementPointerList::const_iterator serialEndIterator = serialElements.constEnd();
+        while (!abortRequested && serialIterator != serialEndIterator) {
+            success = translateElement(*serialIterator) && success;
+            ++serialIterator;
+        }
+
+        return success;
+    }
+
+
     RootElement::RootElementList CodeGenerationEngine::rootElementsToProcess() {
         RootElement::RootElementList buildList =   includeRootImports()
                                                  ? currentRootElement->allDependencies()
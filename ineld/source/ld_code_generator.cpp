@@ -30,6 +30,8 @@
 #include <QByteArray>
 #include <QList>
 #include <QMap>
+#include <QHash>
+#include <QVector>
 
 #include <cassert>
 
@@ -66,6 +68,9 @@ namespace Ld {
         currentEnabledDiagnosticTypes << Diagnostic::Type::FATAL_ERROR
                                       << Diagnostic::Type::INTERNAL_ERROR
                                       << Diagnostic::Type::RUNTIME_ERROR;
+
+        currentParallelTranslationEnabled = false;
+        currentTranslatorTableStale       = true;
     }
 
 
@@ -187,6 +192,8 @@ namespace Ld {
             success = false;
         } else {
             currentTranslators.insert(elementName, translator);
+            currentTranslatorTableStale = true;
+
             success = true;
         }
 
@@ -201,6 +208,8 @@ namespace Ld {
             success = false;
         } else {
             currentTranslators.insert(elementName, QSharedPointer<Translator>(translator));
+            currentTranslatorTableStale = true;
+
             success = true;
         }
 
@@ -241,12 +250,27 @@ namespace Ld {
     }
 
 
+    Translator* CodeGenerator::translator(Element::TypeId typeId) const {
+        Translator* result;
+
+        if (!currentTranslatorTableStale && typeId < static_cast<Element::TypeId>(currentTranslatorsByTypeId.size())) {
+            result = currentTranslatorsByTypeId.at(typeId);
+        } else {
+            result = currentTranslators.value(Element::typeNameById(typeId)).data();
+        }
+
+        return result;
+    }
+
+
     bool CodeGenerator::translate(
             QSharedPointer<RootElement>             rootElement,
             const QString&                          outputFile,
             const CodeGeneratorOutputTypeContainer& outputType,
             CodeGeneratorOutputType::ExportMode     exportMode
         ) {
+        updateTranslatorTable();
+
         currentEngine = createEngine(rootElement, outputFile, outputType, exportMode, currentUsageData);
         bool success = currentEngine->translate();
 
@@ -330,6 +354,26 @@ namespace Ld {
     }
 
 
+    void CodeGenerator::setParallelTranslationEnabled(bool nowEnabled) {
+        currentParallelTranslationEnabled = nowEnabled;
+    }
+
+
+    void CodeGenerator::setParallelTranslationDisabled(bool nowDisabled) {
+        setParallelTranslationEnabled(!nowDisabled);
+    }
+
+
+    bool CodeGenerator::parallelTranslationEnabled() const {
+        return currentParallelTranslationEnabled;
+    }
+
+
+    bool CodeGenerator::parallelTranslationDisabled() const {
+        return !currentParallelTranslationEnabled;
+    }
+
+
     const DiagnosticPointerList& CodeGenerator::reportedDiagnostics() const {
         return currentEngine.isNull() ? emptyDiagnosticsList : currentEngine->reportedDiagnostics();
     }
@@ -432,4 +476,20 @@ namespace Ld {
     const CodeGenerationEngine& CodeGenerator::codeGenerationEngine() const {
         return *currentEngine;
     }
+
+
+    void CodeGenerator::updateTranslatorTable() {
+        Element::TypeId maximumTypeId = Element::maximumTypeId();
+        unsigned        tableSize     = static_cast<unsigned>(maximumTypeId) + 1;
+
+        if (currentTranslatorTableStale || static_cast<unsigned>(currentTranslatorsByTypeId.size()) != tableSize) {
+            currentTranslatorsByTypeId.fill(nullptr, static_cast<int>(tableSize));
+
+            for (Element::TypeId typeId=1 ; typeId<=maximumTypeId ; ++typeId) {
+                currentTranslatorsByTypeId[typeId] = currentTranslators.value(Element::typeNameById(typeId)).data();
+            }
+
+            currentTranslatorTableStale = false;
+        }
+    }
 }
@@ -181,6 +181,7 @@
 #include "ld_data_type.h"
 
 #include "ld_cpp_code_generator.h"
+#include "ld_cpp_declaration_pch_cache.h"
 #include "ld_cpp_variant_data_type_translator.h"
 #include "ld_cpp_boolean_data_type_translator.h"
 #include "ld_cpp_integer_data_type_translator.h"
@@ -570,6 +571,66 @@ namespace Ld {
     }
 
 
+    void Configure::setMaximumNumberThreads(unsigned newMaximumNumberThreads) {
+        QSharedPointer<CppCodeGenerator>
+            cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
+                               .dynamicCast<CppCodeGenerator>();
+
+        cppCodeGenerator->setMaximumNumberThreads(newMaximumNumberThreads);
+    }
+
+
+    unsigned Configure::maximumNumberThreads() {
+        QSharedPointer<CppCodeGenerator>
+            cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
+                               .dynamicCast<CppCodeGenerator>();
+
+        return cppCodeGenerator->maximumNumberThreads();
+    }
+
+
+    bool Configure::setObjectCacheDirectory(const QString& newDirectory) {
+        QSharedPointer<CppCodeGenerator>
+            cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
+                               .dynamicCast<CppCodeGenerator>();
+
+        return cppCodeGenerator->objectCache().setDirectory(newDirectory);
+    }
+
+
+    void Configure::setObjectCacheMaximumSize(unsigned long long newMaximumSize) {
+        QSharedPointer<CppCodeGenerator>
+            cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
+                               .dynamicCast<CppCodeGenerator>();
+
+        cppCodeGenerator->objectCache().setMaximumSize(newMaximumSize);
+    }
+
+
+    unsigned Configure::prewarmObjectCache(const QString& documentDirectory, const PlugInsByName& plugInsByName) {
+        QSharedPointer<CppCodeGenerator>
+            cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
+                               .dynamicCast<CppCodeGenerator>();
+
+        return cppCodeGenerator->prewarmObjectCache(documentDirectory, plugInsByName);
+    }
+
+
+    bool Configure::setDeclarationPchDirectory(const QString& newDirectory, const QString& compilerExecutable) {
+        QSharedPointer<CppCodeGenerator>
+            cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
+                               .dynamicCast<CppCodeGenerator>();
+
+        CppDeclarationPchCache& pchCache = cppCodeGenerator->declarationPchCache();
+        pchCache.setCompilerExecutable(compilerExecutable);
+
+        bool success = pchCache.setDirectory(newDirectory);
+        cppCodeGenerator->updateDeclarationPchFiles();
+
+        return success;
+    }
+
+
     void Configure::configureLinker(const QString& linkerPath, const QString& linkerExecutable) {
         QSharedPointer<CppCodeGenerator>
             cppCodeGenerator = Ld::CodeGenerator::codeGenerator(CppCodeGenerator::codeGeneratorName)
@@ -607,6 +668,7 @@ namespace Ld {
         cppCodeGenerator->setGccToolchain(Ld::Environment::gccPrefix());
         cppCodeGenerator->setRunTimeSearchPaths(runTimeLibrarySearchPaths);
         cppCodeGenerator->setLibrarySearchPaths(librarySearchPaths);
+        cppCodeGenerator->updateDeclarationPchFiles();
 
         #if (defined(Q_OS_WIN))
 
@@ -26,6 +26,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QList>
 
 #include <model_variant.h>
 
@@ -370,6 +371,34 @@ namespace Ld {
 
             engine.popCurrentScope();
 
+            QSharedPointer<FunctionElement>   functionElement = child0.dynamicCast<FunctionElement>();
+            QList<QList<DataType::ValueType>> specializations = engine.functionSpecializations(
+                functionElement->identifier()
+            );
+
+            unsigned numberSpecializations = static_cast<unsigned>(specializations.size());
+            for (unsigned specializationIndex=0 ; specializationIndex<numberSpecializations ; ++specializationIndex) {
+                QList<DataType> genericTypes = applySpecialization(
+                    functionElement,
+                    engine,
+                    specializations.at(specializationIndex)
+                );
+
+                insertFunctionPrototype(
+                    functionElement,
+                    engine,
+                    QString(),
+                    true,
+                    true,
+                    false,
+                    true,
+                    CppCodeGenerationEngine::functionSpecializationSuffix(specializationIndex)
+                );
+
+                engine.popCurrentScope();
+                restoreGenericTypes(functionElement, engine, genericTypes);
+            }
+
             success = true;
         } else {
             success = true;
@@ -553,6 +582,47 @@ namespace Ld {
 
             engine.popCurrentScope();
             engine.popCurrentScope();
+
+            // Each specialization repeats the function body with concrete parameter types so calls that bind to it
+            // avoid dispatching on variants.
+
+            QSharedPointer<FunctionElement>   functionElement = child0.dynamicCast<FunctionElement>();
+            QList<QList<DataType::ValueType>> specializations = engine.functionSpecializations(
+                functionElement->identifier()
+            );
+
+            unsigned numberSpecializations = static_cast<unsigned>(specializations.size());
+            for (unsigned specializationIndex=0 ; specializationIndex<numberSpecializations ; ++specializationIndex) {
+                QList<DataType> genericTypes = applySpecialization(
+                    functionElement,
+                    engine,
+                    specializations.at(specializationIndex)
+                );
+
+                success = insertFunctionPrototype(
+                    functionElement,
+                    engine,
+                    QString("ModelImpl::"),
+                    true,
+                    true,
+                    false,
+                    true,
+                    CppCodeGenerationEngine::functionSpecializationSuffix(specializationIndex)
+                ) && success;
+
+                context(element) << " {\n";
+                context.startedNewStatement();
+
+                context(element) << "return ";
+                success = engine.translateChild(child1) && success;
+
+                context.startNewStatement();
+                context(element) << "}\n";
+                context.startedNewStatement();
+
+                engine.popCurrentScope();
+                restoreGenericTypes(functionElement, engine, genericTypes);
+            }
         } else {
             if (!engine.atGlobalScope()) {
                 success = threadImplementation(element, engine);
@@ -768,19 +838,19 @@ namespace Ld {
 
                     switch (assignmentType) {
                         case AssignmentType::SIMPLE: {
-                            rightSideValueType = child1->valueType();
+                            rightSideValueType = engine.inferredValueType(child1);
                             break;
                         }
 
                         case AssignmentType::MATRIX_OR_TUPLE: {
-                            DataType::ValueType child1Type = child1->valueType();
+                            DataType::ValueType child1Type = engine.inferredValueType(child1);
                             rightSideValueType = subscriptedTypeConversion[static_cast<unsigned char>(child1Type)];
 
                             break;
                         }
 
                         case AssignmentType::MATRIX: {
-                            rightSideValueType = DataType::matrixTypeFromBaseType(child1->valueType());
+                            rightSideValueType = DataType::matrixTypeFromBaseType(engine.inferredValueType(child1));
                             break;
                         }
 
@@ -801,6 +871,7 @@ namespace Ld {
 
                         if (identifier.dataType().isInvalid()) {
                             identifier.setDataType(DataType::fromValueType(rightSideValueType));
+                            engine.inferredTypeChanged(identifier, assignmentElement);
                         } else {
                             DataType::ValueType currentValueType = identifier.dataType().valueType();
 
@@ -815,8 +886,11 @@ namespace Ld {
                                     bestUpcast = DataType::bestUpcast(currentValueType, rightSideValueType);
                                 }
 
-                                if (bestUpcast != DataType::ValueType::NONE) {
+                                if (bestUpcast == currentValueType) {
+                                    // Nothing changed, so no further inference pass is needed for this variable.
+                                } else if (bestUpcast != DataType::ValueType::NONE) {
                                     identifier->setDataType(DataType::fromValueType(bestUpcast));
+                                    engine.inferredTypeChanged(identifier, assignmentElement);
                                 } else {
                                     CppContext& context = engine.context();
 
@@ -942,10 +1016,30 @@ namespace Ld {
                 engine.popCurrentScope();
 
                 if (success) {
-                    DataType::ValueType returnType = child1->valueType();
-                    DataType dataType = DataType::fromValueType(returnType);
+                    QList<IdentifierContainer> parameters = parameterIdentifiers(functionElement, engine);
+                    QList<DataType::ValueType> genericSignature;
+
+                    for (  QList<IdentifierContainer>::const_iterator it  = parameters.constBegin(),
+                                                                      end = parameters.constEnd()
+                         ; it != end
+                         ; ++it
+                        ) {
+                        DataType parameterDataType = it->dataType();
+                        if (parameterDataType.isInvalid()) {
+                            parameterDataType = DataType::defaultDataType();
+                        }
+
+                        genericSignature.append(parameterDataType.valueType());
+                    }
 
-                    functionIdentifier->setDataType(dataType);
+                    engine.setGenericFunctionSignature(functionIdentifier, genericSignature);
+
+                    DataType::ValueType returnType = engine.inferredValueType(child1);
+                    if (returnType != DataType::ValueType::NONE                   &&
+                        returnType != functionIdentifier.dataType().valueType()    ) {
+                        functionIdentifier->setDataType(DataType::fromValueType(returnType));
+                        engine.inferredTypeChanged(functionIdentifier, assignmentElement);
+                    }
                 }
             } else {
                 CppContext& context = engine.context();
@@ -1000,7 +1094,8 @@ namespace Ld {
             bool                            includeReturnType,
             bool                            includeParameterTypes,
             bool                            includeModelImplementation,
-            bool                            includePerThread
+            bool                            includePerThread,
+            const QString&                  functionNameSuffix
         ) {
         IdentifierContainer functionIdentifier = functionElement->identifier();
         assert(functionIdentifier.isValid()); // The identifier should already exist.
@@ -1025,7 +1120,11 @@ namespace Ld {
             context(functionElement) << QString("%1 ").arg(returnTypeString);
         }
 
-        context(functionElement) << QString("%2%3(").arg(additionalFunctionPrefix, functionInternalName);
+        context(functionElement) << QString("%2%3%4(").arg(
+            additionalFunctionPrefix,
+            functionInternalName,
+            functionNameSuffix
+        );
 
         engine.pushNewScope(functionElement);
         bool success = insertFunctionParameters(
@@ -1131,4 +1230,82 @@ namespace Ld {
 
         return true;
     }
+
+
+    QList<IdentifierContainer> CppAssignmentOperatorTranslator::parameterIdentifiers(
+            QSharedPointer<FunctionElement> functionElement,
+            CppCodeGenerationEngine&        engine
+        ) {
+        QList<IdentifierContainer> result;
+
+        unsigned long numberParameters = functionElement->numberChildren();
+        for (unsigned long parameterIndex=0 ; parameterIndex<numberParameters ; ++parameterIndex) {
+            ElementPointer parameter = functionElement->child(parameterIndex);
+            if (!parameter.isNull() && !parameter->isPlaceholder()) {
+                AssignmentType      assignmentType;
+                DataType::ValueType valueType;
+                ElementPointer      variable = parseLeftChild(parameter, engine, assignmentType, valueType);
+
+                if (!variable.isNull()) {
+                    result.append(engine.identifier(variable->text(0), variable->text(1), functionElement));
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    QList<DataType> CppAssignmentOperatorTranslator::applySpecialization(
+            QSharedPointer<FunctionElement>   functionElement,
+            CppCodeGenerationEngine&          engine,
+            const QList<DataType::ValueType>& parameterTypes
+        ) {
+        QList<DataType>            genericTypes;
+        QList<IdentifierContainer> parameters = parameterIdentifiers(functionElement, engine);
+        assert(parameters.size() == parameterTypes.size());
+
+        unsigned numberParameters = static_cast<unsigned>(parameters.size());
+        for (unsigned parameterIndex=0 ; parameterIndex<numberParameters ; ++parameterIndex) {
+            IdentifierContainer parameter = parameters.at(parameterIndex);
+
+            genericTypes.append(parameter.dataType());
+            parameter.setDataType(DataType::fromValueType(parameterTypes.at(parameterIndex)));
+        }
+
+        // The return type follows from the body once the parameters have their specialized types.
+
+        IdentifierContainer functionIdentifier = functionElement->identifier();
+        genericTypes.append(functionIdentifier.dataType());
+
+        ElementPointer assignmentElement = functionElement->parent();
+        ElementPointer body              = assignmentElement.isNull() ? ElementPointer() : assignmentElement->child(1);
+        if (!body.isNull()) {
+            DataType::ValueType returnType = body->valueType();
+            if (returnType != DataType::ValueType::NONE) {
+                functionIdentifier.setDataType(DataType::fromValueType(returnType));
+            }
+        }
+
+        return genericTypes;
+    }
+
+
+    void CppAssignmentOperatorTranslator::restoreGenericTypes(
+            QSharedPointer<FunctionElement> functionElement,
+            CppCodeGenerationEngine&        engine,
+            const QList<DataType>&          genericTypes
+        ) {
+        QList<IdentifierContainer> parameters = parameterIdentifiers(functionElement, engine);
+        assert(parameters.size() + 1 == genericTypes.size());
+
+        unsigned numberParameters = static_cast<unsigned>(parameters.size());
+        for (unsigned parameterIndex=0 ; parameterIndex<numberParameters ; ++parameterIndex) {
+            IdentifierContainer parameter = parameters.at(parameterIndex);
+            parameter.setDataType(genericTypes.at(parameterIndex));
+        }
+
+        IdentifierContainer functionIdentifier = functionElement->identifier();
+        functionIdentifier.setDataType(genericTypes.last());
+    }
 }
@@ -35,6 +35,7 @@
 #include "ld_cpp_code_generator_diagnostic.h"
 #include "ld_cpp_context.h"
 #include "ld_cpp_translator.h"
+#include "ld_cpp_elementwise_fusion.h"
 #include "ld_cpp_binary_function_operator_translator_base.h"
 
 namespace Ld {
@@ -52,7 +53,9 @@ namespace Ld {
         ElementPointer child0 = element->child(0);
         ElementPointer child1 = element->child(1);
 
-        if (!child0.isNull() || !child1.isNull()) {
+        if (CppElementwiseFusion::isFusionRoot(element, engine)) {
+            success = CppElementwiseFusion::translate(element, engine);
+        } else if (!child0.isNull() || !child1.isNull()) {
             context(element) << QString("%1((").arg(cppFunction());
             engine.translateChild(child0);
             context(element) << "),(";
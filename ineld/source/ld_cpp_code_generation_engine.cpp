@@ -32,8 +32,19 @@
 #include <QTemporaryFile>
 #include <QFile>
 #include <QSemaphore>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QPair>
+#include <QWeakPointer>
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QStringList>
+#include <QCryptographicHash>
 
 #include <cassert>
+#include <algorithm>
 
 #include <model_api.h>
 #include <model_status.h>
@@ -49,7 +60,14 @@
 #include "ld_environment.h"
 #include "ld_element_structures.h"
 #include "ld_element.h"
+#include "ld_element_iterator.h"
 #include "ld_root_element.h"
+#include "ld_variable_element.h"
+#include "ld_function_element.h"
+#include "ld_plot_element.h"
+#include "ld_variable_name.h"
+#include "ld_function_data.h"
+#include "ld_function_database.h"
 #include "ld_code_generator_output_type.h"
 #include "ld_code_generator_output_type_container.h"
 #include "ld_translation_phase.h"
@@ -58,6 +76,8 @@
 #include "ld_code_generator.h"
 #include "ld_cpp_code_generator.h"
 #include "ld_cpp_context.h"
+#include "ld_cpp_object_cache.h"
+#include "ld_cpp_parallel_loop.h"
 #include "ld_cpp_declaration_payload.h"
 #include "ld_cpp_library_information.h"
 #include "ld_cpp_library_dependencies.h"
@@ -76,6 +96,70 @@
 #include "ld_code_generation_engine.h"
 #include "ld_cpp_code_generation_engine.h"
 
+/**
+ * Function that locates the representative of a group in a disjoint set, compressing the path as it goes.
+ *
+ * \param[in,out] parents The parent index of each entry in the disjoint set.
+ *
+ * \param[in]     index   The index of the entry to locate the group for.
+ *
+ * \return Returns the index of the entry representing the group.
+ */
+static unsigned findGroup(QVector<unsigned>& parents, unsigned index) {
+    while (parents.at(index) != index) {
+        parents[index] = parents.at(parents.at(index));
+        index          = parents.at(index);
+    }
+
+    return index;
+}
+
+
+/**
+ * Function that merges the groups holding two entries of a disjoint set.  The group with the lower index is kept.
+ *
+ * \param[in,out] parents The parent index of each entry in the disjoint set.
+ *
+ * \param[in]     index1  The index of the first entry.
+ *
+ * \param[in]     index2  The index of the second entry.
+ */
+static void mergeGroups(QVector<unsigned>& parents, unsigned index1, unsigned index2) {
+    unsigned group1 = findGroup(parents, index1);
+    unsigned group2 = findGroup(parents, index2);
+    if (group1 != group2) {
+        parents[qMax(group1, group2)] = qMin(group1, group2);
+    }
+}
+
+
+/**
+ * Function that determines if a function call has effects outside the model, such as reading or writing files.
+ * Calls to plug-in and external user-defined functions are assumed to have such effects.
+ *
+ * \param[in] functionElement The function element making the call.
+ *
+ * \return Returns true if the call must stay in program order with other such calls.
+ */
+static bool externalEffects(Ld::ElementPointer functionElement) {
+    const Ld::FunctionData& functionData = Ld::FunctionDatabase::function(
+        Ld::VariableName(functionElement->text(0), functionElement->text(1))
+    );
+
+    bool result = false;
+    if (functionData.isValid()) {
+        const QString& internalName = functionData.internalName();
+        result = (
+               functionData.functionType() != Ld::FunctionData::Type::BUILT_IN
+            || internalName.startsWith(QString("M::file"))
+            || internalName.startsWith(QString("M::load"))
+            || internalName.startsWith(QString("M::save"))
+        );
+    }
+
+    return result;
+}
+
 namespace Ld {
     const QString CppCodeGenerationEngine::modelAllocatorFunctionName(Model::allocatorFunctionName);
     const QString CppCodeGenerationEngine::modelDeallocatorFunctionName(Model::deallocatorFunctionName);
@@ -126,6 +210,41 @@ namespace Ld {
         parentScopeForcedStack.append(true);
 
         currentAsLValue = false;
+
+        const CppCodeGenerator* cppCodeGenerator = dynamic_cast<const CppCodeGenerator*>(codeGenerator);
+        currentMaximumNumberThreads = cppCodeGenerator != nullptr ? cppCodeGenerator->maximumNumberThreads() : 1;
+
+        if (cppCodeGenerator != nullptr) {
+            currentReleaseProfile = (
+                cppCodeGenerator->optimizationProfile() == CppCodeGenerator::OptimizationProfile::RELEASE
+            );
+
+            currentReleaseCheckpointInterval      = cppCodeGenerator->releaseCheckpointInterval();
+            currentMaximumFunctionSpecializations = cppCodeGenerator->maximumFunctionSpecializations();
+            currentElementwiseFusionEnabled       = cppCodeGenerator->elementwiseFusionEnabled();
+            currentParallelLoopsEnabled           = cppCodeGenerator->parallelLoopsEnabled();
+            currentExpressionOptimizer.setEnabled(cppCodeGenerator->expressionOptimizationEnabled());
+        } else {
+            currentReleaseProfile                 = false;
+            currentReleaseCheckpointInterval      = 0;
+            currentMaximumFunctionSpecializations = CppCodeGenerator::defaultMaximumFunctionSpecializations;
+            currentElementwiseFusionEnabled       = true;
+            currentParallelLoopsEnabled           = false;
+        }
+
+        currentOperationsSinceCheckpoint = 0;
+        currentProfilingEnabled          = cppCodeGenerator != nullptr && cppCodeGenerator->profilingEnabled();
+
+        currentTypeInferenceReportEnabled = (
+               cppCodeGenerator != nullptr
+            && cppCodeGenerator->typeInferenceReportEnabled()
+        );
+
+        currentInferencePass            = 0;
+        currentDeferringUnresolvedTypes = true;
+        currentInferredTypesChanged     = false;
+
+        currentUsingCachedModel = false;
     }
 
 
@@ -147,10 +266,16 @@ namespace Ld {
 
     void CppCodeGenerationEngine::dependsOnLibrary(const QString& libraryName) {
         if (!requiredLibraries.contains(libraryName)) {
-            CppDeclarationPayload declarationPayload = CppDeclarationPayload::payload(libraryName);
-            if (declarationPayload.isValid()) {
-                QByteArray declaration = declarationPayload.payload();
-                *currentContext << QString::fromUtf8(declaration);
+            const CppCodeGenerator& cppCodeGenerator = dynamic_cast<const CppCodeGenerator&>(codeGenerator());
+
+            // Declarations supplied by a precompiled header are already visible through the standard PCH files.
+
+            if (!cppCodeGenerator.declarationPchAvailable(libraryName)) {
+                CppDeclarationPayload declarationPayload = CppDeclarationPayload::payload(libraryName);
+                if (declarationPayload.isValid()) {
+                    QByteArray declaration = declarationPayload.payload();
+                    *currentContext << QString::fromUtf8(declaration);
+                }
             }
 
             requiredLibraries.insert(libraryName);
@@ -159,20 +284,8 @@ namespace Ld {
 
 
     bool CppCodeGenerationEngine::insertOperationCheckpoint(ElementPointer element) {
-        bool                        result = false;
-        QSharedPointer<RootElement> root   = element->root().dynamicCast<RootElement>();
-
-        if (!root.isNull()) {
-            Operation operation = root->operationDatabase().createOperation(element);
-            if (operation.isValid()) {
-                currentContext->startNewStatement();
-                (*currentContext) << QString("{ c(pt, %1); } ").arg(operation.handle());
-                currentContext->startedNewStatement();
-                result = true;
-            }
-        }
-
-        return result;
+        QString checkpointCall = operationCheckpointRequired(element) ? QString("c(pt, %1);") : QString();
+        return insertOperationCheckpointCode(element, checkpointCall);
     }
 
 
@@ -180,23 +293,12 @@ namespace Ld {
             ElementPointer     element,
             Identifier::Handle identifierHandle
         ) {
-        bool                        result = false;
-        QSharedPointer<RootElement> root   = element->root().dynamicCast<RootElement>();
-
-        if (!root.isNull()) {
-            Operation operation = root->operationDatabase().createOperation(element);
-            if (operation.isValid()) {
-                currentContext->startNewStatement();
-                (*currentContext) << QString("{ c(pt, %1, %2); } ")
-                                     .arg(operation.handle())
-                                     .arg(identifierHandle);
-                currentContext->startedNewStatement();
-
-                result = true;
-            }
+        QString checkpointCall;
+        if (operationCheckpointRequired(element)) {
+            checkpointCall = QString("c(pt, %1, ") + QString::number(identifierHandle) + QString(");");
         }
 
-        return result;
+        return insertOperationCheckpointCode(element, checkpointCall);
     }
 
 
@@ -376,9 +478,135 @@ namespace Ld {
     }
 
 
+    bool CppCodeGenerationEngine::elementwiseFusionEnabled() const {
+        return currentElementwiseFusionEnabled;
+    }
+
+
+    bool CppCodeGenerationEngine::parallelLoopsEnabled() const {
+        return (
+               currentParallelLoopsEnabled
+            && currentReleaseProfile
+            && currentReleaseCheckpointInterval == 0
+            && !currentProfilingEnabled
+        );
+    }
+
+
+    const QList<ElementPointerList>& CppCodeGenerationEngine::threadPartitions() const {
+        return currentThreadPartitions;
+    }
+
+
+    bool CppCodeGenerationEngine::inCurrentThread(ElementPointer element) const {
+        bool                       result;
+        const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(translationPhase());
+        unsigned                   threadId            = cppTranslationPhase.threadId();
+
+        if (element.isNull() || element->parent().isNull()) {
+            result = (threadId == 0);
+        } else {
+            ElementPointer topLevelElement = element;
+            ElementPointer parent          = element->parent();
+            while (!parent->parent().isNull()) {
+                topLevelElement = parent;
+                parent          = parent->parent();
+            }
+
+            result = (currentThreadsByTopLevelElement.value(topLevelElement, 0) == threadId);
+        }
+
+        return result;
+    }
+
+
+    DataType::ValueType CppCodeGenerationEngine::inferredValueType(ElementPointer element) const {
+        DataType::ValueType result;
+
+        if (currentDeferringUnresolvedTypes && dependsOnUnresolvedType(element)) {
+            result = DataType::ValueType::NONE;
+        } else {
+            result = element->valueType();
+        }
+
+        return result;
+    }
+
+
+    void CppCodeGenerationEngine::inferredTypeChanged(
+            const IdentifierContainer& identifier,
+            ElementPointer             sourceElement
+        ) {
+        currentInferredTypesChanged = true;
+
+        if (identifier.dataType().valueType() == DataType::ValueType::VARIANT &&
+            !currentVariantSources.contains(identifier)                          ) {
+            currentVariantSources.insert(identifier, sourceElement);
+        }
+    }
+
+
+    void CppCodeGenerationEngine::setGenericFunctionSignature(
+            const IdentifierContainer&                        function,
+            const CppCodeGenerationEngine::FunctionSignature& parameterTypes
+        ) {
+        currentGenericFunctionSignatures.insert(function, parameterTypes);
+    }
+
+
+    CppCodeGenerationEngine::FunctionSignature CppCodeGenerationEngine::genericFunctionSignature(
+            const IdentifierContainer& function
+        ) const {
+        return currentGenericFunctionSignatures.value(function);
+    }
+
+
+    bool CppCodeGenerationEngine::addFunctionSpecialization(
+            const IdentifierContainer&                        function,
+            const CppCodeGenerationEngine::FunctionSignature& parameterTypes
+        ) {
+        bool                      result;
+        QList<FunctionSignature>& specializations = currentFunctionSpecializations[function];
+
+        if (specializations.contains(parameterTypes)) {
+            result = true;
+        } else if (static_cast<unsigned>(specializations.size()) < currentMaximumFunctionSpecializations) {
+            specializations.append(parameterTypes);
+            result = true;
+        } else {
+            result = false;
+        }
+
+        return result;
+    }
+
+
+    QList<CppCodeGenerationEngine::FunctionSignature> CppCodeGenerationEngine::functionSpecializations(
+            const IdentifierContainer& function
+        ) const {
+        return currentFunctionSpecializations.value(function);
+    }
+
+
+    int CppCodeGenerationEngine::functionSpecializationIndex(
+            const IdentifierContainer&                        function,
+            const CppCodeGenerationEngine::FunctionSignature& parameterTypes
+        ) const {
+        QHash<IdentifierContainer, QList<FunctionSignature>>::const_iterator
+            it = currentFunctionSpecializations.constFind(function);
+
+        return it != currentFunctionSpecializations.constEnd() ? it.value().indexOf(parameterTypes) : -1;
+    }
+
+
+    QString CppCodeGenerationEngine::functionSpecializationSuffix(unsigned specializationIndex) {
+        return QString("_S%1").arg(specializationIndex);
+    }
+
+
     TranslationPhase* CppCodeGenerationEngine::createTranslationPhase() const {
         bool generateDynamicLibrary = outputType().applicationLoadable();
-        return new CppTranslationPhase(generateDynamicLibrary);
+        return new CppTranslationPhase(generateDynamicLibrary, currentMaximumNumberThreads);
     }
 
 
@@ -390,109 +618,114 @@ namespace Ld {
     bool CppCodeGenerationEngine::preTranslate() {
         bool                       success;
         const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(translationPhase());
-        switch(cppTranslationPhase.phase()) {
-            case CppTranslationPhase::Phase::IDENTIFY_DEPENDENCIES_AND_EXPLICIT_TYPES: {
-                success = preIdentifyDependenciesAndExplicitTypes();
-                break;
-            }
 
-            case CppTranslationPhase::Phase::IDENTIFY_INFERRED_TYPES: {
-                success = preIdentifyInferredTypes();
-                break;
-            }
+        if (currentUsingCachedModel) {
+            success = true;
+        } else {
+            switch(cppTranslationPhase.phase()) {
+                case CppTranslationPhase::Phase::IDENTIFY_DEPENDENCIES_AND_EXPLICIT_TYPES: {
+                    success = preIdentifyDependenciesAndExplicitTypes();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::DECLARATIONS: {
-                success = preDeclarations();
-                break;
-            }
+                case CppTranslationPhase::Phase::IDENTIFY_INFERRED_TYPES: {
+                    success = preIdentifyInferredTypes();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::MODEL_CLASS_DECLARATION: {
-                success = preModelClassDeclaration();
-                break;
-            }
+                case CppTranslationPhase::Phase::DECLARATIONS: {
+                    success = preDeclarations();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::METHOD_DECLARATIONS: {
-                success = preMethodDeclarations();
-                break;
-            }
+                case CppTranslationPhase::Phase::MODEL_CLASS_DECLARATION: {
+                    success = preModelClassDeclaration();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::CLASS_SCOPE_VARIABLES: {
-                success = preClassScopeVariables();
-                break;
-            }
+                case CppTranslationPhase::Phase::METHOD_DECLARATIONS: {
+                    success = preMethodDeclarations();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::END_MODEL_CLASS_DECLARATION: {
-                success = preEndModelClassDeclaration();
-                break;
-            }
+                case CppTranslationPhase::Phase::CLASS_SCOPE_VARIABLES: {
+                    success = preClassScopeVariables();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::THREAD_DEFINITION: {
-                success = preThreadDefinition();
-                break;
-            }
+                case CppTranslationPhase::Phase::END_MODEL_CLASS_DECLARATION: {
+                    success = preEndModelClassDeclaration();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::THREAD_LOCALS: {
-                success = preThreadLocals();
-                break;
-            }
+                case CppTranslationPhase::Phase::THREAD_DEFINITION: {
+                    success = preThreadDefinition();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::THREAD_IMPLEMENTATION: {
-                success = preThreadImplementation();
-                break;
-            }
+                case CppTranslationPhase::Phase::THREAD_LOCALS: {
+                    success = preThreadLocals();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::THREAD_POST_PROCESSING: {
-                success = preThreadPostProcessing();
-                break;
-            }
+                case CppTranslationPhase::Phase::THREAD_IMPLEMENTATION: {
+                    success = preThreadImplementation();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::THREAD_CLEANUP: {
-                success = preThreadCleanup();
-                break;
-            }
+                case CppTranslationPhase::Phase::THREAD_POST_PROCESSING: {
+                    success = preThreadPostProcessing();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::THREAD_END: {
-                success = preThreadEnd();
-                break;
-            }
+                case CppTranslationPhase::Phase::THREAD_CLEANUP: {
+                    success = preThreadCleanup();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::METHOD_DEFINITIONS: {
-                success = preMethodDefinitions();
-                break;
-            }
+                case CppTranslationPhase::Phase::THREAD_END: {
+                    success = preThreadEnd();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::BOOKKEEPING_DEFINITION: {
-                success = preBookkeepingDefinition();
-                break;
-            }
+                case CppTranslationPhase::Phase::METHOD_DEFINITIONS: {
+                    success = preMethodDefinitions();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::MODEL_ALLOCATOR: {
-                success = preModelAllocator();
-                break;
-            }
+                case CppTranslationPhase::Phase::BOOKKEEPING_DEFINITION: {
+                    success = preBookkeepingDefinition();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::CONVERT_IR_TO_OBJECT: {
-                success = preConvertIrToObject();
-                break;
-            }
+                case CppTranslationPhase::Phase::MODEL_ALLOCATOR: {
+                    success = preModelAllocator();
+                    break;
+                }
 
-            case CppTranslationPhase::Phase::LINK: {
-                success = preLink();
-                break;
-            }
+                case CppTranslationPhase::Phase::CONVERT_IR_TO_OBJECT: {
+                    success = preConvertIrToObject();
+                    break;
+                }
 
-            default: {
-                CppCodeGeneratorDiagnostic* diagnostic = new CppCodeGeneratorDiagnostic(
-                    nullptr,
-                    CppCodeGeneratorDiagnostic::Type::INTERNAL_ERROR,
-                    cppTranslationPhase,
-                    CppCodeGeneratorDiagnostic::Code::UNEXPECTED_TRANSLATION_PHASE
-                );
+                case CppTranslationPhase::Phase::LINK: {
+                    success = preLink();
+                    break;
+                }
 
-                translationErrorDetected(diagnostic);
-                success = false;
+                default: {
+                    CppCodeGeneratorDiagnostic* diagnostic = new CppCodeGeneratorDiagnostic(
+                        nullptr,
+                        CppCodeGeneratorDiagnostic::Type::INTERNAL_ERROR,
+                        cppTranslationPhase,
+                        CppCodeGeneratorDiagnostic::Code::UNEXPECTED_TRANSLATION_PHASE
+                    );
 
-                break;
+                    translationErrorDetected(diagnostic);
+                    success = false;
+
+                    break;
+                }
             }
         }
 
@@ -501,7 +734,50 @@ namespace Ld {
 
 
     bool CppCodeGenerationEngine::postTranslate() {
-        return true;
+        bool success = true;
+
+        if (!currentUsingCachedModel) {
+            const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(
+                translationPhase()
+            );
+
+            if (cppTranslationPhase.phase() == CppTranslationPhase::Phase::IDENTIFY_INFERRED_TYPES) {
+                success = postIdentifyInferredTypes();
+            } else if (cppTranslationPhase.lastPhase()) {
+                storeCachedModel();
+            }
+        }
+
+        return success;
+    }
+
+
+    bool CppCodeGenerationEngine::translateElement(ElementPointer element) {
+        bool                       success;
+        const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(translationPhase());
+        CppTranslationPhase::Phase phase               = cppTranslationPhase.phase();
+
+        if (currentUsingCachedModel) {
+            translationStepCompleted();
+            success = true;
+        } else if (   phase >= CppTranslationPhase::Phase::THREAD_DEFINITION
+                   && phase <= CppTranslationPhase::Phase::THREAD_END
+                   && !element.isNull()
+                   && !element->parent().isNull()
+                   && !inCurrentThread(element)) {
+            success = true;
+        } else if (   (   phase == CppTranslationPhase::Phase::THREAD_IMPLEMENTATION
+                       || phase == CppTranslationPhase::Phase::METHOD_DEFINITIONS)
+                   && currentExpressionOptimizer.replaces(element)) {
+            success = currentExpressionOptimizer.translate(element, *this);
+            if (success) {
+                translationStepCompleted();
+            }
+        } else {
+            success = CodeGenerationEngine::translateElement(element);
+        }
+
+        return success;
     }
 
 
@@ -509,13 +785,232 @@ namespace Ld {
         requiredHeaders.clear();
         requiredLibraries.clear();
 
-        rootElement()->identifierDatabase().clear();
+        // A cache hit leaves the identifier database untouched; it still describes the unchanged model.
+        currentUsingCachedModel = restoreCachedModel();
+        if (!currentUsingCachedModel) {
+            rootElement()->identifierDatabase().clear();
+        }
+
+        currentExpressionOptimizer.clear();
+
+        currentInferencePass = 0;
 
         return true;
     }
 
 
+    bool CppCodeGenerationEngine::operationCheckpointRequired(ElementPointer element) {
+        bool required;
+
+        if (!currentReleaseProfile) {
+            required = true;
+        } else if (element->instructionBreakpointSet()) {
+            required                         = true;
+            currentOperationsSinceCheckpoint = 0;
+        } else if (currentReleaseCheckpointInterval > 0) {
+            ++currentOperationsSinceCheckpoint;
+            if (currentOperationsSinceCheckpoint >= currentReleaseCheckpointInterval) {
+                required                         = true;
+                currentOperationsSinceCheckpoint = 0;
+            } else {
+                required = false;
+            }
+        } else {
+            required = false;
+        }
+
+        return required;
+    }
+
+
+    bool CppCodeGenerationEngine::insertOperationCheckpointCode(
+            ElementPointer element,
+            const QString& checkpointCall
+        ) {
+        bool result = false;
+
+        if (checkpointCall.isEmpty() && !currentProfilingEnabled) {
+            currentContext->startNewStatement();
+            result = true;
+        } else {
+            QSharedPointer<RootElement> root = element->root().dynamicCast<RootElement>();
+            if (!root.isNull()) {
+                // Function specializations translate the body again.  Those copies report against the operation
+                // created for the generic body so profiles and breakpoints cover every copy.
+
+                OperationDatabase& operationDatabase = root->operationDatabase();
+                Operation          operation         = operationDatabase.createOperation(element);
+                if (!operation.isValid()) {
+                    operation = operationDatabase.fromElement(element);
+                }
+
+                if (operation.isValid()) {
+                    QString code;
+                    if (currentProfilingEnabled) {
+                        code = QString("LdProfile::record(%1); ").arg(operation.handle());
+                    }
+
+                    if (!checkpointCall.isEmpty()) {
+                        code += checkpointCall.arg(operation.handle());
+                    }
+
+                    currentContext->startNewStatement();
+                    (*currentContext) << QString("{ %1 } ").arg(code);
+                    currentContext->startedNewStatement();
+
+                    result = true;
+                }
+            }
+        }
+
+        if (result) {
+            // Temporaries follow the checkpoint so errors computing them are reported against this statement.
+            result = currentExpressionOptimizer.computeTemporaries(element, *this);
+        }
+
+        return result;
+    }
+
+
     bool CppCodeGenerationEngine::preIdentifyInferredTypes() {
+        if (currentInferencePass == 0) {
+            currentDeferringUnresolvedTypes = true;
+            currentVariantSources.clear();
+
+            emitRuntimeLibrarySymbols();
+        }
+
+        // Call sites request specializations on every pass.  Only the requests made once types have settled are
+        // kept so that types seen on earlier passes do not use up the specialization budget.
+        currentFunctionSpecializations.clear();
+
+        currentInferredTypesChanged = false;
+        currentContext->startedNewStatement();
+
+        return true;
+    }
+
+
+    bool CppCodeGenerationEngine::postIdentifyInferredTypes() {
+        bool repeat = false;
+
+        ++currentInferencePass;
+        if (currentInferencePass < maximumInferencePasses) {
+            if (currentInferredTypesChanged) {
+                repeat = true;
+            } else if (currentDeferringUnresolvedTypes) {
+                // Types have settled.  Any variables still unresolved only depend on each other so we make one more
+                // pass letting them fall back to the default type.
+                currentDeferringUnresolvedTypes = false;
+
+                QList<IdentifierContainer>                 identifiers = currentIdentifierDatabase.identifiers();
+                QList<IdentifierContainer>::const_iterator it          = identifiers.constBegin();
+                QList<IdentifierContainer>::const_iterator end         = identifiers.constEnd();
+                while (!repeat && it != end) {
+                    repeat = unresolvedVariable(*it);
+                    ++it;
+                }
+            }
+        }
+
+        if (repeat) {
+            dynamic_cast<CppTranslationPhase&>(modifiableTranslationPhase()).repeatPhase();
+        } else if (currentTypeInferenceReportEnabled) {
+            reportVariantVariables();
+        }
+
+        return true;
+    }
+
+
+    bool CppCodeGenerationEngine::dependsOnUnresolvedType(ElementPointer element) {
+        bool result = false;
+
+        if (!element.isNull()) {
+            QString typeName = element->typeName();
+            if (typeName == VariableElement::elementName) {
+                result = unresolvedVariable(element.dynamicCast<VariableElement>()->identifier());
+            } else if (typeName == FunctionElement::elementName) {
+                IdentifierContainer functionIdentifier = element.dynamicCast<FunctionElement>()->identifier();
+                result = functionIdentifier.isValid() && functionIdentifier.dataType().isInvalid();
+            }
+
+            unsigned long numberChildren = element->numberChildren();
+            unsigned long childIndex     = 0;
+            while (!result && childIndex < numberChildren) {
+                result = dependsOnUnresolvedType(element->child(childIndex));
+                ++childIndex;
+            }
+        }
+
+        return result;
+    }
+
+
+    bool CppCodeGenerationEngine::unresolvedVariable(const IdentifierContainer& identifier) {
+        bool result = false;
+
+        if (identifier.isValid() && identifier.dataType().isInvalid()) {
+            Identifier::DefinedAs definedAs = identifier.definedAs();
+            result = (
+                   definedAs == Identifier::DefinedAs::GLOBAL_SCOPE_VARIABLE
+                || definedAs == Identifier::DefinedAs::LOCAL_SCOPE_VARIABLE
+            );
+        }
+
+        return result;
+    }
+
+
+    void CppCodeGenerationEngine::reportVariantVariables() {
+        const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(translationPhase());
+        bool defaultIsVariant = (DataType::defaultDataType().valueType() == DataType::ValueType::VARIANT);
+
+        QList<IdentifierContainer> identifiers = currentIdentifierDatabase.identifiers();
+        for (  QList<IdentifierContainer>::const_iterator it  = identifiers.constBegin(),
+                                                          end = identifiers.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            const IdentifierContainer& identifier = *it;
+            Identifier::DefinedAs      definedAs  = identifier.definedAs();
+
+            if ((definedAs == Identifier::DefinedAs::GLOBAL_SCOPE_VARIABLE ||
+                 definedAs == Identifier::DefinedAs::LOCAL_SCOPE_VARIABLE     ) &&
+                !identifier.typeExplicitlySet()                                   ) {
+                CppCodeGeneratorDiagnostic::Code code     = CppCodeGeneratorDiagnostic::Code::NO_DIAGNOSTIC;
+                ElementPointer                   element  = identifier.primaryElement();
+                DataType                         dataType = identifier.dataType();
+
+                if (dataType.isInvalid()) {
+                    if (defaultIsVariant) {
+                        code = CppCodeGeneratorDiagnostic::Code::VARIABLE_TYPE_NOT_INFERRED;
+                    }
+                } else if (dataType.valueType() == DataType::ValueType::VARIANT) {
+                    code    = CppCodeGeneratorDiagnostic::Code::VARIABLE_INFERRED_AS_VARIANT;
+                    element = currentVariantSources.value(identifier, element);
+                }
+
+                if (code != CppCodeGeneratorDiagnostic::Code::NO_DIAGNOSTIC) {
+                    QString text2 = identifier.text2();
+                    QString name  = text2.isEmpty() ? identifier.text1() : identifier.text1() + "_" + text2;
+
+                    translationErrorDetected(
+                        new CppCodeGeneratorDiagnostic(
+                            element,
+                            CppCodeGeneratorDiagnostic::Type::WARNING,
+                            cppTranslationPhase,
+                            code,
+                            name
+                        )
+                    );
+                }
+            }
+        }
+    }
+
+
+    void CppCodeGenerationEngine::emitRuntimeLibrarySymbols() {
         #if (defined(Q_OS_WIN))
 
             // Block below is required on Windows using the Visual Studion 2017 libcpmt library to get around a new
@@ -536,19 +1031,88 @@ namespace Ld {
                             << "}\n";
 
         #endif
-
-        currentContext->startedNewStatement();
-
-        return true;
     }
 
 
     bool CppCodeGenerationEngine::preDeclarations() {
+        if (currentProfilingEnabled) {
+            // Each thread records operation checkpoints into a thread local ring buffer.  Full buffers are folded
+            // into the per-operation totals defined in the bookkeeping phase, once the number of operations is known.
+
+            currentContext->startNewStatement();
+            *currentContext << "#include <chrono>\n"
+                               "#include <mutex>\n"
+                               "namespace LdProfile {\n"
+                               "struct Ring {\n"
+                               "static constexpr unsigned size = 4096;\n"
+                               "unsigned long long timestamps[size];\n"
+                               "unsigned long long handles[size];\n"
+                               "unsigned count = 0;\n"
+                               "unsigned long long lastHandle = ~0ULL;\n"
+                               "unsigned long long lastTimestamp = 0;\n"
+                               "};\n"
+                               "static thread_local Ring ring;\n"
+                               "void drain(Ring& r);\n"
+                               "inline void record(unsigned long long h) {\n"
+                               "Ring& r = ring;\n"
+                               "r.timestamps[r.count] = static_cast<unsigned long long>(\n"
+                               "std::chrono::duration_cast<std::chrono::nanoseconds>(\n"
+                               "std::chrono::steady_clock::now().time_since_epoch()\n"
+                               ").count()\n"
+                               ");\n"
+                               "r.handles[r.count] = h;\n"
+                               "if (++r.count == Ring::size) drain(r);\n"
+                               "}\n"
+                               "inline void finishThread() { record(~0ULL); drain(ring); ring.lastHandle = ~0ULL; }\n"
+                               "}\n";
+            currentContext->startedNewStatement();
+        }
+
+        if (parallelLoopsEnabled()) {
+            // Parallel for-all loops split their range into one contiguous block per worker.  Worker 0 runs on the
+            // model thread so short ranges never pay for a thread launch.  Workers perform the run-time's per-thread
+            // setup and capture any error so that every worker is joined before the first error is rethrown on the
+            // model thread, where it aborts the model as it would for a sequential loop.
+
+            currentContext->startNewStatement();
+            *currentContext << "#include <thread>\n"
+                               "#include <vector>\n"
+                               "#include <exception>\n"
+                               "namespace LdParallel {\n"
+                               "inline unsigned workers(unsigned long long count) {\n"
+                               "unsigned long long w = std::thread::hardware_concurrency();\n"
+                               "unsigned long long limit = count / "
+                            << QString::number(CppParallelLoop::minimumIterationsPerWorker)
+                            << ";\n"
+                               "if (w > limit) w = limit;\n"
+                               "return w == 0 ? 1 : static_cast<unsigned>(w);\n"
+                               "}\n"
+                               "template<typename P, typename F> void run(P& pt, unsigned w, F f) {\n"
+                               "std::vector<std::exception_ptr> e(w);\n"
+                               "std::vector<std::thread> t;\n"
+                               "t.reserve(w - 1);\n"
+                               "for (unsigned j=1 ; j<w ; ++j) {\n"
+                               "t.emplace_back(\n"
+                               "[&pt, &f, &e, j]() {\n"
+                               "try { pt.threadLocalSetup(); f(j); } catch (...) { e[j] = std::current_exception(); }\n"
+                               "}\n"
+                               ");\n"
+                               "}\n"
+                               "try { f(0U); } catch (...) { e[0] = std::current_exception(); }\n"
+                               "for (std::thread& x : t) x.join();\n"
+                               "for (const std::exception_ptr& x : e) if (x) std::rethrow_exception(x);\n"
+                               "}\n"
+                               "}\n";
+            currentContext->startedNewStatement();
+        }
+
         return true;
     }
 
 
     bool CppCodeGenerationEngine::preModelClassDeclaration() {
+        partitionThreads();
+
         currentContext->startNewStatement();
 
         *currentContext << "class ModelImpl:public M::ModelBase {\n"
@@ -655,12 +1219,18 @@ namespace Ld {
         *currentContext << QString(
             "void ModelImpl::t%1(M::PerThread& pt) {\n"
             "pt.threadLocalSetup();\n"
-            "M::Console::report("
-                "%1, "
-                "M::Console::MessageType::INFORMATION, "
-                "\"Entered thread %1 .\""
-            ");\n"
         ).arg(threadId + 1);
+
+        if (!currentReleaseProfile) {
+            *currentContext << QString(
+                "M::Console::report("
+                    "%1, "
+                    "M::Console::MessageType::INFORMATION, "
+                    "\"Entered thread %1 .\""
+                ");\n"
+            ).arg(threadId + 1);
+        }
+
         currentContext->startedNewStatement();
 
         return true;
@@ -668,12 +1238,26 @@ namespace Ld {
 
 
     bool CppCodeGenerationEngine::preThreadLocals() {
+        const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(translationPhase());
+        unsigned                   threadId            = cppTranslationPhase.threadId();
+
+        if (!currentUsingCachedModel && threadId < static_cast<unsigned>(currentThreadPartitions.size())) {
+            const ElementPointerList& statements = currentThreadPartitions.at(static_cast<int>(threadId));
+            currentExpressionOptimizer.declareTemporaries(statements, *this);
+        }
+
         return true;
     }
 
 
     bool CppCodeGenerationEngine::preThreadImplementation() {
-        rootElement()->operationDatabase().clear();
+        const CppTranslationPhase& cppTranslationPhase = dynamic_cast<const CppTranslationPhase&>(translationPhase());
+        if (cppTranslationPhase.threadId() == 0) {
+            // Operation handles are unique across all threads so we only clear the database before the first thread.
+            rootElement()->operationDatabase().clear();
+            rootElement()->clearOperationProfile();
+        }
+
         return true;
     }
 
@@ -694,15 +1278,23 @@ namespace Ld {
         unsigned                   threadId            = cppTranslationPhase.threadId();
 
         currentContext->startNewStatement();
-        *currentContext << QString(
-            "M::Console::report("
-                "%1, "
-                "M::Console::MessageType::INFORMATION, "
-                "\"Exiting thread %1.\""
-            ");\n"
-            "return;\n"
-            "}\n"
-        ).arg(threadId + 1);
+
+        if (currentProfilingEnabled) {
+            *currentContext << "LdProfile::finishThread();\n";
+        }
+
+        if (!currentReleaseProfile) {
+            *currentContext << QString(
+                "M::Console::report("
+                    "%1, "
+                    "M::Console::MessageType::INFORMATION, "
+                    "\"Exiting thread %1.\""
+                ");\n"
+            ).arg(threadId + 1);
+        }
+
+        *currentContext << "return;\n"
+                           "}\n";
         currentContext->startedNewStatement();
 
         return true;
@@ -731,6 +1323,31 @@ namespace Ld {
         ).arg(numberOperationHandles);
         currentContext->startedNewStatement();
 
+        if (currentProfilingEnabled) {
+            currentContext->startNewStatement();
+            *currentContext << QString(
+                "namespace LdProfile {\n"
+                "static const unsigned long long numberOperations = %1;\n"
+                "static unsigned long long hitCounts[%2];\n"
+                "static unsigned long long exclusiveNanoseconds[%2];\n"
+                "static std::mutex mutex;\n"
+                "void drain(Ring& r) {\n"
+                "std::lock_guard<std::mutex> guard(mutex);\n"
+                "for (unsigned i=0 ; i<r.count ; ++i) {\n"
+                "unsigned long long h = r.handles[i];\n"
+                "unsigned long long t = r.timestamps[i];\n"
+                "if (r.lastHandle < numberOperations) exclusiveNanoseconds[r.lastHandle] += t - r.lastTimestamp;\n"
+                "if (h < numberOperations) ++hitCounts[h];\n"
+                "r.lastHandle = h;\n"
+                "r.lastTimestamp = t;\n"
+                "}\n"
+                "r.count = 0;\n"
+                "}\n"
+                "}\n"
+            ).arg(numberOperationHandles).arg(numberOperationHandles + 1);
+            currentContext->startedNewStatement();
+        }
+
         *currentContext << "M::IdentifierDatabase ModelImpl::identifierDatabase() {\n"
                         << "M::IdentifierDatabase r;\n";
 
@@ -815,6 +1432,28 @@ namespace Ld {
 
         currentContext->startedNewStatement();
 
+        if (currentProfilingEnabled) {
+            currentContext->startNewStatement();
+            *currentContext << QString(
+                "extern \"C\" %1 unsigned long long %2("
+                    "unsigned long long* hitCounts,"
+                    "unsigned long long* exclusiveNanoseconds,"
+                    "unsigned long long capacity,"
+                    "bool reset"
+                ") { "
+                    "std::lock_guard<std::mutex> guard(LdProfile::mutex);"
+                    "for (unsigned long long i=0 ; i<capacity && i<LdProfile::numberOperations ; ++i) {"
+                        "hitCounts[i] = LdProfile::hitCounts[i];"
+                        "exclusiveNanoseconds[i] = LdProfile::exclusiveNanoseconds[i];"
+                        "if (reset) { LdProfile::hitCounts[i] = 0; LdProfile::exclusiveNanoseconds[i] = 0; }"
+                    "}"
+                    "return LdProfile::numberOperations;"
+                "}\n"
+            ).arg(declspec).arg(CppCodeGenerator::modelProfileFunctionName);
+
+            currentContext->startedNewStatement();
+        }
+
         return true;
     }
 
@@ -822,10 +1461,24 @@ namespace Ld {
     bool CppCodeGenerationEngine::preConvertIrToObject() {
         assert(backendSemaphore.available() == 0);
 
-        dynamic_cast<CppCodeGenerator&>(codeGenerator()).currentCompiler->compile(currentContext);
-        backendSemaphore.acquire(1);
+        CppCodeGenerator& cppCodeGenerator = dynamic_cast<CppCodeGenerator&>(codeGenerator());
+        CppObjectCache&   objectCache      = cppCodeGenerator.currentObjectCache;
+        QByteArray        cacheKey         = objectCacheKey(QString("object"));
+
+        bool success;
+        if (objectCache.retrieve(cacheKey, objectFile)) {
+            success = true;
+        } else {
+            cppCodeGenerator.currentCompiler->compile(currentContext);
+            backendSemaphore.acquire(1);
+
+            success = backendWasSuccessful;
+            if (success) {
+                objectCache.insert(cacheKey, objectFile);
+            }
+        }
 
-        return backendWasSuccessful;
+        return success;
     }
 
 
@@ -855,13 +1508,310 @@ namespace Ld {
             }
         }
 
-        currentContext->setStaticLibraries(staticLibraries.values());
-        currentContext->setDynamicLibraries(dynamicLibraries.values());
+        QStringList staticLibraryList  = staticLibraries.values();
+        QStringList dynamicLibraryList = dynamicLibraries.values();
+        staticLibraryList.sort();
+        dynamicLibraryList.sort();
+
+        currentContext->setStaticLibraries(staticLibraryList);
+        currentContext->setDynamicLibraries(dynamicLibraryList);
+
+        CppCodeGenerator& cppCodeGenerator = dynamic_cast<CppCodeGenerator&>(codeGenerator());
+        CppObjectCache&   objectCache      = cppCodeGenerator.currentObjectCache;
+        QByteArray        cacheKey         = objectCacheKey(
+            QString("library\n%1\n%2").arg(staticLibraryList.join(QChar(';'))).arg(dynamicLibraryList.join(QChar(';')))
+        );
+
+        bool success;
+        if (objectCache.retrieve(cacheKey, outputFile())) {
+            success = true;
+        } else {
+            cppCodeGenerator.currentLinker->link(currentContext);
+            backendSemaphore.acquire(1);
+
+            success = backendWasSuccessful;
+            if (success) {
+                objectCache.insert(cacheKey, outputFile());
+            }
+        }
+
+        return success;
+    }
+
+
+    void CppCodeGenerationEngine::partitionThreads() {
+        ElementPointerList topLevelElements;
+
+        RootElement::RootElementList rootElements = rootElement()->allDependencies();
+        rootElements << rootElement();
+
+        for (  RootElement::RootElementList::const_iterator rootIterator    = rootElements.constBegin(),
+                                                            rootEndIterator = rootElements.constEnd()
+             ; rootIterator != rootEndIterator
+             ; ++rootIterator
+            ) {
+            ElementPointerList children = (*rootIterator)->children();
+            for (  ElementPointerList::const_iterator it = children.constBegin(), end = children.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                if (!it->isNull()) {
+                    topLevelElements.append(*it);
+                }
+            }
+        }
+
+        // Group top level elements that share an identifier using a disjoint set.  Each group must be executed in
+        // program order and therefore by a single thread.  Plots name the variables they read rather than holding
+        // them as children so their data sources are added explicitly.  Statements with external effects, such as
+        // file I/O, are kept in program order with each other.
+
+        unsigned                            numberTopLevelElements = static_cast<unsigned>(topLevelElements.size());
+        QVector<unsigned>                   groupParents(static_cast<int>(numberTopLevelElements));
+        QVector<unsigned long>              elementCosts(static_cast<int>(numberTopLevelElements));
+        QHash<Identifier::Handle, unsigned> firstElementByIdentifier;
+        int                                 firstExternalElement = -1;
+
+        for (unsigned elementIndex=0 ; elementIndex<numberTopLevelElements ; ++elementIndex) {
+            groupParents[elementIndex] = elementIndex;
+
+            ElementPointer topLevelElement = topLevelElements.at(elementIndex);
+            elementCosts[elementIndex] = topLevelElement->numberDescendants() + 1;
+
+            for (  ElementIterator it  = ElementIterator(topLevelElement, ElementIterator::Order::PRE_ORDER, true),
+                                   end = ElementIterator()
+                 ; it != end
+                 ; ++it
+                ) {
+                const ElementPointer& element  = *it;
+                QString               typeName = element->typeName();
+                QList<IdentifierContainer> identifiers;
+
+                if (typeName == VariableElement::elementName) {
+                    identifiers.append(element.dynamicCast<VariableElement>()->identifier());
+                } else if (typeName == FunctionElement::elementName) {
+                    identifiers.append(element.dynamicCast<FunctionElement>()->identifier());
+
+                    if (externalEffects(element)) {
+                        if (firstExternalElement < 0) {
+                            firstExternalElement = static_cast<int>(elementIndex);
+                        } else {
+                            mergeGroups(groupParents, static_cast<unsigned>(firstExternalElement), elementIndex);
+                        }
+                    }
+                } else if (typeName == PlotElement::elementName) {
+                    QSharedPointer<PlotElement> plotElement      = element.dynamicCast<PlotElement>();
+                    unsigned                    numberDataSeries = plotElement->numberDataSeries();
+                    for (unsigned seriesIndex=0 ; seriesIndex<numberDataSeries ; ++seriesIndex) {
+                        unsigned numberDataSources = plotElement->numberDataSources(seriesIndex);
+                        for (unsigned sourceIndex=0 ; sourceIndex<numberDataSources ; ++sourceIndex) {
+                            const VariableName& variableName = plotElement->dataSource(seriesIndex, sourceIndex);
+                            identifiers.append(identifier(variableName.text1(), variableName.text2()));
+                        }
+                    }
+                }
+
+                for (  QList<IdentifierContainer>::const_iterator identifierIterator    = identifiers.constBegin(),
+                                                                  identifierEndIterator = identifiers.constEnd()
+                     ; identifierIterator != identifierEndIterator
+                     ; ++identifierIterator
+                    ) {
+                    if (identifierIterator->isValid()) {
+                        Identifier::Handle handle = identifierIterator->handle();
+                        QHash<Identifier::Handle, unsigned>::iterator firstIt = firstElementByIdentifier.find(handle);
+                        if (firstIt == firstElementByIdentifier.end()) {
+                            firstElementByIdentifier.insert(handle, elementIndex);
+                        } else {
+                            mergeGroups(groupParents, firstIt.value(), elementIndex);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Total the cost of each group.  Groups are listed by their first element so the result is deterministic.
+
+        QList<unsigned>                groups;
+        QHash<unsigned, unsigned long> costsByGroup;
+        for (unsigned elementIndex=0 ; elementIndex<numberTopLevelElements ; ++elementIndex) {
+            unsigned group = findGroup(groupParents, elementIndex);
+            if (group == elementIndex) {
+                groups.append(group);
+            }
+
+            costsByGroup[group] += elementCosts.at(elementIndex);
+        }
+
+        unsigned numberThreads = qMin(currentMaximumNumberThreads, static_cast<unsigned>(groups.size()));
+        if (numberThreads == 0) {
+            numberThreads = 1;
+        }
+
+        // Assign the most expensive groups first, each to the least loaded thread.
+
+        std::stable_sort(
+            groups.begin(),
+            groups.end(),
+            [&costsByGroup](unsigned a, unsigned b) {
+                return costsByGroup.value(a) > costsByGroup.value(b);
+            }
+        );
+
+        QVector<unsigned long>    threadCosts(static_cast<int>(numberThreads), 0);
+        QHash<unsigned, unsigned> threadsByGroup;
+        for (QList<unsigned>::const_iterator it = groups.constBegin(), end = groups.constEnd() ; it != end ; ++it) {
+            unsigned threadId = 0;
+            for (unsigned i=1 ; i<numberThreads ; ++i) {
+                if (threadCosts.at(i) < threadCosts.at(threadId)) {
+                    threadId = i;
+                }
+            }
+
+            threadCosts[threadId] += costsByGroup.value(*it);
+            threadsByGroup.insert(*it, threadId);
+        }
+
+        currentThreadPartitions.clear();
+        currentThreadsByTopLevelElement.clear();
+
+        QList<ElementWeakPointerList> partitionReport;
+        for (unsigned threadId=0 ; threadId<numberThreads ; ++threadId) {
+            currentThreadPartitions.append(ElementPointerList());
+            partitionReport.append(ElementWeakPointerList());
+        }
+
+        for (unsigned elementIndex=0 ; elementIndex<numberTopLevelElements ; ++elementIndex) {
+            ElementPointer topLevelElement = topLevelElements.at(elementIndex);
+            unsigned       threadId        = threadsByGroup.value(findGroup(groupParents, elementIndex));
+
+            currentThreadPartitions[threadId].append(topLevelElement);
+            partitionReport[threadId].append(topLevelElement.toWeakRef());
+            currentThreadsByTopLevelElement.insert(topLevelElement, threadId);
+        }
+
+        CppTranslationPhase& cppTranslationPhase = dynamic_cast<CppTranslationPhase&>(modifiableTranslationPhase());
+        cppTranslationPhase.setNumberThreads(numberThreads);
+
+        CppCodeGenerator* cppCodeGenerator = dynamic_cast<CppCodeGenerator*>(&codeGenerator());
+        if (cppCodeGenerator != nullptr) {
+            cppCodeGenerator->currentThreadPartitions = partitionReport;
+        }
+    }
+
+
+    bool CppCodeGenerationEngine::restoreCachedModel() {
+        CppCodeGenerator& cppCodeGenerator = dynamic_cast<CppCodeGenerator&>(codeGenerator());
+
+        currentRootRevisions.clear();
+
+        RootElement::RootElementList rootElements = rootElement()->allDependencies();
+        rootElements << rootElement();
+
+        for (  RootElement::RootElementList::const_iterator it  = rootElements.constBegin(),
+                                                            end = rootElements.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            currentRootRevisions.append(qMakePair(it->toWeakRef(), (*it)->revision()));
+        }
+
+        currentBuildSettings = QString("%1\n%2\n%3").arg(outputType().name())
+                                                     .arg(static_cast<int>(exportMode()))
+                                                     .arg(cppCodeGenerator.buildSettings());
+
+        bool restored = false;
+        if (cppCodeGenerator.currentModelCacheEnabled) {
+            Handle rootHandle = rootElement()->handle();
+            if (cppCodeGenerator.currentModelCache.contains(rootHandle)) {
+                const CppCodeGenerator::ModelCacheEntry& entry = cppCodeGenerator.currentModelCache[
+                    rootHandle
+                ];
+
+                if (   entry.rootRevisions == currentRootRevisions
+                    && entry.buildSettings == currentBuildSettings
+                    && QFile::exists(entry.artifactFile)) {
+                    deleteFileIfExists(outputFile());
+                    restored = QFile::copy(entry.artifactFile, outputFile());
+                }
+
+                if (restored) {
+                    // The elements are unchanged so the diagnostics still point at the right place.
+
+                    DiagnosticPointerList diagnostics = entry.diagnostics;
+                    for (  DiagnosticPointerList::const_iterator it  = diagnostics.constBegin(),
+                                                                 end = diagnostics.constEnd()
+                         ; it != end
+                         ; ++it
+                        ) {
+                        translationErrorDetected(*it);
+                    }
+                } else {
+                    QFile::remove(entry.artifactFile);
+                    cppCodeGenerator.currentModelCache.remove(rootHandle);
+                }
+            }
+        }
+
+        cppCodeGenerator.currentLastModelWasCached = restored;
+        return restored;
+    }
+
+
+    void CppCodeGenerationEngine::storeCachedModel() {
+        CppCodeGenerator& cppCodeGenerator = dynamic_cast<CppCodeGenerator&>(codeGenerator());
+
+        if (cppCodeGenerator.currentModelCacheEnabled) {
+            QString cacheDirectory = cppCodeGenerator.modelCacheDirectory();
+            if (!cacheDirectory.isEmpty()) {
+                Handle  rootHandle   = rootElement()->handle();
+                QString artifactFile = QDir(cacheDirectory).filePath(
+                    QString("%1-%2").arg(rootHandle.toCaseInsensitiveQString()).arg(QFileInfo(outputFile()).fileName())
+                );
+
+                cppCodeGenerator.currentModelCache.remove(rootHandle);
+                deleteFileIfExists(artifactFile);
+
+                if (QFile::copy(outputFile(), artifactFile)) {
+                    CppCodeGenerator::ModelCacheEntry entry;
+                    entry.rootRevisions = currentRootRevisions;
+                    entry.buildSettings = currentBuildSettings;
+                    entry.artifactFile  = artifactFile;
+                    entry.diagnostics   = reportedDiagnostics();
+
+                    cppCodeGenerator.currentModelCache.insert(rootHandle, entry);
+                }
+            }
+        }
+    }
+
+
+    QByteArray CppCodeGenerationEngine::objectCacheKey(const QString& stage) const {
+        const CppCodeGenerator& cppCodeGenerator = dynamic_cast<const CppCodeGenerator&>(codeGenerator());
+        QCryptographicHash      hash(QCryptographicHash::Sha256);
+
+        hash.addData(stage.toUtf8());
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(cppCodeGenerator.buildSettings().toUtf8());
+        hash.addData(QByteArray(1, '\0'));
+
+        // Rebuilt precompiled headers invalidate every object built against them.
+
+        QList<QString> pchFiles = cppCodeGenerator.standardPchFiles();
+        for (  QList<QString>::const_iterator it = pchFiles.constBegin(), end = pchFiles.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            QFileInfo pchInformation(*it);
+            hash.addData(QString("%1:%2:%3;").arg(*it)
+                                             .arg(pchInformation.size())
+                                             .arg(pchInformation.lastModified().toMSecsSinceEpoch())
+                                             .toUtf8());
+        }
 
-        dynamic_cast<CppCodeGenerator&>(codeGenerator()).currentLinker->link(currentContext);
-        backendSemaphore.acquire(1);
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(currentContext->sourceData());
 
-        return backendWasSuccessful;
+        return hash.result();
     }
 
 
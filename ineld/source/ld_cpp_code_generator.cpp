@@ -25,11 +25,22 @@
 * This file implements the \ref Ld::CppCodeGenerator class.
 ***********************************************************************************************************************/
 
+#include <QCoreApplication>
 #include <QString>
 #include <QByteArray>
 #include <QSharedPointer>
+#include <QStringList>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QVector>
 
 #include <cstdint>
+#include <algorithm>
 
 #include <cbe_cpp_compiler.h>
 #include <cbe_linker.h>
@@ -42,14 +53,21 @@
 #include "ld_diagnostic.h"
 #include "ld_element.h"
 #include "ld_root_element.h"
+#include "ld_operation_database.h"
 #include "ld_cpp_code_generator_diagnostic.h"
 #include "ld_cpp_code_generation_engine.h"
 #include "ld_cpp_context.h"
+#include "ld_cpp_object_cache.h"
+#include "ld_cpp_declaration_pch_cache.h"
+#include "ld_cpp_pch_probe_context.h"
+#include "ld_plug_in_information.h"
 #include "ld_code_generator.h"
 #include "ld_cpp_code_generator.h"
 
 namespace Ld {
     const char CppCodeGenerator::codeGeneratorName[] = "CppCodeGenerator";
+    const char CppCodeGenerator::modelProfileFunctionName[] = "ldModelOperationProfile";
+    const char CppCodeGenerator::declarationPchLibraryName[] = "declarations";
 
     CppCodeGenerator::CppCodeGenerator(
             CodeGeneratorVisual* visual
@@ -62,6 +80,18 @@ namespace Ld {
         ) {
         currentOutputTypes.clear();
         currentOutputTypes << CodeGeneratorOutputTypeContainer(new CppLoadableModuleOutputType());
+
+        currentOptimizationProfile            = OptimizationProfile::DEBUGGABLE;
+        currentReleaseCheckpointInterval      = 0;
+        currentProfilingEnabled               = false;
+        currentTypeInferenceReportEnabled     = false;
+        currentMaximumFunctionSpecializations = defaultMaximumFunctionSpecializations;
+        currentElementwiseFusionEnabled       = true;
+        currentExpressionOptimizationEnabled  = true;
+        currentParallelLoopsEnabled           = true;
+        currentMaximumNumberThreads           = 1;
+        currentModelCacheEnabled              = true;
+        currentLastModelWasCached             = false;
     }
 
 
@@ -95,6 +125,400 @@ namespace Ld {
     }
 
 
+    void CppCodeGenerator::setOptimizationProfile(CppCodeGenerator::OptimizationProfile newOptimizationProfile) {
+        currentOptimizationProfile = newOptimizationProfile;
+    }
+
+
+    CppCodeGenerator::OptimizationProfile CppCodeGenerator::optimizationProfile() const {
+        return currentOptimizationProfile;
+    }
+
+
+    void CppCodeGenerator::setReleaseCheckpointInterval(unsigned newCheckpointInterval) {
+        currentReleaseCheckpointInterval = newCheckpointInterval;
+    }
+
+
+    unsigned CppCodeGenerator::releaseCheckpointInterval() const {
+        return currentReleaseCheckpointInterval;
+    }
+
+
+    void CppCodeGenerator::setProfilingEnabled(bool nowEnabled) {
+        currentProfilingEnabled = nowEnabled;
+    }
+
+
+    void CppCodeGenerator::setProfilingDisabled(bool nowDisabled) {
+        setProfilingEnabled(!nowDisabled);
+    }
+
+
+    bool CppCodeGenerator::profilingEnabled() const {
+        return currentProfilingEnabled;
+    }
+
+
+    bool CppCodeGenerator::profilingDisabled() const {
+        return !currentProfilingEnabled;
+    }
+
+
+    void CppCodeGenerator::setTypeInferenceReportEnabled(bool nowEnabled) {
+        currentTypeInferenceReportEnabled = nowEnabled;
+    }
+
+
+    void CppCodeGenerator::setTypeInferenceReportDisabled(bool nowDisabled) {
+        setTypeInferenceReportEnabled(!nowDisabled);
+    }
+
+
+    bool CppCodeGenerator::typeInferenceReportEnabled() const {
+        return currentTypeInferenceReportEnabled;
+    }
+
+
+    bool CppCodeGenerator::typeInferenceReportDisabled() const {
+        return !currentTypeInferenceReportEnabled;
+    }
+
+
+    void CppCodeGenerator::setMaximumFunctionSpecializations(unsigned newMaximumSpecializations) {
+        currentMaximumFunctionSpecializations = newMaximumSpecializations;
+    }
+
+
+    unsigned CppCodeGenerator::maximumFunctionSpecializations() const {
+        return currentMaximumFunctionSpecializations;
+    }
+
+
+    void CppCodeGenerator::setElementwiseFusionEnabled(bool nowEnabled) {
+        currentElementwiseFusionEnabled = nowEnabled;
+    }
+
+
+    void CppCodeGenerator::setElementwiseFusionDisabled(bool nowDisabled) {
+        setElementwiseFusionEnabled(!nowDisabled);
+    }
+
+
+    bool CppCodeGenerator::elementwiseFusionEnabled() const {
+        return currentElementwiseFusionEnabled;
+    }
+
+
+    bool CppCodeGenerator::elementwiseFusionDisabled() const {
+        return !currentElementwiseFusionEnabled;
+    }
+
+
+    void CppCodeGenerator::setExpressionOptimizationEnabled(bool nowEnabled) {
+        currentExpressionOptimizationEnabled = nowEnabled;
+    }
+
+
+    void CppCodeGenerator::setExpressionOptimizationDisabled(bool nowDisabled) {
+        setExpressionOptimizationEnabled(!nowDisabled);
+    }
+
+
+    bool CppCodeGenerator::expressionOptimizationEnabled() const {
+        return currentExpressionOptimizationEnabled;
+    }
+
+
+    bool CppCodeGenerator::expressionOptimizationDisabled() const {
+        return !currentExpressionOptimizationEnabled;
+    }
+
+
+    void CppCodeGenerator::setParallelLoopsEnabled(bool nowEnabled) {
+        currentParallelLoopsEnabled = nowEnabled;
+    }
+
+
+    void CppCodeGenerator::setParallelLoopsDisabled(bool nowDisabled) {
+        setParallelLoopsEnabled(!nowDisabled);
+    }
+
+
+    bool CppCodeGenerator::parallelLoopsEnabled() const {
+        return currentParallelLoopsEnabled;
+    }
+
+
+    bool CppCodeGenerator::parallelLoopsDisabled() const {
+        return !currentParallelLoopsEnabled;
+    }
+
+
+    bool CppCodeGenerator::collectOperationProfile(
+            CppCodeGenerator::ModelProfileFunction profileFunction,
+            QSharedPointer<RootElement>            rootElement,
+            bool                                   reset
+        ) {
+        bool success = false;
+
+        if (profileFunction != nullptr && !rootElement.isNull()) {
+            unsigned long long numberOperations = rootElement->operationDatabase().size();
+
+            QVector<unsigned long long> hitCounts(static_cast<int>(numberOperations), 0);
+            QVector<unsigned long long> exclusiveNanoseconds(static_cast<int>(numberOperations), 0);
+
+            unsigned long long modelNumberOperations = (*profileFunction)(
+                hitCounts.data(),
+                exclusiveNanoseconds.data(),
+                numberOperations,
+                reset
+            );
+
+            if (modelNumberOperations == numberOperations) {
+                rootElement->setOperationProfile(hitCounts, exclusiveNanoseconds);
+                success = true;
+            }
+        }
+
+        return success;
+    }
+
+
+    void CppCodeGenerator::setMaximumNumberThreads(unsigned newMaximumNumberThreads) {
+        currentMaximumNumberThreads = newMaximumNumberThreads > 0 ? newMaximumNumberThreads : 1;
+    }
+
+
+    unsigned CppCodeGenerator::maximumNumberThreads() const {
+        return currentMaximumNumberThreads;
+    }
+
+
+    QList<ElementWeakPointerList> CppCodeGenerator::threadPartitions() const {
+        return currentThreadPartitions;
+    }
+
+
+    void CppCodeGenerator::setModelCacheEnabled(bool nowEnabled) {
+        currentModelCacheEnabled = nowEnabled;
+        if (!nowEnabled) {
+            clearModelCache();
+        }
+    }
+
+
+    void CppCodeGenerator::setModelCacheDisabled(bool nowDisabled) {
+        setModelCacheEnabled(!nowDisabled);
+    }
+
+
+    bool CppCodeGenerator::modelCacheEnabled() const {
+        return currentModelCacheEnabled;
+    }
+
+
+    bool CppCodeGenerator::modelCacheDisabled() const {
+        return !currentModelCacheEnabled;
+    }
+
+
+    void CppCodeGenerator::clearModelCache() {
+        for (  QHash<Handle, ModelCacheEntry>::const_iterator it  = currentModelCache.constBegin(),
+                                                              end = currentModelCache.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            QFile::remove(it.value().artifactFile);
+        }
+
+        currentModelCache.clear();
+    }
+
+
+    bool CppCodeGenerator::lastModelWasCached() const {
+        return currentLastModelWasCached;
+    }
+
+
+    CppObjectCache& CppCodeGenerator::objectCache() {
+        return currentObjectCache;
+    }
+
+
+    const CppObjectCache& CppCodeGenerator::objectCache() const {
+        return currentObjectCache;
+    }
+
+
+    unsigned CppCodeGenerator::prewarmObjectCache(
+            const QString&       documentDirectory,
+            const PlugInsByName& plugInsByName
+        ) {
+        unsigned      numberTranslated = 0;
+        QTemporaryDir outputDirectory;
+
+        if (!active() && outputDirectory.isValid()) {
+            QFileInfoList documents = QDir(documentDirectory).entryInfoList(QDir::Files, QDir::Name);
+            for (  QFileInfoList::const_iterator it = documents.constBegin(), end = documents.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                QSharedPointer<RootElement> rootElement(new RootElement);
+                rootElement->setWeakThis(rootElement.toWeakRef());
+
+                if (rootElement->openExisting(it->absoluteFilePath(), true, plugInsByName)) {
+                    QString outputFile = QDir(outputDirectory.path()).filePath(it->completeBaseName());
+                    if (translate(rootElement, outputFile, CodeGeneratorOutputType::ExportMode::NO_EXPORT)) {
+                        waitComplete();
+
+                        if (translationAvailable()) {
+                            ++numberTranslated;
+                        }
+                    }
+
+                    // Prewarmed programs are not kept, so don't hold on to their whole-model translations.  Models
+                    // cached for other root elements are left in place.
+
+                    Handle rootHandle = rootElement->handle();
+                    if (currentModelCache.contains(rootHandle)) {
+                        QFile::remove(currentModelCache.value(rootHandle).artifactFile);
+                        currentModelCache.remove(rootHandle);
+                    }
+
+                    rootElement->close();
+                }
+            }
+        }
+
+        return numberTranslated;
+    }
+
+
+    CppDeclarationPchCache& CppCodeGenerator::declarationPchCache() {
+        return currentDeclarationPchCache;
+    }
+
+
+    const CppDeclarationPchCache& CppCodeGenerator::declarationPchCache() const {
+        return currentDeclarationPchCache;
+    }
+
+
+    unsigned CppCodeGenerator::updateDeclarationPchFiles() {
+        if (!active()) {
+            // Put back the standard PCH file the previous declaration header was chained on.
+
+            QList<QString> pchFiles = standardPchFiles();
+            if (!currentDeclarationPchFile.isEmpty()) {
+                int pchIndex = pchFiles.indexOf(currentDeclarationPchFile);
+                if (pchIndex >= 0) {
+                    if (currentDeclarationPchBaseFile.isEmpty()) {
+                        pchFiles.removeAt(pchIndex);
+                    } else {
+                        pchFiles[pchIndex] = currentDeclarationPchBaseFile;
+                    }
+                }
+            }
+
+            currentDeclarationPchFile.clear();
+            currentDeclarationPchBaseFile.clear();
+            currentDeclarationPchLibraries.clear();
+
+            if (currentDeclarationPchCache.enabled()) {
+                if (currentDeclarationPchCache.compilerExecutable().isEmpty()) {
+                    QFileInfo compilerInformation(QDir(executableDirectory()).filePath("clang++"));
+                    if (!executableDirectory().isEmpty() && compilerInformation.isExecutable()) {
+                        currentDeclarationPchCache.setCompilerExecutable(compilerInformation.absoluteFilePath());
+                    }
+                }
+
+                if (currentDeclarationPchCache.embeddedCompilerFiles().isEmpty() && QCoreApplication::instance()) {
+                    // The embedded compiler is linked into the application.
+                    currentDeclarationPchCache.setEmbeddedCompilerFiles(
+                        QStringList() << QCoreApplication::applicationFilePath()
+                    );
+                }
+
+                // The compiler accepts a single -include-pch chain so every payload goes into one header, in a
+                // stable order so the cache key does not depend on plug-in load order.
+
+                QList<QString> libraries = CppDeclarationPayload::libraries();
+                std::sort(libraries.begin(), libraries.end());
+
+                QByteArray    declarations;
+                QSet<QString> includedLibraries;
+                for (  QList<QString>::const_iterator it = libraries.constBegin(), end = libraries.constEnd()
+                     ; it != end
+                     ; ++it
+                    ) {
+                    CppDeclarationPayload payload = CppDeclarationPayload::payload(*it);
+                    if (payload.isValid()) {
+                        declarations += payload.payload();
+                        declarations += '\n';
+
+                        includedLibraries.insert(*it);
+                    }
+                }
+
+                if (!declarations.isEmpty()) {
+                    QString basePchFile = pchFiles.isEmpty() ? QString() : pchFiles.last();
+
+                    CppDeclarationPayload combinedPayload(
+                        QString(declarationPchLibraryName),
+                        reinterpret_cast<const unsigned char*>(declarations.constData()),
+                        static_cast<unsigned long>(declarations.size()),
+                        false
+                    );
+
+                    QString pchFile = currentDeclarationPchCache.build(
+                        combinedPayload,
+                        declarationPchCompilerArguments(basePchFile)
+                    );
+
+                    if (!pchFile.isEmpty()) {
+                        QList<QString> candidatePchFiles = pchFiles;
+                        if (basePchFile.isEmpty()) {
+                            candidatePchFiles.append(pchFile);
+                        } else {
+                            candidatePchFiles.last() = pchFile;
+                        }
+
+                        // The header is built by an external compiler that may not match the embedded compiler.
+                        // If the embedded compiler rejects it, the plain standard PCH files are kept.
+
+                        if (embeddedCompilerAccepts(candidatePchFiles)) {
+                            pchFiles = candidatePchFiles;
+
+                            currentDeclarationPchFile      = pchFile;
+                            currentDeclarationPchBaseFile  = basePchFile;
+                            currentDeclarationPchLibraries = includedLibraries;
+                        }
+                    }
+                }
+            }
+
+            if (pchFiles != standardPchFiles()) {
+                setStandardPchFiles(pchFiles);
+            }
+        }
+
+        return static_cast<unsigned>(currentDeclarationPchLibraries.size());
+    }
+
+
+    bool CppCodeGenerator::declarationPchAvailable(const QString& libraryName) const {
+        // The standard PCH files may have been replaced, or the header removed from the cache, since the declaration
+        // header was added.  The declarations are then inserted into the translation unit instead.
+
+        return (
+               currentDeclarationPchLibraries.contains(libraryName)
+            && standardPchFiles().contains(currentDeclarationPchFile)
+            && QFileInfo(currentDeclarationPchFile).isFile()
+        );
+    }
+
+
     QList<CodeGeneratorOutputTypeContainer> CppCodeGenerator::supportedOutputTypes() const {
         return currentOutputTypes;
     }
@@ -287,4 +711,137 @@ namespace Ld {
 
         return QSharedPointer<CodeGenerationEngine>(engine);
     }
+
+
+    QString CppCodeGenerator::buildSettings() const {
+        QStringList settings;
+
+        settings << QString::number(currentMaximumNumberThreads)
+                 << QString::number(debugOutputEnabled() ? 1 : 0)
+                 << QString::number(static_cast<unsigned>(currentOptimizationProfile))
+                 << QString::number(currentReleaseCheckpointInterval)
+                 << QString::number(currentProfilingEnabled ? 1 : 0)
+                 << QString::number(currentTypeInferenceReportEnabled ? 1 : 0)
+                 << QString::number(currentMaximumFunctionSpecializations)
+                 << QString::number(currentElementwiseFusionEnabled ? 1 : 0)
+                 << QString::number(currentExpressionOptimizationEnabled ? 1 : 0)
+                 << QString::number(currentParallelLoopsEnabled ? 1 : 0)
+                 << executableDirectory()
+                 << linkerExecutable()
+                 << systemRoot()
+                 << resourceDirectory()
+                 << gccToolchain()
+                 << targetTriple()
+                 << QStringList(systemLibraries()).join(QChar(';'))
+                 << QStringList(headerSearchPaths()).join(QChar(';'))
+                 << QStringList(standardHeaders()).join(QChar(';'))
+                 << QStringList(standardPchFiles()).join(QChar(';'))
+                 << QStringList(librarySearchPaths()).join(QChar(';'))
+                 << QStringList(staticLibraries()).join(QChar(';'))
+                 << QStringList(dynamicLibraries()).join(QChar(';'))
+                 << QStringList(runTimeSearchPaths()).join(QChar(';'));
+
+        return settings.join(QChar('\n'));
+    }
+
+
+    QString CppCodeGenerator::modelCacheDirectory() {
+        if (currentModelCacheDirectory.isNull()) {
+            currentModelCacheDirectory.reset(new QTemporaryDir);
+        }
+
+        return currentModelCacheDirectory->isValid() ? currentModelCacheDirectory->path() : QString();
+    }
+
+
+    bool CppCodeGenerator::embeddedCompilerAccepts(const QList<QString>& pchFiles) {
+        QList<QString> originalPchFiles = standardPchFiles();
+        currentCompiler->setPrecompiledHeaders(pchFiles);
+
+        QTemporaryDir probeDirectory;
+        bool          success = probeDirectory.isValid();
+        if (success) {
+            QSharedPointer<CppPchProbeContext> probeContext(
+                new CppPchProbeContext(probeDirectory.filePath(QString("pch_probe.o")))
+            );
+
+            currentCompiler->compile(probeContext);
+            success = probeContext->waitComplete();
+        }
+
+        currentCompiler->setPrecompiledHeaders(originalPchFiles);
+        return success;
+    }
+
+
+    QStringList CppCodeGenerator::declarationPchCompilerArguments(const QString& basePchFile) const {
+        QStringList result;
+
+        // The compiler rejects a chained header built with language options that differ from the header it is
+        // chained on, so a mismatch here causes the build to fail and the declarations to be pasted instead.
+
+        #if (defined(_MSVC_LANG))
+
+            long languageStandard = _MSVC_LANG;
+
+        #else
+
+            long languageStandard = __cplusplus;
+
+        #endif
+
+        if (languageStandard >= 201703L) {
+            result << QString("-std=c++17");
+        } else if (languageStandard >= 201402L) {
+            result << QString("-std=c++14");
+        } else {
+            result << QString("-std=c++11");
+        }
+
+        QString target = targetTriple();
+        if (!target.isEmpty()) {
+            result << QString("--target=%1").arg(target);
+        }
+
+        QString root = systemRoot();
+        if (!root.isEmpty()) {
+            #if (defined(Q_OS_DARWIN))
+
+                bool appleTarget = target.isEmpty() || target.contains(QString("apple"));
+
+            #else
+
+                bool appleTarget = target.contains(QString("apple"));
+
+            #endif
+
+            if (appleTarget) {
+                result << QString("-isysroot") << root;
+            } else {
+                result << QString("--sysroot=%1").arg(root);
+            }
+        }
+
+        if (!resourceDirectory().isEmpty()) {
+            result << QString("-resource-dir") << resourceDirectory();
+        }
+
+        if (!gccToolchain().isEmpty()) {
+            result << QString("--gcc-toolchain=%1").arg(gccToolchain());
+        }
+
+        QList<QString> searchPaths = headerSearchPaths();
+        for (  QList<QString>::const_iterator it = searchPaths.constBegin(), end = searchPaths.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            result << QString("-I") << *it;
+        }
+
+        if (!basePchFile.isEmpty()) {
+            result << QString("-include-pch") << basePchFile;
+        }
+
+        return result;
+    }
 }
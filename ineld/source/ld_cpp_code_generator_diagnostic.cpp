@@ -223,6 +223,16 @@ namespace Ld {
                     break;
                 }
 
+                case Code::VARIABLE_TYPE_NOT_INFERRED: {
+                    description = tr("Type of \"%1\" could not be inferred, using a variant.").arg(backendMessage());
+                    break;
+                }
+
+                case Code::VARIABLE_INFERRED_AS_VARIANT: {
+                    description = tr("\"%1\" is assigned values that require a variant.").arg(backendMessage());
+                    break;
+                }
+
                 default: {
                     description = tr("Undefined error %1.").arg(static_cast<unsigned>(diagnosticCode()));
                     break;
@@ -27,6 +27,7 @@
 
 #include <QSharedPointer>
 #include <QString>
+#include <QList>
 #include <QByteArray>
 #include <QHash>
 
@@ -58,6 +59,11 @@ namespace Ld {
     }
 
 
+    QList<QString> CppDeclarationPayload::libraries() {
+        return payloadsByLibrary.keys();
+    }
+
+
     CppDeclarationPayload::CppDeclarationPayload():impl() {}
 
 
@@ -116,6 +122,11 @@ namespace Ld {
     }
 
 
+    QByteArray CppDeclarationPayload::hash() const {
+        return !impl.isNull() ? impl->hash() : QByteArray();
+    }
+
+
     CppDeclarationPayload& CppDeclarationPayload::operator=(const CppDeclarationPayload& other) {
         impl = other.impl;
         return *this;
@@ -29,6 +29,9 @@
 #include <QString>
 #include <QByteArray>
 #include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QCryptographicHash>
 
 #include <cstdint>
 
@@ -73,8 +76,35 @@ namespace Ld {
 
 
     QByteArray CppDeclarationPayload::Private::payload() const {
-        return   currentIsCompressed
-               ? qUncompress(reinterpret_cast<const uchar*>(currentRawPayload), currentPayloadLength)
-               : QByteArray(reinterpret_cast<const char*>(currentRawPayload), currentPayloadLength);
+        QMutexLocker locker(&currentMutex);
+
+        if (currentPayload.isNull()) {
+            if (currentIsCompressed) {
+                currentPayload = qUncompress(
+                    reinterpret_cast<const uchar*>(currentRawPayload),
+                    static_cast<int>(currentPayloadLength)
+                );
+            } else {
+                // The raw payload is resident for the life of the application so we can reference it in place.
+                currentPayload = QByteArray::fromRawData(
+                    reinterpret_cast<const char*>(currentRawPayload),
+                    static_cast<int>(currentPayloadLength)
+                );
+            }
+        }
+
+        return currentPayload;
+    }
+
+
+    QByteArray CppDeclarationPayload::Private::hash() const {
+        QByteArray   uncompressedPayload = payload();
+        QMutexLocker locker(&currentMutex);
+
+        if (currentHash.isEmpty()) {
+            currentHash = QCryptographicHash::hash(uncompressedPayload, QCryptographicHash::Sha256);
+        }
+
+        return currentHash;
     }
 }
@@ -34,6 +34,7 @@
 #include <QString>
 #include <QByteArray>
 #include <QHash>
+#include <QMutex>
 
 #include <cstdint>
 
@@ -94,12 +95,21 @@ namespace Ld {
             bool isCompressed() const;
 
             /**
-             * Method you can use to obtain the uncompressed payload.
+             * Method you can use to obtain the uncompressed payload.  Compressed payloads are decompressed on first use
+             * and the result is retained.
              *
              * \return Returns a byte array holding the uncompressed payload.
              */
             QByteArray payload() const;
 
+            /**
+             * Method you can use to obtain a SHA-256 hash of the uncompressed payload.  The hash is calculated on first
+             * use and retained.
+             *
+             * \return Returns the payload hash.
+             */
+            QByteArray hash() const;
+
         private:
             /**
              * The library name
@@ -120,6 +130,21 @@ namespace Ld {
              * Flag indicating if the current payload is compressed.
              */
             bool currentIsCompressed;
+
+            /**
+             * Mutex used to guard the retained payload and hash.
+             */
+            mutable QMutex currentMutex;
+
+            /**
+             * The retained uncompressed payload.  The array is null until the payload is first requested.
+             */
+            mutable QByteArray currentPayload;
+
+            /**
+             * The retained payload hash.  The array is empty until the hash is first requested.
+             */
+            mutable QByteArray currentHash;
     };
 }
 
@@ -0,0 +1,265 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::CppDeclarationPchCache class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QCryptographicHash>
+#include <QRegularExpression>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QProcess>
+
+#include "ld_cpp_declaration_payload.h"
+#include "ld_cpp_declaration_pch_cache.h"
+
+namespace Ld {
+    const QString CppDeclarationPchCache::headerExtension(".h");
+    const QString CppDeclarationPchCache::pchExtension(".pch");
+
+    CppDeclarationPchCache::CppDeclarationPchCache() {
+        currentNumberBuilds = 0;
+    }
+
+
+    CppDeclarationPchCache::~CppDeclarationPchCache() {}
+
+
+    bool CppDeclarationPchCache::setDirectory(const QString& newDirectory) {
+        QMutexLocker locker(&cacheMutex);
+
+        currentDirectory.clear();
+
+        bool success;
+        if (newDirectory.isEmpty()) {
+            success = true;
+        } else {
+            success = QDir().mkpath(newDirectory);
+            if (success) {
+                currentDirectory = QDir(newDirectory).absolutePath();
+            }
+        }
+
+        return success;
+    }
+
+
+    QString CppDeclarationPchCache::directory() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentDirectory;
+    }
+
+
+    bool CppDeclarationPchCache::enabled() const {
+        QMutexLocker locker(&cacheMutex);
+        return !currentDirectory.isEmpty();
+    }
+
+
+    void CppDeclarationPchCache::setCompilerExecutable(const QString& newCompilerExecutable) {
+        QMutexLocker locker(&cacheMutex);
+        currentCompilerExecutable = newCompilerExecutable;
+    }
+
+
+    QString CppDeclarationPchCache::compilerExecutable() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentCompilerExecutable;
+    }
+
+
+    void CppDeclarationPchCache::setEmbeddedCompilerFiles(const QStringList& newEmbeddedCompilerFiles) {
+        QMutexLocker locker(&cacheMutex);
+        currentEmbeddedCompilerFiles = newEmbeddedCompilerFiles;
+    }
+
+
+    QStringList CppDeclarationPchCache::embeddedCompilerFiles() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentEmbeddedCompilerFiles;
+    }
+
+
+    QByteArray CppDeclarationPchCache::key(
+            const CppDeclarationPayload& payload,
+            const QStringList&           compilerArguments
+        ) const {
+        QByteArray result;
+
+        if (payload.isValid()) {
+            QStringList stampedFiles;
+            stampedFiles << compilerExecutable() << compilerArguments << embeddedCompilerFiles();
+
+            QCryptographicHash hash(QCryptographicHash::Sha256);
+
+            hash.addData(QString("%1;%2;").arg(formatVersion).arg(payload.library()).toUtf8());
+            hash.addData(payload.hash());
+            hash.addData(QByteArray(1, '\0'));
+
+            // The compilers and any files named on the command line, such as base precompiled headers, are identified
+            // by their size and modification time as well as their name.
+
+            for (  QStringList::const_iterator it = stampedFiles.constBegin(), end = stampedFiles.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                QFileInfo fileInformation(*it);
+                if (fileInformation.isFile()) {
+                    hash.addData(QString("%1:%2:%3;").arg(*it)
+                                                     .arg(fileInformation.size())
+                                                     .arg(fileInformation.lastModified().toMSecsSinceEpoch())
+                                                     .toUtf8());
+                } else {
+                    hash.addData(QString("%1;").arg(*it).toUtf8());
+                }
+            }
+
+            result = hash.result();
+        }
+
+        return result;
+    }
+
+
+    QString CppDeclarationPchCache::pchFile(
+            const CppDeclarationPayload& payload,
+            const QStringList&           compilerArguments
+        ) const {
+        QString    result;
+        QByteArray entryKey = key(payload, compilerArguments);
+
+        QMutexLocker locker(&cacheMutex);
+        if (!currentDirectory.isEmpty() && !entryKey.isEmpty()) {
+            QString pchFilename = entryBasePath(payload, entryKey) + pchExtension;
+            if (QFileInfo(pchFilename).isFile()) {
+                result = pchFilename;
+            }
+        }
+
+        return result;
+    }
+
+
+    QString CppDeclarationPchCache::build(
+            const CppDeclarationPayload& payload,
+            const QStringList&           compilerArguments
+        ) {
+        QString result = pchFile(payload, compilerArguments);
+
+        if (result.isEmpty()) {
+            QByteArray entryKey = key(payload, compilerArguments);
+            QString    basePath;
+            QString    compiler;
+
+            {
+                QMutexLocker locker(&cacheMutex);
+                if (!currentDirectory.isEmpty() && !entryKey.isEmpty()) {
+                    basePath = entryBasePath(payload, entryKey);
+                    compiler = currentCompilerExecutable;
+                }
+            }
+
+            if (!basePath.isEmpty() && !compiler.isEmpty()) {
+                QString headerFilename    = basePath + headerExtension;
+                QString pchFilename       = basePath + pchExtension;
+                QString temporaryFilename = pchFilename + QString(".tmp");
+
+                QFile headerFile(headerFilename);
+                bool  success = headerFile.open(QFile::WriteOnly | QFile::Truncate);
+                if (success) {
+                    QByteArray declarations = payload.payload();
+                    success = (headerFile.write(declarations) == declarations.size());
+                    headerFile.close();
+                }
+
+                if (success) {
+                    QStringList arguments = compilerArguments;
+                    arguments << QString("-x") << QString("c++-header")
+                              << headerFilename
+                              << QString("-o") << temporaryFilename;
+
+                    QProcess compilerProcess;
+                    compilerProcess.setProcessChannelMode(QProcess::MergedChannels);
+                    compilerProcess.start(compiler, arguments);
+
+                    success = (
+                           compilerProcess.waitForFinished(buildTimeoutMilliseconds)
+                        && compilerProcess.exitStatus() == QProcess::NormalExit
+                        && compilerProcess.exitCode() == 0
+                        && QFileInfo(temporaryFilename).isFile()
+                    );
+
+                    if (compilerProcess.state() != QProcess::NotRunning) {
+                        compilerProcess.kill();
+                        compilerProcess.waitForFinished();
+                    }
+                }
+
+                // Rename into place so a concurrent reader never sees a partially written precompiled header.
+
+                if (success) {
+                    QFile::remove(pchFilename);
+                    success = QFile::rename(temporaryFilename, pchFilename);
+                }
+
+                if (success) {
+                    QMutexLocker locker(&cacheMutex);
+                    ++currentNumberBuilds;
+
+                    result = pchFilename;
+                } else {
+                    QFile::remove(temporaryFilename);
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    unsigned long CppDeclarationPchCache::numberBuilds() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentNumberBuilds;
+    }
+
+
+    QString CppDeclarationPchCache::entryBasePath(
+            const CppDeclarationPayload& payload,
+            const QByteArray&            key
+        ) const {
+        QString libraryName = payload.library();
+        libraryName.replace(QRegularExpression("[^A-Za-z0-9_]"), QString("_"));
+
+        return QDir(currentDirectory).filePath(
+            QString("%1-%2").arg(libraryName).arg(QString::fromLatin1(key.toHex().left(32)))
+        );
+    }
+}
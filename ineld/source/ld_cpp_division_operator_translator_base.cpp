@@ -35,6 +35,7 @@
 #include "ld_cpp_code_generator_diagnostic.h"
 #include "ld_cpp_code_generation_engine.h"
 #include "ld_cpp_translator.h"
+#include "ld_cpp_elementwise_fusion.h"
 #include "ld_cpp_division_operator_translator_base.h"
 
 namespace Ld {
@@ -56,7 +57,9 @@ namespace Ld {
             DataType::ValueType child0ValueType = child0->valueType();
             DataType::ValueType child1ValueType = child1->valueType();
 
-            if (child1ValueType == DataType::ValueType::BOOLEAN) {
+            if (CppElementwiseFusion::isFusionRoot(element, engine)) {
+                success = CppElementwiseFusion::translate(element, engine);
+            } else if (child1ValueType == DataType::ValueType::BOOLEAN) {
                 engine.translationErrorDetected(
                     new CppCodeGeneratorDiagnostic(
                         element,
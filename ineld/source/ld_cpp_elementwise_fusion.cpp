@@ -0,0 +1,388 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::CppElementwiseFusion class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+#include <cassert>
+
+#include "ld_element_structures.h"
+#include "ld_element.h"
+#include "ld_data_type.h"
+#include "ld_addition_operator_element.h"
+#include "ld_subtraction_operator_element.h"
+#include "ld_multiplication_operator_element.h"
+#include "ld_division_operator_element.h"
+#include "ld_fraction_operator_element.h"
+#include "ld_hadamard_product_operator_element.h"
+#include "ld_unary_minus_operator_element.h"
+#include "ld_grouping_parenthesis_operator_element.h"
+#include "ld_grouping_brackets_operator_element.h"
+#include "ld_grouping_braces_operator_element.h"
+#include "ld_cpp_context.h"
+#include "ld_cpp_code_generation_engine.h"
+#include "ld_cpp_elementwise_fusion.h"
+
+namespace Ld {
+    bool CppElementwiseFusion::isFusionRoot(ElementPointer element, const CppCodeGenerationEngine& engine) {
+        bool result = false;
+
+        if (engine.elementwiseFusionEnabled() && operation(element) != Operation::NONE) {
+            // A fused operator whose parent is also fused is emitted as part of the parent's loop.
+
+            ElementPointer parent = element->parent();
+            while (isGrouping(parent)) {
+                parent = parent->parent();
+            }
+
+            if (parent.isNull() || operation(parent) == Operation::NONE) {
+                result = (countOperators(element) >= minimumFusedOperators);
+            }
+        }
+
+        return result;
+    }
+
+
+    bool CppElementwiseFusion::translate(ElementPointer element, CppCodeGenerationEngine& engine) {
+        bool                  success    = true;
+        CppContext&           context    = engine.context();
+        DataType::ValueType   resultType = element->valueType();
+        QList<ElementPointer> operands;
+
+        collectOperands(element, operands);
+
+        QString matrixType;
+        QString coefficientType;
+        if (resultType == DataType::ValueType::MATRIX_REAL) {
+            matrixType      = QString("M::MatrixReal");
+            coefficientType = QString("M::Real");
+        } else {
+            matrixType      = QString("M::MatrixComplex");
+            coefficientType = QString("M::Complex");
+        }
+
+        // Evaluate each operand exactly once, in left to right order.
+
+        context(element) << QString("([&]()->%1 {").arg(matrixType);
+
+        QList<unsigned> matrixOperands;
+        unsigned        numberOperands = static_cast<unsigned>(operands.size());
+        for (unsigned operandIndex=0 ; operandIndex<numberOperands ; ++operandIndex) {
+            ElementPointer operand = operands.at(operandIndex);
+            if (isMatrixOperand(operand)) {
+                context(element) << QString("const auto& ewA%1=(").arg(operandIndex);
+                success = engine.translateChild(operand) && success;
+                context(element) << ");";
+
+                matrixOperands.append(operandIndex);
+            } else {
+                QString format   = conversion(operand->valueType(), resultType);
+                int     position = format.indexOf(QString("%1"));
+
+                context(element) << QString("const %1 ewS%2=%3").arg(coefficientType)
+                                                                 .arg(operandIndex)
+                                                                 .arg(format.left(position));
+                success = engine.translateChild(operand) && success;
+                context(element) << format.mid(position + 2) << ";";
+            }
+        }
+
+        assert(!matrixOperands.isEmpty());
+        unsigned firstMatrix = matrixOperands.first();
+
+        // Non-conforming operands use the unfused operators so the run-time library reports the mismatch.
+
+        if (matrixOperands.size() > 1) {
+            QStringList conditions;
+            for (unsigned i=1 ; i<static_cast<unsigned>(matrixOperands.size()) ; ++i) {
+                QString other = QString::number(matrixOperands.at(i));
+                QString first = QString::number(firstMatrix);
+                conditions << QString("ewA%1.numberRows()!=ewA%2.numberRows()").arg(other, first)
+                           << QString("ewA%1.numberColumns()!=ewA%2.numberColumns()").arg(other, first);
+            }
+
+            unsigned fallbackOperandIndex = 0;
+            context(element) << QString("if (%1) {return %2;}").arg(
+                conditions.join(QString("||")),
+                expression(element, operands, fallbackOperandIndex, resultType, false)
+            );
+        }
+
+        // Coefficients are read and written through the matrix accessors.  Operands may be transposed or padded so
+        // their storage can not be walked directly.
+
+        context(element) << QString("const unsigned long ewNR=ewA%1.numberRows();").arg(firstMatrix)
+                         << QString("const unsigned long ewNC=ewA%1.numberColumns();").arg(firstMatrix)
+                         << QString("%1 ewR(ewNR,ewNC);").arg(matrixType);
+
+        unsigned kernelOperandIndex = 0;
+        context(element) << QString(
+                                "for (unsigned long ewC=1;ewC<=ewNC;++ewC) {"
+                                    "for (unsigned long ewI=1;ewI<=ewNR;++ewI) {ewR.update(ewI,ewC,%1);}"
+                                "}"
+                            ).arg(expression(element, operands, kernelOperandIndex, resultType, true))
+                         << "return ewR;}())";
+
+        return success;
+    }
+
+
+    CppElementwiseFusion::Operation CppElementwiseFusion::operation(ElementPointer element) {
+        Operation result = Operation::NONE;
+
+        if (!element.isNull()) {
+            DataType::ValueType valueType = element->valueType();
+            if (valueType == DataType::ValueType::MATRIX_REAL || valueType == DataType::ValueType::MATRIX_COMPLEX) {
+                QString typeName = element->typeName();
+
+                if (typeName == UnaryMinusOperatorElement::elementName) {
+                    if (isMatrixOperand(element->child(0))) {
+                        result = Operation::NEGATE;
+                    }
+                } else if (element->numberChildren() == 2) {
+                    ElementPointer child0 = element->child(0);
+                    ElementPointer child1 = element->child(1);
+
+                    if (typeName == AdditionOperatorElement::elementName) {
+                        if (isMatrixOperand(child0) && isMatrixOperand(child1)) {
+                            result = Operation::ADD;
+                        }
+                    } else if (typeName == SubtractionOperatorElement::elementName) {
+                        if (isMatrixOperand(child0) && isMatrixOperand(child1)) {
+                            result = Operation::SUBTRACT;
+                        }
+                    } else if (typeName == HadamardProductOperatorElement::elementName) {
+                        if (isMatrixOperand(child0) && isMatrixOperand(child1)) {
+                            result = Operation::HADAMARD;
+                        }
+                    } else if (typeName == MultiplicationOperatorElement::elementName) {
+                        if ((isMatrixOperand(child0) && isScalarOperand(child1)) ||
+                            (isScalarOperand(child0) && isMatrixOperand(child1))    ) {
+                            result = Operation::MULTIPLY;
+                        }
+                    } else if (typeName == DivisionOperatorElement::elementName ||
+                               typeName == FractionOperatorElement::elementName    ) {
+                        if (isMatrixOperand(child0) && isScalarOperand(child1)) {
+                            result = Operation::DIVIDE;
+                        }
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    bool CppElementwiseFusion::isGrouping(ElementPointer element) {
+        bool result = false;
+
+        if (!element.isNull()) {
+            QString typeName = element->typeName();
+            result = (
+                   typeName == GroupingParenthesisOperatorElement::elementName
+                || typeName == GroupingBracketsOperatorElement::elementName
+                || typeName == GroupingBracesOperatorElement::elementName
+            );
+        }
+
+        return result;
+    }
+
+
+    ElementPointer CppElementwiseFusion::skipGrouping(ElementPointer element) {
+        ElementPointer result = element;
+        while (isGrouping(result)) {
+            result = result->child(0);
+        }
+
+        return result;
+    }
+
+
+    bool CppElementwiseFusion::isMatrixOperand(ElementPointer element) {
+        bool result = false;
+
+        if (!element.isNull()) {
+            DataType::ValueType valueType = element->valueType();
+            result = (
+                   valueType == DataType::ValueType::MATRIX_INTEGER
+                || valueType == DataType::ValueType::MATRIX_REAL
+                || valueType == DataType::ValueType::MATRIX_COMPLEX
+            );
+        }
+
+        return result;
+    }
+
+
+    bool CppElementwiseFusion::isScalarOperand(ElementPointer element) {
+        bool result = false;
+
+        if (!element.isNull()) {
+            DataType::ValueType valueType = element->valueType();
+            result = (
+                   valueType == DataType::ValueType::INTEGER
+                || valueType == DataType::ValueType::REAL
+                || valueType == DataType::ValueType::COMPLEX
+            );
+        }
+
+        return result;
+    }
+
+
+    unsigned CppElementwiseFusion::countOperators(ElementPointer element) {
+        unsigned       result       = 0;
+        ElementPointer fusedElement = skipGrouping(element);
+
+        if (operation(fusedElement) != Operation::NONE) {
+            result = 1;
+
+            unsigned long numberChildren = fusedElement->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                result += countOperators(fusedElement->child(childIndex));
+            }
+        }
+
+        return result;
+    }
+
+
+    void CppElementwiseFusion::collectOperands(ElementPointer element, QList<ElementPointer>& operands) {
+        ElementPointer fusedElement = skipGrouping(element);
+
+        if (operation(fusedElement) != Operation::NONE) {
+            unsigned long numberChildren = fusedElement->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                collectOperands(fusedElement->child(childIndex), operands);
+            }
+        } else {
+            operands.append(element);
+        }
+    }
+
+
+    QString CppElementwiseFusion::expression(
+            ElementPointer               element,
+            const QList<ElementPointer>& operands,
+            unsigned&                    operandIndex,
+            DataType::ValueType          resultType,
+            bool                         perElement
+        ) {
+        QString        result;
+        ElementPointer fusedElement   = skipGrouping(element);
+        Operation      fusedOperation = operation(fusedElement);
+
+        if (fusedOperation == Operation::NONE) {
+            ElementPointer operand = operands.at(operandIndex);
+
+            if (!isMatrixOperand(operand)) {
+                result = QString("ewS%1").arg(operandIndex);
+            } else if (perElement) {
+                QString coefficient = QString("ewA%1.at(ewI,ewC)").arg(operandIndex);
+                result = conversion(operand->valueType(), resultType).arg(coefficient);
+            } else {
+                result = QString("ewA%1").arg(operandIndex);
+            }
+
+            ++operandIndex;
+        } else if (fusedOperation == Operation::NEGATE) {
+            result = QString("(-%1)").arg(
+                expression(fusedElement->child(0), operands, operandIndex, resultType, perElement)
+            );
+        } else {
+            QString left  = expression(fusedElement->child(0), operands, operandIndex, resultType, perElement);
+            QString right = expression(fusedElement->child(1), operands, operandIndex, resultType, perElement);
+
+            switch (fusedOperation) {
+                case Operation::ADD: {
+                    result = QString("(%1+%2)").arg(left, right);
+                    break;
+                }
+
+                case Operation::SUBTRACT: {
+                    result = QString("(%1-%2)").arg(left, right);
+                    break;
+                }
+
+                case Operation::MULTIPLY: {
+                    result = QString("(%1*%2)").arg(left, right);
+                    break;
+                }
+
+                case Operation::DIVIDE: {
+                    result = QString("(%1/%2)").arg(left, right);
+                    break;
+                }
+
+                case Operation::HADAMARD: {
+                    if (perElement) {
+                        result = QString("(%1*%2)").arg(left, right);
+                    } else {
+                        result = QString("M::hadamard(%1,%2)").arg(left, right);
+                    }
+
+                    break;
+                }
+
+                default: {
+                    assert(false);
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    QString CppElementwiseFusion::conversion(DataType::ValueType fromType, DataType::ValueType resultType) {
+        QString result;
+
+        bool fromInteger = (
+               fromType == DataType::ValueType::INTEGER
+            || fromType == DataType::ValueType::MATRIX_INTEGER
+        );
+
+        bool fromReal = (fromType == DataType::ValueType::REAL || fromType == DataType::ValueType::MATRIX_REAL);
+
+        if (resultType == DataType::ValueType::MATRIX_REAL) {
+            result = fromInteger ? QString("M::Real(%1)") : QString("%1");
+        } else if (fromInteger) {
+            result = QString("M::Complex(M::Real(%1))");
+        } else if (fromReal) {
+            result = QString("M::Complex(%1)");
+        } else {
+            result = QString("%1");
+        }
+
+        return result;
+    }
+}
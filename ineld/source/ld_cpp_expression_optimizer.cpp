@@ -0,0 +1,747 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::CppExpressionOptimizer class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+#include <sstream>
+#include <ios>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+#include <model_intrinsic_types.h>
+#include <model_variant.h>
+
+#include "ld_element_structures.h"
+#include "ld_element.h"
+#include "ld_data_type.h"
+#include "ld_variable_name.h"
+#include "ld_function_data.h"
+#include "ld_function_database.h"
+#include "ld_literal_element.h"
+#include "ld_variable_element.h"
+#include "ld_function_element.h"
+#include "ld_pi_special_value_element.h"
+#include "ld_eulers_number_special_value_element.h"
+#include "ld_assignment_operator_element.h"
+#include "ld_element_of_set_operator_element.h"
+#include "ld_for_all_in_operator_element.h"
+#include "ld_subscript_index_operator_element.h"
+#include "ld_subscript_row_column_operator_element.h"
+#include "ld_absolute_value_operator_element.h"
+#include "ld_addition_operator_element.h"
+#include "ld_ceiling_operator_element.h"
+#include "ld_complex_conjugate_operator_element.h"
+#include "ld_division_operator_element.h"
+#include "ld_factorial_operator_element.h"
+#include "ld_floor_operator_element.h"
+#include "ld_fraction_operator_element.h"
+#include "ld_grouping_braces_operator_element.h"
+#include "ld_grouping_brackets_operator_element.h"
+#include "ld_grouping_parenthesis_operator_element.h"
+#include "ld_hadamard_product_operator_element.h"
+#include "ld_kronecker_product_operator_element.h"
+#include "ld_matrix_combine_left_to_right_operator_element.h"
+#include "ld_matrix_combine_top_to_bottom_operator_element.h"
+#include "ld_matrix_conjugate_transpose_operator_element.h"
+#include "ld_matrix_operator_element.h"
+#include "ld_matrix_transpose_operator_element.h"
+#include "ld_multiplication_operator_element.h"
+#include "ld_nearest_integer_operator_element.h"
+#include "ld_power_operator_element.h"
+#include "ld_root_operator_element.h"
+#include "ld_square_root_operator_element.h"
+#include "ld_subtraction_operator_element.h"
+#include "ld_unary_minus_operator_element.h"
+#include "ld_unary_plus_operator_element.h"
+#include "ld_data_type_translator.h"
+#include "ld_cpp_data_type_translator.h"
+#include "ld_cpp_code_generator.h"
+#include "ld_cpp_context.h"
+#include "ld_cpp_code_generation_engine.h"
+#include "ld_cpp_expression_optimizer.h"
+
+/**
+ * Magnitude below which integer sums, differences and products are known to be exact.  The value is checked using
+ * long double arithmetic before the integer operation is performed.
+ */
+static const long double maximumFoldedInteger = 9.0E18L;
+
+namespace Ld {
+    CppExpressionOptimizer::CppExpressionOptimizer() {
+        currentEnabled = true;
+    }
+
+
+    CppExpressionOptimizer::~CppExpressionOptimizer() {}
+
+
+    void CppExpressionOptimizer::setEnabled(bool nowEnabled) {
+        currentEnabled = nowEnabled;
+    }
+
+
+    bool CppExpressionOptimizer::enabled() const {
+        return currentEnabled;
+    }
+
+
+    void CppExpressionOptimizer::clear() {
+        currentKeys.clear();
+        currentFoldRoots.clear();
+        currentTemporariesByElement.clear();
+        currentTemporarySources.clear();
+        currentTemporariesByStatement.clear();
+        currentComputedElement.clear();
+    }
+
+
+    void CppExpressionOptimizer::declareTemporaries(
+            const ElementPointerList& statements,
+            CppCodeGenerationEngine&  engine
+        ) {
+        if (currentEnabled) {
+            QList<QSet<QString>>              assignedKeys;
+            QHash<QString, QList<Occurrence>> occurrences;
+
+            unsigned numberStatements = static_cast<unsigned>(statements.size());
+            for (unsigned statementIndex=0 ; statementIndex<numberStatements ; ++statementIndex) {
+                ElementPointer statement = statements.at(statementIndex);
+
+                QSet<QString> assigned;
+                assignedVariables(statement, assigned);
+                assignedKeys.append(assigned);
+
+                if (isOptimizedAssignment(statement)) {
+                    collectOccurrences(statement->child(1), statementIndex, occurrences);
+                }
+            }
+
+            // Larger subtrees are placed first so that subtrees they make redundant are not given temporaries.  Ties
+            // are broken by key so the generated code does not depend on hash ordering.
+
+            QList<QString>                keys = occurrences.keys();
+            QHash<QString, unsigned long> sizes;
+            for (QList<QString>::const_iterator it = keys.constBegin(), end = keys.constEnd() ; it != end ; ++it) {
+                sizes.insert(*it, occurrences.value(*it).first().element->numberDescendants());
+            }
+
+            std::sort(
+                keys.begin(),
+                keys.end(),
+                [&sizes](const QString& a, const QString& b) {
+                    unsigned long aSize = sizes.value(a);
+                    unsigned long bSize = sizes.value(b);
+                    return aSize > bSize || (aSize == bSize && a < b);
+                }
+            );
+
+            QSet<ElementPointer> coveredRoots;
+            for (QList<QString>::const_iterator it = keys.constBegin(), end = keys.constEnd() ; it != end ; ++it) {
+                const QList<Occurrence>& keyOccurrences = occurrences.value(*it);
+                if (keyOccurrences.size() > 1) {
+                    QList<Occurrence> uncovered;
+                    for (  QList<Occurrence>::const_iterator occurrenceIterator    = keyOccurrences.constBegin(),
+                                                             occurrenceEndIterator = keyOccurrences.constEnd()
+                         ; occurrenceIterator != occurrenceEndIterator
+                         ; ++occurrenceIterator
+                        ) {
+                        ElementPointer ancestor = occurrenceIterator->element->parent();
+                        while (!ancestor.isNull() && !coveredRoots.contains(ancestor)) {
+                            ancestor = ancestor->parent();
+                        }
+
+                        if (ancestor.isNull()) {
+                            uncovered.append(*occurrenceIterator);
+                        }
+                    }
+
+                    if (uncovered.size() > 1) {
+                        assignTemporaries(uncovered, assignedKeys, statements, coveredRoots, engine);
+                    }
+                }
+            }
+        }
+    }
+
+
+    bool CppExpressionOptimizer::computeTemporaries(ElementPointer statement, CppCodeGenerationEngine& engine) {
+        bool success = true;
+
+        if (currentEnabled) {
+            CppContext&     context    = engine.context();
+            QList<unsigned> temporaries = currentTemporariesByStatement.value(statement);
+
+            for (  QList<unsigned>::const_iterator it = temporaries.constBegin(), end = temporaries.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                ElementPointer source = currentTemporarySources.at(*it);
+
+                context(source) << QString("%1=(").arg(temporaryName(*it));
+
+                currentComputedElement = source;
+                success = engine.translateChild(source) && success;
+                currentComputedElement.clear();
+
+                context(source) << "); ";
+            }
+        }
+
+        return success;
+    }
+
+
+    bool CppExpressionOptimizer::replaces(ElementPointer element) {
+        bool result = false;
+
+        if (currentEnabled && !element.isNull() && element != currentComputedElement) {
+            result = currentTemporariesByElement.contains(element) || isFoldRoot(element);
+        }
+
+        return result;
+    }
+
+
+    bool CppExpressionOptimizer::translate(ElementPointer element, CppCodeGenerationEngine& engine) {
+        bool        success = true;
+        CppContext& context = engine.context();
+
+        QHash<ElementPointer, unsigned>::const_iterator temporaryIterator = currentTemporariesByElement.constFind(
+            element
+        );
+
+        if (temporaryIterator != currentTemporariesByElement.constEnd()) {
+            context(element) << temporaryName(temporaryIterator.value());
+        } else if (element->valueType() == DataType::ValueType::INTEGER) {
+            Model::Integer value;
+            success = foldInteger(element, value);
+            if (success) {
+                context(element) << QString("M::Integer(%1)").arg(value);
+            }
+        } else {
+            Model::Real value;
+            success = foldReal(element, value);
+            if (success) {
+                // Scientific notation with max_digits10 digits round-trips every finite value, including values far
+                // below 1 that a fixed-point literal would truncate.  Non-finite results are never folded.
+
+                std::stringstream stream;
+                stream << "M::Real("
+                       << std::scientific << std::setprecision(std::numeric_limits<Model::Real>::max_digits10) << value
+                       << "L)";
+
+                context(element) << QString::fromStdString(stream.str());
+            }
+        }
+
+        return success;
+    }
+
+
+    void CppExpressionOptimizer::collectOccurrences(
+            ElementPointer                     element,
+            unsigned                           statementIndex,
+            QHash<QString, QList<Occurrence>>& occurrences
+        ) {
+        if (!element.isNull() && isPureOperation(element) && !isFoldRoot(element)) {
+            // Grouping operators share the key of their child so only the child is recorded.
+
+            if (!isGrouping(element)) {
+                QString elementKey = key(element);
+                if (!elementKey.isEmpty() && weight(element) >= minimumSubexpressionWeight) {
+                    Occurrence occurrence;
+                    occurrence.element        = element;
+                    occurrence.statementIndex = statementIndex;
+
+                    occurrences[elementKey].append(occurrence);
+                }
+            }
+
+            unsigned long numberChildren = element->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                collectOccurrences(element->child(childIndex), statementIndex, occurrences);
+            }
+        }
+    }
+
+
+    void CppExpressionOptimizer::assignTemporaries(
+            const QList<Occurrence>&    occurrences,
+            const QList<QSet<QString>>& assignedKeys,
+            const ElementPointerList&   statements,
+            QSet<ElementPointer>&       coveredRoots,
+            CppCodeGenerationEngine&    engine
+        ) {
+        QSet<QString> variableKeys;
+        referencedVariables(occurrences.first().element, variableKeys);
+
+        const CppDataTypeTranslator* translator = dynamic_cast<const CppDataTypeTranslator*>(
+            DataType::translator(CppCodeGenerator::codeGeneratorName, occurrences.first().element->valueType())
+        );
+
+        if (translator != nullptr) {
+            // A run ends when a statement between two occurrences assigns a variable the subtree depends on.
+
+            unsigned numberOccurrences = static_cast<unsigned>(occurrences.size());
+            unsigned runStart          = 0;
+            for (unsigned occurrenceIndex=1 ; occurrenceIndex<=numberOccurrences ; ++occurrenceIndex) {
+                bool runEnds = (occurrenceIndex == numberOccurrences);
+                if (!runEnds) {
+                    unsigned statementIndex = occurrences.at(occurrenceIndex - 1).statementIndex;
+                    unsigned endIndex       = occurrences.at(occurrenceIndex).statementIndex;
+                    while (!runEnds && statementIndex < endIndex) {
+                        runEnds = assignedKeys.at(statementIndex).intersects(variableKeys);
+                        ++statementIndex;
+                    }
+                }
+
+                if (runEnds) {
+                    if (occurrenceIndex - runStart > 1) {
+                        unsigned          temporary = static_cast<unsigned>(currentTemporarySources.size());
+                        const Occurrence& first     = occurrences.at(runStart);
+
+                        currentTemporarySources.append(first.element);
+                        for (unsigned runIndex=runStart ; runIndex<occurrenceIndex ; ++runIndex) {
+                            ElementPointer element = occurrences.at(runIndex).element;
+                            currentTemporariesByElement.insert(element, temporary);
+
+                            if (runIndex != runStart) {
+                                coveredRoots.insert(element);
+                            }
+                        }
+
+                        // Temporaries are assigned largest first but must be computed smallest first.
+                        currentTemporariesByStatement[statements.at(first.statementIndex)].prepend(temporary);
+
+                        CppContext& context = engine.context();
+                        context.startNewStatement();
+                        context << QString("%1 %2").arg(translator->dataTypeName()).arg(temporaryName(temporary));
+                    }
+
+                    runStart = occurrenceIndex;
+                }
+            }
+        }
+    }
+
+
+    bool CppExpressionOptimizer::isPureOperation(ElementPointer element) {
+        static const QSet<QString> pureOperators = {
+            AbsoluteValueOperatorElement::elementName,
+            AdditionOperatorElement::elementName,
+            CeilingOperatorElement::elementName,
+            ComplexConjugateOperatorElement::elementName,
+            DivisionOperatorElement::elementName,
+            FactorialOperatorElement::elementName,
+            FloorOperatorElement::elementName,
+            FractionOperatorElement::elementName,
+            GroupingBracesOperatorElement::elementName,
+            GroupingBracketsOperatorElement::elementName,
+            GroupingParenthesisOperatorElement::elementName,
+            HadamardProductOperatorElement::elementName,
+            KroneckerProductOperatorElement::elementName,
+            MatrixCombineLeftToRightOperatorElement::elementName,
+            MatrixCombineTopToBottomOperatorElement::elementName,
+            MatrixConjugateTransposeOperatorElement::elementName,
+            MatrixOperatorElement::elementName,
+            MatrixTransposeOperatorElement::elementName,
+            MultiplicationOperatorElement::elementName,
+            NearestIntegerOperatorElement::elementName,
+            PowerOperatorElement::elementName,
+            RootOperatorElement::elementName,
+            SquareRootOperatorElement::elementName,
+            SubscriptIndexOperatorElement::elementName,
+            SubscriptRowColumnOperatorElement::elementName,
+            SubtractionOperatorElement::elementName,
+            UnaryMinusOperatorElement::elementName,
+            UnaryPlusOperatorElement::elementName,
+            LiteralElement::elementName,
+            VariableElement::elementName,
+            PiSpecialValueElement::elementName,
+            EulersNumberSpecialValueElement::elementName
+        };
+
+        bool result = false;
+
+        if (!element.isNull()) {
+            QString typeName = element->typeName();
+            if (typeName == FunctionElement::elementName) {
+                // Functions that need a per-thread instance draw random numbers or otherwise depend on thread state.
+                // The file functions read or change file positions and contents.
+
+                const FunctionData& functionData = FunctionDatabase::function(
+                    VariableName(element->text(0), element->text(1))
+                );
+
+                const QString& internalName = functionData.internalName();
+                result = (
+                       functionData.isValid()
+                    && functionData.functionType() == FunctionData::Type::BUILT_IN
+                    && !functionData.requiresPerThreadInstance()
+                    && !internalName.startsWith(QString("M::file"))
+                    && !internalName.startsWith(QString("M::load"))
+                    && !internalName.startsWith(QString("M::save"))
+                );
+            } else {
+                result = pureOperators.contains(typeName);
+            }
+        }
+
+        return result;
+    }
+
+
+    bool CppExpressionOptimizer::isGrouping(ElementPointer element) {
+        bool result = false;
+
+        if (!element.isNull()) {
+            QString typeName = element->typeName();
+            result = (
+                   typeName == GroupingParenthesisOperatorElement::elementName
+                || typeName == GroupingBracketsOperatorElement::elementName
+                || typeName == GroupingBracesOperatorElement::elementName
+            );
+        }
+
+        return result;
+    }
+
+
+    bool CppExpressionOptimizer::isOptimizedAssignment(ElementPointer statement) {
+        bool result = false;
+
+        if (   !statement.isNull()
+            && statement->typeName() == AssignmentOperatorElement::elementName
+            && statement->valueType() != DataType::ValueType::BOOLEAN
+            && !statement->child(0).isNull()
+            && !statement->child(1).isNull()) {
+            ElementPointer valueElement = statement->child(0);
+            if (valueElement->typeName() == ElementOfSetOperatorElement::elementName) {
+                valueElement = valueElement->child(0);
+            }
+
+            if (!valueElement.isNull()) {
+                QString typeName = valueElement->typeName();
+                result = (
+                       typeName == VariableElement::elementName
+                    || typeName == SubscriptIndexOperatorElement::elementName
+                    || typeName == SubscriptRowColumnOperatorElement::elementName
+                );
+            }
+        }
+
+        return result;
+    }
+
+
+    QString CppExpressionOptimizer::key(ElementPointer element) {
+        QString result;
+
+        QHash<ElementPointer, QString>::const_iterator it = currentKeys.constFind(element);
+        if (it != currentKeys.constEnd()) {
+            result = it.value();
+        } else {
+            if (isPureOperation(element)) {
+                if (isGrouping(element)) {
+                    result = key(element->child(0));
+                } else {
+                    // Each text region and child key is prefixed by its length so distinct trees can not share a key.
+
+                    result = element->typeName();
+
+                    unsigned numberTextRegions = element->numberTextRegions();
+                    for (unsigned regionIndex=0 ; regionIndex<numberTextRegions ; ++regionIndex) {
+                        QString text = element->text(regionIndex);
+                        result += QString("|%1:%2").arg(text.length()).arg(text);
+                    }
+
+                    unsigned long numberChildren = element->numberChildren();
+                    unsigned long childIndex     = 0;
+                    while (!result.isEmpty() && childIndex < numberChildren) {
+                        QString childKey = key(element->child(childIndex));
+                        if (childKey.isEmpty()) {
+                            result.clear();
+                        } else {
+                            result += QString("(%1:%2)").arg(childKey.length()).arg(childKey);
+                        }
+
+                        ++childIndex;
+                    }
+                }
+            }
+
+            currentKeys.insert(element, result);
+        }
+
+        return result;
+    }
+
+
+    unsigned CppExpressionOptimizer::weight(ElementPointer element) {
+        unsigned result = 0;
+
+        if (!element.isNull()) {
+            unsigned long numberChildren = element->numberChildren();
+
+            if (element->typeName() == FunctionElement::elementName) {
+                result = minimumSubexpressionWeight;
+            } else if (numberChildren > 0 && !isGrouping(element)) {
+                result = 1;
+            }
+
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                result += weight(element->child(childIndex));
+            }
+        }
+
+        return result;
+    }
+
+
+    QString CppExpressionOptimizer::temporaryName(unsigned temporary) {
+        return QString("cse%1").arg(temporary);
+    }
+
+
+    void CppExpressionOptimizer::referencedVariables(ElementPointer element, QSet<QString>& variableKeys) {
+        if (!element.isNull()) {
+            if (element->typeName() == VariableElement::elementName) {
+                variableKeys.insert(key(element));
+            }
+
+            unsigned long numberChildren = element->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                referencedVariables(element->child(childIndex), variableKeys);
+            }
+        }
+    }
+
+
+    void CppExpressionOptimizer::assignedVariables(ElementPointer element, QSet<QString>& variableKeys) {
+        if (!element.isNull()) {
+            QString typeName = element->typeName();
+            if (   (   typeName == AssignmentOperatorElement::elementName
+                    && element->valueType() != DataType::ValueType::BOOLEAN)
+                || typeName == ForAllInOperatorElement::elementName) {
+                referencedVariables(element->child(0), variableKeys);
+            }
+
+            unsigned long numberChildren = element->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                assignedVariables(element->child(childIndex), variableKeys);
+            }
+        }
+    }
+
+
+    bool CppExpressionOptimizer::isFoldRoot(ElementPointer element) {
+        bool result;
+
+        QHash<ElementPointer, bool>::const_iterator it = currentFoldRoots.constFind(element);
+        if (it != currentFoldRoots.constEnd()) {
+            result = it.value();
+        } else {
+            // A lone literal is already a constant and the largest constant subtree is folded as a whole.
+
+            result = false;
+            if (element->numberChildren() > 0 && !isGrouping(element) && isFoldable(element)) {
+                ElementPointer parent = element->parent();
+                while (isGrouping(parent)) {
+                    parent = parent->parent();
+                }
+
+                result = parent.isNull() || !isFoldable(parent);
+            }
+
+            currentFoldRoots.insert(element, result);
+        }
+
+        return result;
+    }
+
+
+    bool CppExpressionOptimizer::isFoldable(ElementPointer element) {
+        bool result = false;
+
+        DataType::ValueType valueType = element->valueType();
+        if (valueType == DataType::ValueType::INTEGER) {
+            Model::Integer value;
+            result = foldInteger(element, value);
+        } else if (valueType == DataType::ValueType::REAL) {
+            Model::Real value;
+            result = foldReal(element, value);
+        }
+
+        return result;
+    }
+
+
+    bool CppExpressionOptimizer::foldInteger(ElementPointer element, Model::Integer& value) {
+        bool success = false;
+
+        if (!element.isNull() && element->valueType() == DataType::ValueType::INTEGER) {
+            QString typeName = element->typeName();
+
+            if (typeName == LiteralElement::elementName) {
+                Model::Variant literalValue = element.dynamicCast<LiteralElement>()->convert();
+                if (literalValue.valueType() == DataType::ValueType::INTEGER) {
+                    value = literalValue.toInteger(&success);
+                }
+            } else if (   isGrouping(element)
+                       || typeName == UnaryPlusOperatorElement::elementName) {
+                success = foldInteger(element->child(0), value);
+            } else if (typeName == UnaryMinusOperatorElement::elementName) {
+                Model::Integer childValue;
+                success = (
+                       foldInteger(element->child(0), childValue)
+                    && childValue != std::numeric_limits<Model::Integer>::min()
+                );
+
+                if (success) {
+                    value = -childValue;
+                }
+            } else if (   typeName == AdditionOperatorElement::elementName
+                       || typeName == SubtractionOperatorElement::elementName
+                       || typeName == MultiplicationOperatorElement::elementName) {
+                Model::Integer left;
+                Model::Integer right;
+                if (foldInteger(element->child(0), left) && foldInteger(element->child(1), right)) {
+                    long double estimate;
+                    if (typeName == AdditionOperatorElement::elementName) {
+                        estimate = static_cast<long double>(left) + static_cast<long double>(right);
+                    } else if (typeName == SubtractionOperatorElement::elementName) {
+                        estimate = static_cast<long double>(left) - static_cast<long double>(right);
+                    } else {
+                        estimate = static_cast<long double>(left) * static_cast<long double>(right);
+                    }
+
+                    if (std::fabs(estimate) < maximumFoldedInteger) {
+                        if (typeName == AdditionOperatorElement::elementName) {
+                            value = left + right;
+                        } else if (typeName == SubtractionOperatorElement::elementName) {
+                            value = left - right;
+                        } else {
+                            value = left * right;
+                        }
+
+                        success = true;
+                    }
+                }
+            } else if (typeName == PowerOperatorElement::elementName) {
+                Model::Integer base;
+                Model::Integer exponent;
+                if (   foldInteger(element->child(0), base)
+                    && foldInteger(element->child(1), exponent)
+                    && exponent > 0
+                    && exponent < std::numeric_limits<Model::Integer>::digits) {
+                    value   = 1;
+                    success = true;
+
+                    for (Model::Integer i=0 ; success && i<exponent ; ++i) {
+                        success = std::fabs(static_cast<long double>(value) * base) < maximumFoldedInteger;
+                        if (success) {
+                            value *= base;
+                        }
+                    }
+                }
+            }
+        }
+
+        return success;
+    }
+
+
+    bool CppExpressionOptimizer::foldReal(ElementPointer element, Model::Real& value) {
+        bool success = false;
+
+        if (!element.isNull()) {
+            DataType::ValueType valueType = element->valueType();
+            if (valueType == DataType::ValueType::INTEGER) {
+                // Integer subtrees are evaluated with integer arithmetic, as they are at run time.
+
+                Model::Integer integerValue;
+                success = foldInteger(element, integerValue);
+                if (success) {
+                    value = static_cast<Model::Real>(integerValue);
+                }
+            } else if (valueType == DataType::ValueType::REAL) {
+                QString typeName = element->typeName();
+
+                if (typeName == LiteralElement::elementName) {
+                    Model::Variant literalValue = element.dynamicCast<LiteralElement>()->convert();
+                    if (literalValue.valueType() == DataType::ValueType::REAL) {
+                        value = literalValue.toReal(&success);
+                    }
+                } else if (typeName == PiSpecialValueElement::elementName) {
+                    value   = std::acos(Model::Real(-1));
+                    success = true;
+                } else if (typeName == EulersNumberSpecialValueElement::elementName) {
+                    value   = std::exp(Model::Real(1));
+                    success = true;
+                } else if (   isGrouping(element)
+                           || typeName == UnaryPlusOperatorElement::elementName) {
+                    success = foldReal(element->child(0), value);
+                } else if (typeName == UnaryMinusOperatorElement::elementName) {
+                    success = foldReal(element->child(0), value);
+                    value   = -value;
+                } else if (   typeName == AdditionOperatorElement::elementName
+                           || typeName == SubtractionOperatorElement::elementName
+                           || typeName == MultiplicationOperatorElement::elementName
+                           || typeName == DivisionOperatorElement::elementName
+                           || typeName == FractionOperatorElement::elementName) {
+                    Model::Real left;
+                    Model::Real right;
+                    if (foldReal(element->child(0), left) && foldReal(element->child(1), right)) {
+                        success = true;
+
+                        if (typeName == AdditionOperatorElement::elementName) {
+                            value = left + right;
+                        } else if (typeName == SubtractionOperatorElement::elementName) {
+                            value = left - right;
+                        } else if (typeName == MultiplicationOperatorElement::elementName) {
+                            value = left * right;
+                        } else if (right != 0) {
+                            value = left / right;
+                        } else {
+                            // Division by zero is left to the run-time library so the error is reported at run time.
+                            success = false;
+                        }
+                    }
+                }
+
+                success = success && std::isfinite(value);
+            }
+        }
+
+        return success;
+    }
+}
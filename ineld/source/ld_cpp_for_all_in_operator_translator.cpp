@@ -41,6 +41,7 @@
 #include "ld_cpp_code_generation_engine.h"
 #include "ld_cpp_context.h"
 #include "ld_cpp_translator.h"
+#include "ld_cpp_parallel_loop.h"
 #include "ld_cpp_for_all_in_operator_translator.h"
 
 namespace Ld {
@@ -87,7 +88,11 @@ namespace Ld {
                 success = engine.translateChild(iterable);
 
                 if (success) {
-                    DataType::ValueType inferredIndexValueType = iterableContentsType(iterable);
+                    DataType::ValueType inferredIndexValueType = DataType::ValueType::NONE;
+                    if (engine.inferredValueType(iterable) != DataType::ValueType::NONE) {
+                        inferredIndexValueType = iterableContentsType(iterable);
+                    }
+
                     if (inferredIndexValueType != DataType::ValueType::NONE) {
                         QSharedPointer<VariableElement> variable = index.dynamicCast<VariableElement>();
                         QString                         text0    = variable->text(0);
@@ -111,6 +116,7 @@ namespace Ld {
                             identifier.setTypeimplicitlySet();
 
                             engine.addIdentifier(identifier);
+                            engine.inferredTypeChanged(identifier, element);
                         } else {
                             DataType currentDataType = identifier.dataType();
 
@@ -146,6 +152,7 @@ namespace Ld {
                                 } else if (bestValueType != currentValueType) {
                                     DataType bestDataType = DataType::fromValueType(bestValueType);
                                     identifier->setDataType(bestDataType);
+                                    engine.inferredTypeChanged(identifier, element);
                                 }
                             } else {
                                 DataType::ValueType currentValueType = currentDataType.valueType();
@@ -560,23 +567,34 @@ namespace Ld {
                                 .arg(rangeStartVariable, rangeEndVariable);
 
             context.startNewStatement();
-            context(element) << "for (";
-
-            engine.setAsLValue();
-            success = engine.translateChild(index) && success;
-            engine.setAsRValue();
-
-            context(element) << QString("=%1 ; ").arg(rangeStartVariable);
-            success = engine.translateChild(index) && success;
-            context(element) << QString("<=%2 ; ++").arg(rangeEndVariable);
-            success = engine.translateChild(index) && success;
-            context(element) << ") {\n";
 
-            context.startedNewStatement();
-            success = engine.translateChild(operation) && success;
-            context.startNewStatement();
-            context(element) << "}\n";
-            context.startedNewStatement();
+            CppParallelLoop parallelLoop(element, iterable, engine);
+            if (parallelLoop.isParallel()) {
+                success = parallelLoop.translate(
+                    rangeStartVariable,
+                    rangeEndVariable,
+                    QString::number(lineNumber),
+                    engine
+                ) && success;
+            } else {
+                context(element) << "for (";
+
+                engine.setAsLValue();
+                success = engine.translateChild(index) && success;
+                engine.setAsRValue();
+
+                context(element) << QString("=%1 ; ").arg(rangeStartVariable);
+                success = engine.translateChild(index) && success;
+                context(element) << QString("<=%2 ; ++").arg(rangeEndVariable);
+                success = engine.translateChild(index) && success;
+                context(element) << ") {\n";
+
+                context.startedNewStatement();
+                success = engine.translateChild(operation) && success;
+                context.startNewStatement();
+                context(element) << "}\n";
+                context.startedNewStatement();
+            }
         } else {
             engine.translationErrorDetected(
                 new CppCodeGeneratorDiagnostic(
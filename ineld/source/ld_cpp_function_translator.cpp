@@ -26,6 +26,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QList>
 
 #include <ud_usage_data.h>
 
@@ -33,6 +34,9 @@
 #include "ld_element_structures.h"
 #include "ld_list_placeholder_element.h"
 #include "ld_variable_name.h"
+#include "ld_data_type.h"
+#include "ld_identifier.h"
+#include "ld_identifier_container.h"
 #include "ld_function_data.h"
 #include "ld_function_database.h"
 #include "ld_operation.h"
@@ -115,6 +119,23 @@ namespace Ld {
     }
 
 
+    bool CppFunctionTranslator::identifyInferredTypes(ElementPointer element, CppCodeGenerationEngine& engine) {
+        bool success = CppTranslator::identifyInferredTypes(element, engine);
+
+        if (success) {
+            IdentifierContainer identifier = engine.identifier(element->text(0), element->text(1));
+            if (identifier.isValid() && identifier.definedAs() == Identifier::DefinedAs::GLOBAL_SCOPE_FUNCTION) {
+                QList<DataType::ValueType> signature = specializedSignature(element, identifier, engine, true);
+                if (!signature.isEmpty()) {
+                    engine.addFunctionSpecialization(identifier, signature);
+                }
+            }
+        }
+
+        return success;
+    }
+
+
     bool CppFunctionTranslator::threadImplementation(ElementPointer element, CppCodeGenerationEngine& engine) {
         bool success = true;
 
@@ -129,6 +150,15 @@ namespace Ld {
         IdentifierContainer identifier = engine.identifier(text1, text2);
         if (identifier.isValid()) {
             QString internalName = identifier.internalName();
+
+            QList<DataType::ValueType> signature = specializedSignature(element, identifier, engine, false);
+            if (!signature.isEmpty()) {
+                int specializationIndex = engine.functionSpecializationIndex(identifier, signature);
+                if (specializationIndex >= 0) {
+                    internalName += CppCodeGenerationEngine::functionSpecializationSuffix(specializationIndex);
+                }
+            }
+
             context(element) << QString("%1(pt").arg(internalName);
 
             unsigned long numberChildren = element->numberChildren();
@@ -183,4 +213,56 @@ namespace Ld {
     bool CppFunctionTranslator::methodDefinitions(ElementPointer element, CppCodeGenerationEngine& engine) {
         return threadImplementation(element, engine);
     }
+
+
+    QList<DataType::ValueType> CppFunctionTranslator::specializedSignature(
+            ElementPointer             element,
+            const IdentifierContainer& function,
+            CppCodeGenerationEngine&   engine,
+            bool                       inferring
+        ) {
+        QList<DataType::ValueType> genericSignature = engine.genericFunctionSignature(function);
+        QList<DataType::ValueType> result;
+        bool                       specialized      = false;
+        bool                       valid            = !genericSignature.isEmpty();
+
+        unsigned long numberChildren = element->numberChildren();
+        unsigned long childIndex     = 0;
+        while (valid && childIndex < numberChildren) {
+            ElementPointer child = element->child(childIndex);
+            if (!child.isNull() && !child->isPlaceholder()) {
+                if (result.size() < genericSignature.size()) {
+                    DataType::ValueType parameterType = genericSignature.at(result.size());
+
+                    if (parameterType == DataType::ValueType::VARIANT) {
+                        DataType::ValueType argumentType;
+                        if (inferring) {
+                            argumentType = engine.inferredValueType(child);
+                        } else {
+                            argumentType = child->valueType();
+                        }
+
+                        if (argumentType == DataType::ValueType::NONE) {
+                            valid = false;
+                        } else if (argumentType != DataType::ValueType::VARIANT) {
+                            parameterType = argumentType;
+                            specialized   = true;
+                        }
+                    }
+
+                    result.append(parameterType);
+                } else {
+                    valid = false;
+                }
+            }
+
+            ++childIndex;
+        }
+
+        if (!valid || !specialized || result.size() != genericSignature.size()) {
+            result.clear();
+        }
+
+        return result;
+    }
 }
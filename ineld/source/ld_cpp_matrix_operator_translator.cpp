@@ -24,8 +24,20 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QList>
 
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+
+#include <model_intrinsic_types.h>
+#include <model_complex.h>
+#include <model_variant.h>
+
+#include "ld_element_structures.h"
 #include "ld_matrix_operator_element.h"
+#include "ld_literal_element.h"
 #include "ld_data_type.h"
 #include "ld_cpp_context.h"
 #include "ld_cpp_code_generation_engine.h"
@@ -48,11 +60,27 @@ namespace Ld {
         bool                success   = true;
         DataType::ValueType valueType = element->valueType();
         QString             matrixTypeString;
+        QString             scalarTypeString;
         switch (valueType) {
             case DataType::ValueType::MATRIX_BOOLEAN: { matrixTypeString = "MatrixBoolean";   break; }
-            case DataType::ValueType::MATRIX_INTEGER: { matrixTypeString = "MatrixInteger";   break; }
-            case DataType::ValueType::MATRIX_REAL:    { matrixTypeString = "MatrixReal";      break; }
-            case DataType::ValueType::MATRIX_COMPLEX: { matrixTypeString = "MatrixComplex";   break; }
+
+            case DataType::ValueType::MATRIX_INTEGER: {
+                matrixTypeString = "MatrixInteger";
+                scalarTypeString = "M::Integer";
+                break;
+            }
+
+            case DataType::ValueType::MATRIX_REAL: {
+                matrixTypeString = "MatrixReal";
+                scalarTypeString = "M::Real";
+                break;
+            }
+
+            case DataType::ValueType::MATRIX_COMPLEX: {
+                matrixTypeString = "MatrixComplex";
+                scalarTypeString = "M::Complex";
+                break;
+            }
 
             default: {
                 success = false;
@@ -81,20 +109,88 @@ namespace Ld {
 
             unsigned long numberRows    = matrixElement->numberRows();
             unsigned long numberColumns = matrixElement->numberColumns();
+            unsigned long numberEntries = numberRows * numberColumns;
 
-            context(element) << QString("M::%1::build(%2,%3").arg(matrixTypeString).arg(numberRows).arg(numberColumns);
+            // Large literal matrices are emitted as a packed static array, in column major order, wrapped into the
+            // matrix type once.  Entries that must be calculated at run-time are left as zeros in the packed data and
+            // updated in place on a copy of the packed matrix.  This keeps compile time roughly constant per entry
+            // rather than instantiating the variadic build method with one argument per entry.
 
-            for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
-                for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
-                    ElementPointer child = matrixElement->child(rowIndex, columnIndex);
+            QString              packedData;
+            QList<unsigned long> calculatedEntries;
+            if (!scalarTypeString.isEmpty() && numberEntries >= minimumPackedLiteralEntries) {
+                for (unsigned long entryIndex=0 ; entryIndex<numberEntries ; ++entryIndex) {
+                    ElementPointer child = matrixElement->child(entryIndex % numberRows, entryIndex / numberRows);
+                    QString        entryText;
 
-                    context(element) << ",(";
-                    engine.translateChild(child);
-                    context(element) << ")";
+                    if (!packedEntry(child, valueType, entryText)) {
+                        calculatedEntries.append(entryIndex);
+                        if (valueType == DataType::ValueType::MATRIX_COMPLEX) {
+                            entryText = QString("M::Complex(0,0)");
+                        } else {
+                            entryText = QString("0");
+                        }
+                    }
+
+                    if (entryIndex != 0) {
+                        packedData += (entryIndex % 16) == 0 ? ",\n" : ",";
+                    }
+
+                    packedData += entryText;
                 }
             }
 
-            context(element) << ")";
+            unsigned long numberCalculatedEntries = static_cast<unsigned long>(calculatedEntries.size());
+            if (!packedData.isEmpty() && numberEntries - numberCalculatedEntries >= minimumPackedLiteralEntries) {
+                QString packedMatrix = QString(
+                    "[]()->const M::%1& {"
+                        "alignas(64) static const %2 d[]={\n%3};"
+                        "static const M::%1 m(%4,%5,d);"
+                        "return m;"
+                    "}()"
+                ).arg(matrixTypeString, scalarTypeString, packedData)
+                 .arg(numberRows)
+                 .arg(numberColumns);
+
+                if (numberCalculatedEntries == 0) {
+                    context(element) << "(" << packedMatrix << ")";
+                } else {
+                    context(element) << QString("([&]()->M::%1 {M::%1 m(%2);").arg(matrixTypeString, packedMatrix);
+
+                    for (  QList<unsigned long>::const_iterator it  = calculatedEntries.constBegin(),
+                                                                end = calculatedEntries.constEnd()
+                         ; it != end
+                         ; ++it
+                        ) {
+                        unsigned long  entryIndex  = *it;
+                        unsigned long  rowIndex    = entryIndex % numberRows;
+                        unsigned long  columnIndex = entryIndex / numberRows;
+                        ElementPointer child       = matrixElement->child(rowIndex, columnIndex);
+
+                        context(element) << QString("m.update(%1,%2,(").arg(rowIndex + 1).arg(columnIndex + 1);
+                        success = engine.translateChild(child) && success;
+                        context(element) << "));";
+                    }
+
+                    context(element) << "return m;}())";
+                }
+            } else {
+                context(element) << QString("M::%1::build(%2,%3").arg(matrixTypeString)
+                                                                  .arg(numberRows)
+                                                                  .arg(numberColumns);
+
+                for (unsigned long columnIndex=0 ; columnIndex<numberColumns ; ++columnIndex) {
+                    for (unsigned long rowIndex=0 ; rowIndex<numberRows ; ++rowIndex) {
+                        ElementPointer child = matrixElement->child(rowIndex, columnIndex);
+
+                        context(element) << ",(";
+                        engine.translateChild(child);
+                        context(element) << ")";
+                    }
+                }
+
+                context(element) << ")";
+            }
         }
 
         return success;
@@ -104,4 +200,66 @@ namespace Ld {
     bool CppMatrixOperatorTranslator::methodDefinitions(ElementPointer element, CppCodeGenerationEngine& engine) {
         return threadImplementation(element, engine);
     }
+
+
+    bool CppMatrixOperatorTranslator::packedEntry(
+            ElementPointer      child,
+            DataType::ValueType valueType,
+            QString&            entryText
+        ) {
+        bool success = !child.isNull() && child->typeName() == LiteralElement::elementName;
+
+        if (success) {
+            // Real values are formatted exactly as CppLiteralTranslator formats them so packed and built matrices
+            // hold identical coefficients.
+
+            Model::Variant    value         = child.dynamicCast<LiteralElement>()->convert();
+            unsigned          realPrecision = std::numeric_limits<Model::Real>::digits10 + 1;
+            std::stringstream stream;
+
+            if (valueType == DataType::ValueType::MATRIX_INTEGER) {
+                if (value.valueType() == DataType::ValueType::INTEGER) {
+                    Model::Integer integerValue = value.toInteger(&success);
+
+                    // The most negative value can not be written as a single C++ integer literal.
+                    success = success && integerValue != std::numeric_limits<Model::Integer>::min();
+                    stream << integerValue;
+                } else {
+                    success = false;
+                }
+            } else if (valueType == DataType::ValueType::MATRIX_REAL) {
+                if (value.valueType() == DataType::ValueType::INTEGER ||
+                    value.valueType() == DataType::ValueType::REAL       ) {
+                    Model::Real realValue = value.toReal(&success);
+                    success = success && std::isfinite(realValue);
+                    stream << std::fixed << std::setprecision(realPrecision) << realValue << "L";
+                } else {
+                    success = false;
+                }
+            } else if (valueType == DataType::ValueType::MATRIX_COMPLEX) {
+                if (value.valueType() == DataType::ValueType::INTEGER ||
+                    value.valueType() == DataType::ValueType::REAL    ||
+                    value.valueType() == DataType::ValueType::COMPLEX    ) {
+                    Model::Complex complexValue = value.toComplex(&success);
+                    success = success && std::isfinite(complexValue.real()) && std::isfinite(complexValue.imag());
+
+                    stream << "M::Complex("
+                           << std::fixed << std::setprecision(realPrecision) << complexValue.real() << "L"
+                           << ","
+                           << std::fixed << std::setprecision(realPrecision) << complexValue.imag() << "L"
+                           << ")";
+                } else {
+                    success = false;
+                }
+            } else {
+                success = false;
+            }
+
+            if (success) {
+                entryText = QString::fromStdString(stream.str());
+            }
+        }
+
+        return success;
+    }
 }
@@ -0,0 +1,290 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::CppObjectCache class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileInfoList>
+#include <QDateTime>
+
+#include "ld_cpp_object_cache.h"
+
+namespace Ld {
+    const QString CppObjectCache::entryExtension(".cache");
+
+    CppObjectCache::CppObjectCache() {
+        currentMaximumSize    = defaultMaximumSize;
+        currentSize           = 0;
+        currentAccessSequence = 0;
+        currentNumberHits     = 0;
+        currentNumberMisses   = 0;
+    }
+
+
+    CppObjectCache::~CppObjectCache() {}
+
+
+    bool CppObjectCache::setDirectory(const QString& newDirectory) {
+        QMutexLocker locker(&cacheMutex);
+
+        currentDirectory.clear();
+        currentEntries.clear();
+        currentKeysByLastUse.clear();
+        currentSize = 0;
+
+        bool success;
+        if (newDirectory.isEmpty()) {
+            success = true;
+        } else {
+            success = QDir().mkpath(newDirectory);
+            if (success) {
+                currentDirectory = QDir(newDirectory).absolutePath();
+
+                QFileInfoList entryInformation = QDir(currentDirectory).entryInfoList(
+                    QStringList() << QString("*%1").arg(entryExtension),
+                    QDir::Files,
+                    QDir::Time | QDir::Reversed
+                );
+
+                for (  QFileInfoList::const_iterator it  = entryInformation.constBegin(),
+                                                     end = entryInformation.constEnd()
+                     ; it != end
+                     ; ++it
+                    ) {
+                    QByteArray key = QByteArray::fromHex(it->completeBaseName().toLatin1());
+                    if (!key.isEmpty()) {
+                        Entry entry;
+                        entry.size     = static_cast<unsigned long long>(it->size());
+                        entry.lastUsed = ++currentAccessSequence;
+
+                        currentEntries.insert(key, entry);
+                        currentKeysByLastUse.insert(entry.lastUsed, key);
+                        currentSize += entry.size;
+                    }
+                }
+
+                evict();
+            }
+        }
+
+        return success;
+    }
+
+
+    QString CppObjectCache::directory() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentDirectory;
+    }
+
+
+    bool CppObjectCache::enabled() const {
+        QMutexLocker locker(&cacheMutex);
+        return !currentDirectory.isEmpty();
+    }
+
+
+    void CppObjectCache::setMaximumSize(unsigned long long newMaximumSize) {
+        QMutexLocker locker(&cacheMutex);
+
+        currentMaximumSize = newMaximumSize;
+        evict();
+    }
+
+
+    unsigned long long CppObjectCache::maximumSize() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentMaximumSize;
+    }
+
+
+    unsigned long long CppObjectCache::size() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentSize;
+    }
+
+
+    unsigned long CppObjectCache::numberEntries() const {
+        QMutexLocker locker(&cacheMutex);
+        return static_cast<unsigned long>(currentEntries.size());
+    }
+
+
+    bool CppObjectCache::contains(const QByteArray& key) const {
+        QMutexLocker locker(&cacheMutex);
+        return currentEntries.contains(key);
+    }
+
+
+    bool CppObjectCache::retrieve(const QByteArray& key, const QString& destinationFile) {
+        QMutexLocker locker(&cacheMutex);
+
+        bool success = false;
+        if (!currentDirectory.isEmpty()) {
+            if (currentEntries.contains(key)) {
+                QString sourceFile = entryFilename(key);
+
+                if (QFile::exists(destinationFile)) {
+                    QFile::remove(destinationFile);
+                }
+
+                success = QFile::copy(sourceFile, destinationFile);
+                if (success) {
+                    touch(key);
+                } else {
+                    removeEntry(key);
+                }
+            }
+
+            if (success) {
+                ++currentNumberHits;
+            } else {
+                ++currentNumberMisses;
+            }
+        }
+
+        return success;
+    }
+
+
+    bool CppObjectCache::insert(const QByteArray& key, const QString& sourceFile) {
+        QMutexLocker locker(&cacheMutex);
+
+        bool success = false;
+        if (!currentDirectory.isEmpty() && !key.isEmpty()) {
+            unsigned long long entrySize = static_cast<unsigned long long>(QFileInfo(sourceFile).size());
+            if (entrySize <= currentMaximumSize) {
+                removeEntry(key);
+
+                // Copy under a temporary name and then rename so other processes sharing the directory never see a
+                // partially written entry.
+
+                QString filename          = entryFilename(key);
+                QString temporaryFilename = filename + QString(".partial");
+
+                QFile::remove(temporaryFilename);
+                success = QFile::copy(sourceFile, temporaryFilename);
+                if (success) {
+                    QFile::remove(filename);
+                    success = QFile::rename(temporaryFilename, filename);
+                }
+
+                if (success) {
+                    Entry entry;
+                    entry.size     = entrySize;
+                    entry.lastUsed = ++currentAccessSequence;
+
+                    currentEntries.insert(key, entry);
+                    currentKeysByLastUse.insert(entry.lastUsed, key);
+                    currentSize += entrySize;
+
+                    evict();
+                } else {
+                    QFile::remove(temporaryFilename);
+                }
+            }
+        }
+
+        return success;
+    }
+
+
+    void CppObjectCache::clear() {
+        QMutexLocker locker(&cacheMutex);
+
+        while (!currentKeysByLastUse.isEmpty()) {
+            removeEntry(currentKeysByLastUse.first());
+        }
+    }
+
+
+    unsigned long long CppObjectCache::numberHits() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentNumberHits;
+    }
+
+
+    unsigned long long CppObjectCache::numberMisses() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentNumberMisses;
+    }
+
+
+    void CppObjectCache::resetStatistics() {
+        QMutexLocker locker(&cacheMutex);
+
+        currentNumberHits   = 0;
+        currentNumberMisses = 0;
+    }
+
+
+    QString CppObjectCache::entryFilename(const QByteArray& key) const {
+        return QDir(currentDirectory).filePath(QString::fromLatin1(key.toHex()) + entryExtension);
+    }
+
+
+    void CppObjectCache::touch(const QByteArray& key) {
+        Entry& entry = currentEntries[key];
+
+        currentKeysByLastUse.remove(entry.lastUsed);
+        entry.lastUsed = ++currentAccessSequence;
+        currentKeysByLastUse.insert(entry.lastUsed, key);
+
+        // Update the modification time so the eviction order survives restarts.
+
+        QFile entryFile(entryFilename(key));
+        if (entryFile.open(QIODevice::ReadWrite)) {
+            entryFile.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+            entryFile.close();
+        }
+    }
+
+
+    void CppObjectCache::removeEntry(const QByteArray& key) {
+        QHash<QByteArray, Entry>::iterator it = currentEntries.find(key);
+        if (it != currentEntries.end()) {
+            currentKeysByLastUse.remove(it.value().lastUsed);
+            currentSize -= it.value().size;
+            currentEntries.erase(it);
+
+            QFile::remove(entryFilename(key));
+        }
+    }
+
+
+    void CppObjectCache::evict() {
+        while (currentSize > currentMaximumSize && !currentKeysByLastUse.isEmpty()) {
+            removeEntry(currentKeysByLastUse.first());
+        }
+    }
+}
@@ -0,0 +1,517 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::CppParallelLoop class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QList>
+#include <QHash>
+
+#include "ld_element_structures.h"
+#include "ld_element.h"
+#include "ld_data_type.h"
+#include "ld_variable_name.h"
+#include "ld_function_data.h"
+#include "ld_function_database.h"
+#include "ld_identifier.h"
+#include "ld_identifier_container.h"
+#include "ld_variable_element.h"
+#include "ld_function_element.h"
+#include "ld_range_2_element.h"
+#include "ld_assignment_operator_element.h"
+#include "ld_element_of_set_operator_element.h"
+#include "ld_compound_statement_operator_element.h"
+#include "ld_addition_operator_element.h"
+#include "ld_subtraction_operator_element.h"
+#include "ld_multiplication_operator_element.h"
+#include "ld_grouping_parenthesis_operator_element.h"
+#include "ld_grouping_brackets_operator_element.h"
+#include "ld_grouping_braces_operator_element.h"
+#include "ld_data_type_translator.h"
+#include "ld_cpp_data_type_translator.h"
+#include "ld_cpp_code_generator.h"
+#include "ld_cpp_context.h"
+#include "ld_cpp_code_generation_engine.h"
+#include "ld_cpp_expression_optimizer.h"
+#include "ld_cpp_parallel_loop.h"
+
+namespace Ld {
+    CppParallelLoop::CppParallelLoop(
+            ElementPointer                 element,
+            QSharedPointer<Range2Element>  range,
+            const CppCodeGenerationEngine& engine
+        ) {
+        currentElement   = element;
+        currentOperation = element->child(2);
+        currentParallel  = engine.parallelLoopsEnabled() && engine.atGlobalScope() && analyze(range);
+    }
+
+
+    CppParallelLoop::~CppParallelLoop() {}
+
+
+    bool CppParallelLoop::isParallel() const {
+        return currentParallel;
+    }
+
+
+    bool CppParallelLoop::translate(
+            const QString&           rangeStartVariable,
+            const QString&           rangeEndVariable,
+            const QString&           suffix,
+            CppCodeGenerationEngine& engine
+        ) {
+        CppContext& context = engine.context();
+
+        QString countVariable   = QString("LPC%1").arg(suffix);
+        QString workersVariable = QString("LPW%1").arg(suffix);
+        QString indexName       = currentIndex.internalName();
+
+        // The workers declare locals that shadow the model's members so the body translates unchanged.  Each
+        // worker handles a contiguous block of the range, the last worker handling the final iterations.
+
+        context(currentElement) << QString("const auto %1=(%2>=%3) ? (%2-%3+1) : 0")
+                                   .arg(countVariable, rangeEndVariable, rangeStartVariable);
+
+        context.startNewStatement();
+        context(currentElement) << QString("const unsigned %1=LdParallel::workers(static_cast<unsigned long long>(%2))")
+                                   .arg(workersVariable, countVariable);
+
+        unsigned numberReductions = static_cast<unsigned>(currentReductionVariables.size());
+        for (unsigned i=0 ; i<numberReductions ; ++i) {
+            const IdentifierContainer& variable = currentReductionVariables.at(i);
+            Reduction                  kind     = currentReductions.value(variable);
+            QString                    dataTypeName = variableTypeName(variable);
+            QString                    initial;
+
+            if (kind == Reduction::SUM) {
+                initial = QString("%1(0)").arg(dataTypeName);
+            } else if (kind == Reduction::PRODUCT) {
+                initial = QString("%1(1)").arg(dataTypeName);
+            } else {
+                initial = variable.internalName();
+            }
+
+            context.startNewStatement();
+            context(currentElement) << QString("std::vector<%1> LPR%2_%3(%4,%5)")
+                                       .arg(dataTypeName, suffix, QString::number(i), workersVariable, initial);
+        }
+
+        unsigned numberPrivates = static_cast<unsigned>(currentPrivateVariables.size());
+        for (unsigned i=0 ; i<numberPrivates ; ++i) {
+            const IdentifierContainer& variable = currentPrivateVariables.at(i);
+
+            context.startNewStatement();
+            context(currentElement) << QString("%1 LPV%2_%3")
+                                       .arg(variableTypeName(variable), suffix, QString::number(i));
+        }
+
+        context.startNewStatement();
+        context(currentElement) << QString("LdParallel::run(pt,%1,[&](unsigned LPJ) {\n").arg(workersVariable);
+        context.startedNewStatement();
+
+        context(currentElement) << QString("%1 %2").arg(variableTypeName(currentIndex), indexName);
+
+        for (unsigned i=0 ; i<numberReductions ; ++i) {
+            const IdentifierContainer& variable = currentReductionVariables.at(i);
+
+            context.startNewStatement();
+            context(currentElement) << QString("%1 %2=LPR%3_%4[LPJ]")
+                                       .arg(
+                                           variableTypeName(variable),
+                                           variable.internalName(),
+                                           suffix,
+                                           QString::number(i)
+                                       );
+        }
+
+        for (unsigned i=0 ; i<numberPrivates ; ++i) {
+            const IdentifierContainer& variable = currentPrivateVariables.at(i);
+
+            context.startNewStatement();
+            context(currentElement) << QString("%1 %2").arg(variableTypeName(variable), variable.internalName());
+        }
+
+        context.startNewStatement();
+        context(currentElement) << QString("for (%1=%2+(%3*LPJ)/%4 ; %1<%2+(%3*(LPJ+1))/%4 ; ++%1) {\n")
+                                   .arg(indexName, rangeStartVariable, countVariable, workersVariable);
+        context.startedNewStatement();
+
+        bool success = engine.translateChild(currentOperation);
+
+        context.startNewStatement();
+        context(currentElement) << "}\n";
+        context.startedNewStatement();
+
+        for (unsigned i=0 ; i<numberReductions ; ++i) {
+            context.startNewStatement();
+            context(currentElement) << QString("LPR%1_%2[LPJ]=%3")
+                                       .arg(suffix, QString::number(i), currentReductionVariables.at(i).internalName());
+        }
+
+        for (unsigned i=0 ; i<numberPrivates ; ++i) {
+            context.startNewStatement();
+            context(currentElement) << QString("if (LPJ+1==%1) { LPV%2_%3=%4; }")
+                                       .arg(
+                                           workersVariable,
+                                           suffix,
+                                           QString::number(i),
+                                           currentPrivateVariables.at(i).internalName()
+                                       );
+        }
+
+        context.startNewStatement();
+        context(currentElement) << "})";
+
+        // Partial results are combined in worker order so a given number of workers always produces the same
+        // result.
+
+        if (numberReductions > 0) {
+            context.startNewStatement();
+            context(currentElement) << QString("for (unsigned LPJ=0 ; LPJ<%1 ; ++LPJ) {\n").arg(workersVariable);
+            context.startedNewStatement();
+
+            for (unsigned i=0 ; i<numberReductions ; ++i) {
+                const IdentifierContainer& variable = currentReductionVariables.at(i);
+                Reduction                  kind     = currentReductions.value(variable);
+                QString                    name     = variable.internalName();
+                QString                    partial  = QString("LPR%1_%2[LPJ]").arg(suffix, QString::number(i));
+
+                context.startNewStatement();
+                if (kind == Reduction::SUM) {
+                    context(currentElement) << QString("%1=%1+%2").arg(name, partial);
+                } else if (kind == Reduction::PRODUCT) {
+                    context(currentElement) << QString("%1=%1*%2").arg(name, partial);
+                } else if (kind == Reduction::MINIMUM) {
+                    context(currentElement) << QString("if (%2<%1) { %1=%2; }").arg(name, partial);
+                } else {
+                    context(currentElement) << QString("if (%2>%1) { %1=%2; }").arg(name, partial);
+                }
+            }
+
+            context.startNewStatement();
+            context(currentElement) << "}\n";
+            context.startedNewStatement();
+        }
+
+        for (unsigned i=0 ; i<numberPrivates ; ++i) {
+            context.startNewStatement();
+            context(currentElement) << QString("if (%1>0) { %2=LPV%3_%4; }")
+                                       .arg(
+                                           countVariable,
+                                           currentPrivateVariables.at(i).internalName(),
+                                           suffix,
+                                           QString::number(i)
+                                       );
+        }
+
+        // Leave the index where the sequential loop would have left it.
+
+        context.startNewStatement();
+        context(currentElement) << QString("%1=%2+%3").arg(indexName, rangeStartVariable, countVariable);
+
+        return success;
+    }
+
+
+    bool CppParallelLoop::analyze(QSharedPointer<Range2Element> range) {
+        ElementPointer index  = currentElement->child(0);
+        bool           result = (
+               !index.isNull()
+            && !currentOperation.isNull()
+            && !range.isNull()
+            && index->typeName() == VariableElement::elementName
+            && !range->child(0).isNull()
+            && !range->child(1).isNull()
+            && range->child(0)->valueType() == DataType::ValueType::INTEGER
+            && range->child(1)->valueType() == DataType::ValueType::INTEGER
+            && !hasBreakpoint(currentElement)
+        );
+
+        if (result) {
+            currentIndex = index.dynamicCast<VariableElement>()->identifier();
+            result = (
+                   currentIndex.isValid()
+                && currentIndex.definedAs() == Identifier::DefinedAs::GLOBAL_SCOPE_VARIABLE
+                && currentIndex.dataType().valueType() == DataType::ValueType::INTEGER
+            );
+        }
+
+        ElementPointerList statements;
+        if (result) {
+            if (currentOperation->typeName() == CompoundStatementOperatorElement::elementName) {
+                unsigned long numberChildren = currentOperation->numberChildren();
+                for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                    ElementPointer child = currentOperation->child(childIndex);
+                    if (!child.isNull() && !child->isPlaceholder()) {
+                        statements.append(child);
+                    }
+                }
+            } else {
+                statements.append(currentOperation);
+            }
+        }
+
+        QList<IdentifierContainer> targets;
+        ElementPointerList::const_iterator statementIterator    = statements.constBegin();
+        ElementPointerList::const_iterator statementEndIterator = statements.constEnd();
+        while (result && statementIterator != statementEndIterator) {
+            ElementPointer statement = *statementIterator;
+            result = (
+                   statement->typeName() == AssignmentOperatorElement::elementName
+                && statement->valueType() != DataType::ValueType::BOOLEAN
+                && !statement->child(0).isNull()
+                && !statement->child(1).isNull()
+                && isPureExpression(statement->child(1))
+            );
+
+            if (result) {
+                ElementPointer valueElement = statement->child(0);
+                if (valueElement->typeName() == ElementOfSetOperatorElement::elementName) {
+                    valueElement = valueElement->child(0);
+                }
+
+                result = !valueElement.isNull() && valueElement->typeName() == VariableElement::elementName;
+                if (result) {
+                    IdentifierContainer target = valueElement.dynamicCast<VariableElement>()->identifier();
+                    result = (
+                           target.isValid()
+                        && !(target == currentIndex)
+                        && target.definedAs() == Identifier::DefinedAs::GLOBAL_SCOPE_VARIABLE
+                        && !variableTypeName(target).isEmpty()
+                    );
+
+                    if (result) {
+                        Reduction kind = reduction(target, statement->child(1));
+                        if (kind != Reduction::NONE) {
+                            // Partial results must combine exactly as the sequential assignments would, so the
+                            // assigned value may not be converted.
+
+                            DataType::ValueType valueType = target.dataType().valueType();
+                            result = (
+                                   !targets.contains(target)
+                                && statement->child(1)->valueType() == valueType
+                                && (   valueType == DataType::ValueType::INTEGER
+                                    || valueType == DataType::ValueType::REAL
+                                    || (   valueType == DataType::ValueType::COMPLEX
+                                        && (kind == Reduction::SUM || kind == Reduction::PRODUCT)))
+                            );
+
+                            if (result) {
+                                currentReductionVariables.append(target);
+                                currentReductions.insert(target, kind);
+                            }
+                        } else {
+                            result = !currentReductions.contains(target);
+                            if (result && !currentPrivateVariables.contains(target)) {
+                                currentPrivateVariables.append(target);
+                            }
+                        }
+
+                        targets.append(target);
+                    }
+                }
+            }
+
+            ++statementIterator;
+        }
+
+        // Reduction variables may only be read by their own statement and private variables must be assigned before
+        // they are read.
+
+        QHash<IdentifierContainer, unsigned> totalCounts;
+        unsigned numberStatements = result ? static_cast<unsigned>(statements.size()) : 0;
+        unsigned statementIndex   = 0;
+        while (result && statementIndex < numberStatements) {
+            QHash<IdentifierContainer, unsigned> counts;
+            countReferences(statements.at(statementIndex)->child(1), counts);
+
+            QHash<IdentifierContainer, unsigned>::const_iterator it  = counts.constBegin();
+            QHash<IdentifierContainer, unsigned>::const_iterator end = counts.constEnd();
+            while (result && it != end) {
+                const IdentifierContainer& variable = it.key();
+                if (currentReductions.contains(variable)) {
+                    totalCounts[variable] += it.value();
+                    result = totalCounts.value(variable) == 1 && targets.at(statementIndex) == variable;
+                } else if (currentPrivateVariables.contains(variable)) {
+                    result = targets.mid(0, statementIndex).contains(variable);
+                }
+
+                ++it;
+            }
+
+            ++statementIndex;
+        }
+
+        return result;
+    }
+
+
+    bool CppParallelLoop::hasBreakpoint(ElementPointer element) {
+        return (
+               element->instructionBreakpointSet()
+            || !element->visitDescendants(
+                   [](ElementPointer descendant) {
+                       return !descendant->instructionBreakpointSet();
+                   }
+               )
+        );
+    }
+
+
+    bool CppParallelLoop::isPureExpression(ElementPointer element) {
+        bool result = true;
+
+        if (!element.isNull() && !element->isPlaceholder()) {
+            result = CppExpressionOptimizer::isPureOperation(element);
+
+            unsigned long numberChildren = element->numberChildren();
+            unsigned long childIndex     = 0;
+            while (result && childIndex < numberChildren) {
+                result = isPureExpression(element->child(childIndex));
+                ++childIndex;
+            }
+        }
+
+        return result;
+    }
+
+
+    ElementPointer CppParallelLoop::skipGrouping(ElementPointer element) {
+        ElementPointer result = element;
+
+        while (   !result.isNull()
+               && (   result->typeName() == GroupingParenthesisOperatorElement::elementName
+                   || result->typeName() == GroupingBracketsOperatorElement::elementName
+                   || result->typeName() == GroupingBracesOperatorElement::elementName)
+               && result->numberChildren() == 1) {
+            result = result->child(0);
+        }
+
+        return result;
+    }
+
+
+    bool CppParallelLoop::isVariable(ElementPointer element, const IdentifierContainer& identifier) {
+        ElementPointer variable = skipGrouping(element);
+        return (
+               !variable.isNull()
+            && variable->typeName() == VariableElement::elementName
+            && variable.dynamicCast<VariableElement>()->identifier() == identifier
+        );
+    }
+
+
+    void CppParallelLoop::countReferences(ElementPointer element, QHash<IdentifierContainer, unsigned>& counts) {
+        if (!element.isNull()) {
+            if (element->typeName() == VariableElement::elementName) {
+                ++counts[element.dynamicCast<VariableElement>()->identifier()];
+            }
+
+            unsigned long numberChildren = element->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                countReferences(element->child(childIndex), counts);
+            }
+        }
+    }
+
+
+    CppParallelLoop::Reduction CppParallelLoop::reduction(
+            const IdentifierContainer& target,
+            ElementPointer             expression
+        ) {
+        Reduction      result    = Reduction::NONE;
+        ElementPointer operation = skipGrouping(expression);
+
+        if (!operation.isNull()) {
+            QString            typeName = operation->typeName();
+            ElementPointerList operands;
+
+            unsigned long numberChildren = operation->numberChildren();
+            for (unsigned long childIndex=0 ; childIndex<numberChildren ; ++childIndex) {
+                ElementPointer child = operation->child(childIndex);
+                if (!child.isNull() && !child->isPlaceholder()) {
+                    operands.append(child);
+                }
+            }
+
+            Reduction candidate = Reduction::NONE;
+            bool      ordered   = false;
+            if (typeName == AdditionOperatorElement::elementName) {
+                candidate = Reduction::SUM;
+            } else if (typeName == SubtractionOperatorElement::elementName) {
+                candidate = Reduction::SUM;
+                ordered   = true;
+            } else if (typeName == MultiplicationOperatorElement::elementName) {
+                candidate = Reduction::PRODUCT;
+            } else if (typeName == FunctionElement::elementName) {
+                const FunctionData& functionData = FunctionDatabase::function(
+                    VariableName(operation->text(0), operation->text(1))
+                );
+
+                if (functionData.isValid() && functionData.internalName() == QString("M::min")) {
+                    candidate = Reduction::MINIMUM;
+                } else if (functionData.isValid() && functionData.internalName() == QString("M::max")) {
+                    candidate = Reduction::MAXIMUM;
+                }
+            }
+
+            if (candidate != Reduction::NONE && operands.size() == 2) {
+                QHash<IdentifierContainer, unsigned> firstCounts;
+                QHash<IdentifierContainer, unsigned> secondCounts;
+                countReferences(operands.at(0), firstCounts);
+                countReferences(operands.at(1), secondCounts);
+
+                if (isVariable(operands.at(0), target) && !secondCounts.contains(target)) {
+                    result = candidate;
+                } else if (!ordered && isVariable(operands.at(1), target) && !firstCounts.contains(target)) {
+                    result = candidate;
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    QString CppParallelLoop::variableTypeName(const IdentifierContainer& identifier) {
+        QString  result;
+        DataType dataType = identifier.dataType();
+
+        if (dataType.isInvalid()) {
+            dataType = DataType::defaultDataType();
+        }
+
+        const CppDataTypeTranslator* translator = dynamic_cast<const CppDataTypeTranslator*>(
+            dataType.translator(CppCodeGenerator::codeGeneratorName)
+        );
+
+        if (translator != nullptr) {
+            result = translator->dataTypeName();
+        }
+
+        return result;
+    }
+}
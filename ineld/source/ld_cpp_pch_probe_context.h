@@ -0,0 +1,87 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::CppPchProbeContext class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_CPP_PCH_PROBE_CONTEXT_H
+#define LD_CPP_PCH_PROBE_CONTEXT_H
+
+#include <QString>
+#include <QSemaphore>
+
+#include <cbe_cpp_compiler_context.h>
+
+#include "ld_common.h"
+
+namespace Ld {
+    /**
+     * Compiler context used to confirm that the embedded compiler accepts a chain of precompiled headers.  The
+     * context holds a trivial translation unit.  Compiling it forces the compiler to load every precompiled header
+     * it has been configured with.
+     */
+    class LD_PUBLIC_API CppPchProbeContext:public Cbe::CppCompilerContext {
+        public:
+            /**
+             * Constructor.
+             *
+             * \param[in] objectFile The object file to be generated.
+             */
+            CppPchProbeContext(const QString& objectFile);
+
+            ~CppPchProbeContext() override;
+
+            /**
+             * Method you can use to wait for the compiler to finish.
+             *
+             * \return Returns true if the compiler completed successfully.  Returns false if the compiler reported an
+             *         error.
+             */
+            bool waitComplete();
+
+        private:
+            /**
+             * Method that is called when the compiler has finished.  Note that the method may be called from a
+             * different thread than the one used to invoke the compiler.
+             *
+             * \param[in] success Holds true if the compiler completed successfully, returns false if an error is
+             *                    reported.
+             */
+            void compilerFinished(bool success) final;
+
+            /**
+             * Semaphore released when the compiler finishes.
+             */
+            QSemaphore completedSemaphore;
+
+            /**
+             * Flag holding the compiler status.
+             */
+            bool currentSuccess;
+    };
+};
+
+#endif
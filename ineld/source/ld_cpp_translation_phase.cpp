@@ -60,8 +60,11 @@ static const struct PhaseData {
 };
 
 namespace Ld {
-    CppTranslationPhase::CppTranslationPhase(bool generateDynamicLibrary) {
-        currentNumberPhases = generateDynamicLibrary ? dynamicLibraryPhaseCount : objectFilePhaseCount;
+    CppTranslationPhase::CppTranslationPhase(bool generateDynamicLibrary, unsigned numberThreads) {
+        currentNumberPhases  = generateDynamicLibrary ? dynamicLibraryPhaseCount : objectFilePhaseCount;
+        currentNumberThreads = numberThreads > 0 ? numberThreads : 1;
+        currentThreadId      = 0;
+        currentRepeatPhase   = false;
     }
 
 
@@ -102,17 +105,49 @@ namespace Ld {
     }
 
 
-    unsigned CppTranslationPhase::numberThreads() const {
-        // Eventually we can set and return the number of threads.  Value can also be used to adjust the translation
-        // phases that are performed.
+    void CppTranslationPhase::setNumberThreads(unsigned newNumberThreads) {
+        currentNumberThreads = newNumberThreads > 0 ? newNumberThreads : 1;
+        if (currentThreadId >= currentNumberThreads) {
+            currentThreadId = currentNumberThreads - 1;
+        }
+    }
 
-        return 1;
+
+    unsigned CppTranslationPhase::numberThreads() const {
+        return currentNumberThreads;
     }
 
+
     unsigned CppTranslationPhase::threadId() const {
-        // Eventually we can loop through a subset of the translation phases for each thread that we need to build
-        // code for.  For now, everything is singly threaded so we don't loop and always return zero here.
+        return currentThreadId;
+    }
+
+
+    void CppTranslationPhase::reset() {
+        TranslationPhase::reset();
+        currentThreadId    = 0;
+        currentRepeatPhase = false;
+    }
+
+
+    void CppTranslationPhase::nextPhase() {
+        if (currentRepeatPhase) {
+            currentRepeatPhase = false;
+        } else if (phase() == Phase::THREAD_END && currentThreadId + 1 < currentNumberThreads) {
+            ++currentThreadId;
+            setPhaseNumber(static_cast<unsigned>(Phase::THREAD_DEFINITION));
+        } else {
+            TranslationPhase::nextPhase();
+        }
+    }
+
+
+    void CppTranslationPhase::repeatPhase() {
+        currentRepeatPhase = true;
+    }
+
 
-        return 0;
+    bool CppTranslationPhase::phaseWillRepeat() const {
+        return currentRepeatPhase;
     }
 }
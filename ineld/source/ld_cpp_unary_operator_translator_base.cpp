@@ -35,6 +35,7 @@
 #include "ld_cpp_code_generator_diagnostic.h"
 #include "ld_cpp_context.h"
 #include "ld_cpp_translator.h"
+#include "ld_cpp_elementwise_fusion.h"
 #include "ld_cpp_unary_operator_translator_base.h"
 
 namespace Ld {
@@ -51,7 +52,9 @@ namespace Ld {
 
         ElementPointer child0 = element->child(0);
 
-        if (!child0.isNull()) {
+        if (CppElementwiseFusion::isFusionRoot(element, engine)) {
+            success = CppElementwiseFusion::translate(element, engine);
+        } else if (!child0.isNull()) {
             context(element) << "(";
             context(element) << cppOperator();
             engine.translateChild(child0);
@@ -31,6 +31,8 @@
 #include <QWeakPointer>
 #include <QList>
 #include <QSet>
+#include <QHash>
+#include <QVector>
 #include <QByteArray>
 
 #include <cassert>
@@ -56,6 +58,7 @@
 #include "ld_data_type.h"
 #include "ld_calculated_value.h"
 #include "ld_element_cursor.h"
+#include "ld_element_iterator.h"
 #include "ld_cursor.h"
 #include "ld_cursor_state_collection.h"
 #include "ld_element.h"
@@ -95,15 +98,23 @@ namespace Ld {
     const Element::Precedence Element::matrixOperatorPrecedence         = 100;
     const Element::Precedence Element::subscriptOperatorPrecedence      = 100;
 
-    QMap<QString, Element::CreatorFunction> Element::creators;
-    bool                                    Element::currentAutoDeleteVisual = true;
+    QHash<QString, Element::TypeId>   Element::typeIdsByName;
+    QVector<QString>                  Element::typeNamesById;
+    QVector<Element::CreatorFunction> Element::creatorsById;
+    bool                              Element::currentAutoDeleteVisual = true;
 
     ElementPointer Element::create(const QString& typeName) {
-        Element*        newElement      = nullptr;
-        CreatorFunction creatorFunction = creators.value(typeName);
+        return create(typeIdsByName.value(typeName, invalidTypeId));
+    }
+
+
+    ElementPointer Element::create(TypeId typeId) {
+        Element* newElement = nullptr;
+        QString  typeName;
 
-        if (creatorFunction != nullptr) {
-            newElement = (*creatorFunction)(typeName);
+        if (typeId != invalidTypeId && typeId <= static_cast<TypeId>(creatorsById.size())) {
+            typeName   = typeNamesById.at(typeId - 1);
+            newElement = (*creatorsById.at(typeId - 1))(typeName);
         }
 
         ElementPointer sharedElement(newElement);
@@ -121,8 +132,11 @@ namespace Ld {
     bool Element::registerCreator(const QString& typeName, Element::CreatorFunction creatorFunction) {
         bool success;
 
-        if (creatorFunction != nullptr && !creators.contains(typeName)) {
-            creators.insert(typeName, creatorFunction);
+        if (creatorFunction != nullptr && !typeIdsByName.contains(typeName)) {
+            typeNamesById.append(typeName);
+            creatorsById.append(creatorFunction);
+            typeIdsByName.insert(typeName, static_cast<TypeId>(creatorsById.size()));
+
             success = true;
         } else {
             success = false;
@@ -132,6 +146,23 @@ namespace Ld {
     }
 
 
+    Element::TypeId Element::typeIdByName(const QString& typeName) {
+        return typeIdsByName.value(typeName, invalidTypeId);
+    }
+
+
+    QString Element::typeNameById(TypeId typeId) {
+        return   typeId != invalidTypeId && typeId <= static_cast<TypeId>(typeNamesById.size())
+               ? typeNamesById.at(typeId - 1)
+               : QString();
+    }
+
+
+    Element::TypeId Element::maximumTypeId() {
+        return static_cast<TypeId>(creatorsById.size());
+    }
+
+
     void Element::setAutoDeleteVisuals(bool nowAutoDeleteVisuals) {
         currentAutoDeleteVisual = nowAutoDeleteVisuals;
     }
@@ -148,7 +179,11 @@ namespace Ld {
 
         currentDiagnostic.reset();
 
-        currentHandle = Ld::Handle::create();
+        currentHandle                    = Ld::Handle::create();
+        currentTypeId                    = invalidTypeId;
+        currentIndexInParent             = invalidChildIndex;
+        currentNumberDescendants         = 0;
+        currentCalculatedValueGeneration = 0;
     }
 
 
@@ -175,6 +210,7 @@ namespace Ld {
 
     void Element::setWeakThis(const ElementWeakPointer& newWeakThis) {
         currentWeakThis = newWeakThis;
+        currentTypeId   = typeIdsByName.value(typeName(), invalidTypeId);
     }
 
 
@@ -183,6 +219,11 @@ namespace Ld {
     }
 
 
+    Element::TypeId Element::typeId() const {
+        return currentTypeId;
+    }
+
+
     Element::Precedence Element::childPrecedence() const {
         return defaultPrecedence;
     }
@@ -506,6 +547,21 @@ namespace Ld {
     }
 
 
+    unsigned long Element::numberDescendants() const {
+        return currentNumberDescendants;
+    }
+
+
+    ElementIterator Element::descendantsBegin(ElementIterator::Order order) const {
+        return ElementIterator(currentWeakThis.toStrongRef(), order);
+    }
+
+
+    ElementIterator Element::descendantsEnd() const {
+        return ElementIterator();
+    }
+
+
     ElementPointerList Element::ancestors() const {
         ElementPointerList ancestorList;
 
@@ -739,6 +795,8 @@ namespace Ld {
 
 
     void Element::setCalculatedValue(unsigned valueIndex, const CalculatedValue& calculatedValue) {
+        ++currentCalculatedValueGeneration;
+
         if (currentVisual != nullptr) {
             currentVisual->calculatedValueUpdated(valueIndex, calculatedValue);
         }
@@ -746,6 +804,8 @@ namespace Ld {
 
 
     void Element::clearCalculatedValue() {
+        ++currentCalculatedValueGeneration;
+
         if (currentVisual != nullptr) {
             currentVisual->calculatedValueCleared();
         }
@@ -757,6 +817,11 @@ namespace Ld {
     }
 
 
+    unsigned long long Element::calculatedValueGeneration() const {
+        return currentCalculatedValueGeneration;
+    }
+
+
     bool Element::supportsPayloads() const {
         return false;
     }
@@ -870,10 +935,23 @@ namespace Ld {
     }
 
 
+    void Element::descendantInstructionBreakpointUpdated(ElementPointer changedElement, bool breakpointNowSet) {
+        ElementPointer parent = currentParent.toStrongRef();
+        if (!parent.isNull()) {
+            parent->descendantInstructionBreakpointUpdated(changedElement, breakpointNowSet);
+        }
+    }
+
+
     void Element::instructionBreakpointStatusChanged(bool breakpointNowSet) {
         if (currentVisual != nullptr) {
             currentVisual->instructionBreakpointUpdated(breakpointNowSet);
         }
+
+        ElementPointer parent = currentParent.toStrongRef();
+        if (!parent.isNull()) {
+            parent->descendantInstructionBreakpointUpdated(currentWeakThis.toStrongRef(), breakpointNowSet);
+        }
     }
 
 
@@ -1062,4 +1140,23 @@ namespace Ld {
 
         return result;
     }
+
+
+    void Element::increaseNumberDescendants(unsigned long numberAdded) {
+        Element* element = this;
+        while (element != nullptr) {
+            element->currentNumberDescendants += numberAdded;
+            element = element->currentParent.toStrongRef().data();
+        }
+    }
+
+
+    void Element::decreaseNumberDescendants(unsigned long numberRemoved) {
+        Element* element = this;
+        while (element != nullptr) {
+            assert(element->currentNumberDescendants >= numberRemoved);
+            element->currentNumberDescendants -= numberRemoved;
+            element = element->currentParent.toStrongRef().data();
+        }
+    }
 }
@@ -0,0 +1,150 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::ElementImageCache class.
+***********************************************************************************************************************/
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QCryptographicHash>
+
+#include "ld_handle.h"
+#include "ld_element_structures.h"
+#include "ld_element.h"
+#include "ld_format.h"
+#include "ld_element_image.h"
+#include "ld_element_image_cache.h"
+
+namespace Ld {
+    ElementImageCache::ElementImageCache() {
+        currentNumberHits   = 0;
+        currentNumberMisses = 0;
+    }
+
+
+    ElementImageCache::~ElementImageCache() {}
+
+
+    ElementImage ElementImageCache::image(ElementPointer element, float dpi) {
+        ElementImage       result;
+        QByteArray         elementFormatHash = formatHash(element);
+        unsigned long long generation        = element->calculatedValueGeneration();
+
+        QMutexLocker locker(&cacheMutex);
+
+        const QList<Entry>& entries = currentEntries.value(element->handle());
+        for (  QList<Entry>::const_iterator it = entries.constBegin(), end = entries.constEnd()
+             ; it != end && result.isInvalid()
+             ; ++it
+            ) {
+            if (it->dpi == dpi && it->calculatedValueGeneration == generation && it->formatHash == elementFormatHash) {
+                result = it->image;
+            }
+        }
+
+        if (result.isValid()) {
+            ++currentNumberHits;
+        } else {
+            ++currentNumberMisses;
+        }
+
+        return result;
+    }
+
+
+    void ElementImageCache::insert(ElementPointer element, float dpi, const ElementImage& image) {
+        Entry entry;
+        entry.formatHash                = formatHash(element);
+        entry.dpi                       = dpi;
+        entry.calculatedValueGeneration = element->calculatedValueGeneration();
+        entry.image                     = image;
+
+        QMutexLocker locker(&cacheMutex);
+
+        // Entries for an older format or generation can never be hit again so we only keep one entry per resolution.
+
+        QList<Entry>&          entries = currentEntries[element->handle()];
+        QList<Entry>::iterator it      = entries.begin();
+        while (it != entries.end()) {
+            if (it->dpi == dpi) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        entries.append(entry);
+    }
+
+
+    void ElementImageCache::remove(const Handle& handle) {
+        QMutexLocker locker(&cacheMutex);
+        currentEntries.remove(handle);
+    }
+
+
+    void ElementImageCache::clear() {
+        QMutexLocker locker(&cacheMutex);
+        currentEntries.clear();
+    }
+
+
+    unsigned long ElementImageCache::numberEntries() const {
+        QMutexLocker locker(&cacheMutex);
+
+        unsigned long result = 0;
+        for (  QHash<Handle, QList<Entry>>::const_iterator it  = currentEntries.constBegin(),
+                                                           end = currentEntries.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            result += static_cast<unsigned long>(it.value().size());
+        }
+
+        return result;
+    }
+
+
+    unsigned long long ElementImageCache::numberHits() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentNumberHits;
+    }
+
+
+    unsigned long long ElementImageCache::numberMisses() const {
+        QMutexLocker locker(&cacheMutex);
+        return currentNumberMisses;
+    }
+
+
+    QByteArray ElementImageCache::formatHash(ElementPointer element) {
+        FormatPointer format = element->format();
+        return   format.isNull()
+               ? QByteArray()
+               : QCryptographicHash::hash(format->toString().toUtf8(), QCryptographicHash::Sha1);
+    }
+}
@@ -0,0 +1,203 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::ElementIterator class.
+***********************************************************************************************************************/
+
+#include <QSharedPointer>
+
+#include "ld_element_structures.h"
+#include "ld_element.h"
+#include "ld_element_iterator.h"
+
+namespace Ld {
+    ElementIterator::ElementIterator() {
+        currentOrder       = Order::PRE_ORDER;
+        currentIncludeRoot = false;
+    }
+
+
+    ElementIterator::ElementIterator(
+            ElementPointer subtreeRoot,
+            Order          order,
+            bool           includeRoot
+        ) {
+        currentSubtreeRoot = subtreeRoot;
+        currentOrder       = order;
+        currentIncludeRoot = includeRoot;
+
+        if (!subtreeRoot.isNull()) {
+            if (order == Order::PRE_ORDER) {
+                currentElement = includeRoot ? subtreeRoot : firstChild(subtreeRoot);
+            } else {
+                currentElement = deepestFirstDescendant(subtreeRoot);
+                if (currentElement == subtreeRoot && !includeRoot) {
+                    currentElement.reset();
+                }
+            }
+        }
+    }
+
+
+    ElementIterator::ElementIterator(const ElementIterator& other) {
+        currentSubtreeRoot = other.currentSubtreeRoot;
+        currentElement     = other.currentElement;
+        currentOrder       = other.currentOrder;
+        currentIncludeRoot = other.currentIncludeRoot;
+    }
+
+
+    ElementIterator::~ElementIterator() {}
+
+
+    ElementIterator::Order ElementIterator::order() const {
+        return currentOrder;
+    }
+
+
+    ElementPointer ElementIterator::element() const {
+        return currentElement;
+    }
+
+
+    ElementIterator& ElementIterator::operator=(const ElementIterator& other) {
+        currentSubtreeRoot = other.currentSubtreeRoot;
+        currentElement     = other.currentElement;
+        currentOrder       = other.currentOrder;
+        currentIncludeRoot = other.currentIncludeRoot;
+
+        return *this;
+    }
+
+
+    const ElementPointer& ElementIterator::operator*() const {
+        return currentElement;
+    }
+
+
+    Element* ElementIterator::operator->() const {
+        return currentElement.data();
+    }
+
+
+    ElementIterator& ElementIterator::operator++() {
+        if (!currentElement.isNull()) {
+            if (currentOrder == Order::PRE_ORDER) {
+                ElementPointer next = firstChild(currentElement);
+                ElementPointer node = currentElement;
+
+                while (next.isNull() && node != currentSubtreeRoot) {
+                    next = nextSibling(node);
+                    if (next.isNull()) {
+                        node = node->parent();
+                    }
+                }
+
+                currentElement = next;
+            } else {
+                if (currentElement == currentSubtreeRoot) {
+                    currentElement.reset();
+                } else {
+                    ElementPointer sibling = nextSibling(currentElement);
+                    if (!sibling.isNull()) {
+                        currentElement = deepestFirstDescendant(sibling);
+                    } else {
+                        currentElement = currentElement->parent();
+                        if (currentElement == currentSubtreeRoot && !currentIncludeRoot) {
+                            currentElement.reset();
+                        }
+                    }
+                }
+            }
+        }
+
+        return *this;
+    }
+
+
+    ElementIterator ElementIterator::operator++(int) {
+        ElementIterator result = *this;
+        ++(*this);
+
+        return result;
+    }
+
+
+    bool ElementIterator::operator==(const ElementIterator& other) const {
+        return currentElement == other.currentElement;
+    }
+
+
+    bool ElementIterator::operator!=(const ElementIterator& other) const {
+        return currentElement != other.currentElement;
+    }
+
+
+    ElementPointer ElementIterator::firstChild(ElementPointer element) {
+        ElementPointer result;
+
+        unsigned long numberChildren = element->numberChildren();
+        unsigned long childIndex     = 0;
+        while (result.isNull() && childIndex < numberChildren) {
+            result = element->child(childIndex);
+            ++childIndex;
+        }
+
+        return result;
+    }
+
+
+    ElementPointer ElementIterator::nextSibling(ElementPointer element) {
+        ElementPointer result;
+
+        ElementPointer parent = element->parent();
+        if (!parent.isNull()) {
+            unsigned long numberChildren = parent->numberChildren();
+            unsigned long childIndex     = parent->indexOfChild(element);
+
+            if (childIndex != Element::invalidChildIndex) {
+                ++childIndex;
+                while (result.isNull() && childIndex < numberChildren) {
+                    result = parent->child(childIndex);
+                    ++childIndex;
+                }
+            }
+        }
+
+        return result;
+    }
+
+
+    ElementPointer ElementIterator::deepestFirstDescendant(ElementPointer element) {
+        ElementPointer result = element;
+        ElementPointer child  = firstChild(result);
+
+        while (!child.isNull()) {
+            result = child;
+            child  = firstChild(result);
+        }
+
+        return result;
+    }
+}
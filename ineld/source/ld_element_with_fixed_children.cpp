@@ -129,8 +129,11 @@ namespace Ld {
                 childElement->aboutToUngraftFromTree();
 
                 childElement->currentParent.clear();
+                childElement->currentIndexInParent = invalidChildIndex;
                 currentChildren[childIndex].reset();
 
+                decreaseNumberDescendants(1 + childElement->currentNumberDescendants);
+
                 if (cursorStateCollection != nullptr) {
                     ElementPointerSet descendants = childElement->descendants();
 
@@ -164,8 +167,7 @@ namespace Ld {
             ElementPointer         childToRemove,
             CursorStateCollection* cursorStateCollection
         ) {
-        long index = currentChildren.indexOf(childToRemove);
-        return removeChild(static_cast<unsigned long>(index), cursorStateCollection);
+        return removeChild(indexOfChild(childToRemove), cursorStateCollection);
     }
 
 
@@ -184,7 +186,10 @@ namespace Ld {
                 childElement->aboutToUngraftFromTree();
 
                 childElement->currentParent.clear();
+                childElement->currentIndexInParent = invalidChildIndex;
                 currentChildren[childIndex].reset();
+
+                decreaseNumberDescendants(1 + childElement->currentNumberDescendants);
             }
         }
     }
@@ -209,6 +214,9 @@ namespace Ld {
 
                         oldChildElement->aboutToUngraftFromTree();
                         oldChildElement->currentParent.clear();
+                        oldChildElement->currentIndexInParent = invalidChildIndex;
+
+                        decreaseNumberDescendants(1 + oldChildElement->currentNumberDescendants);
                     }
 
                     ElementPointer oldParent = childElement->currentParent.toStrongRef();
@@ -217,7 +225,10 @@ namespace Ld {
                     }
 
                     currentChildren[index] = childElement;
-                    childElement->currentParent = currentWeakThis;
+                    childElement->currentParent        = currentWeakThis;
+                    childElement->currentIndexInParent = index;
+
+                    increaseNumberDescendants(1 + childElement->currentNumberDescendants);
 
                     childElement->graftedToTree();
 
@@ -326,14 +337,17 @@ namespace Ld {
 
 
     unsigned long ElementWithFixedChildren::indexOfChild(ElementPointer childElement) const {
-        unsigned long numberChildren = static_cast<unsigned long>(currentChildren.size());
-        unsigned long index          = 0;
+        unsigned long index = invalidChildIndex;
 
-        while (index < numberChildren && currentChildren[index] != childElement) {
-            ++index;
+        if (!childElement.isNull()) {
+            unsigned long childIndex = childElement->currentIndexInParent;
+            if (childIndex < static_cast<unsigned long>(currentChildren.size())   &&
+                currentChildren.at(childIndex) == childElement                       ) {
+                index = childIndex;
+            }
         }
 
-        return index >= numberChildren ? invalidChildIndex : index;
+        return index;
     }
 
 
@@ -349,6 +363,16 @@ namespace Ld {
                 currentChildren.append(nullptr);
             }
         } else if (currentNumberChildren > newNumberChildren) {
+            unsigned long numberRemovedElements = 0;
+            for (unsigned childIndex=newNumberChildren ; childIndex<currentNumberChildren ; ++childIndex) {
+                ElementPointer childElement = currentChildren.at(childIndex);
+                if (!childElement.isNull()) {
+                    numberRemovedElements += 1 + childElement->currentNumberDescendants;
+                }
+            }
+
+            decreaseNumberDescendants(numberRemovedElements);
+
             if (cursorStateCollection != nullptr) {
                 ElementPointerSet removedChildren;
                 ElementPointer    bestFinalPosition;
@@ -158,6 +158,7 @@ namespace Ld {
             Q_ASSERT(numberRemoved == 1);
 
             childToRemove->currentParent.clear();
+            decreaseNumberDescendants(1 + childToRemove->currentNumberDescendants);
 
             success = true;
         } else {
@@ -195,6 +196,7 @@ namespace Ld {
             Q_ASSERT(numberRemoved == 1);
 
             childElement->currentParent.clear();
+            decreaseNumberDescendants(1 + childElement->currentNumberDescendants);
         }
     }
 
@@ -216,6 +218,8 @@ namespace Ld {
         currentChildrenByLocation.insert(location, childElement);
         currentLocationsByChild.insert(childElement, location);
 
+        increaseNumberDescendants(1 + childElement->currentNumberDescendants);
+
         childElement->graftedToTree();
 
         if (visual() != nullptr) {
@@ -25,6 +25,7 @@
 * This file implements the \ref Ld::ElementWithPositionalChildren class.
 ***********************************************************************************************************************/
 
+#include <QtGlobal>
 #include <QList>
 #include <QSharedPointer>
 
@@ -155,8 +156,13 @@ namespace Ld {
             }
 
             childElement->currentParent.clear();
+            childElement->currentIndexInParent = invalidChildIndex;
             currentChildren.removeAt(childIndex);
 
+            decreaseNumberDescendants(1 + childElement->currentNumberDescendants);
+
+            updateChildIndices(childIndex);
+
             success = true;
         }
 
@@ -168,8 +174,7 @@ namespace Ld {
             ElementPointer         childToRemove,
             CursorStateCollection* cursorStateCollection
         ) {
-        unsigned long index = currentChildren.indexOf(childToRemove);
-        return removeChild(static_cast<unsigned long>(index), cursorStateCollection);
+        return removeChild(indexOfChild(childToRemove), cursorStateCollection);
     }
 
 
@@ -189,6 +194,9 @@ namespace Ld {
 
             currentChildren.removeFirst();
             childElement->currentParent.clear();
+            childElement->currentIndexInParent = invalidChildIndex;
+
+            decreaseNumberDescendants(1 + childElement->currentNumberDescendants);
         }
     }
 
@@ -205,9 +213,16 @@ namespace Ld {
             oldParent->removeChild(childElement, nullptr);
         }
 
-        currentChildren.insert(childIndex, childElement);
+        // QList clamps out of range insertion points so we clamp the same way when updating child indices.
+
+        unsigned long insertionIndex = qMin(childIndex, static_cast<unsigned long>(currentChildren.size()));
+
+        currentChildren.insert(static_cast<int>(insertionIndex), childElement);
         childElement->currentParent = currentWeakThis;
 
+        updateChildIndices(insertionIndex);
+        increaseNumberDescendants(1 + childElement->currentNumberDescendants);
+
         childElement->graftedToTree();
 
         if (visual() != nullptr) {
@@ -228,9 +243,16 @@ namespace Ld {
             oldParent->removeChild(childElement, nullptr);
         }
 
-        currentChildren.insert(childIndex+1, childElement);
+        // QList clamps out of range insertion points so we clamp the same way when updating child indices.
+
+        unsigned long insertionIndex = qMin(childIndex + 1, static_cast<unsigned long>(currentChildren.size()));
+
+        currentChildren.insert(static_cast<int>(insertionIndex), childElement);
         childElement->currentParent = currentWeakThis;
 
+        updateChildIndices(insertionIndex);
+        increaseNumberDescendants(1 + childElement->currentNumberDescendants);
+
         childElement->graftedToTree();
 
         if (visual() != nullptr) {
@@ -275,14 +297,17 @@ namespace Ld {
 
 
     unsigned long ElementWithPositionalChildren::indexOfChild(ElementPointer childElement) const {
-        unsigned long numberChildren = static_cast<unsigned long>(currentChildren.size());
-        unsigned long index          = 0;
+        unsigned long index = invalidChildIndex;
 
-        while (index < numberChildren && currentChildren[index] != childElement) {
-            ++index;
+        if (!childElement.isNull()) {
+            unsigned long childIndex = childElement->currentIndexInParent;
+            if (childIndex < static_cast<unsigned long>(currentChildren.size())   &&
+                currentChildren.at(childIndex) == childElement                       ) {
+                index = childIndex;
+            }
         }
 
-        return index >= numberChildren ? invalidChildIndex : index;
+        return index;
     }
 
 
@@ -394,4 +419,12 @@ namespace Ld {
 
         return success;
     }
+
+
+    void ElementWithPositionalChildren::updateChildIndices(unsigned long startingIndex) {
+        unsigned long numberChildren = static_cast<unsigned long>(currentChildren.size());
+        for (unsigned long index=startingIndex ; index<numberChildren ; ++index) {
+            currentChildren.at(index)->currentIndexInParent = index;
+        }
+    }
 }
@@ -25,8 +25,13 @@
 * This file implements the \ref Ld::FormatContainer class.
 ***********************************************************************************************************************/
 
+#include <QString>
+#include <QHash>
+
 #include <cassert>
 
+#include <util_hash_functions.h>
+
 #include "ld_format_structures.h"
 #include "ld_format.h"
 #include "ld_format_container.h"
@@ -34,21 +39,26 @@
 namespace Ld {
     FormatContainer::FormatContainer() {
         currentFormatInstance = FormatPointer();
+        currentHash           = 0;
     }
 
 
     FormatContainer::FormatContainer(const Format* formatInstance) {
         currentFormatInstance = FormatPointer(formatInstance->clone());
+        updateKey();
     }
 
 
     FormatContainer::FormatContainer(FormatPointer formatInstance) {
         currentFormatInstance = FormatPointer(formatInstance->clone());
+        updateKey();
     }
 
 
     FormatContainer::FormatContainer(const FormatContainer& other) {
         currentFormatInstance = other.currentFormatInstance;
+        currentKey            = other.currentKey;
+        currentHash           = other.currentHash;
     }
 
 
@@ -58,11 +68,13 @@ namespace Ld {
 
     void FormatContainer::setFormat(Format* formatInstance) {
         currentFormatInstance = FormatPointer(formatInstance->clone());
+        updateKey();
     }
 
 
     void FormatContainer::setFormat(FormatPointer formatInstance) {
         currentFormatInstance = formatInstance;
+        updateKey();
     }
 
 
@@ -71,8 +83,21 @@ namespace Ld {
     }
 
 
+    const QString& FormatContainer::key() const {
+        return currentKey;
+    }
+
+
+    Util::HashResult FormatContainer::hash() const {
+        return currentHash;
+    }
+
+
     FormatContainer& FormatContainer::operator=(const FormatContainer& other) {
         currentFormatInstance = other.currentFormatInstance;
+        currentKey            = other.currentKey;
+        currentHash           = other.currentHash;
+
         return *this;
     }
 
@@ -91,7 +116,7 @@ namespace Ld {
         assert(currentFormatInstance);
         assert(other.currentFormatInstance);
 
-        return currentFormatInstance->toString() == other.currentFormatInstance->toString();
+        return currentHash == other.currentHash && currentKey == other.currentKey;
     }
 
 
@@ -99,7 +124,7 @@ namespace Ld {
         assert(currentFormatInstance);
         assert(other.currentFormatInstance);
 
-        return currentFormatInstance->toString() != other.currentFormatInstance->toString();
+        return currentHash != other.currentHash || currentKey != other.currentKey;
     }
 
 
@@ -107,6 +132,22 @@ namespace Ld {
         assert(currentFormatInstance);
         assert(other.currentFormatInstance);
 
-        return currentFormatInstance->toString() < other.currentFormatInstance->toString();
+        return currentKey < other.currentKey;
+    }
+
+
+    void FormatContainer::updateKey() {
+        if (currentFormatInstance) {
+            currentKey  = currentFormatInstance->toString();
+            currentHash = ::qHash(currentKey);
+        } else {
+            currentKey.clear();
+            currentHash = 0;
+        }
+    }
+
+
+    Util::HashResult qHash(const FormatContainer& key, Util::HashSeed seed) {
+        return key.hash() ^ static_cast<Util::HashResult>(seed);
     }
 }
@@ -25,6 +25,11 @@
 * This file implements the \ref Ld::FormatOrganizer class.
 ***********************************************************************************************************************/
 
+#include <QHash>
+#include <QList>
+#include <QPair>
+
+#include <algorithm>
 #include <cassert>
 
 #include "ld_format_structures.h"
@@ -38,14 +43,24 @@ namespace Ld {
     }
 
 
+    FormatOrganizer::FormatOrganizer(const FormatOrganizer& other) {
+        updateNeeded               = other.updateNeeded;
+        uniqueFormats              = other.uniqueFormats;
+        currentIdentifiersByFormat = other.currentIdentifiersByFormat;
+        currentFormatsByIdentifier = other.currentFormatsByIdentifier;
+        currentFormatParedos       = other.currentFormatParedos;
+    }
+
+
     FormatOrganizer::~FormatOrganizer() {}
 
 
     void FormatOrganizer::addFormat(FormatContainer& newFormatContainer) {
-        if (!uniqueFormats.contains(newFormatContainer)) {
+        QHash<FormatContainer, unsigned long>::iterator it = uniqueFormats.find(newFormatContainer);
+        if (it == uniqueFormats.end()) {
             uniqueFormats.insert(newFormatContainer, 1);
         } else {
-            uniqueFormats[newFormatContainer]++;
+            ++it.value();
         }
 
         updateNeeded = true;
@@ -70,28 +85,60 @@ namespace Ld {
     }
 
 
-    FormatIdentifier FormatOrganizer::identifier(FormatPointer format) {
-        return identifier(format.data());
+    void FormatOrganizer::addFormats(const FormatOrganizer& other) {
+        for (  QHash<FormatContainer, unsigned long>::const_iterator it  = other.uniqueFormats.constBegin(),
+                                                                     end = other.uniqueFormats.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            uniqueFormats[it.key()] += it.value();
+        }
+
+        if (!other.uniqueFormats.isEmpty()) {
+            updateNeeded = true;
+        }
     }
 
 
-    FormatIdentifier FormatOrganizer::identifier(const Format* format) {
-        FormatIdentifier identifier;
+    bool FormatOrganizer::removeFormat(const FormatContainer& formatContainer) {
+        bool success;
 
+        QHash<FormatContainer, unsigned long>::iterator it = uniqueFormats.find(formatContainer);
+        if (it != uniqueFormats.end()) {
+            if (it.value() > 1) {
+                --it.value();
+            } else {
+                uniqueFormats.erase(it);
+            }
+
+            updateNeeded = true;
+            success      = true;
+        } else {
+            success = false;
+        }
+
+        return success;
+    }
+
+
+    FormatIdentifier FormatOrganizer::identifier(FormatPointer format) {
         if (updateNeeded) {
             updateNeeded = false;
             updateDataStructures();
         }
 
-        const FormatContainer container(format);
+        return currentIdentifiersByFormat.value(lookupContainer(format), invalidFormatIdentifier);
+    }
 
-        if (currentIdentifiersByFormat.contains(container)) {
-            identifier = currentIdentifiersByFormat.value(container);
-        } else {
-            identifier = invalidFormatIdentifier;
+
+    FormatIdentifier FormatOrganizer::identifier(const Format* format) {
+        if (updateNeeded) {
+            updateNeeded = false;
+            updateDataStructures();
         }
 
-        return identifier;
+        const FormatContainer container(format);
+        return currentIdentifiersByFormat.value(container, invalidFormatIdentifier);
     }
 
 
@@ -145,33 +192,48 @@ namespace Ld {
         currentIdentifiersByFormat.clear();
         currentFormatParedos.clear();
 
-        QMultiMap<long long, FormatContainer> reverseParedo;
+        typedef QPair<unsigned long, FormatContainer> ParedoEntry;
 
-        FormatIdentifiersByFormat::const_iterator formatsIterator    = uniqueFormats.begin();
-        FormatIdentifiersByFormat::const_iterator formatsEndIterator = uniqueFormats.end();
+        QList<ParedoEntry> paredo;
+        paredo.reserve(uniqueFormats.size());
 
-        while (formatsIterator != formatsEndIterator) {
-            FormatContainer container      = formatsIterator.key();
-            unsigned long   referenceCount = formatsIterator.value();
-            reverseParedo.insert(-static_cast<long long>(referenceCount), container);
-
-            ++formatsIterator;
+        for (  QHash<FormatContainer, unsigned long>::const_iterator it  = uniqueFormats.constBegin(),
+                                                                     end = uniqueFormats.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            paredo.append(ParedoEntry(it.value(), it.key()));
         }
 
-        QMultiMap<long long, FormatContainer>::const_iterator paredoIterator    = reverseParedo.begin();
-        QMultiMap<long long, FormatContainer>::const_iterator paredoEndIterator = reverseParedo.end();
+        // Order by descending reference count.  Ties are ordered by descending key so identifiers are deterministic
+        // and match the order historically produced by the map based implementation.
+        std::sort(
+            paredo.begin(),
+            paredo.end(),
+            [](const ParedoEntry& a, const ParedoEntry& b) {
+                return a.first > b.first || (a.first == b.first && b.second < a.second);
+            }
+        );
+
+        currentIdentifiersByFormat.reserve(paredo.size());
 
-        while (paredoIterator != paredoEndIterator) {
-            FormatContainer  container  = paredoIterator.value();
-            FormatIdentifier identifier = currentFormatsByIdentifier.size();
-            QString          formatType = (*container).typeName();
+        for (QList<ParedoEntry>::const_iterator it = paredo.constBegin(), end = paredo.constEnd() ; it != end ; ++it) {
+            const FormatContainer& container  = it->second;
+            FormatIdentifier       identifier = currentFormatsByIdentifier.size();
+            QString                formatType = (*container).typeName();
 
             currentFormatsByIdentifier.insert(identifier, container);
             currentIdentifiersByFormat.insert(container, identifier);
 
             currentFormatParedos[formatType].insert(identifier, container);
-
-            ++paredoIterator;
         }
     }
+
+
+    FormatContainer FormatOrganizer::lookupContainer(FormatPointer format) {
+        FormatContainer container;
+        container.setFormat(format);
+
+        return container;
+    }
 }
@@ -136,7 +136,12 @@ namespace Ld {
 
 
     void HtmlCodeGenerationEngine::registerFormat(FormatPointer format) {
-        formatOrganizer.addFormat(format);
+        int shardIndex = parallelShardIndex();
+        if (shardIndex >= 0) {
+            shardFormatOrganizers.at(shardIndex)->addFormat(format);
+        } else {
+            formatOrganizer.addFormat(format);
+        }
     }
 
 
@@ -271,6 +276,11 @@ namespace Ld {
                 break;
             }
 
+            case HtmlTranslationPhase::Phase::RENDER_IMAGES: {
+                success = preRenderImages();
+                break;
+            }
+
             case HtmlTranslationPhase::Phase::HEADER: {
                 success = preHeader();
                 break;
@@ -317,6 +327,11 @@ namespace Ld {
                 break;
             }
 
+            case HtmlTranslationPhase::Phase::RENDER_IMAGES: {
+                success = postRenderImages();
+                break;
+            }
+
             case HtmlTranslationPhase::Phase::HEADER: {
                 success = postHeader();
                 break;
@@ -369,6 +384,27 @@ namespace Ld {
     }
 
 
+    void HtmlCodeGenerationEngine::parallelTranslationStarting(unsigned numberShards) {
+        shardFormatOrganizers.clear();
+        for (unsigned shardIndex=0 ; shardIndex<numberShards ; ++shardIndex) {
+            shardFormatOrganizers.append(QSharedPointer<FormatOrganizer>(new FormatOrganizer));
+        }
+    }
+
+
+    void HtmlCodeGenerationEngine::parallelTranslationFinished(unsigned) {
+        for (  QList<QSharedPointer<FormatOrganizer>>::const_iterator it  = shardFormatOrganizers.constBegin(),
+                                                                      end = shardFormatOrganizers.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            formatOrganizer.addFormats(**it);
+        }
+
+        shardFormatOrganizers.clear();
+    }
+
+
     bool HtmlCodeGenerationEngine::preDtd() {
         bool success;
 
@@ -410,6 +446,18 @@ namespace Ld {
 
 
     bool HtmlCodeGenerationEngine::preRegisterFormats() {
+        // Root elements track the formats used by their elements incrementally, as they do for saves, so we start
+        // from those.  Translators only need to register formats that are not tied to an element.
+
+        RootElement::RootElementList rootElements = rootElementsToProcess();
+        for (  RootElement::RootElementList::const_iterator it  = rootElements.constBegin(),
+                                                            end = rootElements.constEnd()
+             ; it != end
+             ; ++it
+            ) {
+            formatOrganizer.addFormats((*it)->elementFormatOrganizer());
+        }
+
         return true;
     }
 
@@ -419,6 +467,16 @@ namespace Ld {
     }
 
 
+    bool HtmlCodeGenerationEngine::preRenderImages() {
+        return true;
+    }
+
+
+    bool HtmlCodeGenerationEngine::postRenderImages() {
+        return true;
+    }
+
+
     bool HtmlCodeGenerationEngine::preHeader() {
         bool success;
 
@@ -38,6 +38,11 @@ namespace Ld {
     HtmlImageTranslatorBase::~HtmlImageTranslatorBase() {}
 
 
+    bool HtmlImageTranslatorBase::renderImages(ElementPointer element, HtmlCodeGenerationEngine& engine) {
+        return prerenderImage(element, engine);
+    }
+
+
     bool HtmlImageTranslatorBase::body(ElementPointer element, HtmlCodeGenerationEngine& engine) {
         return writeAsImage(element, engine);
     }
@@ -26,6 +26,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QStringList>
 
 #include <cassert>
 
@@ -36,7 +37,6 @@
 
 #include <util_string.h>
 
-#include "ld_complex_data_type_translator_helpers.h"
 
 #include "ld_element.h"
 #include "ld_format_structures.h"
@@ -75,6 +75,14 @@ namespace Ld {
     HtmlMatrixComplexDataTypeTranslator::Context::~Context() {}
 
 
+    QStringList HtmlMatrixComplexDataTypeTranslator::Context::formatCell(
+            unsigned long row,
+            unsigned long column
+        ) const {
+        return componentStrings(row, column);
+    }
+
+
     bool HtmlMatrixComplexDataTypeTranslator::Context::toMathML(
             unsigned long             row,
             unsigned long             column,
@@ -83,28 +91,12 @@ namespace Ld {
         ) {
         XmlExportContext& xmlContext = engine.context();
 
-        const Model::MatrixComplex&
-            matrixComplex = dynamic_cast<const Model::MatrixComplex&>(MatrixComplexDataTypeDecoder::Context::matrix());
-        Model::Complex v = matrixComplex(row, column) * multiplier();
-
-        QString realBaselineString;
-        QString realSuperscriptString;
-        QString imaginaryBaselineString;
-        QString imaginarySuperscriptString;
-        QString imaginaryUnitString;
-
-        generateComplexValueStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            upperCase(),
-            imaginaryUnit(),
-            realBaselineString,
-            realSuperscriptString,
-            imaginaryBaselineString,
-            imaginarySuperscriptString,
-            imaginaryUnitString
-        );
+        const QStringList& strings                    = formattedCell(row, column);
+        const QString&     realBaselineString         = strings.at(0);
+        const QString&     realSuperscriptString      = strings.at(1);
+        const QString&     imaginaryBaselineString    = strings.at(2);
+        const QString&     imaginarySuperscriptString = strings.at(3);
+        const QString&     imaginaryUnitString        = strings.at(4);
 
         bool needRow = (
                !realSuperscriptString.isEmpty()
@@ -222,28 +214,12 @@ namespace Ld {
         ) {
         XmlExportContext& xmlContext = engine.context();
 
-        const Model::MatrixComplex&
-            matrixComplex = dynamic_cast<const Model::MatrixComplex&>(MatrixComplexDataTypeDecoder::Context::matrix());
-        Model::Complex v = matrixComplex(row, column) * multiplier();
-
-        QString realBaselineString;
-        QString realSuperscriptString;
-        QString imaginaryBaselineString;
-        QString imaginarySuperscriptString;
-        QString imaginaryUnitString;
-
-        generateComplexValueStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            upperCase(),
-            imaginaryUnit(),
-            realBaselineString,
-            realSuperscriptString,
-            imaginaryBaselineString,
-            imaginarySuperscriptString,
-            imaginaryUnitString
-        );
+        const QStringList& strings                    = formattedCell(row, column);
+        const QString&     realBaselineString         = strings.at(0);
+        const QString&     realSuperscriptString      = strings.at(1);
+        const QString&     imaginaryBaselineString    = strings.at(2);
+        const QString&     imaginarySuperscriptString = strings.at(3);
+        const QString&     imaginaryUnitString        = strings.at(4);
 
         if (!realBaselineString.isEmpty()) {
             if (!realSuperscriptString.isEmpty()) {
@@ -286,28 +262,12 @@ namespace Ld {
         ) {
         XmlExportContext& xmlContext = engine.context();
 
-        const Model::MatrixComplex&
-            matrixComplex = dynamic_cast<const Model::MatrixComplex&>(MatrixComplexDataTypeDecoder::Context::matrix());
-        Model::Complex v = matrixComplex(row, column) * multiplier();
-
-        QString realBaselineString;
-        QString realSuperscriptString;
-        QString imaginaryBaselineString;
-        QString imaginarySuperscriptString;
-        QString imaginaryUnitString;
-
-        generateComplexValueStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            upperCase(),
-            imaginaryUnit(),
-            realBaselineString,
-            realSuperscriptString,
-            imaginaryBaselineString,
-            imaginarySuperscriptString,
-            imaginaryUnitString
-        );
+        const QStringList& strings                    = formattedCell(row, column);
+        const QString&     realBaselineString         = strings.at(0);
+        const QString&     realSuperscriptString      = strings.at(1);
+        const QString&     imaginaryBaselineString    = strings.at(2);
+        const QString&     imaginarySuperscriptString = strings.at(3);
+        const QString&     imaginaryUnitString        = strings.at(4);
 
         if (!realBaselineString.isEmpty()) {
             insertText(realBaselineString, format(), engine);
@@ -26,6 +26,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QStringList>
 
 #include <cassert>
 
@@ -33,7 +34,6 @@
 #include <model_variant.h>
 #include <model_matrix_real.h>
 
-#include <util_string.h>
 
 #include "ld_element.h"
 #include "ld_format_structures.h"
@@ -72,6 +72,11 @@ namespace Ld {
     HtmlMatrixRealDataTypeTranslator::Context::~Context() {}
 
 
+    QStringList HtmlMatrixRealDataTypeTranslator::Context::formatCell(unsigned long row, unsigned long column) const {
+        return mantissaAndExponentStrings(row, column);
+    }
+
+
     bool HtmlMatrixRealDataTypeTranslator::Context::toMathML(
             unsigned long             row,
             unsigned long             column,
@@ -80,19 +85,9 @@ namespace Ld {
         ) {
         XmlExportContext& xmlContext = engine.context();
 
-        const Model::MatrixReal&
-            matrixReal = dynamic_cast<const Model::MatrixReal&>(MatrixRealDataTypeDecoder::Context::matrix());
-        Model::Real v = matrixReal(row, column) * multiplier();
-        QString mantissaString;
-        QString exponentString;
-
-        Util::longDoubleToMantissaAndExponentStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            mantissaString,
-            exponentString
-        );
+        const QStringList& strings        = formattedCell(row, column);
+        const QString&     mantissaString = strings.at(0);
+        const QString&     exponentString = strings.at(1);
 
         if (exponentString.isEmpty()) {
             xmlContext.writeStartElement("mn");
@@ -121,19 +116,9 @@ namespace Ld {
         ) {
         XmlExportContext& xmlContext = engine.context();
 
-        const Model::MatrixReal&
-            matrixReal = dynamic_cast<const Model::MatrixReal&>(MatrixRealDataTypeDecoder::Context::matrix());
-        Model::Real v = matrixReal(row, column) * multiplier();
-        QString mantissaString;
-        QString exponentString;
-
-        Util::longDoubleToMantissaAndExponentStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            mantissaString,
-            exponentString
-        );
+        const QStringList& strings        = formattedCell(row, column);
+        const QString&     mantissaString = strings.at(0);
+        const QString&     exponentString = strings.at(1);
 
         if (exponentString.isEmpty()) {
             xmlContext.writeCharacters(mantissaString);
@@ -153,19 +138,9 @@ namespace Ld {
         ) {
         XmlExportContext& xmlContext = engine.context();
 
-        const Model::MatrixReal&
-            matrixReal = dynamic_cast<const Model::MatrixReal&>(MatrixRealDataTypeDecoder::Context::matrix());
-        Model::Real v = matrixReal(row, column) * multiplier();
-        QString mantissaString;
-        QString exponentString;
-
-        Util::longDoubleToMantissaAndExponentStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            mantissaString,
-            exponentString
-        );
+        const QStringList& strings        = formattedCell(row, column);
+        const QString&     mantissaString = strings.at(0);
+        const QString&     exponentString = strings.at(1);
 
         insertText(mantissaString, format(), engine);
         if (!exponentString.isEmpty()) {
@@ -32,7 +32,7 @@
 #include "ld_translation_phase.h"
 #include "ld_html_translation_phase.h"
 
-static constexpr unsigned phaseCount = 4;
+static constexpr unsigned phaseCount = 5;
 
 static const struct PhaseData {
     const char*                           name;
@@ -40,6 +40,7 @@ static const struct PhaseData {
 } phaseData[phaseCount] = {
     { "DTD",              Ld::TranslationPhase::TranslationMode::NO_PER_ELEMENT_TRANSLATION },
     { "REGISTER_FORMATS", Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY },
+    { "RENDER_IMAGES",    Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY },
     { "HEADER",           Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY },
     { "BODY",             Ld::TranslationPhase::TranslationMode::HONOR_HEIRARCHY }
 };
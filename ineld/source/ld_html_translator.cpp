@@ -42,6 +42,7 @@
 #include "ld_xml_export_context.h"
 #include "ld_code_generation_engine.h"
 #include "ld_root_element.h"
+#include "ld_paragraph_element.h"
 #include "ld_html_translation_phase.h"
 #include "ld_html_code_generator_diagnostic.h"
 #include "ld_html_code_generation_engine.h"
@@ -63,6 +64,11 @@ namespace Ld {
                 break;
             }
 
+            case HtmlTranslationPhase::Phase::RENDER_IMAGES: {
+                success = renderImages(element, engine);
+                break;
+            }
+
             case HtmlTranslationPhase::Phase::HEADER: {
                 success = header(element, engine);
                 break;
@@ -93,16 +99,38 @@ namespace Ld {
     }
 
 
-    bool HtmlTranslator::registerFormats(ElementPointer element, HtmlCodeGenerationEngine& engine) {
-        FormatPointer format = element->format();
-        if (!format.isNull()) {
-            engine.registerFormat(format);
-        }
+    bool HtmlTranslator::threadSafe(const TranslationPhase& translationPhase) const {
+        const HtmlTranslationPhase& htmlTranslationPhase = dynamic_cast<const HtmlTranslationPhase&>(translationPhase);
+        HtmlTranslationPhase::Phase phase                = htmlTranslationPhase.phase();
+
+        // Image rendering reads payloads from the shared program file and drives element visuals, neither of which
+        // can be used from several threads at once, so only format registration is run on the parallel shards.
+
+        return phase == HtmlTranslationPhase::Phase::REGISTER_FORMATS;
+    }
+
 
+    bool HtmlTranslator::registerFormats(ElementPointer, HtmlCodeGenerationEngine&) {
         return true;
     }
 
 
+    bool HtmlTranslator::renderImages(ElementPointer element, HtmlCodeGenerationEngine& engine) {
+        bool success = true;
+
+        if (engine.mathMode() == HtmlCodeGenerationEngine::MathMode::IMAGES) {
+            ElementPointer parent = element->parent();
+            if (!parent.isNull()                                                          &&
+                parent->typeName() == ParagraphElement::elementName                       &&
+                element->exportImageCapability() != Element::ExportImageCapability::NONE    ) {
+                success = prerenderImage(element, engine);
+            }
+        }
+
+        return success;
+    }
+
+
     bool HtmlTranslator::header(ElementPointer, HtmlCodeGenerationEngine&) {
         return true;
     }
@@ -31,12 +31,13 @@
 #include <QColor>
 #include <QBuffer>
 #include <QByteArray>
-#include <QImageReader>
 #include <QTransform>
 #include <QImage>
 
 #include "ld_element.h"
 #include "ld_element_structures.h"
+#include "ld_element_image.h"
+#include "ld_special_characters.h"
 #include "ld_format.h"
 #include "ld_format_structures.h"
 #include "ld_xml_export_context.h"
@@ -101,8 +102,10 @@ namespace Ld {
 
                 ++endingIndex;
                 startingIndex = endingIndex;
-            } else {
+            } else if (escapeMathJax) {
                 ++endingIndex;
+            } else {
+                endingIndex = SpecialCharacters::nextNonAsciiIndex(text, endingIndex);
             }
         }
 
@@ -126,14 +129,14 @@ namespace Ld {
         bool success;
 
         if (engine.imageHandlingMode() != HtmlCodeGenerationEngine::ImageHandlingMode::EXCLUDE) {
-            QByteArray payloadData = getRawImage(element, engine);
+            ElementImage image = getImage(element, engine);
 
-            if (!payloadData.isEmpty()) {
+            if (image.isValid()) {
                 if (engine.imageHandlingMode() == HtmlCodeGenerationEngine::ImageHandlingMode::SEPARATE_PAYLOADS) {
-                    success = exportPayload(payloadData, element, engine);
+                    success = exportPayload(image, element, engine);
                 } else {
                     Q_ASSERT(engine.imageHandlingMode() == HtmlCodeGenerationEngine::ImageHandlingMode::EMBEDDED);
-                    success = embedPayload(payloadData, element, engine);
+                    success = embedPayload(image, element, engine);
                 }
             } else {
                 HtmlCodeGeneratorDiagnostic* diagnostic = new HtmlCodeGeneratorDiagnostic(
@@ -155,12 +158,22 @@ namespace Ld {
     }
 
 
-    QByteArray HtmlTranslatorHelper::getRawImage(
+    bool HtmlTranslatorHelper::prerenderImage(ElementPointer element, HtmlCodeGenerationEngine& engine) const {
+        if (engine.imageHandlingMode() != HtmlCodeGenerationEngine::ImageHandlingMode::EXCLUDE) {
+            // Failures are reported when the image is written during the body phase.
+            getImage(element, engine);
+        }
+
+        return true;
+    }
+
+
+    ElementImage HtmlTranslatorHelper::getImage(
             ElementPointer            element,
             HtmlCodeGenerationEngine& /* engine */
         ) const {
         QSharedPointer<RootElement> root = element->root().dynamicCast<RootElement>();
-        return root->exportElementImage(element, generatedImageDpi());
+        return root->elementImage(element, generatedImageDpi());
     }
 
 
@@ -184,19 +197,18 @@ namespace Ld {
 
 
     bool HtmlTranslatorHelper::exportPayload(
-            QByteArray&               imageData,
+            const ElementImage&       image,
             ElementPointer            element,
             HtmlCodeGenerationEngine& engine
         ) const {
         bool success = true;
 
-        QBuffer      buffer(&imageData);
-        QImageReader reader(&buffer);
-        QByteArray   imageFormat = reader.format();
+        QByteArray imageData   = image.data();
+        QByteArray imageFormat = image.format();
 
         Handle  elementHandle = element->handle();
         QString imageFilename = elementHandle.toCaseInsensitiveQString() + "." + QString(imageFormat);
-        QSize   imageSize     = reader.size();
+        QSize   imageSize     = image.size();
         float   scaleFactor   = htmlImageDpi() / generatedImageDpi();
         QSize   htmlSize(int(0.5 + imageSize.width() * scaleFactor), int(0.5 + imageSize.height() * scaleFactor));
 
@@ -206,16 +218,19 @@ namespace Ld {
             if (!format.isNull()) {
                 Format::Rotation rotation = getImageRotation(element, format, engine);
                 if (rotation != Format::Rotation::NO_ROTATION) {
-                    QImage image;
-                    success = image.loadFromData(imageData);
+                    QImage decodedImage;
+                    success = decodedImage.loadFromData(imageData);
                     if (success) {
                         QTransform transformationMatrix;
                         transformationMatrix.rotate(-90.0 * static_cast<int>(rotation));
-                        image = image.transformed(transformationMatrix, Qt::TransformationMode::SmoothTransformation);
+                        decodedImage = decodedImage.transformed(
+                            transformationMatrix,
+                            Qt::TransformationMode::SmoothTransformation
+                        );
 
                         QByteArray newImageData;
                         QBuffer saveBuffer(&newImageData);
-                        success = image.save(&saveBuffer, imageFormat.data());
+                        success = decodedImage.save(&saveBuffer, imageFormat.data());
                         if (success) {
                             imageData = newImageData;
                         }
@@ -270,47 +285,48 @@ namespace Ld {
 
 
     bool HtmlTranslatorHelper::embedPayload(
-            QByteArray&               imageData,
+            const ElementImage&       image,
             ElementPointer            element,
             HtmlCodeGenerationEngine& engine
         ) const {
         bool success = true;
 
-        QBuffer      buffer(&imageData);
-        QImageReader reader(&buffer);
-        QString      imageFormat    = QString(reader.format()).toLower();
-        bool         rebuildPayload = false;
-        QImage       image;
+        QString imageFormat = QString(image.format());
+        QSize   imageSize   = image.size();
+        float   scaleFactor = htmlImageDpi() / generatedImageDpi();
+        QSize   htmlSize(int(0.5 + imageSize.width() * scaleFactor), int(0.5 + imageSize.height() * scaleFactor));
 
-        success = image.loadFromData(imageData);
-        if (success) {
-            QSize imageSize     = image.size();
-            float scaleFactor   = htmlImageDpi() / generatedImageDpi();
-            QSize htmlSize(int(0.5 + imageSize.width() * scaleFactor), int(0.5 + imageSize.height() * scaleFactor));
+        Format::Rotation rotation = Format::Rotation::NO_ROTATION;
 
-            if (engine.htmlStyle() == HtmlCodeGenerationEngine::HtmlStyle::HTML4_WITHOUT_CSS) {
-                FormatPointer    format   = element->format();
-                Format::Rotation rotation =   !format.isNull()
-                                            ? getImageRotation(element, format, engine)
-                                            : Format::Rotation::NO_ROTATION;
+        if (engine.htmlStyle() == HtmlCodeGenerationEngine::HtmlStyle::HTML4_WITHOUT_CSS) {
+            FormatPointer format = element->format();
+            if (!format.isNull()) {
+                rotation = getImageRotation(element, format, engine);
+            }
+        }
 
+        bool convertFormat = imageFormat != "png" && imageFormat != "jpg" && imageFormat != "jpeg";
+        if (rotation != Format::Rotation::NO_ROTATION || convertFormat) {
+            // Only decode the image when the payload must actually be rebuilt.
+            QImage decodedImage;
+            success = decodedImage.loadFromData(image.data());
+            if (success) {
                 if (rotation != Format::Rotation::NO_ROTATION) {
                     QTransform transformationMatrix;
                     transformationMatrix.rotate(-90.0 * static_cast<int>(rotation));
-                    image = image.transformed(transformationMatrix, Qt::TransformationMode::SmoothTransformation);
-                    rebuildPayload = true;
+                    decodedImage = decodedImage.transformed(
+                        transformationMatrix,
+                        Qt::TransformationMode::SmoothTransformation
+                    );
                 }
-            }
 
-            if (imageFormat != "png" && imageFormat != "jpg" && imageFormat != "jpeg") {
-                imageFormat    = "png";
-                rebuildPayload = true;
-            }
+                if (convertFormat) {
+                    imageFormat = "png";
+                }
 
-            if (rebuildPayload) {
                 QByteArray newImageData;
                 QBuffer saveBuffer(&newImageData);
-                success = image.save(&saveBuffer, imageFormat.toLocal8Bit().data());
+                success = decodedImage.save(&saveBuffer, imageFormat.toLocal8Bit().data());
                 if (success) {
                     success = embedPreparedPayload(newImageData, imageFormat, htmlSize, element, engine);
                 } else {
@@ -325,18 +341,18 @@ namespace Ld {
                     engine.translationErrorDetected(diagnostic);
                 }
             } else {
-                success = embedPreparedPayload(imageData, imageFormat, htmlSize, element, engine);
+                HtmlCodeGeneratorDiagnostic* diagnostic = new HtmlCodeGeneratorDiagnostic(
+                    element,
+                    HtmlCodeGeneratorDiagnostic::Type::INTERNAL_ERROR,
+                    dynamic_cast<const HtmlTranslationPhase&>(engine.translationPhase()),
+                    HtmlCodeGeneratorDiagnostic::Code::BAD_IMAGE_PAYLOAD,
+                    engine.contextPointer()
+                );
+
+                engine.translationErrorDetected(diagnostic);
             }
         } else {
-            HtmlCodeGeneratorDiagnostic* diagnostic = new HtmlCodeGeneratorDiagnostic(
-                element,
-                HtmlCodeGeneratorDiagnostic::Type::INTERNAL_ERROR,
-                dynamic_cast<const HtmlTranslationPhase&>(engine.translationPhase()),
-                HtmlCodeGeneratorDiagnostic::Code::BAD_IMAGE_PAYLOAD,
-                engine.contextPointer()
-            );
-
-            engine.translationErrorDetected(diagnostic);
+            success = embedPreparedPayload(image.data(), imageFormat, htmlSize, element, engine);
         }
 
         return success;
@@ -313,6 +313,11 @@ namespace Ld {
                 break;
             }
 
+            case LaTeXTranslationPhase::Phase::RENDER_IMAGES: {
+                success = preRenderImages();
+                break;
+            }
+
             case LaTeXTranslationPhase::Phase::PREAMBLE: {
                 success = prePreamble();
                 break;
@@ -354,6 +359,11 @@ namespace Ld {
                 break;
             }
 
+            case LaTeXTranslationPhase::Phase::RENDER_IMAGES: {
+                success = postRenderImages();
+                break;
+            }
+
             case LaTeXTranslationPhase::Phase::PREAMBLE: {
                 success = postPreamble();
                 break;
@@ -437,6 +447,16 @@ namespace Ld {
     }
 
 
+    bool LaTeXCodeGenerationEngine::preRenderImages() {
+        return true;
+    }
+
+
+    bool LaTeXCodeGenerationEngine::postRenderImages() {
+        return true;
+    }
+
+
     bool LaTeXCodeGenerationEngine::prePreamble() {
         bool success;
 
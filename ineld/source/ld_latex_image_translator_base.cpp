@@ -27,7 +27,6 @@
 
 #include <QString>
 #include <QBuffer>
-#include <QImageReader>
 #include <QImage>
 #include <QFileInfo>
 
@@ -37,6 +36,7 @@
 
 #include "ld_element.h"
 #include "ld_element_structures.h"
+#include "ld_element_image.h"
 #include "ld_root_element.h"
 #include "ld_format.h"
 #include "ld_format_structures.h"
@@ -61,17 +61,21 @@ namespace Ld {
     }
 
 
+    bool LaTeXImageTranslatorBase::renderImages(ElementPointer element, LaTeXCodeGenerationEngine& engine) {
+        // Failures are reported when the image is inserted during the body phase.
+        getImage(element, engine);
+        return true;
+    }
+
+
     bool LaTeXImageTranslatorBase::body(ElementPointer element, LaTeXCodeGenerationEngine& engine) {
         bool               success;
         TextExportContext& context = engine.context();
 
-        QByteArray rawPayload = getRawImage(element, engine);
-
-        if (!rawPayload.isEmpty()) {
-            QBuffer      buffer(&rawPayload);
-            QImageReader reader(&buffer);
+        ElementImage image = getImage(element, engine);
 
-            QString currentImageFormat = QString(reader.format()).toLower();
+        if (image.isValid()) {
+            QString currentImageFormat = QString(image.format());
             Handle  elementHandle      = element->handle();
             QString command;
 
@@ -87,7 +91,7 @@ namespace Ld {
                 float imageHeightPoints = 0;
 
                 QString newFormat = translateImage(
-                    rawPayload,
+                    image.data(),
                     currentImageFormat,
                     imageMode,
                     translatedPayload,
@@ -157,9 +161,9 @@ namespace Ld {
     }
 
 
-    QByteArray LaTeXImageTranslatorBase::getRawImage(ElementPointer element, LaTeXCodeGenerationEngine& /* engine */) {
+    ElementImage LaTeXImageTranslatorBase::getImage(ElementPointer element, LaTeXCodeGenerationEngine& /* engine */) {
         QSharedPointer<RootElement> root = element->root().dynamicCast<RootElement>();
-        return root->exportElementImage(element, defaultDpi);
+        return root->elementImage(element, defaultDpi);
     }
 
 
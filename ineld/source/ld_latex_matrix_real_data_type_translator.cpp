@@ -26,6 +26,7 @@
 ***********************************************************************************************************************/
 
 #include <QString>
+#include <QStringList>
 
 #include <cassert>
 
@@ -33,7 +34,6 @@
 #include <model_variant.h>
 #include <model_matrix_real.h>
 
-#include <util_string.h>
 
 #include "ld_element.h"
 #include "ld_element_structures.h"
@@ -71,6 +71,11 @@ namespace Ld {
     LaTeXMatrixRealDataTypeTranslator::Context::~Context() {}
 
 
+    QStringList LaTeXMatrixRealDataTypeTranslator::Context::formatCell(unsigned long row, unsigned long column) const {
+        return mantissaAndExponentStrings(row, column);
+    }
+
+
     bool LaTeXMatrixRealDataTypeTranslator::Context::toLaTeX(
             unsigned long              row,
             unsigned long              column,
@@ -79,20 +84,9 @@ namespace Ld {
         ) {
         TextExportContext& textContext = engine.context();
 
-        const Model::MatrixReal&
-            matrixReal = dynamic_cast<const Model::MatrixReal&>(MatrixRealDataTypeDecoder::Context::matrix());
-        Model::Real v = matrixReal(row, column) * multiplier();
-
-        QString mantissaString;
-        QString exponentString;
-
-        Util::longDoubleToMantissaAndExponentStrings(
-            v,
-            realNumberStyle(),
-            precision(),
-            mantissaString,
-            exponentString
-        );
+        const QStringList& strings        = formattedCell(row, column);
+        const QString&     mantissaString = strings.at(0);
+        const QString&     exponentString = strings.at(1);
 
         textContext << mantissaString;
         if (!exponentString.isEmpty()) {
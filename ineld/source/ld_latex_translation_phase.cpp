@@ -30,13 +30,14 @@
 #include "ld_translation_phase.h"
 #include "ld_latex_translation_phase.h"
 
-static constexpr unsigned phaseCount = 3;
+static constexpr unsigned phaseCount = 4;
 
 static const struct PhaseData {
     const char*                           name;
     Ld::TranslationPhase::TranslationMode mode;
 } phaseData[phaseCount] = {
     { "IDENTIFY_DEPENDENCIES", Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY },
+    { "RENDER_IMAGES",         Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY },
     { "PREAMBLE",              Ld::TranslationPhase::TranslationMode::NO_PER_ELEMENT_TRANSLATION },
     { "BODY",                  Ld::TranslationPhase::TranslationMode::HONOR_HEIRARCHY }
 };
@@ -43,9 +43,37 @@
 #include "ld_latex_code_generation_engine.h"
 #include "ld_latex_translator.h"
 
-namespace Ld {
-    QMap<SpecialCharacters::UnicodeValue, QString> LaTeXTranslator::commandsByUnicodeValue;
+/**
+ * Function that returns the LaTeX escape sequence for an ASCII character.
+ *
+ * \param[in] unicodeValue The ASCII character to be escaped.
+ *
+ * \param[in] textMode     If true, the text is being inserted in text mode.  If false, the text is being inserted in
+ *                         math mode.
+ *
+ * \return Returns the escape sequence.  A null pointer is returned if the character does not need to be escaped.
+ */
+static inline const char* escapeSequence(Ld::SpecialCharacters::UnicodeValue unicodeValue, bool textMode) {
+    const char* result;
+
+    switch (unicodeValue) {
+        case '$':  { result = "\\$";                                        break; }
+        case '%':  { result = "\\%";                                        break; }
+        case '&':  { result = "\\&";                                        break; }
+        case '#':  { result = "\\#";                                        break; }
+        case '_':  { result = "\\_";                                        break; }
+        case '{':  { result = "\\{";                                        break; }
+        case '}':  { result = "\\}";                                        break; }
+        case '~':  { result = textMode ? "\\textasciitilde" : "\\sim";      break; }
+        case '^':  { result = textMode ? "\\textasciicircum" : "\\^{}";     break; }
+        case '\\': { result = textMode ? "\\textbackslash" : "\\backslash"; break; }
+        default:   { result = nullptr;                                      break; }
+    }
+
+    return result;
+}
 
+namespace Ld {
     LaTeXTranslator::~LaTeXTranslator() {}
 
     bool LaTeXTranslator::translate(ElementPointer element, CodeGenerationEngine& codeGenerationEngine) {
@@ -62,6 +90,11 @@ namespace Ld {
                 break;
             }
 
+            case LaTeXTranslationPhase::Phase::RENDER_IMAGES: {
+                success = renderImages(element, engine);
+                break;
+            }
+
             case LaTeXTranslationPhase::Phase::BODY: {
                 success = body(element, engine);
                 break;
@@ -92,6 +125,11 @@ namespace Ld {
     }
 
 
+    bool LaTeXTranslator::renderImages(ElementPointer, LaTeXCodeGenerationEngine&) {
+        return true;
+    }
+
+
     bool LaTeXTranslator::body(ElementPointer, LaTeXCodeGenerationEngine&) {
         return true;
     }
@@ -102,89 +140,49 @@ namespace Ld {
             LaTeXCodeGenerationEngine::UnicodeMode unicodeTranslationMode,
             bool                                   textMode
         ) {
-        QString  result;
-        unsigned length = static_cast<unsigned>(rawText.length());
-
-        for (unsigned index=0 ; index<length ; ++index) {
-            QChar c = rawText.at(index);
-            if (c == QChar('$')) {
-                result += "\\$";
-            } else if (c == QChar('%')) {
-                result += "\\%";
-            } else if (c == QChar('&')) {
-                result += "\\&";
-            } else if (c == QChar('#')) {
-                result += "\\#";
-            } else if (c == QChar('_')) {
-                result += "\\_";
-            } else if (c == QChar('{')) {
-                result += "\\{";
-            } else if (c == QChar('}')) {
-                result += "\\}";
-            } else if (c == QChar('~')) {
-                if (textMode) {
-                    result += "\\textasciitilde";
-                } else {
-                    result += "\\sim";
-                }
-            } else if (c == QChar('^')) {
-                if (textMode) {
-                    result += "\\textasciicircum";
-                } else {
-                    result += "\\^{}";
+        QString       result;
+        const QChar*  data          = rawText.constData();
+        unsigned long length        = static_cast<unsigned long>(rawText.length());
+        unsigned long startingIndex = 0;
+
+        result.reserve(rawText.length());
+
+        for (unsigned long index=0 ; index<length ; ++index) {
+            SpecialCharacters::UnicodeValue unicodeValue = data[index].unicode();
+            if (unicodeValue <= 0x7F) {
+                const char* escape = escapeSequence(unicodeValue, textMode);
+                if (escape != nullptr) {
+                    result.append(data + startingIndex, static_cast<int>(index - startingIndex));
+                    result += QString::fromLatin1(escape);
+                    startingIndex = index + 1;
                 }
-            } else if (c == QChar('\\')) {
-                if (textMode) {
-                    result += "\\textbackslash";
-                } else {
-                    result += "\\backslash";
-                }
-            } else {
-                SpecialCharacters::UnicodeValue unicodeValue = c.unicode();
-                if (unicodeValue > 0x7F) {
-                    switch (unicodeTranslationMode) {
-                        case LaTeXCodeGenerationEngine::UnicodeMode::INSERT_UNICODE: {
-                            result += c;
-                            break;
-                        }
+            } else if (unicodeTranslationMode != LaTeXCodeGenerationEngine::UnicodeMode::INSERT_UNICODE) {
+                result.append(data + startingIndex, static_cast<int>(index - startingIndex));
+                startingIndex = index + 1;
 
-                        case LaTeXCodeGenerationEngine::UnicodeMode::CONVERT_TO_HAT_NOTATION: {
-                            QString  unicodeString       = QString::number(unicodeValue, 16);
-                            unsigned unicodeStringLength = static_cast<unsigned>(unicodeString.length());
+                if (unicodeTranslationMode == LaTeXCodeGenerationEngine::UnicodeMode::CONVERT_TO_HAT_NOTATION) {
+                    QString  unicodeString       = QString::number(unicodeValue, 16);
+                    unsigned unicodeStringLength = static_cast<unsigned>(unicodeString.length());
 
-                            result += QString("^").repeated(unicodeStringLength) + unicodeString;
-                            break;
-                        }
-
-                        case LaTeXCodeGenerationEngine::UnicodeMode::CONVERT_TO_LATEX_COMMAND: {
-                            if (commandsByUnicodeValue.isEmpty()) {
-                                commandsByUnicodeValue = SpecialCharacters::characterCommandsByUnicodeValue(
-                                    true, // Greek
-                                    true, // Diacriticals
-                                    true, // other special characters
-                                    true  // other special symbols
-                                );
-                            }
-
-                            if (commandsByUnicodeValue.contains(unicodeValue)) {
-                                QString command = commandsByUnicodeValue.value(unicodeValue);
-                                if (textMode) {
-                                    result += QString("$\\%1$").arg(command);
-                                } else {
-                                    result += QString("\\%1").arg(command);
-                                }
-                            } else {
-                                result += QString("\textbf{!!Unknown Character U%1!!}")
-                                          .arg(unicodeValue, 4, 16, QChar('0'));
-                            }
+                    result += QString("^").repeated(unicodeStringLength) + unicodeString;
+                } else {
+                    QString command = SpecialCharacters::commandForUnicodeValue(unicodeValue);
+                    if (!command.isEmpty()) {
+                        if (textMode) {
+                            result += QString("$\\%1$").arg(command);
+                        } else {
+                            result += QString("\\%1").arg(command);
                         }
+                    } else {
+                        result += QString("\\textbf{!!Unknown Character U%1!!}")
+                                  .arg(unicodeValue, 4, 16, QChar('0'));
                     }
-                } else {
-                    result += c;
                 }
             }
         }
 
+        result.append(data + startingIndex, static_cast<int>(length - startingIndex));
+
         return result;
     }
 }
@@ -107,7 +107,7 @@ namespace Ld {
     }
 
 
-    QString MatrixBooleanDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) {
+    QString MatrixBooleanDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) const {
         Model::Boolean b = currentMatrix(row, column);
         return Util::booleanToUnicodeString(b, currentBooleanStyle);
     }
@@ -27,6 +27,7 @@
 
 #include <QCoreApplication>
 #include <QString>
+#include <QStringList>
 #include <QSharedPointer>
 
 #include <cassert>
@@ -45,6 +46,7 @@
 #include "ld_data_type_decoder.h"
 #include "ld_matrix_data_type_decoder.h"
 #include "ld_matrix_complex_data_type_decoder.h"
+#include "ld_complex_data_type_translator_helpers.h"
 
 /***********************************************************************************************************************
  * MatrixComplexDataTypeDecoder::Context:
@@ -137,7 +139,38 @@ namespace Ld {
     }
 
 
-    QString MatrixComplexDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) {
+    QStringList MatrixComplexDataTypeDecoder::Context::componentStrings(unsigned long row, unsigned long column) const {
+        QString realBaselineString;
+        QString realSuperscriptString;
+        QString imaginaryBaselineString;
+        QString imaginarySuperscriptString;
+        QString imaginaryUnitString;
+
+        generateComplexValueStrings(
+            currentMatrix(row, column) * currentMultiplier,
+            currentRealNumberStyle,
+            currentPrecision,
+            currentUpperCase,
+            currentImaginaryUnit,
+            realBaselineString,
+            realSuperscriptString,
+            imaginaryBaselineString,
+            imaginarySuperscriptString,
+            imaginaryUnitString
+        );
+
+        return (
+               QStringList()
+            << realBaselineString
+            << realSuperscriptString
+            << imaginaryBaselineString
+            << imaginarySuperscriptString
+            << imaginaryUnitString
+        );
+    }
+
+
+    QString MatrixComplexDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) const {
         Model::Complex c = currentMatrix(row, column) * currentMultiplier;
         Model::Real    r = c.real();
         Model::Real    i = c.imag();
@@ -25,6 +25,14 @@
 * This file implements the \ref Ld::MatrixDataTypeDecoder class.
 ***********************************************************************************************************************/
 
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+
 #include <algorithm>
 
 #include <model_matrix.h>
@@ -34,12 +42,71 @@
 #include "ld_data_type_decoder.h"
 #include "ld_matrix_data_type_decoder.h"
 
+/**
+ * The minimum number of matrix elements we'll assign to a worker thread when formatting.  Smaller shards are not worth
+ * the thread hand-off.
+ */
+static constexpr unsigned long minimumCellsPerShard = 1024;
+
+/***********************************************************************************************************************
+ * Ld::MatrixDataTypeDecoder::Context::FormattingShard:
+ */
+
+namespace Ld {
+    class MatrixDataTypeDecoder::Context::FormattingShard:public QRunnable {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] context          The context to be formatted.
+             *
+             * \param[in] startingRowIndex The zero based index of the first visible row to format.
+             *
+             * \param[in] endingRowIndex   The zero based index just past the last visible row to format.
+             */
+            FormattingShard(Context* context, unsigned long startingRowIndex, unsigned long endingRowIndex) {
+                currentContext          = context;
+                currentStartingRowIndex = startingRowIndex;
+                currentEndingRowIndex   = endingRowIndex;
+
+                setAutoDelete(false);
+            }
+
+            ~FormattingShard() override {}
+
+            /**
+             * Method that formats each row in this shard.
+             */
+            void run() override {
+                currentContext->formatVisibleRows(currentStartingRowIndex, currentEndingRowIndex);
+            }
+
+        private:
+            /**
+             * The context being formatted.
+             */
+            Context* currentContext;
+
+            /**
+             * The first visible row to be formatted.
+             */
+            unsigned long currentStartingRowIndex;
+
+            /**
+             * The visible row just past the last row to be formatted.
+             */
+            unsigned long currentEndingRowIndex;
+    };
+}
+
 /***********************************************************************************************************************
  * Ld::MatrixDataTypeDecoder::Context:
  */
 
 namespace Ld {
-    MatrixDataTypeDecoder::Context::Context(FormatPointer format):currentFormat(format) {}
+    MatrixDataTypeDecoder::Context::Context(FormatPointer format):currentFormat(format) {
+        currentCellsFormatted = false;
+    }
 
 
     MatrixDataTypeDecoder::Context::~Context() {}
@@ -117,6 +184,113 @@ namespace Ld {
         } else {
             currentFirstTrailingColumn = numberColumns - currentNumberTrailingColumns + 1;
         }
+
+        currentFormattedCells.clear();
+        currentCellsFormatted = false;
+    }
+
+
+    QStringList MatrixDataTypeDecoder::Context::formatCell(unsigned long row, unsigned long column) const {
+        return QStringList() << toString(row, column);
+    }
+
+
+    const QStringList& MatrixDataTypeDecoder::Context::formattedCell(unsigned long row, unsigned long column) {
+        if (!currentCellsFormatted) {
+            formatVisibleCells();
+        }
+
+        unsigned long numberVisibleColumns = currentNumberLeadingColumns + currentNumberTrailingColumns;
+        unsigned long cellIndex            = visibleRowIndex(row) * numberVisibleColumns + visibleColumnIndex(column);
+
+        return currentFormattedCells.at(static_cast<int>(cellIndex));
+    }
+
+
+    void MatrixDataTypeDecoder::Context::formatVisibleCells() {
+        unsigned long numberVisibleRows    = currentNumberLeadingRows + currentNumberTrailingRows;
+        unsigned long numberVisibleColumns = currentNumberLeadingColumns + currentNumberTrailingColumns;
+        unsigned long numberCells          = numberVisibleRows * numberVisibleColumns;
+
+        currentFormattedCells.clear();
+        currentFormattedCells.resize(static_cast<int>(numberCells));
+
+        unsigned long numberShards = std::min(
+            std::min(static_cast<unsigned long>(std::max(QThread::idealThreadCount(), 1)), numberVisibleRows),
+            numberCells / minimumCellsPerShard
+        );
+
+        if (numberShards > 1) {
+            // Each shard writes a disjoint, contiguous range of rows into the pre-sized buffer.  The first shard runs
+            // on this thread.
+
+            QList<FormattingShard*> shards;
+            unsigned long           startingRowIndex = 0;
+            for (unsigned long shardIndex=0 ; shardIndex<numberShards ; ++shardIndex) {
+                unsigned long endingRowIndex = (numberVisibleRows * (shardIndex + 1)) / numberShards;
+                shards.append(new FormattingShard(this, startingRowIndex, endingRowIndex));
+                startingRowIndex = endingRowIndex;
+            }
+
+            QThreadPool threadPool;
+            threadPool.setMaxThreadCount(static_cast<int>(numberShards - 1));
+
+            for (unsigned long shardIndex=1 ; shardIndex<numberShards ; ++shardIndex) {
+                threadPool.start(shards.at(static_cast<int>(shardIndex)));
+            }
+
+            shards.first()->run();
+            threadPool.waitForDone();
+
+            for (  QList<FormattingShard*>::const_iterator it = shards.constBegin(), end = shards.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                delete *it;
+            }
+        } else {
+            formatVisibleRows(0, numberVisibleRows);
+        }
+
+        currentCellsFormatted = true;
+    }
+
+
+    void MatrixDataTypeDecoder::Context::formatVisibleRows(
+            unsigned long startingRowIndex,
+            unsigned long endingRowIndex
+        ) {
+        unsigned long numberVisibleColumns = currentNumberLeadingColumns + currentNumberTrailingColumns;
+        QStringList*  cell                 = currentFormattedCells.data() + startingRowIndex * numberVisibleColumns;
+
+        for (unsigned long rowIndex=startingRowIndex ; rowIndex<endingRowIndex ; ++rowIndex) {
+            unsigned long row =   rowIndex < currentNumberLeadingRows
+                                ? rowIndex + 1
+                                : currentFirstTrailingRow + (rowIndex - currentNumberLeadingRows);
+
+            for (unsigned long columnIndex=0 ; columnIndex<numberVisibleColumns ; ++columnIndex) {
+                unsigned long column =   columnIndex < currentNumberLeadingColumns
+                                       ? columnIndex + 1
+                                       : currentFirstTrailingColumn + (columnIndex - currentNumberLeadingColumns);
+
+                *cell = formatCell(row, column);
+                ++cell;
+            }
+        }
+    }
+
+
+    unsigned long MatrixDataTypeDecoder::Context::visibleRowIndex(unsigned long row) const {
+        return   row <= currentNumberLeadingRows
+               ? row - 1
+               : currentNumberLeadingRows + (row - currentFirstTrailingRow);
+    }
+
+
+    unsigned long MatrixDataTypeDecoder::Context::visibleColumnIndex(unsigned long column) const {
+        return   column <= currentNumberLeadingColumns
+               ? column - 1
+               : currentNumberLeadingColumns + (column - currentFirstTrailingColumn);
     }
 }
 
@@ -157,8 +331,8 @@ namespace Ld {
         for (unsigned long row=1 ; row<=numberLeadingRows ; ++row) {
             unsigned long columnIndex = 0;
             for (unsigned long column=1 ; column<=numberLeadingColumns ; ++column) {
-                QString  s = context.toString(row, column);
-                unsigned l = static_cast<unsigned>(s.length());
+                const QString& s = context.formattedCell(row, column).first();
+                unsigned       l = static_cast<unsigned>(s.length());
 
                 if (columnWidths[columnIndex] < l) {
                     columnWidths[columnIndex] = l;
@@ -176,8 +350,8 @@ namespace Ld {
                 ++columnIndex;
 
                 for (unsigned long column=firstTrailingColumn ; column<=numberColumns ; ++column) {
-                    QString  s = context.toString(row, column);
-                    unsigned l = static_cast<unsigned>(s.length());
+                    const QString& s = context.formattedCell(row, column).first();
+                    unsigned       l = static_cast<unsigned>(s.length());
 
                     if (columnWidths[columnIndex] < l) {
                         columnWidths[columnIndex] = l;
@@ -199,8 +373,8 @@ namespace Ld {
             for (unsigned long row=firstTrailingRow ; row<=numberRows ; ++row) {
                 unsigned long columnIndex = 0;
                 for (unsigned long column=1 ; column<=numberLeadingColumns ; ++column) {
-                    QString  s = context.toString(row, column);
-                    unsigned l = static_cast<unsigned>(s.length());
+                    const QString& s = context.formattedCell(row, column).first();
+                    unsigned       l = static_cast<unsigned>(s.length());
 
                     if (columnWidths[columnIndex] < l) {
                         columnWidths[columnIndex] = l;
@@ -218,8 +392,8 @@ namespace Ld {
                     ++columnIndex;
 
                     for (unsigned long column=firstTrailingColumn ; column<=numberColumns ; ++column) {
-                        QString  s = context.toString(row, column);
-                        unsigned l = static_cast<unsigned>(s.length());
+                        const QString& s = context.formattedCell(row, column).first();
+                        unsigned       l = static_cast<unsigned>(s.length());
 
                         if (columnWidths[columnIndex] < l) {
                             columnWidths[columnIndex] = l;
@@ -236,7 +410,7 @@ namespace Ld {
         for (unsigned long row=1 ; row<=numberLeadingRows ; ++row) {
             unsigned long columnIndex = 0;
             for (unsigned long column=1 ; column<=numberLeadingColumns ; ++column) {
-                QString  s = context.toString(row, column);
+                const QString& s = context.formattedCell(row, column).first();
                 if (columnIndex == 0) {
                     result += tr("%1").arg(s, columnWidths[columnIndex]);
                 } else {
@@ -256,7 +430,7 @@ namespace Ld {
                 ++columnIndex;
 
                 for (unsigned long column=firstTrailingColumn ; column<=numberColumns ; ++column) {
-                    QString  s = context.toString(row, column);
+                    const QString& s = context.formattedCell(row, column).first();
                     if (columnIndex == 0) {
                         result += tr("%1").arg(s, columnWidths[columnIndex]);
                     } else {
@@ -287,7 +461,7 @@ namespace Ld {
             for (unsigned long row=firstTrailingRow ; row<=numberRows ; ++row) {
                 unsigned long columnIndex = 0;
                 for (unsigned long column=1 ; column<=numberLeadingColumns ; ++column) {
-                    QString  s = context.toString(row, column);
+                    const QString& s = context.formattedCell(row, column).first();
                     if (columnIndex == 0) {
                         result += tr("%1").arg(s, columnWidths[columnIndex]);
                     } else {
@@ -307,7 +481,7 @@ namespace Ld {
                     ++columnIndex;
 
                     for (unsigned long column=firstTrailingColumn ; column<=numberColumns ; ++column) {
-                        QString  s = context.toString(row, column);
+                        const QString& s = context.formattedCell(row, column).first();
                         if (columnIndex == 0) {
                             result += tr("%1").arg(s, columnWidths[columnIndex]);
                         } else {
@@ -127,7 +127,7 @@ namespace Ld {
     }
 
 
-    QString MatrixIntegerDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) {
+    QString MatrixIntegerDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) const {
         Model::Integer i = currentMatrix(row, column);
         return Util::longLongIntegerToUnicodeString(
             i,
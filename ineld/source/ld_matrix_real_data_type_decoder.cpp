@@ -27,6 +27,7 @@
 
 #include <QCoreApplication>
 #include <QString>
+#include <QStringList>
 #include <QSharedPointer>
 
 #include <cassert>
@@ -131,10 +132,30 @@ namespace Ld {
     }
 
 
-    QString MatrixRealDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) {
+    QString MatrixRealDataTypeDecoder::Context::toString(unsigned long row, unsigned long column) const {
         Model::Real r = currentMatrix(row, column) * currentMultiplier;
         return Util::longDoubleToUnicodeString(r, currentRealNumberStyle, currentPrecision, currentUpperCase);
     }
+
+
+    QStringList MatrixRealDataTypeDecoder::Context::mantissaAndExponentStrings(
+            unsigned long row,
+            unsigned long column
+        ) const {
+        Model::Real r = currentMatrix(row, column) * currentMultiplier;
+        QString     mantissaString;
+        QString     exponentString;
+
+        Util::longDoubleToMantissaAndExponentStrings(
+            r,
+            currentRealNumberStyle,
+            currentPrecision,
+            mantissaString,
+            exponentString
+        );
+
+        return QStringList() << mantissaString << exponentString;
+    }
 }
 
 /***********************************************************************************************************************
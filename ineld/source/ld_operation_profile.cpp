@@ -0,0 +1,107 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::OperationProfile class.
+***********************************************************************************************************************/
+
+#include "ld_element_structures.h"
+#include "ld_operation.h"
+#include "ld_operation_profile.h"
+
+namespace Ld {
+    OperationProfile::OperationProfile() {
+        currentHitCount             = 0;
+        currentExclusiveNanoseconds = 0;
+        currentInclusiveNanoseconds = 0;
+    }
+
+
+    OperationProfile::OperationProfile(
+            const Operation&   operation,
+            unsigned long long hitCount,
+            unsigned long long exclusiveNanoseconds,
+            unsigned long long inclusiveNanoseconds
+        ) {
+        currentOperation            = operation;
+        currentHitCount             = hitCount;
+        currentExclusiveNanoseconds = exclusiveNanoseconds;
+        currentInclusiveNanoseconds = inclusiveNanoseconds;
+    }
+
+
+    OperationProfile::OperationProfile(const OperationProfile& other) {
+        currentOperation            = other.currentOperation;
+        currentHitCount             = other.currentHitCount;
+        currentExclusiveNanoseconds = other.currentExclusiveNanoseconds;
+        currentInclusiveNanoseconds = other.currentInclusiveNanoseconds;
+    }
+
+
+    OperationProfile::~OperationProfile() {}
+
+
+    bool OperationProfile::isValid() const {
+        return currentOperation.isValid();
+    }
+
+
+    bool OperationProfile::isInvalid() const {
+        return !isValid();
+    }
+
+
+    const Operation& OperationProfile::operation() const {
+        return currentOperation;
+    }
+
+
+    ElementPointer OperationProfile::element() const {
+        return currentOperation.element();
+    }
+
+
+    unsigned long long OperationProfile::hitCount() const {
+        return currentHitCount;
+    }
+
+
+    unsigned long long OperationProfile::exclusiveNanoseconds() const {
+        return currentExclusiveNanoseconds;
+    }
+
+
+    unsigned long long OperationProfile::inclusiveNanoseconds() const {
+        return currentInclusiveNanoseconds;
+    }
+
+
+    OperationProfile& OperationProfile::operator=(const OperationProfile& other) {
+        currentOperation            = other.currentOperation;
+        currentHitCount             = other.currentHitCount;
+        currentExclusiveNanoseconds = other.currentExclusiveNanoseconds;
+        currentInclusiveNanoseconds = other.currentInclusiveNanoseconds;
+
+        return *this;
+    }
+}
@@ -142,6 +142,8 @@ namespace Ld {
     bool PayloadData::PrivateFile::writeData(const QByteArray& newData) {
         bool success;
 
+        currentProgramFile->waitBackgroundSaveComplete();
+
         QString payloadName = ProgramFile::payloadName(currentPayloadId);
         QPointer<QVirtualFile> virtualFile;
 
@@ -173,6 +175,8 @@ namespace Ld {
     bool PayloadData::PrivateFile::readData(QByteArray& newData) {
         bool success;
 
+        currentProgramFile->waitBackgroundSaveComplete();
+
         QString payloadName = ProgramFile::payloadName(currentPayloadId);
 
         if (currentProgramFile->container->directory().contains(payloadName)) {
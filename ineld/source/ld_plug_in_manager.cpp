@@ -46,6 +46,7 @@
 #include "ld_function_database.h"
 #include "ld_function_data.h"
 #include "ld_function_variant.h"
+#include "ld_capabilities.h"
 #include "ld_plug_in_registrar.h"
 #include "ld_plug_in_information.h"
 #include "ld_plug_in_manager.h"
@@ -69,8 +70,9 @@ namespace Ld {
 
         while (plugInIterator != plugInEndIterator) {
             QString       filename           = *plugInIterator;
-            ::PlugInData* plugInData         = nullptr;
-            bool          isThirdPartyPlugIn = true;
+            ::PlugInData* plugInData           = nullptr;
+            bool          isThirdPartyPlugIn   = true;
+            unsigned      numberUnassignedBits = Capabilities::numberUnassignedBits();
 
             aboutToLoad(filename);
 
@@ -109,6 +111,11 @@ namespace Ld {
                 }
             }
 
+            if (successThisLibrary) {
+                // A plug-in whose capabilities could not all be assigned bits would accept the wrong children.
+                successThisLibrary = (Capabilities::numberUnassignedBits() == numberUnassignedBits);
+            }
+
             if (successThisLibrary) {
                 successThisLibrary = buildFunctionDeclarations(plugInData);
             }
@@ -42,6 +42,8 @@
 #include <QByteArray>
 #include <QBuffer>
 #include <QByteArray>
+#include <QList>
+#include <QThread>
 
 #if (defined(Q_OS_WIN))
 
@@ -54,6 +56,7 @@
 #include <cstring>
 #include <cerrno>
 #include <algorithm>
+#include <functional>
 
 #include <util_system.h>
 
@@ -67,12 +70,100 @@
 #include "ld_program_file.h"
 
 namespace Ld {
+    /**
+     * Thread used to write the program description and save the container in the background.
+     */
+    class ProgramFile::SaveThread:public QThread {
+        public:
+            /**
+             * Constructor
+             *
+             * \param[in] programFile        The program file to be saved.
+             *
+             * \param[in] description        The serialized program description.
+             *
+             * \param[in] binary             If true, the description uses the compact binary encoding.
+             *
+             * \param[in] purgedPayloads     The payloads to be removed before saving.
+             *
+             * \param[in] completionFunction Function called once the save has finished.
+             */
+            SaveThread(
+                    ProgramFile*                         programFile,
+                    const QByteArray&                    description,
+                    bool                                 binary,
+                    const QList<PayloadData::PayloadId>& purgedPayloads,
+                    const std::function<void()>&         completionFunction
+                ) {
+                currentProgramFile        = programFile;
+                currentDescription        = description;
+                currentBinary             = binary;
+                currentPurgedPayloads     = purgedPayloads;
+                currentCompletionFunction = completionFunction;
+            }
+
+            ~SaveThread() override {}
+
+        protected:
+            /**
+             * Method that performs the save.
+             */
+            void run() override {
+                bool success = currentProgramFile->purgePayloads(currentPurgedPayloads);
+
+                if (success) {
+                    success = currentProgramFile->writeStream(QString(), currentDescription, currentBinary);
+                }
+
+                if (success) {
+                    success = currentProgramFile->save();
+                }
+
+                currentProgramFile->currentBackgroundSaveSucceeded = success;
+
+                if (currentCompletionFunction) {
+                    currentCompletionFunction();
+                }
+            }
+
+        private:
+            /**
+             * The program file being saved.
+             */
+            ProgramFile* currentProgramFile;
+
+            /**
+             * The serialized program description.
+             */
+            QByteArray currentDescription;
+
+            /**
+             * Flag indicating if the description uses the binary encoding.
+             */
+            bool currentBinary;
+
+            /**
+             * The payloads to be removed.
+             */
+            QList<PayloadData::PayloadId> currentPurgedPayloads;
+
+            /**
+             * The function to call on completion.
+             */
+            std::function<void()> currentCompletionFunction;
+    };
+
+
     const QString ProgramFile::fileIdentifier = QString("Inesonic, LLC.\nProgram Container");
 
-    ProgramFile::ProgramFile():container(new QFileContainer(ProgramFile::fileIdentifier)) {}
+    ProgramFile::ProgramFile():container(new QFileContainer(ProgramFile::fileIdentifier)) {
+        currentBackgroundSaveSucceeded = true;
+        currentBackgroundSaveOpenMode  = OpenMode::CLOSED;
+    }
 
 
     ProgramFile::~ProgramFile() {
+        waitBackgroundSaveComplete();
         movePayloadsToLocalStorageAndDisconnect();
     }
 
@@ -80,6 +171,8 @@ namespace Ld {
     bool ProgramFile::openExisting(const QString& filename, bool readOnly) {
         bool success;
 
+        waitBackgroundSaveComplete();
+
         if (container->openMode() != QFileContainer::OpenMode::CLOSED) {
             success = false;
             lastError = tr("Container currently open.");
@@ -167,6 +260,8 @@ namespace Ld {
     bool ProgramFile::openNew() {
         bool success;
 
+        waitBackgroundSaveComplete();
+
         if (container->openMode() != QFileContainer::OpenMode::CLOSED) {
             success = false;
             lastError = tr("Container currently open.");
@@ -197,6 +292,8 @@ namespace Ld {
     bool ProgramFile::save() {
         bool success;
 
+        waitBackgroundSaveComplete();
+
         if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
             success = false;
             lastError = tr("Container closed.");
@@ -231,6 +328,8 @@ namespace Ld {
     bool ProgramFile::saveAs(const QString& newFilename) {
         bool success;
 
+        waitBackgroundSaveComplete();
+
         if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
             success = false;
             lastError = tr("Container closed.");
@@ -262,6 +361,8 @@ namespace Ld {
     bool ProgramFile::close() {
         bool success;
 
+        waitBackgroundSaveComplete();
+
         if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
             success = false;
             lastError = tr("Container already closed.");
@@ -296,17 +397,75 @@ namespace Ld {
     }
 
 
+    bool ProgramFile::saveInBackground(
+            const QByteArray&                    description,
+            bool                                 binary,
+            const QList<PayloadData::PayloadId>& purgedPayloads,
+            const std::function<void()>&         completionFunction
+        ) {
+        bool success;
+
+        waitBackgroundSaveComplete();
+
+        if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
+            success = false;
+            lastError = tr("Container closed.");
+        } else if (container->openMode() == QFileContainer::OpenMode::READ_ONLY){
+            success = false;
+            lastError = tr("Container opened read-only.  Can not save.");
+        } else if (isNewContainer) {
+            success = false;
+            lastError = tr("New container must be saved \"as\".");
+        } else if (!currentDevice.isNull()) {
+            success = false;
+            lastError = tr("Stream device already open.");
+        } else {
+            currentBackgroundSaveSucceeded = true;
+            currentBackgroundSaveFilename  = containerFileInformation.absoluteFilePath();
+            currentBackgroundSaveOpenMode  = container->openMode();
+            currentBackgroundSaveError     = lastError;
+
+            currentSaveThread.reset(new SaveThread(this, description, binary, purgedPayloads, completionFunction));
+            currentSaveThread->start();
+
+            success = true;
+        }
+
+        return success;
+    }
+
+
+    bool ProgramFile::backgroundSaveActive() const {
+        return !currentSaveThread.isNull() && currentSaveThread->isRunning();
+    }
+
+
+    bool ProgramFile::waitBackgroundSaveComplete() const {
+        // The save thread itself calls methods that wait so we must not wait on ourselves.
+
+        if (!currentSaveThread.isNull() && QThread::currentThread() != currentSaveThread.data()) {
+            currentSaveThread->wait();
+        }
+
+        return currentBackgroundSaveSucceeded;
+    }
+
+
     QString ProgramFile::filename() const {
-        return containerFileInformation.absoluteFilePath();
+        return   backgroundSaveActiveOnOtherThread()
+               ? currentBackgroundSaveFilename
+               : containerFileInformation.absoluteFilePath();
     }
 
 
     ProgramFile::OpenMode ProgramFile::openMode() const {
-        return container->openMode();
+        return backgroundSaveActiveOnOtherThread() ? currentBackgroundSaveOpenMode : container->openMode();
     }
 
 
     PayloadData ProgramFile::payload(PayloadData::PayloadId payloadId) {
+        waitBackgroundSaveComplete();
+
         PayloadData result;
 
         if (payloadReferenceCounts.contains(payloadId)) {
@@ -331,6 +490,8 @@ namespace Ld {
 
 
     PayloadData ProgramFile::newPayload() {
+        waitBackgroundSaveComplete();
+
         PayloadData::PayloadId newPayloadId;
 
         if (container->openMode() != QFileContainer::OpenMode::CLOSED    &&
@@ -380,15 +541,11 @@ namespace Ld {
     }
 
 
-    bool ProgramFile::purgeUnreferencedPayloads() {
+    QList<PayloadData::PayloadId> ProgramFile::unreferencedPayloads() const {
         typedef QHash<PayloadData::PayloadId, unsigned long> ReferenceHash;
         typedef ReferenceHash::const_iterator                ReferenceHashIterator;
-        typedef QList<PayloadData::PayloadId>                PayloadIdList;
-        typedef PayloadIdList::const_iterator                PayloadIdListIterator;
-
-        bool success = true;
 
-        PayloadIdList unusedPayloads;
+        QList<PayloadData::PayloadId> unusedPayloads;
 
         for (  ReferenceHashIterator referenceCountIterator    = payloadReferenceCounts.constBegin(),
                                      referenceCountEndIterator = payloadReferenceCounts.constEnd()
@@ -403,33 +560,24 @@ namespace Ld {
             }
         }
 
-        for (  PayloadIdListIterator payloadIdIterator    = unusedPayloads.constBegin(),
-                                     payloadIdEndIterator = unusedPayloads.constEnd()
-             ; payloadIdIterator != payloadIdEndIterator
-             ; ++payloadIdIterator
-            ) {
-            PayloadData::PayloadId payloadId = *payloadIdIterator;
-            QString                name      = payloadName(payloadId);
+        return unusedPayloads;
+    }
 
-            if (container->directory().contains(name)) {
-                QPointer<QVirtualFile> virtualFile = container->directory().value(name);
-                bool erased = virtualFile->erase();
-                if (!erased) {
-                    success = false;
-                }
-            }
-        }
 
-        return success;
+    bool ProgramFile::purgeUnreferencedPayloads() {
+        waitBackgroundSaveComplete();
+        return purgePayloads(unreferencedPayloads());
     }
 
 
     QString ProgramFile::errorString() const {
-        return lastError;
+        return backgroundSaveActiveOnOtherThread() ? currentBackgroundSaveError : lastError;
     }
 
 
     bool ProgramFile::initializeXmlReader(const QString& streamName) {
+        waitBackgroundSaveComplete();
+
         bool success = true;
 
         if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
@@ -440,17 +588,19 @@ namespace Ld {
                 success = false;
                 lastError = tr("Stream device already open.");
             } else {
-                QString                      internalFilename = QString("%1.xml").arg(streamName);
-                QFileContainer::DirectoryMap directory        = container->directory();
+                QString                      binaryFilename = QString("%1.bin").arg(streamName);
+                QString                      xmlFilename    = QString("%1.xml").arg(streamName);
+                QFileContainer::DirectoryMap directory      = container->directory();
 
-                if (directory.contains(internalFilename)) {
-                    currentDevice = directory.value(internalFilename);
+                bool binary = directory.contains(binaryFilename);
+                if (binary || directory.contains(xmlFilename)) {
+                    currentDevice = directory.value(binary ? binaryFilename : xmlFilename);
 
                     success = currentDevice->open(QVirtualFile::ReadOnly);
                     if (!success) {
                         lastError = currentDevice->errorString();
                     } else {
-                        currentReader = QSharedPointer<XmlReader>(new XmlReader(currentDevice));
+                        currentReader = QSharedPointer<XmlReader>(new XmlReader(currentDevice, binary));
                     }
                 } else {
                     lastError = tr("Container does not hold stream %1.").arg(streamName);
@@ -469,6 +619,8 @@ namespace Ld {
 
 
     bool ProgramFile::releaseXmlReader() {
+        waitBackgroundSaveComplete();
+
         bool success = true;
 
         if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
@@ -493,7 +645,63 @@ namespace Ld {
     }
 
 
-    bool ProgramFile::initializeXmlWriter(const QString& streamName) {
+    bool ProgramFile::initializeXmlWriter(const QString& streamName, bool binary) {
+        waitBackgroundSaveComplete();
+
+        bool success = createStream(streamName, binary);
+
+        if (success) {
+            currentWriter = QSharedPointer<XmlWriter>(new XmlWriter(currentDevice, binary));
+        }
+
+        return success;
+    }
+
+
+    QSharedPointer<XmlWriter> ProgramFile::writer() {
+        return currentWriter;
+    }
+
+
+    bool ProgramFile::releaseXmlWriter() {
+        waitBackgroundSaveComplete();
+
+        bool success = true;
+
+        if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
+            success = false;
+            lastError = tr("Container not open.");
+        } else {
+            if (currentDevice.isNull()) {
+                success = false;
+                lastError = tr("XML writer not active (1).");
+            } else if (currentWriter.isNull()) {
+                success = false;
+                lastError = tr("XML writer not active (2).");
+            } else {
+                currentWriter.clear();
+
+                currentDevice->close();
+                currentDevice.clear();
+            }
+        }
+
+        return success;
+    }
+
+
+    bool ProgramFile::backgroundSaveActiveOnOtherThread() const {
+        return backgroundSaveActive() && QThread::currentThread() != currentSaveThread.data();
+    }
+
+
+    void ProgramFile::resetState() {
+        currentReader.clear();
+        currentWriter.clear();
+    }
+
+
+    bool ProgramFile::createStream(const QString& streamName, bool binary) {
         bool success = true;
 
         if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
@@ -504,16 +712,25 @@ namespace Ld {
                 success = false;
                 lastError = tr("Stream device already open.");
             } else {
-                QString                      internalFilename = QString("%1.xml").arg(streamName);
+                QString                      binaryFilename   = QString("%1.bin").arg(streamName);
+                QString                      xmlFilename      = QString("%1.xml").arg(streamName);
+                QString                      internalFilename = binary ? binaryFilename : xmlFilename;
                 QFileContainer::DirectoryMap directory        = container->directory();
 
-                if (directory.contains(internalFilename)) {
-                    QPointer<QVirtualFile> vf = directory.value(internalFilename);
+                // Erase both encodings so a stale copy in the other encoding is never read back.
+
+                if (directory.contains(binaryFilename)) {
+                    QPointer<QVirtualFile> vf = directory.value(binaryFilename);
                     success = vf->erase();
+                }
 
-                    if (!success) {
-                        lastError = tr("Could not erase stream %1").arg(streamName);
-                    }
+                if (success && directory.contains(xmlFilename)) {
+                    QPointer<QVirtualFile> vf = directory.value(xmlFilename);
+                    success = vf->erase();
+                }
+
+                if (!success) {
+                    lastError = tr("Could not erase stream %1").arg(streamName);
                 }
 
                 if (success) {
@@ -531,13 +748,10 @@ namespace Ld {
                     }
                 }
 
-                if (success) {
-                    currentWriter = QSharedPointer<XmlWriter>(new XmlWriter(currentDevice));
-                } else {
+                if (!success) {
                     lastError = tr("Can not create stream %1.").arg(streamName);
                     success   = false;
                 }
-
             }
         }
 
@@ -545,29 +759,44 @@ namespace Ld {
     }
 
 
-    QSharedPointer<XmlWriter> ProgramFile::writer() {
-        return currentWriter;
+    bool ProgramFile::writeStream(const QString& streamName, const QByteArray& data, bool binary) {
+        bool success = createStream(streamName, binary);
+
+        if (success) {
+            long long bytesWritten = currentDevice->write(data);
+            if (bytesWritten != data.size()) {
+                success   = false;
+                lastError = currentDevice->errorString();
+            }
+
+            currentDevice->close();
+            currentDevice.clear();
+        }
+
+        return success;
     }
 
 
-    bool ProgramFile::releaseXmlWriter() {
+    bool ProgramFile::purgePayloads(const QList<PayloadData::PayloadId>& payloadIds) {
+        typedef QList<PayloadData::PayloadId> PayloadIdList;
+        typedef PayloadIdList::const_iterator PayloadIdListIterator;
+
         bool success = true;
 
-        if (container->openMode() == QFileContainer::OpenMode::CLOSED) {
-            success = false;
-            lastError = tr("Container not open.");
-        } else {
-            if (currentDevice.isNull()) {
-                success = false;
-                lastError = tr("XML writer not active (1).");
-            } else if (currentWriter.isNull()) {
-                success = false;
-                lastError = tr("XML writer not active (2).");
-            } else {
-                currentWriter.clear();
+        for (  PayloadIdListIterator payloadIdIterator    = payloadIds.constBegin(),
+                                     payloadIdEndIterator = payloadIds.constEnd()
+             ; payloadIdIterator != payloadIdEndIterator
+             ; ++payloadIdIterator
+            ) {
+            PayloadData::PayloadId payloadId = *payloadIdIterator;
+            QString                name      = payloadName(payloadId);
 
-                currentDevice->close();
-                currentDevice.clear();
+            if (container->directory().contains(name)) {
+                QPointer<QVirtualFile> virtualFile = container->directory().value(name);
+                bool erased = virtualFile->erase();
+                if (!erased) {
+                    success = false;
+                }
             }
         }
 
@@ -575,12 +804,6 @@ namespace Ld {
     }
 
 
-    void ProgramFile::resetState() {
-        currentReader.clear();
-        currentWriter.clear();
-    }
-
-
 //    bool ProgramFile::loadFile(const QString& filename, QByteArray& fileBuffer) {
 //        QFile file(filename);
 //        bool success = file.open(QFile::ReadOnly);
@@ -37,9 +37,13 @@
 #include <QByteArray>
 #include <QSharedPointer>
 #include <QHash>
+#include <QVector>
 #include <QFileInfo>
+#include <QCoreApplication>
+#include <QMetaObject>
 
 #include <cstring>
+#include <functional>
 
 #include <model_rng.h>
 
@@ -52,6 +56,9 @@
 #include "ld_default_format_setting.h"
 #include "ld_identifier_database.h"
 #include "ld_operation_database.h"
+#include "ld_operation_profile.h"
+#include "ld_element_image.h"
+#include "ld_element_image_cache.h"
 #include "ld_plug_in_information.h"
 #include "ld_payload_data.h"
 #include "ld_program_file.h"
@@ -59,6 +66,8 @@
 #include "ld_xml_attributes.h"
 #include "ld_element.h"
 #include "ld_format.h"
+#include "ld_format_container.h"
+#include "ld_format_organizer.h"
 #include "ld_character_format.h"
 #include "ld_brace_conditional_format.h"
 #include "ld_visual.h"
@@ -83,6 +92,12 @@ namespace Ld {
         currentDocumentNumber = unassignedDocumentNumber;
         blockReporting        = false;
         currentIsModified     = false;
+        currentRevision       = 0;
+
+        currentBinaryDescriptionEnabled = false;
+        currentBackgroundSavePending    = false;
+        currentBackgroundSaveSucceeded  = true;
+        currentBackgroundSaveRevision   = 0;
 
         if (currentApplicationDefaultPageFormat) {
             currentDefaultPageFormat = currentApplicationDefaultPageFormat->clone().dynamicCast<Ld::PageFormat>();
@@ -209,6 +224,76 @@ namespace Ld {
     }
 
 
+    void RootElement::setOperationProfile(
+            const QVector<unsigned long long>& hitCounts,
+            const QVector<unsigned long long>& exclusiveNanoseconds
+        ) {
+        const QList<Operation>& operations       = currentOperationDatabase.operations();
+        unsigned long           numberOperations = static_cast<unsigned long>(operations.size());
+
+        QVector<unsigned long long> inclusiveNanoseconds(static_cast<int>(numberOperations), 0);
+        for (Operation::Handle handle=0 ; handle<numberOperations ; ++handle) {
+            unsigned long long exclusiveTime = exclusiveNanoseconds.value(static_cast<int>(handle), 0);
+            ElementPointer     element       = operations.at(static_cast<int>(handle)).element();
+
+            inclusiveNanoseconds[static_cast<int>(handle)] += exclusiveTime;
+
+            if (!element.isNull()) {
+                ElementPointer ancestor = element->parent();
+                while (!ancestor.isNull()) {
+                    Operation ancestorOperation = currentOperationDatabase.fromElement(ancestor);
+                    if (ancestorOperation.isValid() && ancestorOperation.handle() < numberOperations) {
+                        inclusiveNanoseconds[static_cast<int>(ancestorOperation.handle())] += exclusiveTime;
+                    }
+
+                    ancestor = ancestor->parent();
+                }
+            }
+        }
+
+        currentOperationProfiles.clear();
+        currentOperationProfiles.reserve(static_cast<int>(numberOperations));
+
+        for (Operation::Handle handle=0 ; handle<numberOperations ; ++handle) {
+            currentOperationProfiles.append(
+                OperationProfile(
+                    operations.at(static_cast<int>(handle)),
+                    hitCounts.value(static_cast<int>(handle), 0),
+                    exclusiveNanoseconds.value(static_cast<int>(handle), 0),
+                    inclusiveNanoseconds.at(static_cast<int>(handle))
+                )
+            );
+        }
+    }
+
+
+    void RootElement::clearOperationProfile() {
+        currentOperationProfiles.clear();
+    }
+
+
+    bool RootElement::hasOperationProfile() const {
+        return !currentOperationProfiles.isEmpty();
+    }
+
+
+    OperationProfile RootElement::operationProfile(ElementPointer element) const {
+        OperationProfile result;
+
+        Operation operation = currentOperationDatabase.fromElement(element);
+        if (operation.isValid() && operation.handle() < static_cast<unsigned long>(currentOperationProfiles.size())) {
+            result = currentOperationProfiles.at(static_cast<int>(operation.handle()));
+        }
+
+        return result;
+    }
+
+
+    const QVector<OperationProfile>& RootElement::operationProfiles() const {
+        return currentOperationProfiles;
+    }
+
+
     Capabilities RootElement::parentRequires(unsigned long) const {
         return Capabilities::frame | Capabilities::expressions;
     }
@@ -250,22 +335,7 @@ namespace Ld {
 
 
     QSharedPointer<FormatOrganizer> RootElement::formatOrganizer() const {
-        QSharedPointer<FormatOrganizer> organizer(new FormatOrganizer);
-
-        for (  ElementMap::const_iterator elementIterator    = currentElementsByHandle.constBegin(),
-                                          elementEndIterator = currentElementsByHandle.constEnd()
-             ; elementIterator != elementEndIterator
-             ; ++elementIterator
-            ) {
-            ElementPointer element = elementIterator.value().toStrongRef();
-            assert(element);
-
-            FormatPointer format = element->format();
-
-            if (format) {
-                organizer->addFormat(format);
-            }
-        }
+        QSharedPointer<FormatOrganizer> organizer(new FormatOrganizer(currentElementFormats));
 
         FormatContainer defaultPageFormatContainer(currentDefaultPageFormat);
         organizer->addFormat(defaultPageFormatContainer);
@@ -301,6 +371,11 @@ namespace Ld {
     }
 
 
+    const FormatOrganizer& RootElement::elementFormatOrganizer() const {
+        return currentElementFormats;
+    }
+
+
     void RootElement::setApplicationDefaultPageFormat(QSharedPointer<PageFormat> newDefaultPageFormat) {
         currentApplicationDefaultPageFormat = newDefaultPageFormat->clone().dynamicCast<Ld::PageFormat>();
     }
@@ -511,6 +586,26 @@ namespace Ld {
     }
 
 
+    void RootElement::setBinaryDescriptionEnabled(bool nowEnabled) {
+        currentBinaryDescriptionEnabled = nowEnabled;
+    }
+
+
+    void RootElement::setBinaryDescriptionDisabled(bool nowDisabled) {
+        setBinaryDescriptionEnabled(!nowDisabled);
+    }
+
+
+    bool RootElement::binaryDescriptionEnabled() const {
+        return currentBinaryDescriptionEnabled;
+    }
+
+
+    bool RootElement::binaryDescriptionDisabled() const {
+        return !currentBinaryDescriptionEnabled;
+    }
+
+
     void RootElement::setRngType(RootElement::RngType newRngType) {
         currentRngType = newRngType;
     }
@@ -581,10 +676,17 @@ namespace Ld {
     }
 
 
+    unsigned long long RootElement::revision() const {
+        return currentRevision;
+    }
+
+
     bool RootElement::openExisting(const QString& filename, bool readOnly, const PlugInsByName& plugInsByName) {
         // The assert below will fire if setWeakThis was not called before using the root element.
         Q_ASSERT(weakThis());
 
+        waitBackgroundSaveComplete();
+
         bool success = true;
 
         QString oldIdentifier = identifier();
@@ -654,6 +756,8 @@ namespace Ld {
         // The assert below will fire if setWeakThis was not called before using the root element.
         Q_ASSERT(weakThis());
 
+        waitBackgroundSaveComplete();
+
         bool success = true;
 
         QString oldIdentifier = identifier();
@@ -702,6 +806,8 @@ namespace Ld {
         // The assert below will fire if setWeakThis was not called before using the root element.
         Q_ASSERT(weakThis());
 
+        waitBackgroundSaveComplete();
+
         bool success = true;
 
         if (programFile.openMode() == ProgramFile::OpenMode::CLOSED) {
@@ -749,6 +855,8 @@ namespace Ld {
         // The assert below will fire if setWeakThis was not called before using the root element.
         Q_ASSERT(weakThis());
 
+        waitBackgroundSaveComplete();
+
         bool success = true;
 
         QString oldIdentifier = identifier();
@@ -807,10 +915,120 @@ namespace Ld {
     }
 
 
+    bool RootElement::saveInBackground(bool purgeOnSave) {
+        // The assert below will fire if setWeakThis was not called before using the root element.
+        Q_ASSERT(weakThis());
+
+        waitBackgroundSaveComplete();
+
+        bool success = true;
+
+        if (programFile.openMode() == ProgramFile::OpenMode::CLOSED) {
+            success = false;
+            lastError = tr("Program closed, can't save.");
+        } else if (programFile.openMode() == ProgramFile::OpenMode::READ_ONLY) {
+            success = false;
+            lastError = tr("Program previously opened read-only.  Save under a new name.");
+        }
+
+        if (success) {
+            // The serialized description is our snapshot of the element tree.  Everything after this point only
+            // touches the container so editing can continue while the background thread runs.
+
+            QByteArray                description;
+            QSharedPointer<XmlWriter> writer(new XmlWriter(&description, currentBinaryDescriptionEnabled));
+            writeXmlDescription(writer, programFile.filename());
+            writer.clear();
+
+            QList<PayloadData::PayloadId> purgedPayloads;
+            if (purgeOnSave) {
+                purgedPayloads = programFile.unreferencedPayloads();
+            }
+
+            ElementWeakPointer    weakRoot           = weakThis();
+            std::function<void()> completionFunction = [weakRoot]() {
+                QCoreApplication* application = QCoreApplication::instance();
+                if (application != nullptr) {
+                    QMetaObject::invokeMethod(
+                        application,
+                        [weakRoot]() {
+                            QSharedPointer<RootElement> root = weakRoot.toStrongRef().dynamicCast<RootElement>();
+                            if (!root.isNull()) {
+                                root->waitBackgroundSaveComplete();
+                            }
+                        },
+                        Qt::QueuedConnection
+                    );
+                }
+            };
+
+            currentBackgroundSaveRevision = currentRevision;
+            currentBackgroundSavePending  = true;
+
+            success = programFile.saveInBackground(
+                description,
+                currentBinaryDescriptionEnabled,
+                purgedPayloads,
+                completionFunction
+            );
+
+            if (!success) {
+                currentBackgroundSavePending = false;
+                lastError                    = programFile.errorString();
+            }
+        }
+
+        if (!success) {
+            RootVisual* rootVisual = visual();
+            if (rootVisual != nullptr) {
+                rootVisual->programSaveFailed(lastError);
+            }
+        }
+
+        return success;
+    }
+
+
+    bool RootElement::backgroundSavePending() const {
+        return currentBackgroundSavePending;
+    }
+
+
+    bool RootElement::waitBackgroundSaveComplete() {
+        if (currentBackgroundSavePending) {
+            currentBackgroundSavePending   = false;
+            currentBackgroundSaveSucceeded = programFile.waitBackgroundSaveComplete();
+
+            RootVisual* rootVisual = visual();
+            if (currentBackgroundSaveSucceeded) {
+                // Edits made while the save was in progress are not in the saved file so the program stays modified.
+
+                if (currentRevision == currentBackgroundSaveRevision) {
+                    markPristine();
+                }
+
+                if (rootVisual != nullptr) {
+                    rootVisual->programSaved(programFile.filename());
+                }
+            } else {
+                lastError = programFile.errorString();
+
+                if (rootVisual != nullptr) {
+                    rootVisual->programSaveFailed(lastError);
+                }
+            }
+        }
+
+        return currentBackgroundSaveSucceeded;
+    }
+
+
     bool RootElement::close() {
         // The assert below will fire if setWeakThis was not called before using the root element.
         Q_ASSERT(weakThis());
 
+        waitBackgroundSaveComplete();
+
         bool success;
 
         QString oldIdentifier = identifier();
@@ -1086,6 +1304,7 @@ namespace Ld {
         RootVisual* rootVisual  = visual();
         bool        wasPristine = !currentIsModified;
         currentIsModified = true;
+        ++currentRevision;
 
         if (rootVisual != nullptr && !blockReporting) {
             rootVisual->nowChanged();
@@ -1119,6 +1338,25 @@ namespace Ld {
     }
 
 
+    ElementImage RootElement::elementImage(ElementPointer element, float dpi) {
+        ElementImage result = currentElementImageCache.image(element, dpi);
+
+        if (result.isInvalid()) {
+            result = ElementImage(exportElementImage(element, dpi));
+            if (result.isValid()) {
+                currentElementImageCache.insert(element, dpi, result);
+            }
+        }
+
+        return result;
+    }
+
+
+    ElementImageCache& RootElement::elementImageCache() {
+        return currentElementImageCache;
+    }
+
+
     QString RootElement::identifier(const QString& filename) {
         QFileInfo fileInformation(filename);
         QString   documentIdentifier = fileInformation.canonicalFilePath();
@@ -1209,6 +1447,8 @@ namespace Ld {
         Q_ASSERT(!currentElementsByHandle.contains(handle));
 
         currentElementsByHandle.insert(handle, descendantElement.toWeakRef());
+        trackElementFormat(descendantElement);
+        invalidateElementImages(descendantElement);
 
         markModified();
 
@@ -1223,6 +1463,8 @@ namespace Ld {
         Ld::Handle handle = descendantElement->handle();
 
         currentElementsByHandle.remove(handle);
+        untrackElementFormat(descendantElement);
+        invalidateElementImages(descendantElement);
 
         markModified();
 
@@ -1235,18 +1477,33 @@ namespace Ld {
 
     void RootElement::descendantFormatChanged(ElementPointer changedElement, FormatPointer newFormat) {
         ElementWithPositionalChildren::descendantFormatChanged(changedElement, newFormat);
+        trackElementFormat(changedElement);
+        invalidateElementImages(changedElement);
         markModified();
     };
 
 
     void RootElement::descendantFormatUpdated(ElementPointer changedElement, FormatPointer newFormat) {
         ElementWithPositionalChildren::descendantFormatUpdated(changedElement, newFormat);
+        trackElementFormat(changedElement);
+        invalidateElementImages(changedElement);
         markModified();
     };
 
 
+    void RootElement::descendantInstructionBreakpointUpdated(ElementPointer changedElement, bool breakpointNowSet) {
+        ElementWithPositionalChildren::descendantInstructionBreakpointUpdated(changedElement, breakpointNowSet);
+
+        // Breakpoints change the checkpoints in the generated code.  Toggling a breakpoint has never marked the
+        // program as modified so only the revision is advanced.
+
+        ++currentRevision;
+    }
+
+
     void RootElement::childChanged(ElementPointer changedChild) {
         markModified();
+        invalidateElementImages(changedChild);
 
         RootVisual* rootVisual = visual();
         if (rootVisual != nullptr && !blockReporting) {
@@ -1283,62 +1540,64 @@ namespace Ld {
 
 
     bool RootElement::writeXmlDescription(const QString& filePath) {
-        bool success = programFile.initializeXmlWriter();
+        bool success = programFile.initializeXmlWriter(QString(), currentBinaryDescriptionEnabled);
 
         if (success) {
-            QSharedPointer<XmlWriter> writer = programFile.writer();
+            writeXmlDescription(programFile.writer(), filePath);
+            success = programFile.releaseXmlWriter();
+        }
 
-            writer->setAutoFormatting(formatXml);
+        if (!success) {
+            lastError = programFile.errorString();
+        }
 
-            writer->writeStartDocument();
-            writer->writeDTD(QString("<!DOCTYPE %1>").arg(doctypedecl));
+        return success;
+    }
 
-            writer->writeStartElement("Program");
-            XmlAttributes attributes;
-            attributes.append("version", QString("%1.%2").arg(xmlMajorVersion).arg(xmlMinorVersion));
 
-            if (currentRngType != defaultRngType) {
-                attributes.append("rng_type", toString(currentRngType));
-            }
+    void RootElement::writeXmlDescription(QSharedPointer<XmlWriter> writer, const QString& filePath) {
+        writer->setAutoFormatting(formatXml);
 
-            if (currentUsePresetRngSeed) {
-                attributes.append("use_preset_seed", true);
+        writer->writeStartDocument();
+        writer->writeDTD(QString("<!DOCTYPE %1>").arg(doctypedecl));
 
-                QString seedString = QString("%1,%2,%3,%4")
-                                     .arg(currentRngSeed[0])
-                                     .arg(currentRngSeed[1])
-                                     .arg(currentRngSeed[2])
-                                     .arg(currentRngSeed[3]);
-                attributes.append("rng_seed", seedString);
-            }
+        writer->writeStartElement("Program");
+        XmlAttributes attributes;
+        attributes.append("version", QString("%1.%2").arg(xmlMajorVersion).arg(xmlMinorVersion));
 
-            writer->writeAttributes(attributes);
+        if (currentRngType != defaultRngType) {
+            attributes.append("rng_type", toString(currentRngType));
+        }
 
-            QSharedPointer<FormatOrganizer> formats = formatOrganizer();
-            updateInternalDocumentSettings(formats);
+        if (currentUsePresetRngSeed) {
+            attributes.append("use_preset_seed", true);
 
-            writeFormats(writer, formats);
+            QString seedString = QString("%1,%2,%3,%4")
+                                 .arg(currentRngSeed[0])
+                                 .arg(currentRngSeed[1])
+                                 .arg(currentRngSeed[2])
+                                 .arg(currentRngSeed[3]);
+            attributes.append("rng_seed", seedString);
+        }
 
-            writeRequiresSection(writer);
-            writeDocumentSettings(writer, currentDocumentSettings);
-            writeImportsSection(writer, filePath);
+        writer->writeAttributes(attributes);
 
-            writePageData(writer, formats, currentDefaultPageFormat, currentPageFormats);
+        QSharedPointer<FormatOrganizer> formats = formatOrganizer();
+        updateInternalDocumentSettings(formats);
 
-            XmlAttributes noInheritedAttributes;
-            Element::writeXml(writer, formats, programFile, noInheritedAttributes);
+        writeFormats(writer, formats);
 
-            writer->writeEndElement();
-            writer->writeEndDocument();
+        writeRequiresSection(writer);
+        writeDocumentSettings(writer, currentDocumentSettings);
+        writeImportsSection(writer, filePath);
 
-            success = programFile.releaseXmlWriter();
-        }
+        writePageData(writer, formats, currentDefaultPageFormat, currentPageFormats);
 
-        if (!success) {
-            lastError = programFile.errorString();
-        }
+        XmlAttributes noInheritedAttributes;
+        Element::writeXml(writer, formats, programFile, noInheritedAttributes);
 
-        return success;
+        writer->writeEndElement();
+        writer->writeEndDocument();
     }
 
 
@@ -1786,7 +2045,7 @@ namespace Ld {
             XmlReader::TokenType tokenType = reader->readNext();
 
             if (tokenType == XmlReader::StartElement) {
-                QString formatTypeName = reader->qualifiedName().toString();
+                QString formatTypeName = reader->internedQualifiedName();
 
                 FormatPointer format(Format::create(formatTypeName));
 
@@ -1838,7 +2097,7 @@ namespace Ld {
             XmlReader::TokenType tokenType = reader->readNext();
 
             if (tokenType == XmlReader::StartElement) {
-                QString       childTag        = reader->qualifiedName().toString();
+                QString       childTag        = reader->internedQualifiedName();
                 XmlAttributes childAttributes = reader->attributes();
 
                 if (childTag == "DefaultPage") {
@@ -2155,4 +2414,34 @@ namespace Ld {
             globalDocumentTracker.resize(lastSet+1);
         }
     }
+
+
+    void RootElement::invalidateElementImages(ElementPointer element) {
+        ElementPointer current = element;
+        while (!current.isNull() && current.data() != this) {
+            currentElementImageCache.remove(current->handle());
+            current = current->parent();
+        }
+    }
+
+
+    void RootElement::trackElementFormat(ElementPointer element) {
+        untrackElementFormat(element);
+
+        FormatPointer format = element->format();
+        if (format) {
+            FormatContainer container(format);
+            currentElementFormats.addFormat(container);
+            currentElementFormatsByHandle.insert(element->handle(), container);
+        }
+    }
+
+
+    void RootElement::untrackElementFormat(ElementPointer element) {
+        QHash<Handle, FormatContainer>::iterator it = currentElementFormatsByHandle.find(element->handle());
+        if (it != currentElementFormatsByHandle.end()) {
+            currentElementFormats.removeFormat(it.value());
+            currentElementFormatsByHandle.erase(it);
+        }
+    }
 }
@@ -33,6 +33,10 @@
 #include <QSet>
 
 #include <utility>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstring>
 
 #include "ld_capabilities.h"
 #include "ld_special_characters.h"
@@ -425,6 +429,191 @@ static const SpecialCharacter specialSymbols[] = {
     { QString(),                    0x0000, QString() } // Ends the list.
 };
 
+/***********************************************************************************************************************
+ * File scope code point table
+ */
+
+/**
+ * Two level table used to classify code points in the basic multilingual plane.  The upper byte of a code point
+ * selects a page and the lower byte selects an entry within the page.  Pages that contain no special characters all
+ * share a single empty page so the table stays small.  The table is generated once from the character database
+ * above and is read-only thereafter, allowing it to be used from multiple threads.
+ */
+class CodePointTable {
+    public:
+        /**
+         * Constructor.  Generates the table.
+         */
+        CodePointTable();
+
+        /**
+         * Method you can use to obtain the database entry associated with a code point.
+         *
+         * \param[in] unicodeValue The code point of interest.
+         *
+         * \return Returns a pointer to the special character entry.  A null pointer is returned if the code point
+         *         is not a special character.
+         */
+        inline const SpecialCharacter* specialCharacter(Ld::SpecialCharacters::UnicodeValue unicodeValue) const {
+            unsigned entryIndex = pages[pageIndexes[unicodeValue >> 8]][unicodeValue & 0xFF];
+            return entryIndex == 0 ? nullptr : entries[entryIndex - 1].character;
+        }
+
+        /**
+         * Method you can use to obtain the capabilities required to represent an ASCII code point.
+         *
+         * \param[in] unicodeValue The code point of interest.  The value must be in the range 0x00 to 0x7F.
+         *
+         * \return Returns the required capabilities.
+         */
+        inline const Ld::Capabilities& asciiRequiredCapabilities(
+                Ld::SpecialCharacters::UnicodeValue unicodeValue
+            ) const {
+            return asciiRequirements[unicodeValue];
+        }
+
+        /**
+         * Method you can use to obtain the capabilities required to represent a code point.
+         *
+         * \param[in] unicodeValue The code point of interest.
+         *
+         * \return Returns the required capabilities.
+         */
+        inline Ld::Capabilities requiredCapabilities(Ld::SpecialCharacters::UnicodeValue unicodeValue) const {
+            Ld::Capabilities result;
+
+            if (unicodeValue <= 0x7F) {
+                result = asciiRequirements[unicodeValue];
+            } else {
+                unsigned entryIndex = pages[pageIndexes[unicodeValue >> 8]][unicodeValue & 0xFF];
+                if (entryIndex != 0 && entries[entryIndex - 1].alphabetic) {
+                    result = Ld::Capabilities::nonAsciiAlphabeticSymbols;
+                } else {
+                    result = Ld::Capabilities::specialSymbols;
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        /**
+         * Type used to represent a single page of entry indexes.  An entry index of zero indicates no entry.
+         */
+        typedef std::array<std::uint16_t, 256> Page;
+
+        /**
+         * Structure used to track information about a special character.
+         */
+        struct Entry {
+            /**
+             * The character database entry.
+             */
+            const SpecialCharacter* character;
+
+            /**
+             * Flag indicating if this character is treated as alphabetic.
+             */
+            bool alphabetic;
+        };
+
+        /**
+         * Method that adds a list of characters to the table.
+         *
+         * \param[in] characters The list of characters, terminated by an entry with a unicode value of 0.
+         *
+         * \param[in] alphabetic Flag indicating if the characters are treated as alphabetic.
+         */
+        void addCharacters(const SpecialCharacter* characters, bool alphabetic);
+
+        /**
+         * Page index for each upper byte.  Page 0 is the shared empty page.
+         */
+        std::array<std::uint8_t, 256> pageIndexes;
+
+        /**
+         * The pages.
+         */
+        std::vector<Page> pages;
+
+        /**
+         * The entries referenced by the pages.
+         */
+        std::vector<Entry> entries;
+
+        /**
+         * Capabilities required by each ASCII code point.
+         */
+        std::array<Ld::Capabilities, 128> asciiRequirements;
+};
+
+
+CodePointTable::CodePointTable() {
+    pageIndexes.fill(0);
+    pages.push_back(Page());
+    pages.front().fill(0);
+
+    addCharacters(greekCharacters, true);
+    addCharacters(diacriticalCharacters, true);
+    addCharacters(specialCharacters, true);
+    addCharacters(specialSymbols, false);
+
+    for (unsigned unicode=0 ; unicode<128 ; ++unicode) {
+        Ld::Capabilities capabilities;
+        QChar            character(unicode);
+
+        if (character.isDigit()) {
+            capabilities = Ld::Capabilities::numericDecimalSymbols;
+        } else if (character.isLetter()) {
+            capabilities = Ld::Capabilities::alphabeticSymbols;
+        } else if (character.isSymbol() || character.isSpace() || character.isPunct()) {
+            capabilities = Ld::Capabilities::specialSymbols;
+
+            if (character == QChar('<') || character == QChar('"') || character == QChar('\'')) {
+                capabilities |= Ld::Capabilities::stringIdentifierSymbols;
+            }
+        }
+
+        asciiRequirements[unicode] = capabilities;
+    }
+}
+
+
+void CodePointTable::addCharacters(const SpecialCharacter* characters, bool alphabetic) {
+    const SpecialCharacter* specialCharacter = characters;
+    while (specialCharacter->unicode != 0x0000) {
+        Ld::SpecialCharacters::UnicodeValue unicode = specialCharacter->unicode;
+
+        std::uint8_t& pageIndex = pageIndexes[unicode >> 8];
+        if (pageIndex == 0) {
+            Q_ASSERT(pages.size() < 256);
+
+            pageIndex = static_cast<std::uint8_t>(pages.size());
+            pages.push_back(Page());
+            pages.back().fill(0);
+        }
+
+        std::uint16_t& entryIndex = pages[pageIndex][unicode & 0xFF];
+        if (entryIndex == 0) {
+            entries.push_back(Entry { specialCharacter, alphabetic });
+            entryIndex = static_cast<std::uint16_t>(entries.size());
+        }
+
+        ++specialCharacter;
+    }
+}
+
+
+/**
+ * Function that returns the code point table, generating it on first use.
+ *
+ * \return Returns a reference to the code point table.
+ */
+static const CodePointTable& codePointTable() {
+    static const CodePointTable table;
+    return table;
+}
+
 /***********************************************************************************************************************
  * SpecialCharacters
  */
@@ -546,6 +735,39 @@ namespace Ld {
     }
 
 
+    QString SpecialCharacters::commandForUnicodeValue(UnicodeValue unicodeValue) {
+        const SpecialCharacter* specialCharacter = codePointTable().specialCharacter(unicodeValue);
+        return specialCharacter == nullptr ? QString() : specialCharacter->command;
+    }
+
+
+    unsigned long SpecialCharacters::nextNonAsciiIndex(const QString& text, unsigned long startingIndex) {
+        const QChar*  data   = text.constData();
+        unsigned long length = static_cast<unsigned long>(text.length());
+        unsigned long index  = startingIndex;
+
+        // Check four UTF-16 code units per step.  The mask tests bits 7 through 15 of every code unit so the test is
+        // independent of byte order.
+
+        while (index + 4 <= length) {
+            std::uint64_t word;
+            std::memcpy(&word, data + index, sizeof(word));
+
+            if ((word & 0xFF80FF80FF80FF80ULL) != 0) {
+                break;
+            }
+
+            index += 4;
+        }
+
+        while (index < length && data[index].unicode() <= 0x7F) {
+            ++index;
+        }
+
+        return index;
+    }
+
+
     QList<SpecialCharacters::UnicodeValue> SpecialCharacters::recommendedCharacterOrder(
             bool includeGreekSymbols,
             bool includeDiacriticalSymbols,
@@ -591,36 +813,23 @@ namespace Ld {
 
 
     Capabilities SpecialCharacters::requiredCapabilities(const QString& text) {
-        prepareDatabase();
+        const CodePointTable& table  = codePointTable();
+        const QChar*          data   = text.constData();
+        unsigned long         length = static_cast<unsigned long>(text.length());
+        unsigned long         index  = 0;
 
         Capabilities requirements;
 
-        for (QString::const_iterator it=text.constBegin(),end=text.constEnd(); it!=end ; ++it) {
-            UnicodeValue unicode = it->unicode();
-            if (unicode <= 0x7F) {
-                if (it->isDigit()) {
-                    requirements |= Capabilities::numericDecimalSymbols;
-                } else if (it->isLetter()) {
-                    requirements |= Capabilities::alphabeticSymbols;
-                } else if (it->isSymbol() || it->isSpace() || it->isPunct()) {
-                    requirements |= Capabilities::specialSymbols;
-
-                    if (*it == QChar('<') || *it == QChar('"') || *it == QChar('\'')) {
-                        requirements |= Capabilities::stringIdentifierSymbols;
-                    }
-                }
-            } else {
-                if (currentGreekCommandsByUnicodeValue.contains(unicode)) {
-                    requirements |= Capabilities::nonAsciiAlphabeticSymbols;
-                } else if (currentDiacriticalCommandsByUnicodeValue.contains(unicode)) {
-                    requirements |= Capabilities::nonAsciiAlphabeticSymbols;
-                } else if (currentSpecialCharactersCommandsByUnicodeValue.contains(unicode)) {
-                    requirements |= Capabilities::nonAsciiAlphabeticSymbols;
-                } else if (currentSpecialSymbolsCommandsByUnicodeValue.contains(unicode)) {
-                    requirements |= Capabilities::specialSymbols;
-                } else {
-                    requirements |= Capabilities::specialSymbols;
-                }
+        while (index < length) {
+            unsigned long asciiEnd = nextNonAsciiIndex(text, index);
+            while (index < asciiEnd) {
+                requirements |= table.asciiRequiredCapabilities(data[index].unicode());
+                ++index;
+            }
+
+            if (index < length) {
+                requirements |= table.requiredCapabilities(data[index].unicode());
+                ++index;
             }
         }
 
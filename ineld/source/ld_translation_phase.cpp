@@ -110,4 +110,11 @@ namespace Ld {
     TranslationPhase::operator unsigned() const {
         return currentPhaseNumber;
     }
+
+
+    void TranslationPhase::setPhaseNumber(unsigned newPhaseNumber) {
+        if (newPhaseNumber < numberPhases()) {
+            currentPhaseNumber = newPhaseNumber;
+        }
+    }
 }
@@ -36,6 +36,11 @@ namespace Ld {
     Translator::~Translator() {}
 
 
+    bool Translator::threadSafe(const TranslationPhase&) const {
+        return false;
+    }
+
+
     Translator::operator QString() const {
         return elementName();
     }
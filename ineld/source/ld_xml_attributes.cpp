@@ -28,6 +28,8 @@
 #include <cstdint>
 
 #include <QString>
+#include <QStringRef>
+#include <QLatin1String>
 #include <QColor>
 #include <QXmlStreamAttributes>
 
@@ -35,6 +37,19 @@
 #include "ld_handle.h"
 #include "ld_xml_attributes.h"
 
+/**
+ * Function that performs a case insensitive comparison of an attribute value against a keyword without allocating.
+ *
+ * \param[in] value   The attribute value.
+ *
+ * \param[in] keyword The lower case keyword to compare against.
+ *
+ * \return Returns true if the value matches the keyword.  Returns false if the value does not match.
+ */
+static inline bool matches(const QStringRef& value, const char* keyword) {
+    return value.compare(QLatin1String(keyword), Qt::CaseInsensitive) == 0;
+}
+
 namespace Ld {
     XmlAttributes::XmlAttributes() {}
 
@@ -79,7 +94,7 @@ namespace Ld {
 
     std::int8_t XmlAttributes::signed8BitValue(const QString& name, bool* ok) const {
         bool         isOK      = true;
-        QString      rawValue  = QXmlStreamAttributes::value(name).toString();
+        QStringRef   rawValue  = QXmlStreamAttributes::value(name);
         std::int64_t converted = rawValue.toLongLong(&isOK);
 
         if (isOK) {
@@ -96,7 +111,7 @@ namespace Ld {
 
     std::int16_t XmlAttributes::signed16BitValue(const QString& name, bool* ok) const {
         bool         isOK      = true;
-        QString      rawValue  = QXmlStreamAttributes::value(name).toString();
+        QStringRef   rawValue  = QXmlStreamAttributes::value(name);
         std::int64_t converted = rawValue.toLongLong(&isOK);
 
         if (isOK) {
@@ -113,7 +128,7 @@ namespace Ld {
 
     std::int32_t XmlAttributes::signed32BitValue(const QString& name, bool* ok) const {
         bool         isOK      = true;
-        QString      rawValue  = QXmlStreamAttributes::value(name).toString();
+        QStringRef   rawValue  = QXmlStreamAttributes::value(name);
         std::int64_t converted = rawValue.toLongLong(&isOK);
 
         if (isOK) {
@@ -129,14 +144,13 @@ namespace Ld {
 
 
     std::int64_t XmlAttributes::signed64BitValue(const QString& name, bool* ok) const {
-        QString rawValue = QXmlStreamAttributes::value(name).toString();
-        return rawValue.toLongLong(ok);
+        return QXmlStreamAttributes::value(name).toLongLong(ok);
     }
 
 
     std::uint8_t XmlAttributes::unsigned8BitValue(const QString& name, bool* ok) const {
         bool          isOK      = true;
-        QString       rawValue  = QXmlStreamAttributes::value(name).toString();
+        QStringRef    rawValue  = QXmlStreamAttributes::value(name);
         std::uint64_t converted = rawValue.toULongLong(&isOK);
 
         if (isOK) {
@@ -153,7 +167,7 @@ namespace Ld {
 
     std::uint16_t XmlAttributes::unsigned16BitValue(const QString& name, bool* ok) const {
         bool          isOK      = true;
-        QString       rawValue  = QXmlStreamAttributes::value(name).toString();
+        QStringRef    rawValue  = QXmlStreamAttributes::value(name);
         std::uint64_t converted = rawValue.toULongLong(&isOK);
 
         if (isOK) {
@@ -170,7 +184,7 @@ namespace Ld {
 
     std::uint32_t XmlAttributes::unsigned32BitValue(const QString& name, bool* ok) const {
         bool          isOK      = true;
-        QString       rawValue  = QXmlStreamAttributes::value(name).toString();
+        QStringRef    rawValue  = QXmlStreamAttributes::value(name);
         std::uint64_t converted = rawValue.toULongLong(&isOK);
 
         if (isOK) {
@@ -186,19 +200,26 @@ namespace Ld {
 
 
     std::uint64_t XmlAttributes::unsigned64BitValue(const QString& name, bool* ok) const {
-        QString rawValue = QXmlStreamAttributes::value(name).toString();
-        return rawValue.toULongLong(ok);
+        return QXmlStreamAttributes::value(name).toULongLong(ok);
     }
 
 
     bool XmlAttributes::boolValue(const QString& name, bool* ok) const {
-        bool    isOK     = true;
-        bool    result   = false;
-        QString rawValue = QXmlStreamAttributes::value(name).toString().trimmed().toLower();
-
-        if (rawValue == "true" || rawValue == "yes" || rawValue == "1" || rawValue == "t" || rawValue == "y") {
+        bool       isOK     = true;
+        bool       result   = false;
+        QStringRef rawValue = QXmlStreamAttributes::value(name).trimmed();
+
+        if (   matches(rawValue, "true")
+            || matches(rawValue, "yes")
+            || matches(rawValue, "1")
+            || matches(rawValue, "t")
+            || matches(rawValue, "y")) {
             result = true;
-        } else if (rawValue == "false" || rawValue == "no" || rawValue == "0" || rawValue == "f" || rawValue == "n") {
+        } else if (   matches(rawValue, "false")
+                   || matches(rawValue, "no")
+                   || matches(rawValue, "0")
+                   || matches(rawValue, "f")
+                   || matches(rawValue, "n")) {
             result = false;
         } else if (ok != nullptr) {
             isOK = false;
@@ -213,14 +234,37 @@ namespace Ld {
 
 
     float XmlAttributes::floatValue(const QString& name, bool* ok) const {
-        QString rawValue = QXmlStreamAttributes::value(name).toString().trimmed().toLower();
-        return rawValue.toFloat(ok);
+        QStringRef rawValue = QXmlStreamAttributes::value(name).trimmed();
+        bool       isOK;
+        float      result   = rawValue.toFloat(&isOK);
+
+        if (!isOK) {
+            // Slow path for values such as "INF" or "NaN" that only convert once folded to lower case.
+            result = rawValue.toString().toLower().toFloat(&isOK);
+        }
+
+        if (ok != nullptr) {
+            *ok = isOK;
+        }
+
+        return result;
     }
 
 
     double XmlAttributes::doubleValue(const QString& name, bool* ok) const {
-        QString rawValue = QXmlStreamAttributes::value(name).toString().trimmed().toLower();
-        return rawValue.toDouble(ok);
+        QStringRef rawValue = QXmlStreamAttributes::value(name).trimmed();
+        bool       isOK;
+        double     result   = rawValue.toDouble(&isOK);
+
+        if (!isOK) {
+            result = rawValue.toString().toLower().toDouble(&isOK);
+        }
+
+        if (ok != nullptr) {
+            *ok = isOK;
+        }
+
+        return result;
     }
 
 
@@ -0,0 +1,138 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements the \ref Ld::XmlBinaryFormat class.
+***********************************************************************************************************************/
+
+#include <QString>
+#include <QByteArray>
+
+#include "ld_xml_binary_format.h"
+
+namespace Ld {
+    const QByteArray XmlBinaryFormat::header("INBX\x01", 5);
+
+    void XmlBinaryFormat::appendInteger(QByteArray& buffer, unsigned long long value) {
+        while (value >= 0x80) {
+            buffer.append(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+
+        buffer.append(static_cast<char>(value));
+    }
+
+
+    bool XmlBinaryFormat::readInteger(const QByteArray& buffer, int& position, unsigned long long& value) {
+        bool     success  = false;
+        bool     finished = false;
+        unsigned shift    = 0;
+        int      size     = buffer.size();
+
+        value = 0;
+        while (!finished && position < size && shift < 64) {
+            std::uint8_t byte = static_cast<std::uint8_t>(buffer.at(position));
+            ++position;
+
+            value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            shift += 7;
+
+            if ((byte & 0x80) == 0) {
+                finished = true;
+                success  = true;
+            }
+        }
+
+        return success;
+    }
+
+
+    void XmlBinaryFormat::appendString(QByteArray& buffer, const QString& value) {
+        QByteArray utf8 = value.toUtf8();
+        appendInteger(buffer, static_cast<unsigned long long>(utf8.size()));
+        buffer.append(utf8);
+    }
+
+
+    bool XmlBinaryFormat::readString(const QByteArray& buffer, int& position, QString& value) {
+        unsigned long long length;
+        bool               success = readInteger(buffer, position, length);
+
+        if (success) {
+            if (length > static_cast<unsigned long long>(buffer.size() - position)) {
+                success = false;
+            } else {
+                value     = QString::fromUtf8(buffer.constData() + position, static_cast<int>(length));
+                position += static_cast<int>(length);
+            }
+        }
+
+        return success;
+    }
+
+
+    bool XmlBinaryFormat::isCanonicalInteger(const QString& value, unsigned long long& magnitude, bool& negative) {
+        bool isCanonical = false;
+        int  length      = value.length();
+
+        negative = length > 1 && value.at(0) == QChar('-');
+
+        int firstDigit   = negative ? 1 : 0;
+        int numberDigits = length - firstDigit;
+
+        if (numberDigits > 0 && numberDigits <= 19) {
+            isCanonical = numberDigits == 1 || value.at(firstDigit) != QChar('0');
+
+            int index = firstDigit;
+            magnitude = 0;
+            while (isCanonical && index < length) {
+                ushort c = value.at(index).unicode();
+                if (c >= '0' && c <= '9') {
+                    magnitude = 10 * magnitude + (c - '0');
+                    ++index;
+                } else {
+                    isCanonical = false;
+                }
+            }
+
+            if (negative && magnitude == 0) {
+                isCanonical = false;
+            }
+        }
+
+        return isCanonical;
+    }
+
+
+    bool XmlBinaryFormat::isBase64Block(const QString& value, QByteArray& decoded) {
+        bool result = false;
+
+        if (value.length() == 16) {
+            QByteArray encoded = value.toLatin1();
+            decoded = QByteArray::fromBase64(encoded);
+            result  = decoded.size() == 12 && decoded.toBase64() == encoded;
+        }
+
+        return result;
+    }
+};
@@ -0,0 +1,205 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This header defines the \ref Ld::XmlBinaryFormat class.
+***********************************************************************************************************************/
+
+/* .. sphinx-project ineld */
+
+#ifndef LD_XML_BINARY_FORMAT_H
+#define LD_XML_BINARY_FORMAT_H
+
+#include <QString>
+#include <QByteArray>
+
+#include <cstdint>
+
+namespace Ld {
+    /**
+     * Class that holds the constants and primitive encoders shared by the \ref Ld::XmlWriter and \ref Ld::XmlReader
+     * classes when operating on the compact binary encoding of the XML event stream.
+     *
+     * The binary stream starts with a fixed header followed by a sequence of tokens.  Each token is a single byte
+     * followed by a token specific payload.  Integers are encoded as little-endian base-128 variable length
+     * integers.  Element names, attribute names and short attribute values are placed into a string table as they
+     * are first encountered and are referenced by index afterwards.
+     */
+    class XmlBinaryFormat {
+        public:
+            /**
+             * Header placed at the start of every binary stream.  The final byte is the format version.
+             */
+            static const QByteArray header;
+
+            /**
+             * Enumeration of binary tokens.
+             */
+            enum class Token : std::uint8_t {
+                /**
+                 * Start of document, no payload.
+                 */
+                START_DOCUMENT = 1,
+
+                /**
+                 * End of document, no payload.
+                 */
+                END_DOCUMENT = 2,
+
+                /**
+                 * Document type declaration, followed by a string.
+                 */
+                DTD = 3,
+
+                /**
+                 * Start of an element, followed by an interned element name.
+                 */
+                START_ELEMENT = 4,
+
+                /**
+                 * Attributes for the most recently started element, followed by an attribute count and, for each
+                 * attribute, an interned name and an encoded value.
+                 */
+                ATTRIBUTES = 5,
+
+                /**
+                 * End of the most recently started element, no payload.
+                 */
+                END_ELEMENT = 6,
+
+                /**
+                 * Character data, followed by a string.
+                 */
+                CHARACTERS = 7
+            };
+
+            /**
+             * Enumeration of attribute value encodings.
+             */
+            enum class ValueEncoding : std::uint8_t {
+                /**
+                 * The value is stored as a length prefixed UTF-8 string.
+                 */
+                STRING = 0,
+
+                /**
+                 * The value is stored in the string table.
+                 */
+                INTERNED = 1,
+
+                /**
+                 * The value is a canonical non-negative decimal integer stored as a variable length integer.
+                 */
+                UNSIGNED_INTEGER = 2,
+
+                /**
+                 * The value is a canonical negative decimal integer whose magnitude is stored as a variable length
+                 * integer.
+                 */
+                NEGATIVE_INTEGER = 3,
+
+                /**
+                 * The value is a 16 character base-64 string, such as an element handle, stored as the 12 bytes it
+                 * decodes to.
+                 */
+                BASE64_12 = 4
+            };
+
+            /**
+             * The maximum length of attribute values that will be placed into the string table.
+             */
+            static constexpr int maximumInternedValueLength = 16;
+
+            /**
+             * Method that appends a variable length integer to a buffer.
+             *
+             * \param[in,out] buffer The buffer to append to.
+             *
+             * \param[in]     value  The value to be appended.
+             */
+            static void appendInteger(QByteArray& buffer, unsigned long long value);
+
+            /**
+             * Method that reads a variable length integer from a buffer.
+             *
+             * \param[in]     buffer   The buffer to read from.
+             *
+             * \param[in,out] position The current read position.  The position is advanced past the integer.
+             *
+             * \param[out]    value    The value that was read.
+             *
+             * \return Returns true on success, returns false if the buffer does not hold a complete integer.
+             */
+            static bool readInteger(const QByteArray& buffer, int& position, unsigned long long& value);
+
+            /**
+             * Method that appends a length prefixed UTF-8 string to a buffer.
+             *
+             * \param[in,out] buffer The buffer to append to.
+             *
+             * \param[in]     value  The string to be appended.
+             */
+            static void appendString(QByteArray& buffer, const QString& value);
+
+            /**
+             * Method that reads a length prefixed UTF-8 string from a buffer.
+             *
+             * \param[in]     buffer   The buffer to read from.
+             *
+             * \param[in,out] position The current read position.  The position is advanced past the string.
+             *
+             * \param[out]    value    The string that was read.
+             *
+             * \return Returns true on success, returns false if the buffer does not hold a complete string.
+             */
+            static bool readString(const QByteArray& buffer, int& position, QString& value);
+
+            /**
+             * Method that determines if a string is a canonical decimal integer that can be encoded losslessly as a
+             * variable length integer.
+             *
+             * \param[in]  value     The value to be tested.
+             *
+             * \param[out] magnitude The magnitude of the integer.
+             *
+             * \param[out] negative  Holds true if the value is negative.
+             *
+             * \return Returns true if the value is a canonical decimal integer.
+             */
+            static bool isCanonicalInteger(const QString& value, unsigned long long& magnitude, bool& negative);
+
+            /**
+             * Method that determines if a string is a base-64 encoding of exactly 12 bytes that can be reproduced
+             * exactly from the decoded bytes.
+             *
+             * \param[in]  value   The value to be tested.
+             *
+             * \param[out] decoded The decoded bytes.
+             *
+             * \return Returns true if the value can be stored as raw bytes.
+             */
+            static bool isBase64Block(const QString& value, QByteArray& decoded);
+    };
+};
+
+#endif
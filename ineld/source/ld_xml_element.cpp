@@ -90,7 +90,7 @@ namespace Ld {
                     QString pcData = reader->text().toString();
                     readData(reader, pcData, formats, programFile, xmlVersion);
                 } else if (tokenType == XmlReader::StartElement) {
-                    QString       childToken      = reader->qualifiedName().toString();
+                    QString       childToken      = reader->internedQualifiedName();
                     XmlAttributes childAttributes = reader->attributes();
                     readChild(reader, childToken, formats, programFile, childAttributes, xmlVersion);
                 } else if (tokenType != XmlReader::EndElement) {
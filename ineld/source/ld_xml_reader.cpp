@@ -26,17 +26,45 @@
 ***********************************************************************************************************************/
 
 #include <QXmlStreamReader>
+#include <QString>
+#include <QStringRef>
+#include <QByteArray>
+#include <QVector>
+#include <QMultiHash>
 
 #include <qvirtual_file.h>
 
+#include "ld_xml_binary_format.h"
 #include "ld_xml_attributes.h"
 #include "ld_xml_reader.h"
 
 namespace Ld {
-    XmlReader::XmlReader() {}
+    XmlReader::XmlReader() {
+        setNamespaceProcessing(false);
+
+        currentBinary    = false;
+        binaryPosition   = 0;
+        currentTokenType = NoToken;
+    }
 
 
-    XmlReader::XmlReader(QVirtualFile* virtualFile):QXmlStreamReader(virtualFile) {}
+    XmlReader::XmlReader(QVirtualFile* virtualFile, bool binary):QXmlStreamReader(virtualFile) {
+        setNamespaceProcessing(false);
+
+        currentBinary    = binary;
+        binaryPosition   = 0;
+        currentTokenType = NoToken;
+
+        if (currentBinary) {
+            binaryData = virtualFile->readAll();
+            if (!binaryData.startsWith(XmlBinaryFormat::header)) {
+                raiseError(QString("Invalid binary document header"));
+                currentTokenType = Invalid;
+            } else {
+                binaryPosition = XmlBinaryFormat::header.size();
+            }
+        }
+    }
 
 
     XmlReader::~XmlReader() {}
@@ -53,6 +81,325 @@ namespace Ld {
 
 
     XmlAttributes XmlReader::attributes() const {
-        return XmlAttributes(QXmlStreamReader::attributes());
+        return XmlAttributes(currentBinary ? currentAttributes : QXmlStreamReader::attributes());
+    }
+
+
+    QString XmlReader::internedQualifiedName() {
+        QStringRef name     = qualifiedName();
+        unsigned   nameHash = static_cast<unsigned>(qHash(name));
+
+        QString result;
+        bool    found = false;
+
+        QMultiHash<unsigned, QString>::const_iterator it  = internedNames.constFind(nameHash);
+        QMultiHash<unsigned, QString>::const_iterator end = internedNames.constEnd();
+        while (!found && it != end && it.key() == nameHash) {
+            if (it.value() == name) {
+                result = it.value();
+                found  = true;
+            } else {
+                ++it;
+            }
+        }
+
+        if (!found) {
+            result = name.toString();
+            internedNames.insert(nameHash, result);
+        }
+
+        return result;
+    }
+
+
+    bool XmlReader::isBinary() const {
+        return currentBinary;
+    }
+
+
+    XmlReader::TokenType XmlReader::readNext() {
+        return currentBinary ? readNextBinary() : QXmlStreamReader::readNext();
+    }
+
+
+    XmlReader::TokenType XmlReader::tokenType() const {
+        return currentBinary ? currentTokenType : QXmlStreamReader::tokenType();
+    }
+
+
+    bool XmlReader::atEnd() const {
+        return currentBinary ? (hasError() || currentTokenType == EndDocument) : QXmlStreamReader::atEnd();
+    }
+
+
+    bool XmlReader::isEndDocument() const {
+        return tokenType() == EndDocument;
+    }
+
+
+    bool XmlReader::isStartElement() const {
+        return tokenType() == StartElement;
+    }
+
+
+    bool XmlReader::isEndElement() const {
+        return tokenType() == EndElement;
+    }
+
+
+    bool XmlReader::isCharacters() const {
+        return tokenType() == Characters;
+    }
+
+
+    bool XmlReader::isWhitespace() const {
+        bool result;
+
+        if (currentBinary) {
+            result = currentTokenType == Characters && currentText.trimmed().isEmpty();
+        } else {
+            result = QXmlStreamReader::isWhitespace();
+        }
+
+        return result;
+    }
+
+
+    QStringRef XmlReader::qualifiedName() const {
+        return currentBinary ? QStringRef(&currentName) : QXmlStreamReader::qualifiedName();
+    }
+
+
+    QStringRef XmlReader::text() const {
+        return currentBinary ? QStringRef(&currentText) : QXmlStreamReader::text();
+    }
+
+
+    QStringRef XmlReader::dtdName() const {
+        return currentBinary ? QStringRef(&currentDtdName) : QXmlStreamReader::dtdName();
+    }
+
+
+    qint64 XmlReader::lineNumber() const {
+        return currentBinary ? 0 : QXmlStreamReader::lineNumber();
+    }
+
+
+    qint64 XmlReader::columnNumber() const {
+        return currentBinary ? 0 : QXmlStreamReader::columnNumber();
+    }
+
+
+    qint64 XmlReader::characterOffset() const {
+        return currentBinary ? binaryPosition : QXmlStreamReader::characterOffset();
+    }
+
+
+    bool XmlReader::readInterned(QString& value) {
+        unsigned long long index;
+        bool               success = XmlBinaryFormat::readInteger(binaryData, binaryPosition, index);
+
+        if (success) {
+            if (index == 0) {
+                success = XmlBinaryFormat::readString(binaryData, binaryPosition, value);
+                if (success) {
+                    stringTable.append(value);
+                }
+            } else if (index <= static_cast<unsigned long long>(stringTable.size())) {
+                value = stringTable.at(static_cast<int>(index - 1));
+            } else {
+                success = false;
+            }
+        }
+
+        return success;
+    }
+
+
+    bool XmlReader::readValue(QString& value) {
+        bool success = binaryPosition < binaryData.size();
+
+        if (success) {
+            XmlBinaryFormat::ValueEncoding encoding = static_cast<XmlBinaryFormat::ValueEncoding>(
+                binaryData.at(binaryPosition)
+            );
+            ++binaryPosition;
+
+            unsigned long long magnitude;
+            switch (encoding) {
+                case XmlBinaryFormat::ValueEncoding::STRING: {
+                    success = XmlBinaryFormat::readString(binaryData, binaryPosition, value);
+                    break;
+                }
+
+                case XmlBinaryFormat::ValueEncoding::INTERNED: {
+                    success = readInterned(value);
+                    break;
+                }
+
+                case XmlBinaryFormat::ValueEncoding::UNSIGNED_INTEGER: {
+                    success = XmlBinaryFormat::readInteger(binaryData, binaryPosition, magnitude);
+                    if (success) {
+                        value = QString::number(magnitude);
+                    }
+
+                    break;
+                }
+
+                case XmlBinaryFormat::ValueEncoding::NEGATIVE_INTEGER: {
+                    success = XmlBinaryFormat::readInteger(binaryData, binaryPosition, magnitude);
+                    if (success) {
+                        value = QString("-%1").arg(magnitude);
+                    }
+
+                    break;
+                }
+
+                case XmlBinaryFormat::ValueEncoding::BASE64_12: {
+                    success = binaryData.size() - binaryPosition >= 12;
+                    if (success) {
+                        value           = QString::fromLatin1(binaryData.mid(binaryPosition, 12).toBase64());
+                        binaryPosition += 12;
+                    }
+
+                    break;
+                }
+
+                default: {
+                    success = false;
+                    break;
+                }
+            }
+        }
+
+        return success;
+    }
+
+
+    bool XmlReader::readBinaryAttributes() {
+        bool success = true;
+
+        currentAttributes.clear();
+        while (success                                                                                &&
+               binaryPosition < binaryData.size()                                                     &&
+               binaryData.at(binaryPosition) == static_cast<char>(XmlBinaryFormat::Token::ATTRIBUTES)    ) {
+            ++binaryPosition;
+
+            unsigned long long numberAttributes;
+            success = XmlBinaryFormat::readInteger(binaryData, binaryPosition, numberAttributes);
+
+            unsigned long long index = 0;
+            while (success && index < numberAttributes) {
+                QString name;
+                QString value;
+
+                success = readInterned(name) && readValue(value);
+                if (success) {
+                    currentAttributes.append(name, value);
+                }
+
+                ++index;
+            }
+        }
+
+        return success;
+    }
+
+
+    XmlReader::TokenType XmlReader::readNextBinary() {
+        if (!hasError()) {
+            bool success = binaryPosition < binaryData.size() && currentTokenType != EndDocument;
+
+            if (success) {
+                XmlBinaryFormat::Token token = static_cast<XmlBinaryFormat::Token>(binaryData.at(binaryPosition));
+                ++binaryPosition;
+
+                currentText.clear();
+                currentAttributes.clear();
+
+                switch (token) {
+                    case XmlBinaryFormat::Token::START_DOCUMENT: {
+                        currentTokenType = StartDocument;
+                        break;
+                    }
+
+                    case XmlBinaryFormat::Token::END_DOCUMENT: {
+                        success          = elementStack.isEmpty();
+                        currentTokenType = EndDocument;
+                        break;
+                    }
+
+                    case XmlBinaryFormat::Token::DTD: {
+                        success = XmlBinaryFormat::readString(binaryData, binaryPosition, currentText);
+                        if (success) {
+                            QString declaration = currentText.trimmed();
+                            if (declaration.startsWith(QString("<!DOCTYPE"))) {
+                                declaration = declaration.mid(9).trimmed();
+                            }
+
+                            int nameLength = 0;
+                            int length     = declaration.length();
+                            while (nameLength < length                           &&
+                                   !declaration.at(nameLength).isSpace()         &&
+                                   declaration.at(nameLength) != QChar('>')      &&
+                                   declaration.at(nameLength) != QChar('[')         ) {
+                                ++nameLength;
+                            }
+
+                            currentDtdName   = declaration.left(nameLength);
+                            currentTokenType = DTD;
+                        }
+
+                        break;
+                    }
+
+                    case XmlBinaryFormat::Token::START_ELEMENT: {
+                        success = readInterned(currentName) && readBinaryAttributes();
+                        if (success) {
+                            elementStack.append(currentName);
+                            currentTokenType = StartElement;
+                        }
+
+                        break;
+                    }
+
+                    case XmlBinaryFormat::Token::END_ELEMENT: {
+                        success = !elementStack.isEmpty();
+                        if (success) {
+                            currentName      = elementStack.takeLast();
+                            currentTokenType = EndElement;
+                        }
+
+                        break;
+                    }
+
+                    case XmlBinaryFormat::Token::CHARACTERS: {
+                        success = XmlBinaryFormat::readString(binaryData, binaryPosition, currentText);
+                        if (success) {
+                            currentTokenType = Characters;
+                        }
+
+                        break;
+                    }
+
+                    default: {
+                        success = false;
+                        break;
+                    }
+                }
+
+                if (!success) {
+                    raiseError(QString("Corrupt binary document at offset %1").arg(binaryPosition));
+                }
+            } else if (currentTokenType != EndDocument) {
+                raiseError(QString("Premature end of binary document"));
+            }
+        }
+
+        if (hasError()) {
+            currentTokenType = Invalid;
+        }
+
+        return currentTokenType;
     }
 };
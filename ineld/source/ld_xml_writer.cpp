@@ -26,19 +26,49 @@
 ***********************************************************************************************************************/
 
 #include <QXmlStreamWriter>
+#include <QString>
+#include <QByteArray>
+#include <QHash>
 
 #include <qvirtual_file.h>
 
+#include "ld_xml_binary_format.h"
 #include "ld_xml_writer.h"
 
 namespace Ld {
-    XmlWriter::XmlWriter() {}
+    XmlWriter::XmlWriter() {
+        currentBinary = false;
+        openElements  = 0;
+    }
+
+
+    XmlWriter::XmlWriter(QVirtualFile* virtualFile, bool binary):QXmlStreamWriter(virtualFile) {
+        currentBinary = binary;
+        openElements  = 0;
+
+        if (currentBinary) {
+            binaryBuffer.reserve(flushThreshold + flushThreshold / 4);
+            binaryBuffer.append(XmlBinaryFormat::header);
+        }
+    }
+
 
+    XmlWriter::XmlWriter(QByteArray* array, bool binary):QXmlStreamWriter(array) {
+        currentBinary = binary;
+        openElements  = 0;
 
-    XmlWriter::XmlWriter(QVirtualFile* virtualFile):QXmlStreamWriter(virtualFile) {}
+        if (currentBinary) {
+            binaryBuffer.reserve(flushThreshold + flushThreshold / 4);
+            binaryBuffer.append(XmlBinaryFormat::header);
+        }
+    }
 
 
-    XmlWriter::~XmlWriter() {}
+    XmlWriter::~XmlWriter() {
+        if (currentBinary) {
+            flushBinary(true);
+        }
+    }
 
 
     void XmlWriter::setVirtualFile(QVirtualFile* newVirtualFile) {
@@ -49,4 +79,180 @@ namespace Ld {
     QVirtualFile* XmlWriter::virtualFile() const {
         return dynamic_cast<QVirtualFile*>(device());
     }
+
+
+    bool XmlWriter::isBinary() const {
+        return currentBinary;
+    }
+
+
+    void XmlWriter::setAutoFormatting(bool nowEnabled) {
+        QXmlStreamWriter::setAutoFormatting(nowEnabled);
+    }
+
+
+    void XmlWriter::writeStartDocument() {
+        if (currentBinary) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::START_DOCUMENT));
+        } else {
+            QXmlStreamWriter::writeStartDocument();
+        }
+    }
+
+
+    void XmlWriter::writeEndDocument() {
+        if (currentBinary) {
+            while (openElements > 0) {
+                writeEndElement();
+            }
+
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::END_DOCUMENT));
+            flushBinary(true);
+        } else {
+            QXmlStreamWriter::writeEndDocument();
+        }
+    }
+
+
+    void XmlWriter::writeDTD(const QString& dtd) {
+        if (currentBinary) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::DTD));
+            XmlBinaryFormat::appendString(binaryBuffer, dtd);
+        } else {
+            QXmlStreamWriter::writeDTD(dtd);
+        }
+    }
+
+
+    void XmlWriter::writeStartElement(const QString& qualifiedName) {
+        if (currentBinary) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::START_ELEMENT));
+            appendInterned(qualifiedName);
+            ++openElements;
+        } else {
+            QXmlStreamWriter::writeStartElement(qualifiedName);
+        }
+    }
+
+
+    void XmlWriter::writeAttributes(const QXmlStreamAttributes& attributes) {
+        if (currentBinary) {
+            if (!attributes.isEmpty()) {
+                binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::ATTRIBUTES));
+                XmlBinaryFormat::appendInteger(binaryBuffer, static_cast<unsigned long long>(attributes.size()));
+
+                for (  QXmlStreamAttributes::const_iterator it  = attributes.constBegin(),
+                                                            end = attributes.constEnd()
+                     ; it != end
+                     ; ++it
+                    ) {
+                    appendInterned(it->qualifiedName().toString());
+                    appendValue(it->value().toString());
+                }
+            }
+        } else {
+            QXmlStreamWriter::writeAttributes(attributes);
+        }
+    }
+
+
+    void XmlWriter::writeAttribute(const QString& qualifiedName, const QString& value) {
+        if (currentBinary) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::ATTRIBUTES));
+            XmlBinaryFormat::appendInteger(binaryBuffer, 1);
+            appendInterned(qualifiedName);
+            appendValue(value);
+        } else {
+            QXmlStreamWriter::writeAttribute(qualifiedName, value);
+        }
+    }
+
+
+    void XmlWriter::writeCharacters(const QString& text) {
+        if (currentBinary) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::CHARACTERS));
+            XmlBinaryFormat::appendString(binaryBuffer, text);
+            flushBinary();
+        } else {
+            QXmlStreamWriter::writeCharacters(text);
+        }
+    }
+
+
+    void XmlWriter::writeEndElement() {
+        if (currentBinary) {
+            if (openElements > 0) {
+                binaryBuffer.append(static_cast<char>(XmlBinaryFormat::Token::END_ELEMENT));
+                --openElements;
+                flushBinary();
+            }
+        } else {
+            QXmlStreamWriter::writeEndElement();
+        }
+    }
+
+
+    void XmlWriter::writeTextElement(const QString& qualifiedName, const QString& text) {
+        if (currentBinary) {
+            writeStartElement(qualifiedName);
+            writeCharacters(text);
+            writeEndElement();
+        } else {
+            QXmlStreamWriter::writeTextElement(qualifiedName, text);
+        }
+    }
+
+
+    void XmlWriter::appendInterned(const QString& value) {
+        // Index 0 indicates a new string follows inline; existing strings are referenced by index + 1.
+
+        QHash<QString, unsigned long long>::const_iterator it = stringTable.constFind(value);
+        if (it != stringTable.constEnd()) {
+            XmlBinaryFormat::appendInteger(binaryBuffer, it.value() + 1);
+        } else {
+            XmlBinaryFormat::appendInteger(binaryBuffer, 0);
+            XmlBinaryFormat::appendString(binaryBuffer, value);
+
+            unsigned long long index = static_cast<unsigned long long>(stringTable.size());
+            stringTable.insert(value, index);
+        }
+    }
+
+
+    void XmlWriter::appendValue(const QString& value) {
+        unsigned long long magnitude;
+        bool               negative;
+        QByteArray         decoded;
+
+        if (XmlBinaryFormat::isCanonicalInteger(value, magnitude, negative)) {
+            XmlBinaryFormat::ValueEncoding encoding =   negative
+                                                      ? XmlBinaryFormat::ValueEncoding::NEGATIVE_INTEGER
+                                                      : XmlBinaryFormat::ValueEncoding::UNSIGNED_INTEGER;
+
+            binaryBuffer.append(static_cast<char>(encoding));
+            XmlBinaryFormat::appendInteger(binaryBuffer, magnitude);
+        } else if (XmlBinaryFormat::isBase64Block(value, decoded)) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::ValueEncoding::BASE64_12));
+            binaryBuffer.append(decoded);
+        } else if (value.length() <= XmlBinaryFormat::maximumInternedValueLength) {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::ValueEncoding::INTERNED));
+            appendInterned(value);
+        } else {
+            binaryBuffer.append(static_cast<char>(XmlBinaryFormat::ValueEncoding::STRING));
+            XmlBinaryFormat::appendString(binaryBuffer, value);
+        }
+    }
+
+
+    void XmlWriter::flushBinary(bool force) {
+        if (!binaryBuffer.isEmpty() && (force || binaryBuffer.size() >= flushThreshold)) {
+            QIODevice* outputDevice = device();
+            if (outputDevice != nullptr) {
+                outputDevice->write(binaryBuffer);
+            }
+
+            binaryBuffer.clear();
+            binaryBuffer.reserve(flushThreshold + flushThreshold / 4);
+        }
+    }
 };
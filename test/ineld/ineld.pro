@@ -95,6 +95,11 @@ HEADERS = test_license_data.h \
           test_latex_code_generator.h \
           test_cpp_code_generator_output_types.h \
           test_cpp_translation_phase.h \
+          test_cpp_object_cache.h \
+          test_cpp_declaration_pch_cache.h \
+          test_element_image_cache.h \
+          test_capabilities.h \
+          test_special_characters.h \
           test_cpp_code_generator_diagnostic.h \
           test_cpp_code_generator.h \
           test_boolean_data_type_format.h \
@@ -102,6 +107,7 @@ HEADERS = test_license_data.h \
           test_complex_data_type_format.h \
           test_list_data_type_format.h \
           test_matrix_data_type_format.h \
+          test_matrix_data_type_decoder.h \
           test_value_field_format.h \
           test_chart_line_style.h \
           test_chart_format.h \
@@ -175,6 +181,11 @@ SOURCES = test_ineld.cpp \
           test_latex_code_generator.cpp \
           test_cpp_code_generator_output_types.cpp \
           test_cpp_translation_phase.cpp \
+          test_cpp_object_cache.cpp \
+          test_cpp_declaration_pch_cache.cpp \
+          test_element_image_cache.cpp \
+          test_capabilities.cpp \
+          test_special_characters.cpp \
           test_cpp_code_generator_diagnostic.cpp \
           test_cpp_code_generator.cpp \
           test_boolean_data_type_format.cpp \
@@ -182,6 +193,7 @@ SOURCES = test_ineld.cpp \
           test_complex_data_type_format.cpp \
           test_list_data_type_format.cpp \
           test_matrix_data_type_format.cpp \
+          test_matrix_data_type_decoder.cpp \
           test_value_field_format.cpp \
           test_chart_line_style.cpp \
           test_chart_format.cpp \
@@ -0,0 +1,110 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+* \file
+*
+* This file implements tests for the \ref Ld::Capabilities class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QString>
+#include <QtTest/QtTest>
+
+#include <ld_capabilities.h>
+
+#include "test_capabilities.h"
+
+TestCapabilities::TestCapabilities() {}
+
+
+TestCapabilities::~TestCapabilities() {}
+
+
+void TestCapabilities::testPredefinedInstances() {
+    QVERIFY(Ld::Capabilities().isEmpty());
+    QVERIFY(Ld::Capabilities::selection.isNotEmpty());
+    QVERIFY(!Ld::Capabilities::selection.intersects(Ld::Capabilities::frame));
+
+    QVERIFY(Ld::Capabilities::expressions.contains(Ld::Capabilities::assignment));
+    QVERIFY(Ld::Capabilities::expressions.contains(Ld::Capabilities::conditionalOperator));
+    QVERIFY(!Ld::Capabilities::expressions.intersects(Ld::Capabilities::variables));
+
+    QVERIFY(Ld::Capabilities::allRValues.contains(Ld::Capabilities::allLValues));
+    QVERIFY(Ld::Capabilities::allRValues.contains(Ld::Capabilities::allTupleRValues));
+    QVERIFY(Ld::Capabilities::allScalarRValues == Ld::Capabilities::allComplexRValues);
+}
+
+
+void TestCapabilities::testSetOperations() {
+    Ld::Capabilities capabilities = Ld::Capabilities::variables | Ld::Capabilities::subscripts;
+    QVERIFY(capabilities == Ld::Capabilities::allLValues);
+    QVERIFY((capabilities & Ld::Capabilities::subscripts) == Ld::Capabilities::subscripts);
+    QVERIFY((capabilities ^ Ld::Capabilities::subscripts) == Ld::Capabilities::variables);
+
+    capabilities |= Ld::Capabilities::ranges;
+    QVERIFY(capabilities.contains(Ld::Capabilities::ranges));
+
+    capabilities &= Ld::Capabilities::ranges;
+    QVERIFY(capabilities == Ld::Capabilities::ranges);
+    QVERIFY(capabilities != Ld::Capabilities::allLValues);
+}
+
+
+void TestCapabilities::testNamedBits() {
+    QVERIFY(Ld::Capabilities("SELECTION") == Ld::Capabilities::selection);
+    QVERIFY(Ld::Capabilities("VARIABLES", "SUBSCRIPTS") == Ld::Capabilities::allLValues);
+    QVERIFY(!Ld::Capabilities::assignBit(QString("FRAME")));
+
+    QVERIFY(Ld::Capabilities::assignBit(QString("TEST_CAPABILITIES_PLUG_IN")));
+    QVERIFY(!Ld::Capabilities::assignBit(QString("TEST_CAPABILITIES_PLUG_IN")));
+
+    Ld::Capabilities plugIn("TEST_CAPABILITIES_PLUG_IN");
+    QVERIFY(plugIn.isNotEmpty());
+    QVERIFY(!plugIn.intersects(Ld::Capabilities::allRValuesAndRanges));
+    QVERIFY(!plugIn.intersects(Ld::Capabilities::allSymbols));
+
+    Ld::Capabilities combined("TEST_CAPABILITIES_PLUG_IN", "FRAME");
+    QVERIFY(combined.contains(plugIn));
+    QVERIFY(combined.contains(Ld::Capabilities::frame));
+    QVERIFY((combined & Ld::Capabilities::frame) == Ld::Capabilities::frame);
+}
+
+
+void TestCapabilities::testPlugInBitsExhausted() {
+    // This test uses up every plug-in bit so it must run last.
+
+    unsigned bitIndex = 0;
+    while (Ld::Capabilities::assignBit(QString("TEST_CAPABILITIES_FILL_%1").arg(bitIndex))) {
+        ++bitIndex;
+    }
+
+    QVERIFY(bitIndex < Ld::Capabilities::maximumNumberPlugInBits);
+
+    unsigned numberUnassignedBits = Ld::Capabilities::numberUnassignedBits();
+
+    Ld::Capabilities assigned("TEST_CAPABILITIES_FILL_0");
+    QVERIFY(assigned.isNotEmpty());
+    QCOMPARE(Ld::Capabilities::numberUnassignedBits(), numberUnassignedBits);
+
+    Ld::Capabilities unassigned("TEST_CAPABILITIES_OVERFLOW");
+    QVERIFY(unassigned.isEmpty());
+    QCOMPARE(Ld::Capabilities::numberUnassignedBits(), numberUnassignedBits + 1);
+}
@@ -32,8 +32,11 @@
 #include <QDebug>
 #include <QString>
 #include <QByteArray>
+#include <QRegularExpression>
 #include <QSharedPointer>
 #include <QWeakPointer>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
 #include <QtTest/QtTest>
 
 #include <iostream>
@@ -43,12 +46,15 @@
 #include <model_api.h>
 #include <model_status.h>
 #include <model_rng.h>
+#include <model_matrix_real.h>
+#include <model_variant.h>
 
 #include <cbe_loader_notifier.h>
 #include <cbe_dynamic_library_loader.h>
 
 #include <ld_element_structures.h>
 #include <ld_diagnostic_structures.h>
+#include <ld_data_type.h>
 #include <ld_environment.h>
 #include <ld_configure.h>
 #include <ld_code_generator.h>
@@ -67,6 +73,9 @@
 #include <ld_subtraction_operator_element.h>
 #include <ld_multiplication_operator_element.h>
 #include <ld_division_operator_element.h>
+#include <ld_hadamard_product_operator_element.h>
+#include <ld_function_element.h>
+#include <ld_grouping_parenthesis_operator_element.h>
 #include <ld_element_of_set_operator_element.h>
 #include <ld_integer_type_element.h>
 #include <ld_real_type_element.h>
@@ -74,13 +83,23 @@
 #include <ld_variable_element.h>
 #include <ld_literal_element.h>
 #include <ld_division_operator_element.h>
+#include <ld_for_all_in_operator_element.h>
+#include <ld_range_2_element.h>
+#include <ld_matrix_operator_element.h>
+#include <ld_matrix_transpose_operator_element.h>
+#include <ld_subscript_index_operator_element.h>
 #include <ld_character_format.h>
 #include <ld_operator_format.h>
 #include <ld_multiplication_operator_format.h>
 #include <ld_division_operator_format.h>
+#include <ld_function_format.h>
 #include <ld_capabilities.h>
 #include <ld_element_with_fixed_children.h>
+#include <ld_list_element_base.h>
+#include <ld_compound_statement_operator_element.h>
 #include <ld_root_element.h>
+#include <ld_operation_profile.h>
+#include <ld_cpp_matrix_operator_translator.h>
 
 #include "test_cpp_code_generator.h"
 
@@ -471,10 +490,17 @@ class TestModelStatus:public Model::Status {
         void threadFinished(Model::Api* modelApi, unsigned threadId) override;
 
         void threadAborted(Model::Api* modelApi, unsigned threadId) override;
+
+        bool abortedCalled() const;
+
+    private:
+        bool currentAbortedCalled;
 };
 
 
-TestModelStatus::TestModelStatus() {}
+TestModelStatus::TestModelStatus() {
+    currentAbortedCalled = false;
+}
 
 
 TestModelStatus::~TestModelStatus() {}
@@ -486,7 +512,9 @@ void TestModelStatus::started(Model::Api*) {}
 void TestModelStatus::finished(Model::Api*) {}
 
 
-void TestModelStatus::aborted(Model::Api*, Model::AbortReason, Model::OperationHandle) {}
+void TestModelStatus::aborted(Model::Api*, Model::AbortReason, Model::OperationHandle) {
+    currentAbortedCalled = true;
+}
 
 
 void TestModelStatus::pausedOnUserRequest(Model::Api*, Model::OperationHandle) {}
@@ -509,6 +537,371 @@ void TestModelStatus::threadFinished(Model::Api*, unsigned) {}
 
 void TestModelStatus::threadAborted(Model::Api*, unsigned) {}
 
+
+bool TestModelStatus::abortedCalled() const {
+    return currentAbortedCalled;
+}
+
+/***********************************************************************************************************************
+ * Model helpers:
+ */
+
+/**
+ * Function that returns the absolute path of a model library built in the current directory.
+ *
+ * \param[in] basename The library name, without the platform specific suffix.
+ *
+ * \return Returns the absolute path to the library.
+ */
+static QString modelLibraryFile(const QString& basename) {
+    #if (defined(Q_OS_WIN))
+
+        QString librarySuffix = ".dll";
+
+    #elif (defined(Q_OS_LINUX))
+
+        QString librarySuffix = ".so";
+
+    #elif (defined(Q_OS_DARWIN))
+
+        QString librarySuffix = ".dylib";
+
+    #else
+
+        #error Unknown platform.
+
+    #endif
+
+    return QFileInfo(basename + librarySuffix).absoluteFilePath();
+}
+
+
+/**
+ * Function that translates a model using the C++ code generator.
+ *
+ * \param[in] rootElement The root element of the model.
+ *
+ * \param[in] libraryFile The library to be generated.
+ *
+ * \return Returns true if the translation completed successfully.
+ */
+static bool translateModel(QSharedPointer<Ld::RootElement> rootElement, const QString& libraryFile) {
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    CodeGeneratorVisual* visual = dynamic_cast<CodeGeneratorVisual*>(generator->visual());
+    visual->reset();
+
+    generator->translate(rootElement, libraryFile);
+    generator->waitComplete();
+
+    return visual->translationCompletedCalled() && visual->successful();
+}
+
+
+/**
+ * Function that loads a model library, runs the model, and reads back variables.
+ *
+ * \param[in]  libraryFile   The model library to be loaded.
+ *
+ * \param[in]  numberRuns    The number of times the model should be run.
+ *
+ * \param[in]  description   Description used to report the average run time.  No time is reported if the
+ *                           description is empty.
+ *
+ * \param[in]  variableNames The variables to read back once the model has been run.
+ *
+ * \param[out] values        The values of the requested variables, in the order requested.
+ *
+ * \param[out] aborted       Optional pointer to a flag set to true if any run of the model was aborted.
+ *
+ * \param[in]  rootElement   Optional root element the model was generated from.  If supplied, the model's operation
+ *                           profile is collected into the root element after the runs.
+ *
+ * \return Returns true on success.  Returns false if the model could not be loaded or run, if a variable could not
+ *         be found, or if a requested operation profile could not be collected.
+ */
+static bool runModel(
+        const QString&                  libraryFile,
+        unsigned                        numberRuns,
+        const QString&                  description,
+        const QList<QString>&           variableNames,
+        QList<Model::Variant>&          values,
+        bool*                           aborted = nullptr,
+        QSharedPointer<Ld::RootElement> rootElement = QSharedPointer<Ld::RootElement>()
+    ) {
+    TestModelStatus statusInstance;
+
+    LoaderNotifier loaderNotifier;
+    Cbe::DynamicLibraryLoader loader(&loaderNotifier);
+
+    values.clear();
+
+    bool success = loader.load(libraryFile);
+    if (success) {
+        Model::AllocatorFunction allocatorFunction = reinterpret_cast<Model::AllocatorFunction>(
+            loader.resolve(Model::allocatorFunctionName)
+        );
+
+        Model::DeallocatorFunction deallocatorFunction = reinterpret_cast<Model::DeallocatorFunction>(
+            loader.resolve(Model::deallocatorFunctionName)
+        );
+
+        Model::Api* model = allocatorFunction != Q_NULLPTR ? (*allocatorFunction)(&matApi) : Q_NULLPTR;
+        success = (model != Q_NULLPTR && deallocatorFunction != Q_NULLPTR);
+
+        if (success) {
+            Model::Rng::RngType rngType = Model::Rng::RngType::MT19937;
+            Model::Rng::RngSeed rngSeed;
+
+            QElapsedTimer timer;
+            timer.start();
+
+            for (unsigned run=0 ; run<numberRuns ; ++run) {
+                model->run(rngType, rngSeed, &statusInstance);
+            }
+
+            qint64 elapsedNanoseconds = timer.nsecsElapsed();
+
+            if (!description.isEmpty()) {
+                qDebug() << description << ":" << (elapsedNanoseconds / (1.0E6 * numberRuns)) << "msec per run.";
+            }
+
+            Model::IdentifierDatabase identifierDatabase = model->identifierDatabase();
+            for (  QList<QString>::const_iterator it = variableNames.constBegin(), end = variableNames.constEnd()
+                 ; it != end
+                 ; ++it
+                ) {
+                Model::IdentifierData identifierData = identifierDatabase.entryByName(it->toUtf8().constData(), "");
+                if (identifierData.isValid()) {
+                    values.append(identifierData.value());
+                } else {
+                    values.append(Model::Variant());
+                    success = false;
+                }
+            }
+
+            if (success && !rootElement.isNull()) {
+                Ld::CppCodeGenerator::ModelProfileFunction profileFunction =
+                    reinterpret_cast<Ld::CppCodeGenerator::ModelProfileFunction>(
+                        loader.resolve(Ld::CppCodeGenerator::modelProfileFunctionName)
+                    );
+
+                success = Ld::CppCodeGenerator::collectOperationProfile(profileFunction, rootElement);
+            }
+
+            (*deallocatorFunction)(model);
+        }
+    }
+
+    if (aborted != nullptr) {
+        *aborted = statusInstance.abortedCalled();
+    }
+
+    return success;
+}
+
+
+/**
+ * Function that creates a variable element.
+ *
+ * \param[in] text1 The variable name.
+ *
+ * \param[in] text2 The variable subscript.
+ *
+ * \return Returns the new element.
+ */
+static Ld::ElementPointer variableElement(const QString& text1, const QString& text2 = QString()) {
+    Ld::ElementPointer element = Ld::Element::create(Ld::VariableElement::elementName);
+    element->setText(text1, 0);
+    element->setText(text2, 1);
+    element->setFormat(Ld::Format::create(Ld::CharacterFormat::formatName));
+
+    return element;
+}
+
+
+/**
+ * Function that creates a literal element.
+ *
+ * \param[in] text The literal text.
+ *
+ * \return Returns the new element.
+ */
+static Ld::ElementPointer literalElement(const QString& text) {
+    Ld::ElementPointer element = Ld::Element::create(Ld::LiteralElement::elementName);
+    element->setText(text);
+    element->setFormat(Ld::Format::create(Ld::CharacterFormat::formatName));
+
+    return element;
+}
+
+
+/**
+ * Function that creates an operator with a fixed number of children, such as an assignment, range, or for-all
+ * operator.
+ *
+ * \param[in] elementName The name of the operator element.
+ *
+ * \param[in] child0      The first child.
+ *
+ * \param[in] child1      The optional second child.
+ *
+ * \param[in] child2      The optional third child.
+ *
+ * \return Returns the new element.
+ */
+static Ld::ElementPointer operatorElement(
+        const QString&     elementName,
+        Ld::ElementPointer child0,
+        Ld::ElementPointer child1 = Ld::ElementPointer(),
+        Ld::ElementPointer child2 = Ld::ElementPointer()
+    ) {
+    QSharedPointer<Ld::ElementWithFixedChildren> element = Ld::Element::create(elementName)
+                                                           .dynamicCast<Ld::ElementWithFixedChildren>();
+
+    if (elementName == Ld::MultiplicationOperatorElement::elementName) {
+        element->setFormat(Ld::Format::create(Ld::MultiplicationOperatorFormat::formatName));
+    } else if (elementName == Ld::DivisionOperatorElement::elementName) {
+        element->setFormat(Ld::Format::create(Ld::DivisionOperatorFormat::formatName));
+    } else {
+        element->setFormat(Ld::Format::create(Ld::OperatorFormat::formatName));
+    }
+
+    element->setChild(0, child0, nullptr);
+
+    if (!child1.isNull()) {
+        element->setChild(1, child1, nullptr);
+    }
+
+    if (!child2.isNull()) {
+        element->setChild(2, child2, nullptr);
+    }
+
+    return element;
+}
+
+
+/**
+ * Function that creates an element holding a list of children, such as a function call or a compound statement.
+ *
+ * \param[in] elementName The name of the element.
+ *
+ * \param[in] children    The children to append.
+ *
+ * \param[in] text1       Optional function name.
+ *
+ * \param[in] text2       Optional function subscript.
+ *
+ * \return Returns the new element.
+ */
+static Ld::ElementPointer listElement(
+        const QString&                elementName,
+        const Ld::ElementPointerList& children,
+        const QString&                text1 = QString(),
+        const QString&                text2 = QString()
+    ) {
+    QSharedPointer<Ld::ListElementBase> element = Ld::Element::create(elementName)
+                                                  .dynamicCast<Ld::ListElementBase>();
+
+    if (elementName == Ld::FunctionElement::elementName) {
+        element->setText(text1, 0);
+        element->setText(text2, 1);
+        element->setFormat(Ld::Format::create(Ld::FunctionFormat::formatName));
+    } else {
+        element->setFormat(Ld::Format::create(Ld::OperatorFormat::formatName));
+    }
+
+    for (  Ld::ElementPointerList::const_iterator it = children.constBegin(), end = children.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        element->append(*it, nullptr);
+    }
+
+    return element;
+}
+
+
+/**
+ * Function that creates a literal matrix.  Entries are populated in column major order.
+ *
+ * \param[in] numberRows    The number of matrix rows.
+ *
+ * \param[in] numberColumns The number of matrix columns.
+ *
+ * \param[in] entries       The text of each literal entry.
+ *
+ * \return Returns the new element.
+ */
+static Ld::ElementPointer matrixElement(
+        unsigned long         numberRows,
+        unsigned long         numberColumns,
+        const QList<QString>& entries
+    ) {
+    QSharedPointer<Ld::MatrixOperatorElement> element = Ld::Element::create(Ld::MatrixOperatorElement::elementName)
+                                                        .dynamicCast<Ld::MatrixOperatorElement>();
+    element->setFormat(Ld::Format::create(Ld::OperatorFormat::formatName));
+    element->setNumberRows(numberRows, nullptr);
+    element->setNumberColumns(numberColumns, nullptr);
+
+    for (unsigned long entryIndex=0 ; entryIndex<numberRows * numberColumns ; ++entryIndex) {
+        element->setChild(
+            entryIndex % numberRows,
+            entryIndex / numberRows,
+            literalElement(entries.at(static_cast<int>(entryIndex))),
+            nullptr
+        );
+    }
+
+    return element;
+}
+
+
+/**
+ * Function that creates a model holding a list of statements followed by a for-all loop.
+ *
+ * \param[in] statements The statements to place ahead of the loop.
+ *
+ * \param[in] index      The name of the loop index.
+ *
+ * \param[in] lastIndex  The last value of the loop index.  The loop starts at 1.
+ *
+ * \param[in] operation  The operation performed by the loop.
+ *
+ * \return Returns the root element of the new model.
+ */
+static QSharedPointer<Ld::RootElement> forAllModel(
+        const Ld::ElementPointerList& statements,
+        const QString&                index,
+        const QString&                lastIndex,
+        Ld::ElementPointer            operation
+    ) {
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    for (  Ld::ElementPointerList::const_iterator it = statements.constBegin(), end = statements.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        rootElement->append(*it, nullptr);
+    }
+
+    rootElement->append(
+        operatorElement(
+            Ld::ForAllInOperatorElement::elementName,
+            variableElement(index),
+            operatorElement(Ld::Range2Element::elementName, literalElement("1"), literalElement(lastIndex)),
+            operation
+        ),
+        nullptr
+    );
+
+    return rootElement;
+}
+
+
 /***********************************************************************************************************************
  * TestCppCodeGenerator:
  */
@@ -790,6 +1183,1375 @@ void TestCppCodeGenerator::testDiagnosticHandling() {
 }
 
 
+void TestCppCodeGenerator::testExpressionOptimization() {
+    // Build the model:
+    //     a <- 3 ; b <- (2 + 3) a ; c <- (b + 1) a + (b + 1) a ; b <- 1 ; d <- (b + 1) a
+    //     e <- 1.0 / 3000000 ; f <- 2 * 1e-20
+    //
+    // The reassignment of b must end the run of the temporary holding (b + 1) a so d is computed from the new value
+    // of b.  The values of e and f exercise folded literals far below 1.
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("a"), literalElement("3")),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("b"),
+            operatorElement(
+                Ld::MultiplicationOperatorElement::elementName,
+                operatorElement(
+                    Ld::GroupingParenthesisOperatorElement::elementName,
+                    operatorElement(
+                        Ld::AdditionOperatorElement::elementName,
+                        literalElement("2"),
+                        literalElement("3")
+                    )
+                ),
+                variableElement("a")
+            )
+        ),
+        nullptr
+    );
+
+    Ld::ElementPointerList cTerms;
+    for (unsigned termIndex=0 ; termIndex<2 ; ++termIndex) {
+        cTerms.append(
+            operatorElement(
+                Ld::MultiplicationOperatorElement::elementName,
+                operatorElement(
+                    Ld::GroupingParenthesisOperatorElement::elementName,
+                    operatorElement(Ld::AdditionOperatorElement::elementName, variableElement("b"), literalElement("1"))
+                ),
+                variableElement("a")
+            )
+        );
+    }
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("c"),
+            operatorElement(Ld::AdditionOperatorElement::elementName, cTerms.at(0), cTerms.at(1))
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("b"), literalElement("1")),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("d"),
+            operatorElement(
+                Ld::MultiplicationOperatorElement::elementName,
+                operatorElement(
+                    Ld::GroupingParenthesisOperatorElement::elementName,
+                    operatorElement(Ld::AdditionOperatorElement::elementName, variableElement("b"), literalElement("1"))
+                ),
+                variableElement("a")
+            )
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("e"),
+            operatorElement(Ld::DivisionOperatorElement::elementName, literalElement("1.0"), literalElement("3000000"))
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("f"),
+            operatorElement(
+                Ld::MultiplicationOperatorElement::elementName,
+                literalElement("2"),
+                literalElement("1e-20")
+            )
+        ),
+        nullptr
+    );
+
+    // Translate and run with and without optimization, check the emitted code, and compare the results.
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    CodeGeneratorVisual* visual = dynamic_cast<CodeGeneratorVisual*>(generator->visual());
+    QVERIFY(visual != nullptr);
+
+    QList<QString>               variableNames = { "b", "c", "d", "e", "f" };
+    QList<QList<Model::Variant>> results;
+
+    for (unsigned pass=0 ; pass<2 ; ++pass) {
+        bool optimized = (pass != 0);
+        generator->setExpressionOptimizationEnabled(optimized);
+
+        QString libraryFile = modelLibraryFile(QString("optimization_%1").arg(pass));
+        QVERIFY(translateModel(rootElement, libraryFile));
+        QVERIFY(visual->reportedDiagnostic().isNull());
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("M::Integer(5)")), optimized);
+        QCOMPARE(ir.contains(QString("cse0=(")), optimized);
+        QVERIFY(!ir.contains(QString("cse1=(")));
+
+        QList<Model::Variant> values;
+        QVERIFY(runModel(libraryFile, 1, QString(), variableNames, values));
+        results.append(values);
+    }
+
+    for (unsigned variableIndex=0 ; variableIndex<static_cast<unsigned>(variableNames.size()) ; ++variableIndex) {
+        QCOMPARE(results.at(1).at(variableIndex).valueType(), results.at(0).at(variableIndex).valueType());
+        QCOMPARE(results.at(1).at(variableIndex).toReal(), results.at(0).at(variableIndex).toReal());
+    }
+
+    QCOMPARE(results.at(1).at(0).toInteger(), Model::Integer(1));
+    QCOMPARE(results.at(1).at(1).toInteger(), Model::Integer(96));
+    QCOMPARE(results.at(1).at(2).toInteger(), Model::Integer(6));
+    QCOMPARE(results.at(1).at(3).toReal(), Model::Real(1.0L) / Model::Real(3000000));
+    QCOMPARE(results.at(1).at(4).toReal(), Model::Real(2) * Model::Real(1.0E-20L));
+
+    generator->setExpressionOptimizationEnabled();
+}
+
+
+void TestCppCodeGenerator::testFunctionSpecialization() {
+    // Build the model:  f(x) <- x x ; a <- f(3) ; b <- f(2.5)
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            listElement(Ld::FunctionElement::elementName, Ld::ElementPointerList() << variableElement("x"), "f"),
+            operatorElement(Ld::MultiplicationOperatorElement::elementName, variableElement("x"), variableElement("x"))
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("a"),
+            listElement(Ld::FunctionElement::elementName, Ld::ElementPointerList() << literalElement("3"), "f")
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("b"),
+            listElement(Ld::FunctionElement::elementName, Ld::ElementPointerList() << literalElement("2.5"), "f")
+        ),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    QList<QString> variableNames;
+    variableNames << "a" << "b";
+
+    // The generic build uses a single definition of f.  The specialized build adds an INTEGER and a REAL
+    // specialization, each with a declaration, a definition, and a call site.
+
+    QList<QList<Model::Variant>> results;
+    for (unsigned modeIndex=0 ; modeIndex<2 ; ++modeIndex) {
+        bool specialized = (modeIndex != 0);
+        if (specialized) {
+            generator->setMaximumFunctionSpecializations(Ld::CppCodeGenerator::defaultMaximumFunctionSpecializations);
+        } else {
+            generator->setMaximumFunctionSpecializations(0);
+        }
+
+        QString libraryFile = modelLibraryFile(QString("specialization_%1").arg(modeIndex));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        for (unsigned specializationIndex=0 ; specializationIndex<2 ; ++specializationIndex) {
+            QString suffix = QString("_S%1(").arg(specializationIndex);
+            QRegularExpression definition(QString("ModelImpl::\\w+%1").arg(QRegularExpression::escape(suffix)));
+
+            if (specialized) {
+                QCOMPARE(ir.count(definition), 1);
+                QVERIFY(ir.count(suffix) >= 3);
+            } else {
+                QCOMPARE(ir.count(suffix), 0);
+            }
+        }
+
+        QVERIFY(!ir.contains(QString("_S2(")));
+
+        QList<Model::Variant> values;
+        QVERIFY(runModel(libraryFile, 1, QString(), variableNames, values));
+        results.append(values);
+    }
+
+    for (unsigned variableIndex=0 ; variableIndex<static_cast<unsigned>(variableNames.size()) ; ++variableIndex) {
+        QCOMPARE(results.at(1).at(variableIndex).valueType(), results.at(0).at(variableIndex).valueType());
+        QCOMPARE(results.at(1).at(variableIndex).toReal(), results.at(0).at(variableIndex).toReal());
+    }
+
+    QCOMPARE(results.at(1).at(0).toReal(), Model::Real(9));
+    QCOMPARE(results.at(1).at(1).toReal(), Model::Real(6.25));
+
+    generator->setMaximumFunctionSpecializations(Ld::CppCodeGenerator::defaultMaximumFunctionSpecializations);
+}
+
+
+void TestCppCodeGenerator::testPackedMatrixLiterals() {
+    static constexpr unsigned long packedRows    = 8;
+    static constexpr unsigned long packedColumns = Ld::CppMatrixOperatorTranslator::minimumPackedLiteralEntries / 8;
+    static constexpr unsigned long builtRows     = 7;
+    static constexpr unsigned long builtColumns  = packedColumns;
+
+    // Build the model:  P <- [ 8 x 8 literals ] ; Q <- [ 7 x 8 literals ]
+    //
+    // P has exactly minimumPackedLiteralEntries entries and is emitted as packed static data.  Q has fewer entries
+    // and is emitted through the matrix build method.  Entries are not exactly representable so the packed text must
+    // carry the same precision as the scalar literals.
+
+    QList<QString> entries;
+    for (unsigned long entryIndex=0 ; entryIndex<packedRows * packedColumns ; ++entryIndex) {
+        entries.append(QString("%1.1").arg(entryIndex));
+    }
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("P"),
+            matrixElement(packedRows, packedColumns, entries)
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("Q"),
+            matrixElement(builtRows, builtColumns, entries)
+        ),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    QString libraryFile = modelLibraryFile("packed_matrix");
+    QVERIFY(translateModel(rootElement, libraryFile));
+
+    QString ir = QString(generator->intermediateRepresentation());
+    QCOMPARE(ir.count(QString("static const M::Real d[]")), 1);
+    QVERIFY(ir.contains(QString("M::MatrixReal::build(%1,%2").arg(builtRows).arg(builtColumns)));
+    QVERIFY(ir.contains(QRegularExpression(QString("\\b0\\.10*L,"))));
+
+    QList<Model::Variant> values;
+    QVERIFY(runModel(libraryFile, 1, QString(), QList<QString>() << "P" << "Q", values));
+
+    QCOMPARE(values.at(0).valueType(), Model::ValueType::MATRIX_REAL);
+    QCOMPARE(values.at(1).valueType(), Model::ValueType::MATRIX_REAL);
+
+    Model::MatrixReal packed = values.at(0).toMatrixReal();
+    Model::MatrixReal built  = values.at(1).toMatrixReal();
+
+    QCOMPARE(static_cast<unsigned long>(packed.numberRows()), packedRows);
+    QCOMPARE(static_cast<unsigned long>(packed.numberColumns()), packedColumns);
+    QCOMPARE(static_cast<unsigned long>(built.numberRows()), builtRows);
+    QCOMPARE(static_cast<unsigned long>(built.numberColumns()), builtColumns);
+
+    // Both matrices are stored in column major order so the first entries line up.
+
+    const Model::Real* packedData = packed.data();
+    const Model::Real* builtData  = built.data();
+    for (unsigned long entryIndex=0 ; entryIndex<builtRows * builtColumns ; ++entryIndex) {
+        QCOMPARE(packedData[entryIndex], builtData[entryIndex]);
+    }
+}
+
+
+void TestCppCodeGenerator::benchmarkOptimizationProfiles() {
+    static constexpr unsigned numberRuns = 5;
+
+    // Build the model:  c in R ; c <- 0 ; for all i in 1 ... 1000000 : c <- c + i
+
+    Ld::ElementPointer realType = Ld::Element::create(Ld::RealTypeElement::elementName);
+    realType->setFormat(Ld::Format::create(Ld::CharacterFormat::formatName));
+
+    QSharedPointer<Ld::RootElement> rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << operatorElement(Ld::ElementOfSetOperatorElement::elementName, variableElement("c"), realType)
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("c"), literalElement("0")),
+        "i",
+        "1000000",
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("c"),
+            operatorElement(Ld::AdditionOperatorElement::elementName, variableElement("c"), variableElement("i"))
+        )
+    );
+
+    // Build and time the model under each profile.  Only the debuggable profile should checkpoint operations.
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    QList<Ld::CppCodeGenerator::OptimizationProfile> profiles;
+    profiles << Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE
+             << Ld::CppCodeGenerator::OptimizationProfile::RELEASE;
+
+    QList<QString> profileNames;
+    profileNames << "debuggable" << "release";
+
+    QList<Model::Variant> results;
+    for (unsigned profileIndex=0 ; profileIndex<static_cast<unsigned>(profiles.size()) ; ++profileIndex) {
+        bool release = (profiles.at(profileIndex) == Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+        generator->setOptimizationProfile(profiles.at(profileIndex));
+
+        QString libraryFile = modelLibraryFile(QString("benchmark_%1").arg(profileNames.at(profileIndex)));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("c(pt,")), !release);
+
+        QList<Model::Variant> values;
+        QVERIFY(
+            runModel(
+                libraryFile,
+                numberRuns,
+                QString("Profile %1").arg(profileNames.at(profileIndex)),
+                QList<QString>() << "c",
+                values
+            )
+        );
+
+        results.append(values.at(0));
+    }
+
+    QCOMPARE(results.at(1).valueType(), results.at(0).valueType());
+    QCOMPARE(results.at(1).toReal(), results.at(0).toReal());
+    QCOMPARE(results.at(1).toReal(), Model::Real(500000500000.0L));
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::benchmarkElementwiseFusion() {
+    static constexpr unsigned numberRuns = 5;
+
+    // Build the model:  A <- 3 OnesMatrix_R(1000) ; for all i in 1 ... 100 : B <- A + A o A - 2 A
+
+    QSharedPointer<Ld::RootElement> rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << operatorElement(
+                   Ld::AssignmentOperatorElement::elementName,
+                   variableElement("A"),
+                   operatorElement(
+                       Ld::MultiplicationOperatorElement::elementName,
+                       literalElement("3"),
+                       listElement(
+                           Ld::FunctionElement::elementName,
+                           Ld::ElementPointerList() << literalElement("1000"),
+                           "OnesMatrix",
+                           "R"
+                       )
+                   )
+               ),
+        "i",
+        "100",
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("B"),
+            operatorElement(
+                Ld::SubtractionOperatorElement::elementName,
+                operatorElement(
+                    Ld::AdditionOperatorElement::elementName,
+                    variableElement("A"),
+                    operatorElement(
+                        Ld::HadamardProductOperatorElement::elementName,
+                        variableElement("A"),
+                        variableElement("A")
+                    )
+                ),
+                operatorElement(
+                    Ld::MultiplicationOperatorElement::elementName,
+                    literalElement("2"),
+                    variableElement("A")
+                )
+            )
+        )
+    );
+
+    // Build and time the model with and without fusion.  Both builds must produce identical coefficients.
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+
+    QList<QString> modeNames;
+    modeNames << "unfused" << "fused";
+
+    QList<Model::MatrixReal> results;
+    for (unsigned modeIndex=0 ; modeIndex<static_cast<unsigned>(modeNames.size()) ; ++modeIndex) {
+        generator->setElementwiseFusionEnabled(modeIndex != 0);
+
+        QString libraryFile = modelLibraryFile(QString("benchmark_%1").arg(modeNames.at(modeIndex)));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("ewR.update(")), modeIndex != 0);
+
+        QList<Model::Variant> values;
+        QVERIFY(
+            runModel(
+                libraryFile,
+                numberRuns,
+                QString("Elementwise %1").arg(modeNames.at(modeIndex)),
+                QList<QString>() << "B",
+                values
+            )
+        );
+
+        QCOMPARE(values.at(0).valueType(), Model::ValueType::MATRIX_REAL);
+        results.append(values.at(0).toMatrixReal());
+    }
+
+    const Model::MatrixReal& unfused = results.at(0);
+    const Model::MatrixReal& fused   = results.at(1);
+
+    QCOMPARE(static_cast<unsigned long>(unfused.numberRows()), 1000UL);
+    QCOMPARE(static_cast<unsigned long>(unfused.numberColumns()), 1000UL);
+    QCOMPARE(static_cast<unsigned long>(fused.numberRows()), 1000UL);
+    QCOMPARE(static_cast<unsigned long>(fused.numberColumns()), 1000UL);
+
+    bool identical = true;
+    for (unsigned long column=1 ; identical && column<=1000 ; ++column) {
+        for (unsigned long row=1 ; identical && row<=1000 ; ++row) {
+            identical = (fused.at(row, column) == unfused.at(row, column) && unfused.at(row, column) == Model::Real(6));
+        }
+    }
+
+    QVERIFY(identical);
+
+    generator->setElementwiseFusionEnabled();
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::testElementwiseFusionFallback() {
+    // Build the model:  A <- OnesMatrix_R(3) ; C <- OnesMatrix_R(4) ; B <- A + A o C - 2 A
+    //
+    // The operand sizes can not be determined at translation time so the fused expression must test them at run
+    // time and fall back to the unfused operators, which report the mismatch.
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("A"),
+            listElement(
+                Ld::FunctionElement::elementName,
+                Ld::ElementPointerList() << literalElement("3"),
+                "OnesMatrix",
+                "R"
+            )
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("C"),
+            listElement(
+                Ld::FunctionElement::elementName,
+                Ld::ElementPointerList() << literalElement("4"),
+                "OnesMatrix",
+                "R"
+            )
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("B"),
+            operatorElement(
+                Ld::SubtractionOperatorElement::elementName,
+                operatorElement(
+                    Ld::AdditionOperatorElement::elementName,
+                    variableElement("A"),
+                    operatorElement(
+                        Ld::HadamardProductOperatorElement::elementName,
+                        variableElement("A"),
+                        variableElement("C")
+                    )
+                ),
+                operatorElement(
+                    Ld::MultiplicationOperatorElement::elementName,
+                    literalElement("2"),
+                    variableElement("A")
+                )
+            )
+        ),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+
+    QList<bool> abortedByMode;
+    for (unsigned modeIndex=0 ; modeIndex<2 ; ++modeIndex) {
+        generator->setElementwiseFusionEnabled(modeIndex != 0);
+
+        QString libraryFile = modelLibraryFile(QString("fusion_fallback_%1").arg(modeIndex));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("ewR.update(")), modeIndex != 0);
+        QCOMPARE(ir.contains(QString(".numberRows()!=ewA")), modeIndex != 0);
+
+        QList<Model::Variant> values;
+        bool                  aborted = false;
+        runModel(libraryFile, 1, QString(), QList<QString>(), values, &aborted);
+
+        abortedByMode.append(aborted);
+    }
+
+    QVERIFY(abortedByMode.at(0));
+    QCOMPARE(abortedByMode.at(1), abortedByMode.at(0));
+
+    generator->setElementwiseFusionEnabled();
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::testElementwiseFusionShapes() {
+    // Build the model:
+    //     A <- 3x5 literal ; B <- 5x3 literal ; V <- 7x1 literal
+    //     C <- A + A o B^T - 2 A ; W <- V + V o V - 2 V ; D <- B^T + B^T o A - A
+    //
+    // The operands are not square and some are transposed so the fused loop must not assume the coefficients of
+    // every operand share one dense layout.
+
+    QList<QString> aEntries;
+    QList<QString> bEntries;
+    for (unsigned entryIndex=0 ; entryIndex<15 ; ++entryIndex) {
+        aEntries << QString("%1.5").arg(entryIndex + 1);
+        bEntries << QString("%1.25").arg(2 * entryIndex + 1);
+    }
+
+    QList<QString> vEntries;
+    for (unsigned entryIndex=0 ; entryIndex<7 ; ++entryIndex) {
+        vEntries << QString("%1.75").arg(entryIndex);
+    }
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("A"),
+            matrixElement(3, 5, aEntries)
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("B"),
+            matrixElement(5, 3, bEntries)
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("V"),
+            matrixElement(7, 1, vEntries)
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("C"),
+            operatorElement(
+                Ld::SubtractionOperatorElement::elementName,
+                operatorElement(
+                    Ld::AdditionOperatorElement::elementName,
+                    variableElement("A"),
+                    operatorElement(
+                        Ld::HadamardProductOperatorElement::elementName,
+                        variableElement("A"),
+                        operatorElement(Ld::MatrixTransposeOperatorElement::elementName, variableElement("B"))
+                    )
+                ),
+                operatorElement(
+                    Ld::MultiplicationOperatorElement::elementName,
+                    literalElement("2"),
+                    variableElement("A")
+                )
+            )
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("W"),
+            operatorElement(
+                Ld::SubtractionOperatorElement::elementName,
+                operatorElement(
+                    Ld::AdditionOperatorElement::elementName,
+                    variableElement("V"),
+                    operatorElement(
+                        Ld::HadamardProductOperatorElement::elementName,
+                        variableElement("V"),
+                        variableElement("V")
+                    )
+                ),
+                operatorElement(
+                    Ld::MultiplicationOperatorElement::elementName,
+                    literalElement("2"),
+                    variableElement("V")
+                )
+            )
+        ),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("D"),
+            operatorElement(
+                Ld::SubtractionOperatorElement::elementName,
+                operatorElement(
+                    Ld::AdditionOperatorElement::elementName,
+                    operatorElement(Ld::MatrixTransposeOperatorElement::elementName, variableElement("B")),
+                    operatorElement(
+                        Ld::HadamardProductOperatorElement::elementName,
+                        operatorElement(Ld::MatrixTransposeOperatorElement::elementName, variableElement("B")),
+                        variableElement("A")
+                    )
+                ),
+                variableElement("A")
+            )
+        ),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+
+    QList<QString>               variableNames = { "A", "B", "V", "C", "W", "D" };
+    QList<QList<Model::Variant>> results;
+
+    for (unsigned modeIndex=0 ; modeIndex<2 ; ++modeIndex) {
+        generator->setElementwiseFusionEnabled(modeIndex != 0);
+
+        QString libraryFile = modelLibraryFile(QString("fusion_shapes_%1").arg(modeIndex));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.count(QString("ewR.update(")), modeIndex != 0 ? 3 : 0);
+
+        QList<Model::Variant> values;
+        QVERIFY(runModel(libraryFile, 1, QString(), variableNames, values));
+        results.append(values);
+    }
+
+    // Compare each result against the unfused build and against values computed here.
+
+    Model::MatrixReal a = results.at(0).at(0).toMatrixReal();
+    Model::MatrixReal b = results.at(0).at(1).toMatrixReal();
+    Model::MatrixReal v = results.at(0).at(2).toMatrixReal();
+
+    for (unsigned resultIndex=3 ; resultIndex<6 ; ++resultIndex) {
+        QCOMPARE(results.at(1).at(resultIndex).valueType(), Model::ValueType::MATRIX_REAL);
+
+        Model::MatrixReal unfused = results.at(0).at(resultIndex).toMatrixReal();
+        Model::MatrixReal fused   = results.at(1).at(resultIndex).toMatrixReal();
+
+        unsigned long numberRows    = resultIndex == 4 ? 7 : 3;
+        unsigned long numberColumns = resultIndex == 4 ? 1 : 5;
+
+        QCOMPARE(static_cast<unsigned long>(fused.numberRows()), numberRows);
+        QCOMPARE(static_cast<unsigned long>(fused.numberColumns()), numberColumns);
+        QCOMPARE(static_cast<unsigned long>(unfused.numberRows()), numberRows);
+        QCOMPARE(static_cast<unsigned long>(unfused.numberColumns()), numberColumns);
+
+        for (unsigned long column=1 ; column<=numberColumns ; ++column) {
+            for (unsigned long row=1 ; row<=numberRows ; ++row) {
+                Model::Real expected;
+                if (resultIndex == 3) {
+                    expected = a.at(row, column) + a.at(row, column) * b.at(column, row) - 2 * a.at(row, column);
+                } else if (resultIndex == 4) {
+                    expected = v.at(row, column) + v.at(row, column) * v.at(row, column) - 2 * v.at(row, column);
+                } else {
+                    expected = b.at(column, row) + b.at(column, row) * a.at(row, column) - a.at(row, column);
+                }
+
+                QCOMPARE(fused.at(row, column), unfused.at(row, column));
+                QCOMPARE(fused.at(row, column), expected);
+            }
+        }
+    }
+
+    generator->setElementwiseFusionEnabled();
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::benchmarkParallelLoops() {
+    static constexpr unsigned numberRuns = 5;
+
+    // Build the model:  c in R ; c <- 0 ; for all i in 1 ... 10000000 : c <- c + i
+
+    QSharedPointer<Ld::Element> realElement = Ld::Element::create(Ld::RealTypeElement::elementName);
+    realElement->setFormat(Ld::Format::create(Ld::CharacterFormat::formatName));
+
+    Ld::ElementPointer cTypeElementOfSet = operatorElement(
+        Ld::ElementOfSetOperatorElement::elementName,
+        variableElement("c"),
+        realElement
+    );
+    cTypeElementOfSet->setFormat(Ld::Format::create(Ld::CharacterFormat::formatName));
+
+    QSharedPointer<Ld::RootElement> rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << cTypeElementOfSet
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("c"), literalElement("0")),
+        "i",
+        "10000000",
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("c"),
+            operatorElement(Ld::AdditionOperatorElement::elementName, variableElement("c"), variableElement("i"))
+        )
+    );
+
+    // Build and time the model with sequential and parallel loops under the release profile.  Every addend and
+    // partial sum is an integer well inside the mantissa so both modes must agree exactly.
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+
+    QList<QString> modeNames;
+    modeNames << "sequential" << "parallel";
+
+    for (unsigned modeIndex=0 ; modeIndex<static_cast<unsigned>(modeNames.size()) ; ++modeIndex) {
+        generator->setParallelLoopsEnabled(modeIndex != 0);
+
+        QString libraryFile = modelLibraryFile(QString("benchmark_%1").arg(modeNames.at(modeIndex)));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("LdParallel::run(")), modeIndex != 0);
+
+        QList<Model::Variant> values;
+        QVERIFY(
+            runModel(
+                libraryFile,
+                numberRuns,
+                QString("Loops %1").arg(modeNames.at(modeIndex)),
+                QList<QString>() << "c" << "i",
+                values
+            )
+        );
+
+        QCOMPARE(values.at(0).valueType(), Model::ValueType::REAL);
+        QCOMPARE(values.at(0).toReal(), Model::Real(50000005000000.0L));
+
+        QCOMPARE(values.at(1).valueType(), Model::ValueType::INTEGER);
+        QCOMPARE(values.at(1).toInteger(), Model::Integer(10000001));
+    }
+
+    // Loops are never parallelized when operation checkpoints are needed.
+
+    generator->setParallelLoopsEnabled();
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+
+    QVERIFY(translateModel(rootElement, modelLibraryFile("benchmark_debuggable_loop")));
+    QVERIFY(!QString(generator->intermediateRepresentation()).contains(QString("LdParallel::run(")));
+}
+
+
+void TestCppCodeGenerator::testParallelLoopAnalysis() {
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+    generator->setParallelLoopsEnabled();
+
+    // Loops drawing random numbers must stay sequential so the random sequence does not depend on scheduling:
+    // s <- 0 ; for all i in 1 ... 1000 : s <- s + UniformInclusive(i)
+
+    QSharedPointer<Ld::RootElement> rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("s"), literalElement("0")),
+        "i",
+        "1000",
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("s"),
+            operatorElement(
+                Ld::AdditionOperatorElement::elementName,
+                variableElement("s"),
+                listElement(
+                    Ld::FunctionElement::elementName,
+                    Ld::ElementPointerList() << variableElement("i"),
+                    "UniformInclusive"
+                )
+            )
+        )
+    );
+
+    QVERIFY(translateModel(rootElement, modelLibraryFile("parallel_rng")));
+    QVERIFY(!QString(generator->intermediateRepresentation()).contains(QString("LdParallel::run(")));
+
+    // Loops performing file I/O must stay sequential:  for all i in 1 ... 1000 : t <- FileReadInteger(0)
+
+    rootElement = forAllModel(
+        Ld::ElementPointerList(),
+        "i",
+        "1000",
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("t"),
+            listElement(
+                Ld::FunctionElement::elementName,
+                Ld::ElementPointerList() << literalElement("0"),
+                "FileReadInteger"
+            )
+        )
+    );
+
+    QVERIFY(translateModel(rootElement, modelLibraryFile("parallel_file")));
+    QVERIFY(!QString(generator->intermediateRepresentation()).contains(QString("LdParallel::run(")));
+
+    // Loops reading a private variable before it is assigned carry a value between iterations and must stay
+    // sequential:  s <- 0 ; t <- 0 ; for all i in 1 ... 1000 : { s <- t ; t <- i }
+
+    rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("s"), literalElement("0"))
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("t"), literalElement("0")),
+        "i",
+        "1000",
+        listElement(
+            Ld::CompoundStatementOperatorElement::elementName,
+            Ld::ElementPointerList()
+                << operatorElement(
+                       Ld::AssignmentOperatorElement::elementName,
+                       variableElement("s"),
+                       variableElement("t")
+                   )
+                << operatorElement(
+                       Ld::AssignmentOperatorElement::elementName,
+                       variableElement("t"),
+                       variableElement("i")
+                   )
+        )
+    );
+
+    QVERIFY(translateModel(rootElement, modelLibraryFile("parallel_carried")));
+    QVERIFY(!QString(generator->intermediateRepresentation()).contains(QString("LdParallel::run(")));
+
+    // Private variables assigned before they are read are allowed and must produce the sequential results:
+    // s <- 0 ; t <- 0 ; for all i in 1 ... 1000 : { t <- i i ; s <- s + t }
+
+    rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("s"), literalElement("0"))
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("t"), literalElement("0")),
+        "i",
+        "1000",
+        listElement(
+            Ld::CompoundStatementOperatorElement::elementName,
+            Ld::ElementPointerList()
+                << operatorElement(
+                       Ld::AssignmentOperatorElement::elementName,
+                       variableElement("t"),
+                       operatorElement(
+                           Ld::MultiplicationOperatorElement::elementName,
+                           variableElement("i"),
+                           variableElement("i")
+                       )
+                   )
+                << operatorElement(
+                       Ld::AssignmentOperatorElement::elementName,
+                       variableElement("s"),
+                       operatorElement(
+                           Ld::AdditionOperatorElement::elementName,
+                           variableElement("s"),
+                           variableElement("t")
+                       )
+                   )
+        )
+    );
+
+    QList<QString> variableNames;
+    variableNames << "s" << "t" << "i";
+
+    QList<QList<Model::Variant>> results;
+    for (unsigned modeIndex=0 ; modeIndex<2 ; ++modeIndex) {
+        generator->setParallelLoopsEnabled(modeIndex != 0);
+
+        QString libraryFile = modelLibraryFile(QString("parallel_private_%1").arg(modeIndex));
+        QVERIFY(translateModel(rootElement, libraryFile));
+
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("LdParallel::run(")), modeIndex != 0);
+
+        QList<Model::Variant> values;
+        QVERIFY(runModel(libraryFile, 1, QString(), variableNames, values));
+        results.append(values);
+    }
+
+    for (unsigned variableIndex=0 ; variableIndex<static_cast<unsigned>(variableNames.size()) ; ++variableIndex) {
+        QCOMPARE(results.at(0).at(variableIndex).valueType(), Model::ValueType::INTEGER);
+        QCOMPARE(results.at(1).at(variableIndex).valueType(), Model::ValueType::INTEGER);
+        QCOMPARE(results.at(1).at(variableIndex).toInteger(), results.at(0).at(variableIndex).toInteger());
+    }
+
+    QCOMPARE(results.at(0).at(0).toInteger(), Model::Integer(333833500));
+    QCOMPARE(results.at(0).at(1).toInteger(), Model::Integer(1000000));
+    QCOMPARE(results.at(0).at(2).toInteger(), Model::Integer(1001));
+
+    generator->setParallelLoopsEnabled();
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::testParallelLoopFault() {
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+
+    // Subscripting past the end of v faults in every worker.  The model must abort rather than take down the test:
+    // v <- [1 ; 2 ; 3] ; s <- 0 ; for all i in 1 ... 1000 : s <- s + v[i]
+
+    QSharedPointer<Ld::RootElement> rootElement = forAllModel(
+        Ld::ElementPointerList()
+            << operatorElement(
+                   Ld::AssignmentOperatorElement::elementName,
+                   variableElement("v"),
+                   matrixElement(3, 1, QList<QString>() << "1" << "2" << "3")
+               )
+            << operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("s"), literalElement("0")),
+        "i",
+        "1000",
+        operatorElement(
+            Ld::AssignmentOperatorElement::elementName,
+            variableElement("s"),
+            operatorElement(
+                Ld::AdditionOperatorElement::elementName,
+                variableElement("s"),
+                operatorElement(
+                    Ld::SubscriptIndexOperatorElement::elementName,
+                    variableElement("v"),
+                    variableElement("i")
+                )
+            )
+        )
+    );
+
+    for (unsigned modeIndex=0 ; modeIndex<2 ; ++modeIndex) {
+        generator->setParallelLoopsEnabled(modeIndex != 0);
+
+        QString libraryFile = modelLibraryFile(QString("parallel_fault_%1").arg(modeIndex));
+        QVERIFY(translateModel(rootElement, libraryFile));
+        QString ir = QString(generator->intermediateRepresentation());
+        QCOMPARE(ir.contains(QString("LdParallel::run(")), modeIndex != 0);
+
+        bool                  aborted = false;
+        QList<Model::Variant> values;
+        runModel(libraryFile, 1, QString(), QList<QString>() << "s", values, &aborted);
+        QVERIFY(aborted);
+    }
+
+    generator->setParallelLoopsEnabled();
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::testThreadPartitionOrdering() {
+    // Build the model:  x <- FileExists("a") ; y <- FileExists("b") ; z <- 3
+    //
+    // The two file statements share no variables but must stay in program order, so they share a thread.
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    Ld::ElementPointer xAssignment = operatorElement(
+        Ld::AssignmentOperatorElement::elementName,
+        variableElement("x"),
+        listElement(Ld::FunctionElement::elementName, Ld::ElementPointerList() << literalElement("\"a\""), "FileExists")
+    );
+
+    Ld::ElementPointer yAssignment = operatorElement(
+        Ld::AssignmentOperatorElement::elementName,
+        variableElement("y"),
+        listElement(Ld::FunctionElement::elementName, Ld::ElementPointerList() << literalElement("\"b\""), "FileExists")
+    );
+
+    Ld::ElementPointer zAssignment = operatorElement(
+        Ld::AssignmentOperatorElement::elementName,
+        variableElement("z"),
+        literalElement("3")
+    );
+
+    rootElement->append(xAssignment, nullptr);
+    rootElement->append(yAssignment, nullptr);
+    rootElement->append(zAssignment, nullptr);
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    unsigned maximumNumberThreads = generator->maximumNumberThreads();
+    generator->setMaximumNumberThreads(3);
+
+    QVERIFY(translateModel(rootElement, modelLibraryFile("partition_ordering")));
+
+    QList<Ld::ElementWeakPointerList> partitions = generator->threadPartitions();
+    QCOMPARE(partitions.size(), 2);
+
+    int xThread = -1;
+    int yThread = -1;
+    for (int threadIndex=0 ; threadIndex<partitions.size() ; ++threadIndex) {
+        const Ld::ElementWeakPointerList& partition = partitions.at(threadIndex);
+        for (int elementIndex=0 ; elementIndex<partition.size() ; ++elementIndex) {
+            Ld::ElementPointer element = partition.at(elementIndex).toStrongRef();
+            if (element == xAssignment) {
+                xThread = threadIndex;
+            } else if (element == yAssignment) {
+                yThread = threadIndex;
+                QVERIFY(xThread == threadIndex);
+            }
+        }
+    }
+
+    QVERIFY(xThread >= 0);
+    QCOMPARE(yThread, xThread);
+
+    generator->setMaximumNumberThreads(maximumNumberThreads);
+}
+
+
+void TestCppCodeGenerator::testModelCacheBreakpoints() {
+    // Build the model:  a <- 3
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    Ld::ElementPointer aAssignment = operatorElement(
+        Ld::AssignmentOperatorElement::elementName,
+        variableElement("a"),
+        literalElement("3")
+    );
+    rootElement->append(aAssignment, nullptr);
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::RELEASE);
+    generator->setModelCacheEnabled();
+    generator->clearModelCache();
+
+    QString libraryFile = modelLibraryFile("cache_breakpoints");
+
+    // The release profile emits no checkpoints without a breakpoint.  A second translation is served from the cache.
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(!generator->lastModelWasCached());
+    QVERIFY(!QString(generator->intermediateRepresentation()).contains(QString("c(pt, ")));
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(generator->lastModelWasCached());
+
+    // Setting a breakpoint must force the model to be rebuilt with a checkpoint at the breakpoint.
+
+    unsigned long long revision = rootElement->revision();
+    QVERIFY(aAssignment->setInstructionBreakpoint(true));
+    QVERIFY(rootElement->revision() > revision);
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(!generator->lastModelWasCached());
+    QVERIFY(QString(generator->intermediateRepresentation()).contains(QString("c(pt, ")));
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(generator->lastModelWasCached());
+
+    // Clearing the breakpoint must also force a rebuild.
+
+    QVERIFY(aAssignment->clearInstructionBreakpoint());
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(!generator->lastModelWasCached());
+    QVERIFY(!QString(generator->intermediateRepresentation()).contains(QString("c(pt, ")));
+
+    generator->setOptimizationProfile(Ld::CppCodeGenerator::OptimizationProfile::DEBUGGABLE);
+}
+
+
+void TestCppCodeGenerator::testModelCachePrewarm() {
+    // Build the model:  a <- 3
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("a"), literalElement("3")),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setModelCacheEnabled();
+    generator->clearModelCache();
+
+    QString libraryFile = modelLibraryFile("cache_prewarm");
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(!generator->lastModelWasCached());
+
+    // Pre-warming the object cache must not evict models cached for other root elements.
+
+    QTemporaryDir documentDirectory;
+    QVERIFY(documentDirectory.isValid());
+    QCOMPARE(generator->prewarmObjectCache(documentDirectory.path(), Ld::PlugInsByName()), 0U);
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(generator->lastModelWasCached());
+}
+
+
+void TestCppCodeGenerator::testModelCacheDiagnostics() {
+    // Build the model:  t <- "abc" ; for i in t: s <- i
+    //
+    // Iterating over a tuple makes i a variant so the type inference report warns about it.
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("t"), literalElement("\"abc\"")),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(
+            Ld::ForAllInOperatorElement::elementName,
+            variableElement("i"),
+            variableElement("t"),
+            operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("s"), variableElement("i"))
+        ),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    CodeGeneratorVisual* visual = dynamic_cast<CodeGeneratorVisual*>(generator->visual());
+    QVERIFY(visual != nullptr);
+
+    generator->setTypeInferenceReportEnabled();
+    generator->setModelCacheEnabled();
+    generator->clearModelCache();
+
+    QString libraryFile = modelLibraryFile("cache_diagnostics");
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(!generator->lastModelWasCached());
+
+    int numberDiagnostics = generator->reportedDiagnostics().size();
+    QVERIFY(numberDiagnostics > 0);
+    QVERIFY(!visual->reportedDiagnostic().isNull());
+
+    // A model restored from the cache reports the warnings raised when it was built.
+
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(generator->lastModelWasCached());
+
+    QCOMPARE(generator->reportedDiagnostics().size(), numberDiagnostics);
+    QVERIFY(!visual->reportedDiagnostic().isNull());
+
+    generator->setTypeInferenceReportDisabled();
+}
+
+
+void TestCppCodeGenerator::testOperationProfile() {
+    // Build the model:  c <- 0 ; for all i in 1 ... 10 : c <- c + i
+
+    Ld::ElementPointer initialization = operatorElement(
+        Ld::AssignmentOperatorElement::elementName,
+        variableElement("c"),
+        literalElement("0")
+    );
+
+    Ld::ElementPointer update = operatorElement(
+        Ld::AssignmentOperatorElement::elementName,
+        variableElement("c"),
+        operatorElement(Ld::AdditionOperatorElement::elementName, variableElement("c"), variableElement("i"))
+    );
+
+    QSharedPointer<Ld::RootElement> rootElement = forAllModel(
+        Ld::ElementPointerList() << initialization,
+        "i",
+        "10",
+        update
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setProfilingEnabled();
+
+    QString libraryFile = modelLibraryFile("operation_profile");
+    QVERIFY(translateModel(rootElement, libraryFile));
+    QVERIFY(QString(generator->intermediateRepresentation()).contains(QString("LdProfile::record(")));
+
+    QList<Model::Variant> values;
+    QVERIFY(runModel(libraryFile, 1, QString(), QList<QString>() << "c", values, nullptr, rootElement));
+    QCOMPARE(values.at(0).toInteger(), Model::Integer(55));
+
+    // The hit counts reported by the model should reach the root element, indexed by each statement's operation.
+
+    QVERIFY(rootElement->hasOperationProfile());
+
+    Ld::OperationProfile initializationProfile = rootElement->operationProfile(initialization);
+    QVERIFY(initializationProfile.isValid());
+    QCOMPARE(initializationProfile.hitCount(), 1ULL);
+
+    Ld::OperationProfile updateProfile = rootElement->operationProfile(update);
+    QVERIFY(updateProfile.isValid());
+    QCOMPARE(updateProfile.hitCount(), 10ULL);
+    QVERIFY(updateProfile.inclusiveNanoseconds() >= updateProfile.exclusiveNanoseconds());
+
+    generator->setProfilingDisabled();
+}
+
+
+void TestCppCodeGenerator::testTypeInference() {
+    // Build the model:  x <- y ; y <- 2 ; u <- w
+    //
+    // x is read from y before y is assigned so only a second inference pass gives it a concrete type.  w is never
+    // assigned so it has no inferred type and u falls back to a variant.
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    Ld::ElementPointer x = variableElement("x");
+    Ld::ElementPointer u = variableElement("u");
+
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, x, variableElement("y")),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, variableElement("y"), literalElement("2")),
+        nullptr
+    );
+
+    rootElement->append(
+        operatorElement(Ld::AssignmentOperatorElement::elementName, u, variableElement("w")),
+        nullptr
+    );
+
+    QSharedPointer<Ld::CppCodeGenerator>
+        generator = Ld::CodeGenerator::codeGenerator(Ld::CppCodeGenerator::codeGeneratorName)
+                    .dynamicCast<Ld::CppCodeGenerator>();
+
+    generator->setTypeInferenceReportEnabled();
+
+    QVERIFY(translateModel(rootElement, modelLibraryFile("type_inference")));
+
+    Ld::DataType xDataType = x.dynamicCast<Ld::VariableElement>()->identifier().dataType();
+    QVERIFY(!xDataType.isInvalid());
+    QVERIFY(xDataType.valueType() == Ld::DataType::ValueType::INTEGER);
+
+    Ld::DataType uDataType = u.dynamicCast<Ld::VariableElement>()->identifier().dataType();
+    QVERIFY(uDataType.valueType() == Ld::DataType::ValueType::VARIANT);
+
+    QStringList notInferred;
+    QStringList inferredAsVariant;
+
+    const Ld::DiagnosticPointerList& diagnostics = generator->reportedDiagnostics();
+    for (  Ld::DiagnosticPointerList::const_iterator it  = diagnostics.constBegin(),
+                                                     end = diagnostics.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        QSharedPointer<Ld::CppCodeGeneratorDiagnostic>
+            diagnostic = it->dynamicCast<Ld::CppCodeGeneratorDiagnostic>();
+
+        QVERIFY(!diagnostic.isNull());
+        if (diagnostic->diagnosticCode() == Ld::CppCodeGeneratorDiagnostic::Code::VARIABLE_TYPE_NOT_INFERRED) {
+            notInferred << diagnostic->backendMessage();
+        } else if (diagnostic->diagnosticCode() ==
+                   Ld::CppCodeGeneratorDiagnostic::Code::VARIABLE_INFERRED_AS_VARIANT) {
+            inferredAsVariant << diagnostic->backendMessage();
+        }
+    }
+
+    QCOMPARE(notInferred, QStringList() << "w");
+    QCOMPARE(inferredAsVariant, QStringList() << "u");
+
+    generator->setTypeInferenceReportDisabled();
+}
+
+
 void TestCppCodeGenerator::cleanupTestCase() {
     QSharedPointer<Ld::CodeGenerator> generator = Ld::CodeGenerator::codeGenerator("CppCodeGenerator");
     delete generator->visual();
@@ -48,6 +48,38 @@ class TestCppCodeGenerator:public QObject {
 
         void testDiagnosticHandling();
 
+        void testExpressionOptimization();
+
+        void testFunctionSpecialization();
+
+        void testPackedMatrixLiterals();
+
+        void benchmarkOptimizationProfiles();
+
+        void benchmarkElementwiseFusion();
+
+        void testElementwiseFusionFallback();
+
+        void testElementwiseFusionShapes();
+
+        void benchmarkParallelLoops();
+
+        void testParallelLoopAnalysis();
+
+        void testParallelLoopFault();
+
+        void testThreadPartitionOrdering();
+
+        void testModelCacheBreakpoints();
+
+        void testModelCachePrewarm();
+
+        void testModelCacheDiagnostics();
+
+        void testOperationProfile();
+
+        void testTypeInference();
+
         void cleanupTestCase();
 };
 
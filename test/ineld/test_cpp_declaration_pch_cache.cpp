@@ -0,0 +1,180 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref Ld::CppDeclarationPchCache class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QCryptographicHash>
+#include <QtTest/QtTest>
+
+#include <ld_cpp_declaration_payload.h>
+#include <ld_cpp_declaration_pch_cache.h>
+
+#include "test_cpp_declaration_pch_cache.h"
+
+static const char          declarations[]          = "namespace Test { int function(int x); }\n";
+static const char          otherDeclarations[]     = "namespace Test { double function(double x); }\n";
+static const unsigned long declarationsLength      = sizeof(declarations) - 1;
+static const unsigned long otherDeclarationsLength = sizeof(otherDeclarations) - 1;
+
+TestCppDeclarationPchCache::TestCppDeclarationPchCache() {}
+
+
+TestCppDeclarationPchCache::~TestCppDeclarationPchCache() {}
+
+
+void TestCppDeclarationPchCache::testPayloadRetained() {
+    QByteArray compressed = qCompress(QByteArray(declarations));
+
+    Ld::CppDeclarationPayload payload(
+        QString("test_library"),
+        reinterpret_cast<const unsigned char*>(compressed.constData()),
+        static_cast<unsigned long>(compressed.size()),
+        true
+    );
+
+    QByteArray first  = payload.payload();
+    QByteArray second = Ld::CppDeclarationPayload(payload).payload();
+
+    QCOMPARE(first, QByteArray(declarations));
+    QVERIFY(first.isSharedWith(second));
+
+    QCOMPARE(payload.hash(), QCryptographicHash::hash(QByteArray(declarations), QCryptographicHash::Sha256));
+    QVERIFY(Ld::CppDeclarationPayload().hash().isEmpty());
+}
+
+
+void TestCppDeclarationPchCache::testDisabledCache() {
+    Ld::CppDeclarationPayload payload(
+        QString("test_library"),
+        reinterpret_cast<const unsigned char*>(declarations),
+        declarationsLength
+    );
+
+    Ld::CppDeclarationPchCache cache;
+    QVERIFY(!cache.enabled());
+    QVERIFY(cache.pchFile(payload, QStringList()).isEmpty());
+    QVERIFY(cache.build(payload, QStringList()).isEmpty());
+    QCOMPARE(cache.numberBuilds(), 0UL);
+}
+
+
+void TestCppDeclarationPchCache::testKey() {
+    Ld::CppDeclarationPayload payload(
+        QString("test_library"),
+        reinterpret_cast<const unsigned char*>(declarations),
+        declarationsLength
+    );
+
+    Ld::CppDeclarationPayload otherPayload(
+        QString("test_library"),
+        reinterpret_cast<const unsigned char*>(otherDeclarations),
+        otherDeclarationsLength
+    );
+
+    Ld::CppDeclarationPchCache cache;
+    QStringList                arguments = QStringList() << QString("-std=c++14");
+
+    QByteArray key = cache.key(payload, arguments);
+    QVERIFY(!key.isEmpty());
+    QCOMPARE(cache.key(payload, arguments), key);
+    QVERIFY(cache.key(otherPayload, arguments) != key);
+    QVERIFY(cache.key(payload, QStringList() << QString("-std=c++17")) != key);
+    QVERIFY(cache.key(Ld::CppDeclarationPayload(), arguments).isEmpty());
+
+    cache.setEmbeddedCompilerFiles(QStringList() << QCoreApplication::applicationFilePath());
+    QVERIFY(cache.key(payload, arguments) != key);
+}
+
+
+void TestCppDeclarationPchCache::testBuild() {
+    #if (defined(Q_OS_LINUX) || defined(Q_OS_DARWIN))
+
+        QTemporaryDir workingDirectory;
+        QVERIFY(workingDirectory.isValid());
+
+        // A stand-in compiler that copies the header to the requested output file.
+
+        QString compilerFilename = QDir(workingDirectory.path()).filePath("compiler.sh");
+        QFile   compilerFile(compilerFilename);
+        QVERIFY(compilerFile.open(QFile::WriteOnly | QFile::Truncate));
+        compilerFile.write(
+            "#!/bin/sh\n"
+            "while [ $# -gt 2 ]; do input=\"$1\"; shift; done\n"
+            "cp \"$input\" \"$2\"\n"
+        );
+        compilerFile.close();
+        compilerFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner);
+
+        Ld::CppDeclarationPayload payload(
+            QString("test library"),
+            reinterpret_cast<const unsigned char*>(declarations),
+            declarationsLength
+        );
+
+        Ld::CppDeclarationPchCache cache;
+        QVERIFY(cache.setDirectory(QDir(workingDirectory.path()).filePath("pch")));
+        cache.setCompilerExecutable(compilerFilename);
+
+        QStringList arguments;
+        QVERIFY(cache.pchFile(payload, arguments).isEmpty());
+
+        QString pchFile = cache.build(payload, arguments);
+        QVERIFY(!pchFile.isEmpty());
+        QVERIFY(pchFile.endsWith(Ld::CppDeclarationPchCache::pchExtension));
+        QVERIFY(QFileInfo(pchFile).fileName().startsWith("test_library-"));
+        QCOMPARE(readFile(pchFile), QByteArray(declarations));
+        QCOMPARE(cache.numberBuilds(), 1UL);
+
+        QCOMPARE(cache.pchFile(payload, arguments), pchFile);
+        QCOMPARE(cache.build(payload, arguments), pchFile);
+        QCOMPARE(cache.numberBuilds(), 1UL);
+
+        QString otherPchFile = cache.build(payload, QStringList() << QString("-DTEST"));
+        QVERIFY(!otherPchFile.isEmpty());
+        QVERIFY(otherPchFile != pchFile);
+        QCOMPARE(cache.numberBuilds(), 2UL);
+
+    #else
+
+        QSKIP("Requires a POSIX shell.");
+
+    #endif
+}
+
+
+QByteArray TestCppDeclarationPchCache::readFile(const QString& filename) {
+    QFile file(filename);
+    file.open(QFile::ReadOnly);
+    return file.readAll();
+}
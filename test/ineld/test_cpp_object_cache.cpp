@@ -0,0 +1,180 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref Ld::CppObjectCache class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include <ld_cpp_object_cache.h>
+
+#include "test_cpp_object_cache.h"
+
+TestCppObjectCache::TestCppObjectCache() {}
+
+
+TestCppObjectCache::~TestCppObjectCache() {}
+
+
+void TestCppObjectCache::testDisabledCache() {
+    QTemporaryDir workingDirectory;
+    QVERIFY(workingDirectory.isValid());
+
+    QString sourceFile      = QDir(workingDirectory.path()).filePath("source.o");
+    QString destinationFile = QDir(workingDirectory.path()).filePath("destination.o");
+    writeFile(sourceFile, QByteArray("object"));
+
+    Ld::CppObjectCache cache;
+    QVERIFY(!cache.enabled());
+    QVERIFY(!cache.insert(QByteArray("key"), sourceFile));
+    QVERIFY(!cache.retrieve(QByteArray("key"), destinationFile));
+
+    QCOMPARE(cache.numberEntries(), 0UL);
+    QCOMPARE(cache.numberHits(), 0ULL);
+    QCOMPARE(cache.numberMisses(), 0ULL);
+}
+
+
+void TestCppObjectCache::testInsertRetrieve() {
+    QTemporaryDir workingDirectory;
+    QVERIFY(workingDirectory.isValid());
+
+    QString cacheDirectory  = QDir(workingDirectory.path()).filePath("cache");
+    QString sourceFile      = QDir(workingDirectory.path()).filePath("source.o");
+    QString destinationFile = QDir(workingDirectory.path()).filePath("destination.o");
+    writeFile(sourceFile, QByteArray("object contents"));
+
+    Ld::CppObjectCache cache;
+    QVERIFY(cache.setDirectory(cacheDirectory));
+    QVERIFY(cache.enabled());
+
+    QVERIFY(!cache.retrieve(QByteArray("key1"), destinationFile));
+    QCOMPARE(cache.numberMisses(), 1ULL);
+
+    QVERIFY(cache.insert(QByteArray("key1"), sourceFile));
+    QVERIFY(cache.contains(QByteArray("key1")));
+    QCOMPARE(cache.numberEntries(), 1UL);
+    QCOMPARE(cache.size(), 15ULL);
+
+    QVERIFY(cache.retrieve(QByteArray("key1"), destinationFile));
+    QCOMPARE(readFile(destinationFile), QByteArray("object contents"));
+    QCOMPARE(cache.numberHits(), 1ULL);
+    QCOMPARE(cache.numberMisses(), 1ULL);
+
+    cache.resetStatistics();
+    QCOMPARE(cache.numberHits(), 0ULL);
+    QCOMPARE(cache.numberMisses(), 0ULL);
+
+    cache.clear();
+    QCOMPARE(cache.numberEntries(), 0UL);
+    QCOMPARE(cache.size(), 0ULL);
+    QVERIFY(!cache.retrieve(QByteArray("key1"), destinationFile));
+}
+
+
+void TestCppObjectCache::testLruEviction() {
+    QTemporaryDir workingDirectory;
+    QVERIFY(workingDirectory.isValid());
+
+    QString sourceFile      = QDir(workingDirectory.path()).filePath("source.o");
+    QString destinationFile = QDir(workingDirectory.path()).filePath("destination.o");
+    writeFile(sourceFile, QByteArray(100, 'x'));
+
+    Ld::CppObjectCache cache;
+    QVERIFY(cache.setDirectory(QDir(workingDirectory.path()).filePath("cache")));
+    cache.setMaximumSize(300);
+
+    QVERIFY(cache.insert(QByteArray("key1"), sourceFile));
+    QVERIFY(cache.insert(QByteArray("key2"), sourceFile));
+    QVERIFY(cache.insert(QByteArray("key3"), sourceFile));
+    QCOMPARE(cache.numberEntries(), 3UL);
+
+    // Using key1 makes key2 the least recently used entry.
+
+    QVERIFY(cache.retrieve(QByteArray("key1"), destinationFile));
+
+    QVERIFY(cache.insert(QByteArray("key4"), sourceFile));
+    QCOMPARE(cache.numberEntries(), 3UL);
+    QCOMPARE(cache.size(), 300ULL);
+
+    QVERIFY(cache.contains(QByteArray("key1")));
+    QVERIFY(!cache.contains(QByteArray("key2")));
+    QVERIFY(cache.contains(QByteArray("key3")));
+    QVERIFY(cache.contains(QByteArray("key4")));
+
+    cache.setMaximumSize(100);
+    QCOMPARE(cache.numberEntries(), 1UL);
+    QVERIFY(cache.contains(QByteArray("key4")));
+
+    writeFile(sourceFile, QByteArray(101, 'x'));
+    QVERIFY(!cache.insert(QByteArray("key5"), sourceFile));
+    QVERIFY(cache.contains(QByteArray("key4")));
+}
+
+
+void TestCppObjectCache::testReloadDirectory() {
+    QTemporaryDir workingDirectory;
+    QVERIFY(workingDirectory.isValid());
+
+    QString cacheDirectory  = QDir(workingDirectory.path()).filePath("cache");
+    QString sourceFile      = QDir(workingDirectory.path()).filePath("source.o");
+    QString destinationFile = QDir(workingDirectory.path()).filePath("destination.o");
+    writeFile(sourceFile, QByteArray("library contents"));
+
+    {
+        Ld::CppObjectCache cache;
+        QVERIFY(cache.setDirectory(cacheDirectory));
+        QVERIFY(cache.insert(QByteArray("key1"), sourceFile));
+    }
+
+    Ld::CppObjectCache cache;
+    QVERIFY(cache.setDirectory(cacheDirectory));
+    QCOMPARE(cache.numberEntries(), 1UL);
+    QCOMPARE(cache.size(), 16ULL);
+
+    QVERIFY(cache.retrieve(QByteArray("key1"), destinationFile));
+    QCOMPARE(readFile(destinationFile), QByteArray("library contents"));
+}
+
+
+void TestCppObjectCache::writeFile(const QString& filename, const QByteArray& contents) {
+    QFile file(filename);
+    file.open(QFile::WriteOnly | QFile::Truncate);
+    file.write(contents);
+    file.close();
+}
+
+
+QByteArray TestCppObjectCache::readFile(const QString& filename) {
+    QFile file(filename);
+    file.open(QFile::ReadOnly);
+    return file.readAll();
+}
@@ -30,6 +30,7 @@
 #include <QDebug>
 #include <QString>
 #include <QSharedPointer>
+#include <QList>
 #include <QtTest/QtTest>
 
 #include <ld_translation_phase.h>
@@ -232,6 +233,91 @@ void TestCppTranslationPhase::testPhases() {
 }
 
 
+void TestCppTranslationPhase::testThreadPhases() {
+    Ld::CppTranslationPhase translationPhase(true, 3);
+    QCOMPARE(translationPhase.numberThreads(), 3U);
+    QCOMPARE(translationPhase.threadId(), 0U);
+
+    QList<unsigned> phaseNumbers;
+    QList<unsigned> threadIds;
+    bool            done;
+    do {
+        phaseNumbers << translationPhase.phaseNumber();
+        threadIds << translationPhase.threadId();
+
+        done = translationPhase.lastPhase();
+        translationPhase.nextPhase();
+    } while (!done);
+
+    QCOMPARE(phaseNumbers.size(), 18 + 2 * 6);
+
+    unsigned threadDefinition = static_cast<unsigned>(Ld::CppTranslationPhase::Phase::THREAD_DEFINITION);
+    unsigned threadEnd        = static_cast<unsigned>(Ld::CppTranslationPhase::Phase::THREAD_END);
+    QCOMPARE(phaseNumbers.count(threadDefinition), 3);
+    QCOMPARE(phaseNumbers.count(threadEnd), 3);
+
+    unsigned index = 0;
+    for (unsigned threadId=0 ; threadId<3 ; ++threadId) {
+        for (unsigned phaseNumber=threadDefinition ; phaseNumber<=threadEnd ; ++phaseNumber) {
+            unsigned position = threadDefinition + index;
+            QCOMPARE(phaseNumbers.at(position), phaseNumber);
+            QCOMPARE(threadIds.at(position), threadId);
+            ++index;
+        }
+    }
+
+    QCOMPARE(phaseNumbers.last(), static_cast<unsigned>(Ld::CppTranslationPhase::Phase::LINK));
+
+    translationPhase.reset();
+    QCOMPARE(translationPhase.phaseNumber(), 0U);
+    QCOMPARE(translationPhase.threadId(), 0U);
+
+    translationPhase.setNumberThreads(0);
+    QCOMPARE(translationPhase.numberThreads(), 1U);
+}
+
+
+void TestCppTranslationPhase::testRepeatPhase() {
+    Ld::CppTranslationPhase translationPhase(true, 1);
+    unsigned inferredTypes = static_cast<unsigned>(Ld::CppTranslationPhase::Phase::IDENTIFY_INFERRED_TYPES);
+
+    translationPhase.nextPhase();
+    QCOMPARE(translationPhase.phaseNumber(), inferredTypes);
+    QCOMPARE(translationPhase.phaseWillRepeat(), false);
+
+    translationPhase.repeatPhase();
+    QCOMPARE(translationPhase.phaseWillRepeat(), true);
+
+    translationPhase.nextPhase();
+    QCOMPARE(translationPhase.phaseNumber(), inferredTypes);
+    QCOMPARE(translationPhase.phaseWillRepeat(), false);
+
+    translationPhase.nextPhase();
+    QCOMPARE(translationPhase.phaseNumber(), inferredTypes + 1);
+
+    unsigned numberPhases  = 0;
+    unsigned numberRepeats = 0;
+    bool     done;
+    translationPhase.reset();
+    do {
+        if (translationPhase.phaseNumber() == inferredTypes && numberRepeats < 2) {
+            translationPhase.repeatPhase();
+            ++numberRepeats;
+        }
+
+        done = translationPhase.lastPhase();
+        translationPhase.nextPhase();
+        ++numberPhases;
+    } while (!done);
+
+    QCOMPARE(numberPhases, 18U + 2U);
+
+    translationPhase.repeatPhase();
+    translationPhase.reset();
+    QCOMPARE(translationPhase.phaseWillRepeat(), false);
+}
+
+
 void TestCppTranslationPhase::testAssignmentOperator() {
     Ld::CppTranslationPhase translationPhase1;
     translationPhase1.nextPhase();
@@ -45,6 +45,10 @@ class TestCppTranslationPhase:public QObject {
 
         void testPhases();
 
+        void testThreadPhases();
+
+        void testRepeatPhase();
+
         void testAssignmentOperator();
 
         void testComparisonOperators();
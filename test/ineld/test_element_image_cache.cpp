@@ -0,0 +1,244 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests for the \ref Ld::ElementImage and \ref Ld::ElementImageCache classes.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QByteArray>
+#include <QBuffer>
+#include <QImage>
+#include <QSize>
+#include <QSharedPointer>
+#include <QtTest/QtTest>
+
+#include <ld_handle.h>
+#include <ld_format_structures.h>
+#include <ld_format.h>
+#include <ld_image_format.h>
+#include <ld_image_element.h>
+#include <ld_element_image.h>
+#include <ld_element_image_cache.h>
+#include <ld_root_element.h>
+#include <ld_paragraph_element.h>
+#include <ld_text_element.h>
+
+#include "test_element_image_cache.h"
+
+/***********************************************************************************************************************
+ * CountingRootElement:
+ */
+
+/**
+ * Root element that renders every element to a fixed image and counts the number of renders.
+ */
+class CountingRootElement:public Ld::RootElement {
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] image The image returned for every element.
+         */
+        CountingRootElement(const QByteArray& image) {
+            currentImage           = image;
+            currentNumberOfRenders = 0;
+        }
+
+        ~CountingRootElement() override {}
+
+        QByteArray exportElementImage(Ld::ElementPointer, float) const override {
+            ++currentNumberOfRenders;
+            return currentImage;
+        }
+
+        /**
+         * Method that reports the number of images rendered.
+         *
+         * \return Returns the number of calls to exportElementImage.
+         */
+        unsigned long numberOfRenders() const {
+            return currentNumberOfRenders;
+        }
+
+    private:
+        QByteArray currentImage;
+
+        mutable unsigned long currentNumberOfRenders;
+};
+
+/***********************************************************************************************************************
+ * TestElementImageCache:
+ */
+
+TestElementImageCache::TestElementImageCache() {}
+
+
+TestElementImageCache::~TestElementImageCache() {}
+
+
+void TestElementImageCache::initTestCase() {
+    Ld::Handle::initialize(0x1234567890ABCDEFULL);
+}
+
+
+void TestElementImageCache::testElementImageMetadata() {
+    Ld::ElementImage emptyImage;
+    QVERIFY(emptyImage.isInvalid());
+
+    Ld::ElementImage badImage(QByteArray("not an image"));
+    QVERIFY(badImage.isInvalid());
+
+    QByteArray       data = pngImage(7, 5);
+    Ld::ElementImage image(data);
+
+    QVERIFY(image.isValid());
+    QCOMPARE(image.data(), data);
+    QCOMPARE(image.format(), QByteArray("png"));
+    QCOMPARE(image.size(), QSize(7, 5));
+
+    Ld::ElementImage copy = image;
+    QCOMPARE(copy.format(), QByteArray("png"));
+    QCOMPARE(copy.size(), QSize(7, 5));
+}
+
+
+void TestElementImageCache::testHitsAndMisses() {
+    QSharedPointer<Ld::ImageElement> element(new Ld::ImageElement());
+    element->setWeakThis(element.toWeakRef());
+
+    Ld::ElementImageCache cache;
+    Ld::ElementImage      image(pngImage(3, 2));
+
+    QVERIFY(cache.image(element, 96.0F).isInvalid());
+    QCOMPARE(cache.numberMisses(), 1ULL);
+
+    cache.insert(element, 96.0F, image);
+    QCOMPARE(cache.numberEntries(), 1UL);
+
+    Ld::ElementImage cached = cache.image(element, 96.0F);
+    QVERIFY(cached.isValid());
+    QCOMPARE(cached.size(), QSize(3, 2));
+    QCOMPARE(cache.numberHits(), 1ULL);
+
+    QVERIFY(cache.image(element, 300.0F).isInvalid());
+    QCOMPARE(cache.numberMisses(), 2ULL);
+
+    cache.insert(element, 300.0F, Ld::ElementImage(pngImage(9, 6)));
+    QCOMPARE(cache.numberEntries(), 2UL);
+    QCOMPARE(cache.image(element, 300.0F).size(), QSize(9, 6));
+    QCOMPARE(cache.image(element, 96.0F).size(), QSize(3, 2));
+
+    cache.insert(element, 96.0F, Ld::ElementImage(pngImage(4, 4)));
+    QCOMPARE(cache.numberEntries(), 2UL);
+    QCOMPARE(cache.image(element, 96.0F).size(), QSize(4, 4));
+
+    cache.remove(element->handle());
+    QCOMPARE(cache.numberEntries(), 0UL);
+    QVERIFY(cache.image(element, 96.0F).isInvalid());
+}
+
+
+void TestElementImageCache::testInvalidation() {
+    QSharedPointer<Ld::ImageElement> element(new Ld::ImageElement());
+    element->setWeakThis(element.toWeakRef());
+
+    Ld::ElementImageCache cache;
+    cache.insert(element, 96.0F, Ld::ElementImage(pngImage(3, 2)));
+    QVERIFY(cache.image(element, 96.0F).isValid());
+
+    QSharedPointer<Ld::ImageFormat> format = Ld::Format::create(Ld::ImageFormat::formatName)
+                                             .dynamicCast<Ld::ImageFormat>();
+    element->setFormat(format);
+    QVERIFY(cache.image(element, 96.0F).isInvalid());
+
+    cache.insert(element, 96.0F, Ld::ElementImage(pngImage(3, 2)));
+    QVERIFY(cache.image(element, 96.0F).isValid());
+
+    format->setRotation(Ld::Format::Rotation::ROTATE_CCW_90);
+    QVERIFY(cache.image(element, 96.0F).isInvalid());
+
+    cache.insert(element, 96.0F, Ld::ElementImage(pngImage(3, 2)));
+    QVERIFY(cache.image(element, 96.0F).isValid());
+
+    unsigned long long generation = element->calculatedValueGeneration();
+    element->clearCalculatedValue();
+    QVERIFY(element->calculatedValueGeneration() != generation);
+    QVERIFY(cache.image(element, 96.0F).isInvalid());
+
+    cache.clear();
+    QCOMPARE(cache.numberEntries(), 0UL);
+}
+
+
+void TestElementImageCache::testTreeInvalidation() {
+    QSharedPointer<CountingRootElement> rootElement(new CountingRootElement(pngImage(3, 2)));
+    rootElement->setWeakThis(rootElement.toWeakRef());
+    QVERIFY(rootElement->openNew());
+
+    QSharedPointer<Ld::ParagraphElement> paragraphElement(new Ld::ParagraphElement);
+    paragraphElement->setWeakThis(paragraphElement.toWeakRef());
+    rootElement->append(paragraphElement, nullptr);
+
+    QSharedPointer<Ld::TextElement> firstText(new Ld::TextElement);
+    firstText->setWeakThis(firstText.toWeakRef());
+    firstText->setText(QString("first"));
+    paragraphElement->append(firstText, nullptr);
+
+    QVERIFY(rootElement->elementImage(paragraphElement, 96.0F).isValid());
+    QVERIFY(rootElement->elementImage(paragraphElement, 96.0F).isValid());
+    QCOMPARE(rootElement->numberOfRenders(), 1UL);
+
+    // Adding a child must discard the cached images of its ancestors.
+
+    QSharedPointer<Ld::TextElement> secondText(new Ld::TextElement);
+    secondText->setWeakThis(secondText.toWeakRef());
+    secondText->setText(QString("second"));
+    paragraphElement->append(secondText, nullptr);
+
+    QVERIFY(rootElement->elementImage(paragraphElement, 96.0F).isValid());
+    QCOMPARE(rootElement->numberOfRenders(), 2UL);
+
+    // So must removing one.
+
+    QVERIFY(paragraphElement->removeChild(secondText, nullptr));
+
+    QVERIFY(rootElement->elementImage(paragraphElement, 96.0F).isValid());
+    QCOMPARE(rootElement->numberOfRenders(), 3UL);
+
+    QVERIFY(rootElement->close());
+}
+
+
+QByteArray TestElementImageCache::pngImage(int width, int height) {
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    QByteArray result;
+    QBuffer    buffer(&result);
+    buffer.open(QBuffer::WriteOnly);
+    image.save(&buffer, "PNG");
+
+    return result;
+}
@@ -29,6 +29,7 @@
 #include <QDebug>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QSet>
 #include <QList>
 #include <QByteArray>
@@ -43,6 +44,7 @@
 #include <ld_xml_attributes.h>
 #include <ld_element.h>
 #include <ld_element_cursor.h>
+#include <ld_element_iterator.h>
 #include <ld_cursor.h>
 #include <ld_cursor_state_collection.h>
 #include <ld_visual_with_positional_children.h>
@@ -796,6 +798,80 @@ void TestElementWithPositionalChildren::testDescendantTracking() {
 }
 
 
+void TestElementWithPositionalChildren::testDescendantIterators() {
+    QSharedPointer<PositionalElement> parent = PositionalElement::create(QString("p"));
+
+    // Build the first subtree before grafting it so the cached counts are exercised for detached subtrees.
+
+    QSharedPointer<PositionalElement> child0  = PositionalElement::create(QString("c0"));
+    QSharedPointer<PositionalElement> child00 = PositionalElement::create(QString("c00"));
+    QSharedPointer<PositionalElement> child01 = PositionalElement::create(QString("c01"));
+    child0->append(child00, nullptr);
+    child0->append(child01, nullptr);
+    parent->append(child0, nullptr);
+
+    QSharedPointer<PositionalElement> child1 = PositionalElement::create(QString("c1"));
+    parent->append(child1, nullptr);
+    child1->append(PositionalElement::create(QString("c10")), nullptr);
+    child1->append(PositionalElement::create(QString("c11")), nullptr);
+
+    QSharedPointer<PositionalElement> child2 = PositionalElement::create(QString("c2"));
+    parent->append(child2, nullptr);
+    child2->append(PositionalElement::create(QString("c20")), nullptr);
+    child2->append(PositionalElement::create(QString("c21")), nullptr);
+
+    // PositionalElement hides the base class methods so we access the tree through base class pointers.
+
+    Ld::ElementPointer root = parent;
+    Ld::ElementPointer leaf = child00;
+    QCOMPARE(root->numberDescendants(), 9UL);
+    QCOMPARE(leaf->numberDescendants(), 0UL);
+    QVERIFY(leaf->descendantsBegin() == leaf->descendantsEnd());
+
+    QStringList preOrder;
+    for (  Ld::ElementIterator it = root->descendantsBegin(), end = root->descendantsEnd()
+         ; it != end
+         ; ++it
+        ) {
+        preOrder << (*it).dynamicCast<PositionalElement>()->identifier();
+    }
+
+    QCOMPARE(preOrder.join(" "), QString("c0 c00 c01 c1 c10 c11 c2 c20 c21"));
+
+    QStringList postOrder;
+    for (  Ld::ElementIterator it  = Ld::ElementIterator(root, Ld::ElementIterator::Order::POST_ORDER, true),
+                               end = Ld::ElementIterator()
+         ; it != end
+         ; ++it
+        ) {
+        postOrder << (*it).dynamicCast<PositionalElement>()->identifier();
+    }
+
+    QCOMPARE(postOrder.join(" "), QString("c00 c01 c0 c10 c11 c1 c20 c21 c2 p"));
+
+    unsigned long numberVisited = 0;
+    bool completed = root->visitDescendants(
+        [&numberVisited](Ld::ElementPointer) {
+            ++numberVisited;
+            return numberVisited < 4;
+        }
+    );
+
+    QCOMPARE(completed, false);
+    QCOMPARE(numberVisited, 4UL);
+
+    bool success = parent->removeChild(child1, nullptr);
+    QVERIFY2(success, "removeChild failed unexpectedly.");
+
+    Ld::ElementPointer removed = child1;
+    QCOMPARE(root->numberDescendants(), 6UL);
+    QCOMPARE(removed->numberDescendants(), 2UL);
+
+    parent->removeChildren(nullptr);
+    QCOMPARE(root->numberDescendants(), 0UL);
+}
+
+
 void TestElementWithPositionalChildren::testVisualTracking() {
     PositionalVisual::clearNumberAllocatedInstances();
 
@@ -931,6 +1007,34 @@ void TestElementWithPositionalChildren::testIndexOfChildMethod() {
 
     childIndex = parentElement->indexOfChild(childElement4);
     QCOMPARE(childIndex, Ld::Element::invalidChildIndex);
+
+    // Indices must track insertions, removals and moves between parents.
+
+    parentElement->insertBefore(1, childElement4, nullptr);
+    QCOMPARE(parentElement->indexOfChild(childElement1), 0U);
+    QCOMPARE(parentElement->indexOfChild(childElement4), 1U);
+    QCOMPARE(parentElement->indexOfChild(childElement2), 2U);
+    QCOMPARE(parentElement->indexOfChild(childElement3), 3U);
+
+    parentElement->removeChild(childElement1, nullptr);
+    QCOMPARE(parentElement->indexOfChild(childElement1), Ld::Element::invalidChildIndex);
+    QCOMPARE(parentElement->indexOfChild(childElement4), 0U);
+    QCOMPARE(parentElement->indexOfChild(childElement2), 1U);
+    QCOMPARE(parentElement->indexOfChild(childElement3), 2U);
+
+    QSharedPointer<PositionalElement> otherParentElement = PositionalElement::create();
+    otherParentElement->append(childElement1, nullptr);
+    otherParentElement->prepend(childElement2, nullptr);
+    QCOMPARE(otherParentElement->indexOfChild(childElement2), 0U);
+    QCOMPARE(otherParentElement->indexOfChild(childElement1), 1U);
+    QCOMPARE(parentElement->indexOfChild(childElement2), Ld::Element::invalidChildIndex);
+    QCOMPARE(parentElement->indexOfChild(childElement3), 1U);
+    QVERIFY(childElement4->isFirstChild());
+    QVERIFY(childElement3->isLastChild());
+    QVERIFY(childElement4->nextSibling() == childElement3);
+
+    parentElement->removeChildren(nullptr);
+    QCOMPARE(parentElement->indexOfChild(childElement3), Ld::Element::invalidChildIndex);
 }
 
 
@@ -1030,3 +1134,26 @@ void TestElementWithPositionalChildren::testInsertBeforeCursorUpdates() {
 
     QCOMPARE(cursor->elementCursor(), Ld::ElementCursor(parentElement, 1));
 }
+
+
+void TestElementWithPositionalChildren::benchmarkSiblingTraversal() {
+    static constexpr unsigned long numberChildren = 100000;
+
+    QSharedPointer<PositionalElement> rootElement = PositionalElement::create();
+    for (unsigned long i=0 ; i<numberChildren ; ++i) {
+        rootElement->append(PositionalElement::create(), nullptr);
+    }
+
+    unsigned long numberVisited = 0;
+    QBENCHMARK {
+        numberVisited = 0;
+
+        Ld::ElementPointer element = rootElement->child(0);
+        while (!element.isNull()) {
+            ++numberVisited;
+            element = element->nextSibling();
+        }
+    }
+
+    QCOMPARE(numberVisited, numberChildren);
+}
@@ -61,6 +61,8 @@ class TestElementWithPositionalChildren:public QObject {
 
         void testDescendantTracking();
 
+        void testDescendantIterators();
+
         void testVisualTracking();
 
         void testCreatorFunctions();
@@ -75,6 +77,8 @@ class TestElementWithPositionalChildren:public QObject {
 
         void testInsertBeforeCursorUpdates();
 
+        void benchmarkSiblingTraversal();
+
     private:
         /**
          * Number of test iterations to perform to confirm that all element handles are, in fact, unique.
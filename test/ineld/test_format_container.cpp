@@ -31,6 +31,7 @@
 #include <QString>
 #include <QSharedPointer>
 #include <QMap>
+#include <QHash>
 #include <QtTest/QtTest>
 
 #include <cassert>
@@ -254,3 +255,32 @@ void TestFormatContainer::testSorting() {
     QVERIFY(container1 < container2);
     QVERIFY((container2 < container3) == false);
 }
+
+
+void TestFormatContainer::testHashing() {
+    Ld::FormatContainer container1(new TestFormat(1));
+    Ld::FormatContainer container2(new TestFormat(2));
+    Ld::FormatContainer container3(new TestFormat(2));
+
+    QVERIFY(container1.key() == QString("TestFormat,1"));
+    QVERIFY(container2.key() == container3.key());
+    QVERIFY(container2.hash() == container3.hash());
+    QVERIFY(qHash(container2) == qHash(container3));
+
+    QVERIFY(container1 != container2);
+    QVERIFY(container2 == container3);
+
+    QHash<Ld::FormatContainer, unsigned> hash;
+    hash.insert(container1, 1);
+    hash.insert(container2, 2);
+    hash.insert(container3, 3);
+
+    QVERIFY(hash.size() == 2);
+    QVERIFY(hash.value(container1) == 1);
+    QVERIFY(hash.value(container2) == 3);
+
+    Ld::FormatContainer container4;
+    container4.setFormat(container1.format());
+    QVERIFY(container4 == container1);
+    QVERIFY(hash.value(container4) == 1);
+}
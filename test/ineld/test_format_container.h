@@ -52,6 +52,8 @@ class TestFormatContainer:public QObject {
         void testAssignmentsAndCasts();
 
         void testSorting();
+
+        void testHashing();
 };
 
 #endif
@@ -32,6 +32,9 @@
 #include <QByteArray>
 #include <QSharedPointer>
 #include <QWeakPointer>
+#include <QFile>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
@@ -283,7 +286,92 @@ void TestHtmlCodeGenerator::testHtml4Functionality() {
 void TestHtmlCodeGenerator::testDiagnosticHandling() {}
 
 
-void TestHtmlCodeGenerator::cleanupTestCase() {}
+void TestHtmlCodeGenerator::testParallelTranslation() {
+    QSharedPointer<Ld::RootElement> rootElement = Ld::Element::create(Ld::RootElement::elementName)
+                                                  .dynamicCast<Ld::RootElement>();
+
+    for (unsigned i=0 ; i<200 ; ++i) {
+        addSimpleParagraph(rootElement);
+        addList(rootElement, (i % 2) == 0);
+    }
+
+    QString serialHtml   = translateToString(rootElement, false);
+    QString parallelHtml = translateToString(rootElement, true);
+
+    QVERIFY(!serialHtml.isEmpty());
+    QCOMPARE(parallelHtml, serialHtml);
+}
+
+
+void TestHtmlCodeGenerator::benchmarkTranslationThroughput() {
+    QSharedPointer<Ld::RootElement> rootElement = Ld::Element::create(Ld::RootElement::elementName)
+                                                  .dynamicCast<Ld::RootElement>();
+
+    for (unsigned i=0 ; i<1000 ; ++i) {
+        addSimpleParagraph(rootElement);
+        addList(rootElement, (i % 2) == 0);
+    }
+
+    unsigned long numberElements     = static_cast<unsigned long>(rootElement->descendants().size()) + 1;
+    unsigned long numberTranslations = 0;
+    QString       html;
+    QElapsedTimer timer;
+
+    timer.start();
+    QBENCHMARK {
+        html = translateToString(rootElement, false);
+        ++numberTranslations;
+    }
+
+    qint64 elapsedNanoseconds = timer.nsecsElapsed();
+    QVERIFY(!html.isEmpty());
+
+    if (elapsedNanoseconds > 0) {
+        qDebug() << "Translated"
+                 << (1.0E9 * numberElements * numberTranslations / elapsedNanoseconds)
+                 << "elements per second.";
+    }
+}
+
+
+void TestHtmlCodeGenerator::cleanupTestCase() {
+    QDir("exported_parallel").removeRecursively();
+    QDir("exported_serial").removeRecursively();
+}
+
+
+QString TestHtmlCodeGenerator::translateToString(QSharedPointer<Ld::RootElement> rootElement, bool parallel) {
+    QSharedPointer<Ld::HtmlCodeGenerator>
+        codeGenerator = Ld::CodeGenerator::codeGenerator(Ld::HtmlCodeGenerator::codeGeneratorName)
+                        .dynamicCast<Ld::HtmlCodeGenerator>();
+
+    QString exportedHtml = parallel ? "exported_parallel/index.html" : "exported_serial/index.html";
+
+    codeGenerator->setReportMissingPerElementTranslators();
+    codeGenerator->setHtmlStyle(Ld::HtmlCodeGenerator::HtmlStyle::HTML5_WITH_CSS);
+    codeGenerator->setProcessNoImports();
+    codeGenerator->setParallelTranslationEnabled(parallel);
+
+    bool success = codeGenerator->translate(
+        rootElement,
+        exportedHtml,
+        codeGenerator->supportedOutputTypes().first(),
+        Ld::CodeGeneratorOutputType::ExportMode::EXPORT_AS_DIRECTORY
+    );
+
+    codeGenerator->waitComplete();
+    codeGenerator->setParallelTranslationDisabled();
+
+    QString result;
+    if (success) {
+        QFile exportedFile(exportedHtml);
+        if (exportedFile.open(QFile::ReadOnly)) {
+            result = QString::fromUtf8(exportedFile.readAll());
+        }
+    }
+
+    return result;
+}
 
 
 QSharedPointer<Ld::RootElement> TestHtmlCodeGenerator::buildSampleProgram() {
@@ -53,11 +53,17 @@ class TestHtmlCodeGenerator:public QObject {
 
         void testDiagnosticHandling();
 
+        void testParallelTranslation();
+
+        void benchmarkTranslationThroughput();
+
         void cleanupTestCase();
 
     private:
         QSharedPointer<Ld::RootElement> buildSampleProgram();
 
+        QString translateToString(QSharedPointer<Ld::RootElement> rootElement, bool parallel);
+
         void addSimpleParagraph(QSharedPointer<Ld::RootElement> root);
 
         void addList(QSharedPointer<Ld::RootElement> root, bool ordered);
@@ -58,7 +58,7 @@ void TestHtmlTranslationPhase::testConstructorsAndDestructors() {
 void TestHtmlTranslationPhase::testPhases() {
     Ld::HtmlTranslationPhase translationPhase;
 
-    QCOMPARE(translationPhase.numberPhases(), 4U);
+    QCOMPARE(translationPhase.numberPhases(), 5U);
 
     QCOMPARE(translationPhase.phaseNumber(), 0U);
     QCOMPARE(translationPhase.phase(), Ld::HtmlTranslationPhase::Phase::DTD);
@@ -80,6 +80,14 @@ void TestHtmlTranslationPhase::testPhases() {
     translationPhase.nextPhase();
 
     QCOMPARE(translationPhase.phaseNumber(), 2U);
+    QCOMPARE(translationPhase.phase(), Ld::HtmlTranslationPhase::Phase::RENDER_IMAGES);
+    QCOMPARE(translationPhase.lastPhase(), false);
+    QCOMPARE(translationPhase.currentPhaseName(), QString("RENDER_IMAGES"));
+    QCOMPARE(translationPhase.currentTranslationMode(), Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY);
+
+    translationPhase.nextPhase();
+
+    QCOMPARE(translationPhase.phaseNumber(), 3U);
     QCOMPARE(translationPhase.phase(), Ld::HtmlTranslationPhase::Phase::HEADER);
     QCOMPARE(translationPhase.lastPhase(), false);
     QCOMPARE(translationPhase.currentPhaseName(), QString("HEADER"));
@@ -87,7 +95,7 @@ void TestHtmlTranslationPhase::testPhases() {
 
     translationPhase.nextPhase();
 
-    QCOMPARE(translationPhase.phaseNumber(), 3U);
+    QCOMPARE(translationPhase.phaseNumber(), 4U);
     QCOMPARE(translationPhase.phase(), Ld::HtmlTranslationPhase::Phase::BODY);
     QCOMPARE(translationPhase.lastPhase(), true);
     QCOMPARE(translationPhase.currentPhaseName(), QString("BODY"));
@@ -86,6 +86,11 @@
 #include "test_environment.h"
 #include "test_cpp_code_generator_output_types.h"
 #include "test_cpp_translation_phase.h"
+#include "test_cpp_object_cache.h"
+#include "test_cpp_declaration_pch_cache.h"
+#include "test_element_image_cache.h"
+#include "test_capabilities.h"
+#include "test_special_characters.h"
 #include "test_cpp_code_generator_diagnostic.h"
 #include "test_cpp_code_generator.h"
 #include "test_html_code_generator_output_types.h"
@@ -101,6 +106,7 @@
 #include "test_complex_data_type_format.h"
 #include "test_list_data_type_format.h"
 #include "test_matrix_data_type_format.h"
+#include "test_matrix_data_type_decoder.h"
 #include "test_value_field_format.h"
 #include "test_chart_line_style.h"
 #include "test_chart_format.h"
@@ -176,6 +182,11 @@ int main(int argumentCount, char** argumentValues) {
     TEST(TestLiteralElement)
     TEST(TestProgramLoadSave)
     TEST(TestCppTranslationPhase)
+    TEST(TestCppObjectCache)
+    TEST(TestCppDeclarationPchCache)
+    TEST(TestElementImageCache)
+    TEST(TestCapabilities)
+    TEST(TestSpecialCharacters)
     TEST(TestCppCodeGeneratorDiagnostic)
     TEST(TestCppCodeGenerator)
     TEST(TestHtmlTranslationPhase)
@@ -189,6 +200,7 @@ int main(int argumentCount, char** argumentValues) {
     TEST(TestComplexDataTypeFormat)
     TEST(TestListDataTypeFormat)
     TEST(TestMatrixDataTypeFormat)
+    TEST(TestMatrixDataTypeDecoder)
     TEST(TestValueFieldFormat)
     TEST(TestChartLineStyle)
     TEST(TestChartFormat)
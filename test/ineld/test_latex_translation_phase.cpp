@@ -58,7 +58,7 @@ void TestLaTeXTranslationPhase::testConstructorsAndDestructors() {
 void TestLaTeXTranslationPhase::testPhases() {
     Ld::LaTeXTranslationPhase translationPhase;
 
-    QCOMPARE(translationPhase.numberPhases(), 3U);
+    QCOMPARE(translationPhase.numberPhases(), 4U);
 
     QCOMPARE(translationPhase.phaseNumber(), 0U);
     QCOMPARE(translationPhase.phase(), Ld::LaTeXTranslationPhase::Phase::IDENTIFY_DEPENDENCIES);
@@ -69,6 +69,14 @@ void TestLaTeXTranslationPhase::testPhases() {
     translationPhase.nextPhase();
 
     QCOMPARE(translationPhase.phaseNumber(), 1U);
+    QCOMPARE(translationPhase.phase(), Ld::LaTeXTranslationPhase::Phase::RENDER_IMAGES);
+    QCOMPARE(translationPhase.lastPhase(), false);
+    QCOMPARE(translationPhase.currentPhaseName(), QString("RENDER_IMAGES"));
+    QCOMPARE(translationPhase.currentTranslationMode(), Ld::TranslationPhase::TranslationMode::IGNORE_HEIRARCHY);
+
+    translationPhase.nextPhase();
+
+    QCOMPARE(translationPhase.phaseNumber(), 2U);
     QCOMPARE(translationPhase.phase(), Ld::LaTeXTranslationPhase::Phase::PREAMBLE);
     QCOMPARE(translationPhase.lastPhase(), false);
     QCOMPARE(translationPhase.currentPhaseName(), QString("PREAMBLE"));
@@ -79,7 +87,7 @@ void TestLaTeXTranslationPhase::testPhases() {
 
     translationPhase.nextPhase();
 
-    QCOMPARE(translationPhase.phaseNumber(), 2U);
+    QCOMPARE(translationPhase.phaseNumber(), 3U);
     QCOMPARE(translationPhase.phase(), Ld::LaTeXTranslationPhase::Phase::BODY);
     QCOMPARE(translationPhase.lastPhase(), true);
     QCOMPARE(translationPhase.currentPhaseName(), QString("BODY"));
@@ -0,0 +1,222 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+********************************************************************************************************************//**
+* \file
+*
+* This file implements tests of the \ref Ld::MatrixDataTypeDecoder class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QDebug>
+#include <QString>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QAtomicInt>
+#include <QThread>
+#include <QtTest/QtTest>
+
+#include <model_matrix.h>
+#include <model_matrix_real.h>
+
+#include <ld_format_structures.h>
+#include <ld_matrix_data_type_format.h>
+#include <ld_matrix_data_type_decoder.h>
+
+#include "test_matrix_data_type_decoder.h"
+
+/***********************************************************************************************************************
+ * MatrixContext:
+ */
+
+/**
+ * Matrix decoder context that counts calls to formatCell and allows individual cells to be changed.
+ */
+class MatrixContext:public Ld::MatrixDataTypeDecoder::Context {
+    public:
+        /**
+         * Constructor
+         *
+         * \param[in] matrix The matrix to be rendered.
+         *
+         * \param[in] format The format used to decode the matrix.
+         */
+        MatrixContext(
+                const Model::MatrixReal& matrix,
+                Ld::FormatPointer        format
+            ):Ld::MatrixDataTypeDecoder::Context(
+                format
+            ),currentMatrix(
+                matrix
+            ) {
+            configure(matrix.numberRows(), matrix.numberColumns());
+        }
+
+        ~MatrixContext() override {}
+
+        const Model::Matrix& matrix() const override {
+            return currentMatrix;
+        }
+
+        unsigned long numberRows() const override {
+            return currentMatrix.numberRows();
+        }
+
+        unsigned long numberColumns() const override {
+            return currentMatrix.numberColumns();
+        }
+
+        bool canSuperscript() const override {
+            return false;
+        }
+
+        bool canSubscript() const override {
+            return false;
+        }
+
+        QString toString(unsigned long row, unsigned long column) const override {
+            return QString::number(static_cast<double>(currentMatrix(row, column)), 'g', 17);
+        }
+
+        /**
+         * The cell position is included so that a cell stored in the wrong slot is detected.
+         */
+        QStringList formatCell(unsigned long row, unsigned long column) const override {
+            currentNumberFormatCalls.fetchAndAddOrdered(1);
+            return QStringList() << toString(row, column) << QString("%1,%2").arg(row).arg(column);
+        }
+
+        /**
+         * Method that changes a single cell.  Reconfiguring the context discards the memoized strings.
+         *
+         * \param[in] row    The one based row of the cell to change.
+         *
+         * \param[in] column The one based column of the cell to change.
+         *
+         * \param[in] value  The new cell value.
+         */
+        void setCell(unsigned long row, unsigned long column, Model::Real value) {
+            currentMatrix.update(row, column, value);
+            configure(currentMatrix.numberRows(), currentMatrix.numberColumns());
+        }
+
+        /**
+         * Method that reports the number of times formatCell has been called.
+         *
+         * \return Returns the number of formatCell calls.
+         */
+        int numberFormatCalls() const {
+            return currentNumberFormatCalls.load();
+        }
+
+    private:
+        Model::MatrixReal currentMatrix;
+
+        mutable QAtomicInt currentNumberFormatCalls;
+};
+
+
+static Model::MatrixReal buildMatrix(unsigned long numberRows, unsigned long numberColumns) {
+    Model::MatrixReal matrix(numberRows, numberColumns);
+
+    for (unsigned long row=1 ; row<=numberRows ; ++row) {
+        for (unsigned long column=1 ; column<=numberColumns ; ++column) {
+            matrix.update(row, column, Model::Real(row) + Model::Real(column) / Model::Real(1024));
+        }
+    }
+
+    return matrix;
+}
+
+/***********************************************************************************************************************
+ * TestMatrixDataTypeDecoder:
+ */
+
+TestMatrixDataTypeDecoder::TestMatrixDataTypeDecoder() {}
+
+
+TestMatrixDataTypeDecoder::~TestMatrixDataTypeDecoder() {}
+
+
+void TestMatrixDataTypeDecoder::initTestCase() {}
+
+
+void TestMatrixDataTypeDecoder::testFormattedCellMemo() {
+    // The default format shows 9 leading and 1 trailing rows and columns, so a 20x20 matrix has 100 visible cells.
+
+    MatrixContext context(buildMatrix(20, 20), Ld::FormatPointer());
+
+    QCOMPARE(context.numberFormatCalls(), 0);
+    QCOMPARE(context.formattedCell(1, 1).last(), QString("1,1"));
+    QCOMPARE(context.numberFormatCalls(), 100);
+
+    QCOMPARE(context.formattedCell(20, 20).last(), QString("20,20"));
+    QCOMPARE(context.formattedCell(9, 20).last(), QString("9,20"));
+    QCOMPARE(context.formattedCell(20, 9).last(), QString("20,9"));
+    QCOMPARE(context.numberFormatCalls(), 100);
+
+    // Changing a cell must discard the memo so the next lookup reformats every visible cell.
+
+    QString oldValue = context.formattedCell(20, 3).first();
+    context.setCell(20, 3, Model::Real(-7.5));
+
+    QCOMPARE(context.formattedCell(20, 3).first(), QString("-7.5"));
+    QVERIFY(context.formattedCell(20, 3).first() != oldValue);
+    QCOMPARE(context.formattedCell(3, 20).first(), context.toString(3, 20));
+    QCOMPARE(context.numberFormatCalls(), 200);
+}
+
+
+void TestMatrixDataTypeDecoder::testShardedFormatting() {
+    if (QThread::idealThreadCount() < 2) {
+        QSKIP("Sharded formatting requires more than one thread.");
+    }
+
+    // 300x200 visible cells is well above the shard threshold so formatting is spread across the thread pool.
+
+    QSharedPointer<Ld::MatrixDataTypeFormat> format(new Ld::MatrixDataTypeFormat);
+    format->setLeadingRows(Ld::MatrixDataTypeFormat::showAllMembers);
+    format->setLeadingColumns(Ld::MatrixDataTypeFormat::showAllMembers);
+
+    unsigned long numberRows    = 300;
+    unsigned long numberColumns = 200;
+    MatrixContext context(buildMatrix(numberRows, numberColumns), format);
+
+    QCOMPARE(context.numberLeadingRows(), numberRows);
+    QCOMPARE(context.numberLeadingColumns(), numberColumns);
+
+    const QStringList& first = context.formattedCell(1, 1);
+    QCOMPARE(context.numberFormatCalls(), static_cast<int>(numberRows * numberColumns));
+    QCOMPARE(first.last(), QString("1,1"));
+
+    // Every memoized cell must match the strings produced by formatting the cell serially on this thread.
+
+    unsigned long numberMismatches = 0;
+    for (unsigned long row=1 ; row<=numberRows ; ++row) {
+        for (unsigned long column=1 ; column<=numberColumns ; ++column) {
+            if (context.formattedCell(row, column) != context.formatCell(row, column)) {
+                ++numberMismatches;
+            }
+        }
+    }
+
+    QCOMPARE(numberMismatches, 0UL);
+}
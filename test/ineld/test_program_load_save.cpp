@@ -29,7 +29,10 @@
 #include <QtGlobal>
 #include <QDebug>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QStringList>
+#include <QElapsedTimer>
 #include <QtTest/QtTest>
 
 #include <ld_handle.h>
@@ -55,6 +58,9 @@
 
 
 const QString TestProgramLoadSave::programFileName("test_program.ms");
+const QString TestProgramLoadSave::benchmarkFileName("test_benchmark_program.ms");
+const QString TestProgramLoadSave::binaryProgramFileName("test_binary_program.ms");
+const QString TestProgramLoadSave::backgroundProgramFileName("test_background_program.ms");
 
 TestProgramLoadSave::TestProgramLoadSave() {
     Ld::CodeGenerator::releaseCodeGenerators();
@@ -163,3 +169,326 @@ void TestProgramLoadSave::testProgramLoad() {
     success = rootElement->close();
     QVERIFY(success);
 }
+
+
+void TestProgramLoadSave::testBinaryDescriptionRoundTrip() {
+    static constexpr unsigned numberParagraphs           = 20;
+    static constexpr unsigned numberTextElementsPerBlock = 10;
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    QVERIFY(rootElement->binaryDescriptionDisabled());
+
+    bool success = rootElement->openNew();
+    QVERIFY(success);
+
+    QStringList expectedText;
+    for (unsigned paragraphIndex=0 ; paragraphIndex<numberParagraphs ; ++paragraphIndex) {
+        QSharedPointer<Ld::ParagraphElement> paragraphElement(new Ld::ParagraphElement);
+        paragraphElement->setWeakThis(paragraphElement.toWeakRef());
+
+        QSharedPointer<Ld::ParagraphFormat> paragraphFormat(new Ld::ParagraphFormat);
+        paragraphFormat->setLeftIndentation(paragraphIndex);
+        paragraphElement->setFormat(paragraphFormat);
+
+        rootElement->append(paragraphElement, nullptr);
+
+        for (unsigned textIndex=0 ; textIndex<numberTextElementsPerBlock ; ++textIndex) {
+            QString text = textIndex % 3 ? QString("t%1 <&> %2").arg(textIndex).arg(-1.5 * paragraphIndex) : QString();
+
+            QSharedPointer<Ld::TextElement> textElement(new Ld::TextElement);
+            textElement->setWeakThis(textElement.toWeakRef());
+            textElement->setText(text);
+
+            QSharedPointer<Ld::CharacterFormat> format(new Ld::CharacterFormat);
+            format->setFamily(textIndex % 2 ? "Courier" : "Helvetica");
+            format->setFontSize(10 + (textIndex % 4));
+            textElement->setFormat(format);
+
+            paragraphElement->append(textElement, nullptr);
+            expectedText << text;
+        }
+    }
+
+    rootElement->setBinaryDescriptionEnabled();
+    QVERIFY(rootElement->binaryDescriptionEnabled());
+
+    success = rootElement->saveAs(binaryProgramFileName);
+    QVERIFY(success);
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    Ld::PlugInsByName plugInsByName;
+    success = rootElement->openExisting(binaryProgramFileName, true, plugInsByName);
+    QVERIFY(success);
+
+    QStringList loadedText;
+    for (unsigned paragraphIndex=0 ; paragraphIndex<numberParagraphs ; ++paragraphIndex) {
+        Ld::ElementPointer paragraphElement = rootElement->child(paragraphIndex);
+        QVERIFY(!paragraphElement.isNull());
+
+        for (unsigned textIndex=0 ; textIndex<numberTextElementsPerBlock ; ++textIndex) {
+            QSharedPointer<Ld::TextElement> textElement = paragraphElement->child(textIndex)
+                                                          .dynamicCast<Ld::TextElement>();
+            QVERIFY(!textElement.isNull());
+
+            loadedText << textElement->text();
+        }
+    }
+
+    QCOMPARE(loadedText, expectedText);
+
+    // Switching back to XML must replace the binary stream so the XML version is what gets loaded.
+
+    rootElement->setBinaryDescriptionDisabled();
+    QSharedPointer<Ld::TextElement> firstText = rootElement->child(0)->child(1).dynamicCast<Ld::TextElement>();
+    QVERIFY(!firstText.isNull());
+    firstText->setText(QString("changed"));
+    expectedText[1] = QString("changed");
+
+    success = rootElement->save();
+    QVERIFY(success);
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    success = rootElement->openExisting(binaryProgramFileName, true, plugInsByName);
+    QVERIFY(success);
+
+    firstText = rootElement->child(0)->child(1).dynamicCast<Ld::TextElement>();
+    QVERIFY(!firstText.isNull());
+    QCOMPARE(firstText->text(), expectedText.at(1));
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    QFile::remove(binaryProgramFileName);
+}
+
+
+void TestProgramLoadSave::testBackgroundSave() {
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    bool success = rootElement->openNew();
+    QVERIFY(success);
+
+    QSharedPointer<Ld::ParagraphElement> paragraphElement(new Ld::ParagraphElement);
+    paragraphElement->setWeakThis(paragraphElement.toWeakRef());
+    rootElement->append(paragraphElement, nullptr);
+
+    QSharedPointer<Ld::TextElement> textElement(new Ld::TextElement);
+    textElement->setWeakThis(textElement.toWeakRef());
+    textElement->setText(QString("first"));
+    paragraphElement->append(textElement, nullptr);
+
+    // New programs must be saved under a name first.
+
+    success = rootElement->saveInBackground();
+    QVERIFY(!success);
+    QVERIFY(!rootElement->backgroundSavePending());
+
+    success = rootElement->saveAs(backgroundProgramFileName);
+    QVERIFY(success);
+    QVERIFY(rootElement->isPristine());
+
+    // An edit made while the save is in progress must leave the program modified.
+
+    textElement->setText(QString("second"));
+    QVERIFY(rootElement->isModified());
+
+    success = rootElement->saveInBackground();
+    QVERIFY(success);
+    QVERIFY(rootElement->backgroundSavePending());
+    QCOMPARE(rootElement->filename(), QFileInfo(backgroundProgramFileName).absoluteFilePath());
+
+    textElement->setText(QString("third"));
+
+    success = rootElement->waitBackgroundSaveComplete();
+    QVERIFY(success);
+    QVERIFY(!rootElement->backgroundSavePending());
+    QVERIFY(rootElement->isModified());
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    Ld::PlugInsByName plugInsByName;
+    success = rootElement->openExisting(backgroundProgramFileName, false, plugInsByName);
+    QVERIFY(success);
+
+    QSharedPointer<Ld::TextElement> loadedText = rootElement->child(0)->child(0).dynamicCast<Ld::TextElement>();
+    QVERIFY(!loadedText.isNull());
+    QCOMPARE(loadedText->text(), QString("second"));
+
+    // Without intervening edits, completion must mark the program pristine.
+
+    loadedText->setText(QString("fourth"));
+    success = rootElement->saveInBackground();
+    QVERIFY(success);
+
+    success = rootElement->waitBackgroundSaveComplete();
+    QVERIFY(success);
+    QVERIFY(rootElement->isPristine());
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    success = rootElement->openExisting(backgroundProgramFileName, true, plugInsByName);
+    QVERIFY(success);
+
+    loadedText = rootElement->child(0)->child(0).dynamicCast<Ld::TextElement>();
+    QVERIFY(!loadedText.isNull());
+    QCOMPARE(loadedText->text(), QString("fourth"));
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    QFile::remove(backgroundProgramFileName);
+}
+
+
+void TestProgramLoadSave::benchmarkSaveAfterFormatEdit() {
+    static constexpr unsigned numberParagraphs           = 1000;
+    static constexpr unsigned numberTextElementsPerBlock = 99;
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    bool success = rootElement->openNew();
+    QVERIFY(success);
+
+    QSharedPointer<Ld::CharacterFormat> editedFormat;
+    for (unsigned paragraphIndex=0 ; paragraphIndex<numberParagraphs ; ++paragraphIndex) {
+        QSharedPointer<Ld::ParagraphElement> paragraphElement(new Ld::ParagraphElement);
+        paragraphElement->setWeakThis(paragraphElement.toWeakRef());
+        paragraphElement->setFormat(QSharedPointer<Ld::ParagraphFormat>(new Ld::ParagraphFormat));
+
+        rootElement->append(paragraphElement, nullptr);
+
+        for (unsigned textIndex=0 ; textIndex<numberTextElementsPerBlock ; ++textIndex) {
+            QSharedPointer<Ld::TextElement> textElement(new Ld::TextElement);
+            textElement->setWeakThis(textElement.toWeakRef());
+            textElement->setText(QString("t%1").arg(textIndex));
+
+            QSharedPointer<Ld::CharacterFormat> format(new Ld::CharacterFormat);
+            format->setFamily(textIndex % 2 ? "Courier" : "Helvetica");
+            format->setFontSize(10 + (textIndex % 4));
+            textElement->setFormat(format);
+
+            paragraphElement->append(textElement, nullptr);
+
+            editedFormat = format;
+        }
+    }
+
+    success = rootElement->saveAs(benchmarkFileName);
+    QVERIFY(success);
+
+    unsigned fontSize = 20;
+    QBENCHMARK {
+        editedFormat->setFontSize(fontSize++);
+        success = rootElement->save();
+    }
+
+    QVERIFY(success);
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    QFile::remove(benchmarkFileName);
+}
+
+
+void TestProgramLoadSave::benchmarkLoadThroughput() {
+    static constexpr unsigned numberParagraphs           = 1000;
+    static constexpr unsigned numberTextElementsPerBlock = 20;
+
+    // Creating by type identifier must match creating by name.
+
+    Ld::Element::TypeId textTypeId = Ld::Element::typeIdByName(Ld::TextElement::elementName);
+    QVERIFY(textTypeId != Ld::Element::invalidTypeId);
+    QCOMPARE(Ld::Element::typeNameById(textTypeId), Ld::TextElement::elementName);
+    QCOMPARE(Ld::Element::create(textTypeId)->typeName(), Ld::TextElement::elementName);
+    QCOMPARE(Ld::Element::create(textTypeId)->typeId(), textTypeId);
+
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    bool success = rootElement->openNew();
+    QVERIFY(success);
+
+    for (unsigned paragraphIndex=0 ; paragraphIndex<numberParagraphs ; ++paragraphIndex) {
+        QSharedPointer<Ld::ParagraphElement> paragraphElement(new Ld::ParagraphElement);
+        paragraphElement->setWeakThis(paragraphElement.toWeakRef());
+        paragraphElement->setFormat(QSharedPointer<Ld::ParagraphFormat>(new Ld::ParagraphFormat));
+
+        rootElement->append(paragraphElement, nullptr);
+
+        for (unsigned textIndex=0 ; textIndex<numberTextElementsPerBlock ; ++textIndex) {
+            QSharedPointer<Ld::TextElement> textElement(new Ld::TextElement);
+            textElement->setWeakThis(textElement.toWeakRef());
+            textElement->setText(QString("t%1").arg(textIndex));
+            textElement->setFormat(QSharedPointer<Ld::CharacterFormat>(new Ld::CharacterFormat));
+
+            paragraphElement->append(textElement, nullptr);
+        }
+    }
+
+    unsigned long numberElements = static_cast<unsigned long>(rootElement->descendants().size());
+
+    success = rootElement->saveAs(benchmarkFileName);
+    QVERIFY(success);
+
+    success = rootElement->close();
+    QVERIFY(success);
+
+    Ld::PlugInsByName  plugInsByName;
+    unsigned long      numberLoads       = 0;
+    unsigned long long initialPeakMemory = peakResidentMemory();
+    QElapsedTimer      timer;
+
+    timer.start();
+    QBENCHMARK {
+        success = rootElement->openExisting(benchmarkFileName, true, plugInsByName) && success;
+        success = rootElement->close() && success;
+        ++numberLoads;
+    }
+
+    qint64 elapsedNanoseconds = timer.nsecsElapsed();
+    QVERIFY(success);
+
+    if (elapsedNanoseconds > 0) {
+        qDebug() << "Loaded"
+                 << (1.0E9 * numberElements * numberLoads / elapsedNanoseconds)
+                 << "elements per second.";
+    }
+
+    unsigned long long finalPeakMemory = peakResidentMemory();
+    if (finalPeakMemory > 0) {
+        qDebug() << "Peak resident memory" << finalPeakMemory << "KiB,"
+                 << (finalPeakMemory - initialPeakMemory) << "KiB above the pre-load peak.";
+    }
+
+    QFile::remove(benchmarkFileName);
+}
+
+
+unsigned long long TestProgramLoadSave::peakResidentMemory() {
+    unsigned long long result = 0;
+
+    QFile statusFile("/proc/self/status");
+    if (statusFile.open(QFile::ReadOnly | QFile::Text)) {
+        QByteArray line = statusFile.readLine();
+        while (!line.isEmpty() && result == 0) {
+            if (line.startsWith("VmHWM:")) {
+                result = line.mid(6).trimmed().split(' ').first().toULongLong();
+            }
+
+            line = statusFile.readLine();
+        }
+    }
+
+    return result;
+}
@@ -45,9 +45,25 @@ class TestProgramLoadSave:public QObject {
 
         void testProgramLoad();
 
+        void testBinaryDescriptionRoundTrip();
+
+        void testBackgroundSave();
+
+        void benchmarkSaveAfterFormatEdit();
+
+        void benchmarkLoadThroughput();
+
     private:
         static const QString programFileName;
 
+        static const QString benchmarkFileName;
+
+        static const QString binaryProgramFileName;
+
+        static const QString backgroundProgramFileName;
+
+        static unsigned long long peakResidentMemory();
+
 };
 
 #endif
@@ -49,6 +49,9 @@
 #include <ld_element_cursor.h>
 
 #include <ld_root_visual.h>
+#include <ld_operation.h>
+#include <ld_operation_database.h>
+#include <ld_operation_profile.h>
 #include <ld_root_element.h>
 
 #include "test_root_element.h"
@@ -466,7 +469,7 @@ void TestRootElement::testTypeName() {
 }
 
 
-void TestRootElement::testStateMethods() { // isEmpty, isNotEmpty, isModified, isPristine
+void TestRootElement::testStateMethods() { // isEmpty, isNotEmpty, isModified, isPristine, revision
     QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
     rootElement->setWeakThis(rootElement.toWeakRef());
 
@@ -480,6 +483,8 @@ void TestRootElement::testStateMethods() { // isEmpty, isNotEmpty, isModified, i
     QVERIFY(rootElement->isPristine());
     QVERIFY(!rootElement->isModified());
 
+    unsigned long long initialRevision = rootElement->revision();
+
     // Add an element, confirm the root element is not empty and is modified.
 
     QSharedPointer<ChildElement> child1(new ChildElement);
@@ -492,7 +497,10 @@ void TestRootElement::testStateMethods() { // isEmpty, isNotEmpty, isModified, i
     QVERIFY(!rootElement->isPristine());
     QVERIFY(rootElement->isModified());
 
-    // Now save the root element and confirm modified status changes.
+    unsigned long long modifiedRevision = rootElement->revision();
+    QVERIFY(modifiedRevision > initialRevision);
+
+    // Now save the root element and confirm modified status changes.  Saving must not change the revision.
 
     success = rootElement->saveAs(QString("test_file.ms"));
     QVERIFY(success);
@@ -501,6 +509,7 @@ void TestRootElement::testStateMethods() { // isEmpty, isNotEmpty, isModified, i
     QVERIFY(rootElement->isNotEmpty());
     QVERIFY(rootElement->isPristine());
     QVERIFY(!rootElement->isModified());
+    QCOMPARE(rootElement->revision(), modifiedRevision);
 
     success = rootElement->close();
     QVERIFY(success);
@@ -924,3 +933,58 @@ void TestRootElement::testFormatOrganizerMethod() {
 
     // We rely on the FormatOrganizer unit test to verify functionality of that class.
 }
+
+
+void TestRootElement::testOperationProfile() { // setOperationProfile, operationProfile, clearOperationProfile
+    QSharedPointer<Ld::RootElement> rootElement(new Ld::RootElement);
+    rootElement->setWeakThis(rootElement.toWeakRef());
+
+    QSharedPointer<ChildElement> child0(new ChildElement);
+    child0->setWeakThis(child0.toWeakRef());
+
+    QSharedPointer<ChildElement> child00(new ChildElement);
+    child00->setWeakThis(child00.toWeakRef());
+
+    QSharedPointer<ChildElement> child01(new ChildElement);
+    child01->setWeakThis(child01.toWeakRef());
+
+    rootElement->append(child0, nullptr);
+    child0->setChild(0, child00, nullptr);
+    child0->setChild(1, child01, nullptr);
+
+    Ld::OperationDatabase& database   = rootElement->operationDatabase();
+    Ld::Operation          operation0 = database.createOperation(child0);
+    Ld::Operation          operation1 = database.createOperation(child00);
+    Ld::Operation          operation2 = database.createOperation(child01);
+
+    QVERIFY(!rootElement->hasOperationProfile());
+    QVERIFY(rootElement->operationProfile(child0).isInvalid());
+
+    QVector<unsigned long long> hitCounts            = { 1, 10, 20 };
+    QVector<unsigned long long> exclusiveNanoseconds = { 100, 1000, 3000 };
+
+    rootElement->setOperationProfile(hitCounts, exclusiveNanoseconds);
+    QVERIFY(rootElement->hasOperationProfile());
+    QCOMPARE(rootElement->operationProfiles().size(), 3);
+
+    Ld::OperationProfile profile0 = rootElement->operationProfile(child0);
+    QVERIFY(profile0.isValid());
+    QCOMPARE(profile0.operation().handle(), operation0.handle());
+    QCOMPARE(profile0.hitCount(), 1ULL);
+    QCOMPARE(profile0.exclusiveNanoseconds(), 100ULL);
+    QCOMPARE(profile0.inclusiveNanoseconds(), 4100ULL);
+
+    Ld::OperationProfile profile1 = rootElement->operationProfile(child00);
+    QCOMPARE(profile1.operation().handle(), operation1.handle());
+    QCOMPARE(profile1.hitCount(), 10ULL);
+    QCOMPARE(profile1.inclusiveNanoseconds(), 1000ULL);
+
+    Ld::OperationProfile profile2 = rootElement->operationProfile(child01);
+    QCOMPARE(profile2.operation().handle(), operation2.handle());
+    QCOMPARE(profile2.exclusiveNanoseconds(), 3000ULL);
+    QCOMPARE(profile2.inclusiveNanoseconds(), 3000ULL);
+
+    rootElement->clearOperationProfile();
+    QVERIFY(!rootElement->hasOperationProfile());
+    QVERIFY(rootElement->operationProfile(child00).isInvalid());
+}
@@ -44,7 +44,7 @@ class TestRootElement:public QObject {
 
         void testTypeName();
 
-        void testStateMethods(); // isEmpty, isNotEmpty, isModified, isPristine
+        void testStateMethods(); // isEmpty, isNotEmpty, isModified, isPristine, revision
 
         void testSaveLoadMethods();
 
@@ -61,6 +61,8 @@ class TestRootElement:public QObject {
         void testRequiredPlugInsMethods();
 
         void testFormatOrganizerMethod();
+
+        void testOperationProfile(); // setOperationProfile, operationProfile, clearOperationProfile
 };
 
 #endif
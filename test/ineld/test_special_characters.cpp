@@ -0,0 +1,97 @@
+/*-*-c++-*-*************************************************************************************************************
+* Copyright 2016 - 2023 Inesonic, LLC.
+*
+* This file is licensed under two licenses.
+*
+* Inesonic Commercial License, Version 1:
+*   All rights reserved.  Inesonic, LLC retains all rights to this software, including the right to relicense the
+*   software in source or binary formats under different terms.  Unauthorized use under the terms of this license is
+*   strictly prohibited.
+*
+* GNU Public License, Version 2:
+*   This program is free software; you can redistribute it and/or modify it under the terms of the GNU General Public
+*   License as published by the Free Software Foundation; either version 2 of the License, or (at your option) any later
+*   version.
+*
+*   This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied
+*   warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+*   details.
+*
+*   You should have received a copy of the GNU General Public License along with this program; if not, write to the Free
+*   Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+* \file
+*
+* This file implements tests for the \ref Ld::SpecialCharacters class.
+***********************************************************************************************************************/
+
+#include <QtGlobal>
+#include <QString>
+#include <QChar>
+#include <QtTest/QtTest>
+
+#include <ld_capabilities.h>
+#include <ld_special_characters.h>
+
+#include "test_special_characters.h"
+
+TestSpecialCharacters::TestSpecialCharacters() {}
+
+
+TestSpecialCharacters::~TestSpecialCharacters() {}
+
+
+void TestSpecialCharacters::testCommandForUnicodeValue() {
+    QCOMPARE(Ld::SpecialCharacters::commandForUnicodeValue(0x03B1), QString("alpha"));
+    QCOMPARE(Ld::SpecialCharacters::commandForUnicodeValue(0x221E), QString("infty"));
+    QVERIFY(Ld::SpecialCharacters::commandForUnicodeValue('a').isEmpty());
+    QVERIFY(Ld::SpecialCharacters::commandForUnicodeValue(0x4E00).isEmpty());
+
+    QMap<Ld::SpecialCharacters::UnicodeValue, QString> commands =
+        Ld::SpecialCharacters::characterCommandsByUnicodeValue(true, true, true, true);
+
+    for (  QMap<Ld::SpecialCharacters::UnicodeValue, QString>::const_iterator it  = commands.constBegin(),
+                                                                              end = commands.constEnd()
+         ; it != end
+         ; ++it
+        ) {
+        QCOMPARE(Ld::SpecialCharacters::commandForUnicodeValue(it.key()), it.value());
+    }
+}
+
+
+void TestSpecialCharacters::testNextNonAsciiIndex() {
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(QString()), 0UL);
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(QString("abc")), 3UL);
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(QString("abcdefghij")), 10UL);
+
+    QString text = QString("abcdefghij") + QChar(0x03B1) + QString("klm") + QChar(0x0100);
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(text), 10UL);
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(text, 10), 10UL);
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(text, 11), 14UL);
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(text, 15), 15UL);
+
+    QString highByte = QString("abc") + QChar(0x0180) + QString("defg");
+    QCOMPARE(Ld::SpecialCharacters::nextNonAsciiIndex(highByte), 3UL);
+}
+
+
+void TestSpecialCharacters::testRequiredCapabilities() {
+    QVERIFY(Ld::SpecialCharacters::requiredCapabilities(QString()).isEmpty());
+
+    QVERIFY(Ld::SpecialCharacters::requiredCapabilities(QString("abc")) == Ld::Capabilities::alphabeticSymbols);
+    QVERIFY(Ld::SpecialCharacters::requiredCapabilities(QString("123")) == Ld::Capabilities::numericDecimalSymbols);
+
+    Ld::Capabilities quoted = Ld::SpecialCharacters::requiredCapabilities(QString("\"x\""));
+    QVERIFY(quoted.contains(Ld::Capabilities::stringIdentifierSymbols));
+    QVERIFY(quoted.contains(Ld::Capabilities::specialSymbols));
+    QVERIFY(quoted.contains(Ld::Capabilities::alphabeticSymbols));
+
+    Ld::Capabilities greek = Ld::SpecialCharacters::requiredCapabilities(QString("a") + QChar(0x03B2));
+    QVERIFY(greek == (Ld::Capabilities::alphabeticSymbols | Ld::Capabilities::nonAsciiAlphabeticSymbols));
+
+    Ld::Capabilities symbol = Ld::SpecialCharacters::requiredCapabilities(QString(QChar(0x221E)));
+    QVERIFY(symbol == Ld::Capabilities::specialSymbols);
+
+    Ld::Capabilities unknown = Ld::SpecialCharacters::requiredCapabilities(QString(QChar(0x4E00)));
+    QVERIFY(unknown == Ld::Capabilities::specialSymbols);
+}